@@ -1,19 +1,36 @@
 from textwrap import dedent
 import re
-from predict_tide import predict_tide, unpack_tz, epoch, rads_per_second, seconds_tz, find_tide_events
-import random, math
+from predict_tide import predict_tide, unpack_tz, epoch, rads_per_second, seconds_tz, find_tide_events, find_tide_event, TideEvent
+from tide_db import ENCODING_HARMONIC, ENCODING_NODAL, name_key
+try:
+    import tide_lib
+except ImportError: # no NumPy, so everything is predicted in Python
+    tide_lib = None
+import random, math, time
+import multiprocessing
 
 MAX_AMP = 12.0
 MAX_PHASE = math.pi*2
 MAX_SPEED = 0.001
+MAX_NODE_FACTOR = 4.0 # as in tide_base.h
+# constituents whose node factors and equilibrium arguments the device can compute, in the order of tide_astro_names in tide_astro.c
+ASTRO_CONSTITUENTS = ["M2", "S2", "N2", "K1", "O1", "NU2", "MU2", "2N2", "OO1", "LAM2", "S1", "J1", "MM", "SSA", "SA", "MF",
+                      "RHO1", "Q1", "T2", "R2", "2Q1", "P1", "L2", "K2", "M3",
+                      "M4", "M6", "M8", "S4", "S6", "MN4", "MS4", "MK3", "2MK3", "2SM2", "MSF"]
+ASTRO_NONE = 0xFF # as in tide_astro.h
+ALMANAC_BLOCK = 32 # events per binary search block in an almanac
+MAX_CHEBYSHEV_ORDER = 32 # as in tide_base.h
+KERNEL_MULTIPLIES = 16 # multiplies per constituent in tide_kernel.c
+
+def quantize_ints(bits, max_val, seq):
+    """Quantize a sequence to the given number of bits,
+    with the given max value, as a list of ints"""
+    return [int((val / max_val) * ((2**bits)-1)) for val in seq]
 
 def get_seq(bits, max_val, seq):
     """Quantize a sequence to the given number of bits,
     with the given max value and return a string of hex values"""
-    elts = []
-    for val in seq:
-        elts.append(int((val / max_val) * ((2**bits)-1)))
-    return ", ".join([f"0x{x:X}" for x in elts])
+    return ", ".join([f"0x{x:X}" for x in quantize_ints(bits, max_val, seq)])
 
 def float_seq(seq):
     """Return a string of floats, with high precision (16 decimal places)"""    
@@ -41,14 +58,22 @@ def predict_c_tide(t, year, phases, speeds, amps, offset):
 
 
 
-def extract_cycles(station, year, constituents, min_amp):
+def device_station(amps, phases, speeds, year, offset):
+    """The cycles for year (from extract_cycles) as the device predicts them, 
+    in the C core (see tide_lib.py), or None if the core isn't available or 
+    can't take them"""
+    if tide_lib is None or not tide_lib.available() or len(speeds) > tide_lib.MAX_CONSTITUENTS or max(amps, default=0.0) > MAX_AMP:
+        return None
+    return tide_lib.DeviceStation(speeds, quantize_ints(16, MAX_AMP, amps), quantize_ints(16, MAX_PHASE, phases), year, 1, offset)
+
+def extract_cycles(station, year, constituents, names):
     """Combine constituent data with station data to extract the raw harmonic 
-    oscillations for the given year. Exclude all oscillations with an amplitude
-    less than min_amp"""
+    oscillations for the given year, for the named constituents (in that order). 
+    The same names must be used for every year, so the C arrays line up."""
     amps = []
     phases = []
     speeds = []    
-    for c in station["constituents"]:
+    for c in names:
         station_amp = station["constituents"][c]["amp"]        
         node_factor = constituents[c]["years"][str(year)]["node_factor"]
         station_phase = station["constituents"][c]["phase"]
@@ -59,20 +84,193 @@ def extract_cycles(station, year, constituents, min_amp):
             scale = 0.3048
         elif station["units"]=="meters":
             scale = 1.0 
-        if amp>min_amp:                        
-            amps.append(amp * scale)            
-            phase = math.radians(equilib - station_phase) - time_offset
-            # force to radians in [0, 2pi]
-            phase = phase % (2*math.pi)
-            if phase<0:
-                phase += 2*math.pi
-            phases.append(phase)
-            speeds.append(rads_per_second(constituents[c]["speed"]))
+        amps.append(amp * scale)            
+        phase = math.radians(equilib - station_phase) - time_offset
+        # force to radians in [0, 2pi]
+        phase = phase % (2*math.pi)
+        if phase<0:
+            phase += 2*math.pi
+        phases.append(phase)
+        speeds.append(rads_per_second(constituents[c]["speed"]))
     
     return amps, phases, speeds
 
-def get_tidal_range(time, constituents, station):
-    events = find_tide_events(time, 3, constituents, station)
+def level_scale(station):
+    return 0.3048 if station["units"]=="feet" else 1.0
+
+def extract_epochs(station, constituents, names):
+    """The base amplitudes and epochs of the named constituents, for a station 
+    stored with the nodal encoding. The yearly node factors and equilibrium 
+    arguments in the shared NodalTable turn these into the cycles that 
+    extract_cycles gives: amp * node_factor, and equilibrium - epoch."""
+    amps = []
+    epochs = []
+    for c in names:
+        amps.append(station["constituents"][c]["amp"] * level_scale(station))
+        time_offset = seconds_tz(station["zone_offset"]) * rads_per_second(constituents[c]["speed"])
+        epochs.append((math.radians(station["constituents"][c]["phase"]) + time_offset) % (2*math.pi))
+    return amps, epochs
+
+def astro_id(name):
+    """The tide_astro id of the named constituent, or ASTRO_NONE if the device cannot compute its corrections"""
+    return ASTRO_CONSTITUENTS.index(name.upper()) if name.upper() in ASTRO_CONSTITUENTS else ASTRO_NONE
+
+class NodalTable:
+    """The node factors and equilibrium arguments shared by every station stored
+    with the nodal encoding (tide_nodal_table in tide_base.h). These depend only
+    on the year, so the table holds each constituent once, however many stations 
+    use it. Stations add their constituents as they are written, and the table 
+    is written after them. 
+    
+    If the device can compute the corrections for every constituent, the yearly
+    rows are only kept in debug builds, where tide_debug --test checks the 
+    device's corrections against them, and the table never runs out of years."""
+    c_name = "tide_nodal"
+
+    def __init__(self, constituents, min_year, max_year):
+        self.constituents = constituents
+        self.min_year = min_year
+        self.max_year = max_year
+        self.names = []
+
+    def declare(self, file=None):
+        """Declare the table, so stations written before it can point at it"""
+        print(f"extern tide_nodal_table {self.c_name};", file=file)
+
+    def index(self, name):
+        """The index of the named constituent in the table, adding it if needed"""
+        if name not in self.names:
+            # tide_nodal_table keeps the count in a uint8_t
+            if len(self.names) == 255:
+                raise ValueError("A nodal table can hold at most 255 constituents")
+            self.names.append(name)
+        return self.names.index(name)
+
+    def computed(self):
+        """True if the device can compute the corrections for every constituent"""
+        return all(astro_id(c) != ASTRO_NONE for c in self.names)
+
+    def size(self):
+        """Bytes of flash used by the table"""
+        size = len(self.names) * 5
+        if not self.computed():
+            size += len(self.names) * 4 * (self.max_year - self.min_year)
+        return size
+
+    def dump(self, file=None, db=None):
+        """Write the table as C, and add it to db if that is given"""
+        node_factors = []
+        equilibria = []
+        for year in range(self.min_year, self.max_year):
+            for c in self.names:
+                node_factors.append(self.constituents[c]["years"][str(year)]["node_factor"])
+                equilibria.append(math.radians(self.constituents[c]["years"][str(year)]["equilibrium"]) % (2*math.pi))
+        speeds = [rads_per_second(self.constituents[c]["speed"]) for c in self.names]
+        # with every constituent computed, the rows are only there to test against
+        debug_only = self.computed()
+        if db:
+            n_years = 0 if debug_only else self.max_year - self.min_year
+            db.set_nodal(self.min_year, n_years, speeds, [astro_id(c) for c in self.names], 
+                         quantize_ints(16, MAX_NODE_FACTOR, node_factors) if n_years else [], quantize_ints(16, MAX_PHASE, equilibria) if n_years else [])
+        rows = dedent(f"""
+                    const uint16_t {self.c_name}_node_factor [] = {{{get_seq(16, MAX_NODE_FACTOR, node_factors)}}};
+                    const uint16_t {self.c_name}_equilibrium [] = {{{get_seq(16, MAX_PHASE, equilibria)}}};""")
+        row_fields = "".join([f"\n        .n_years = {self.max_year - self.min_year},",
+                              f"\n        .node_factors = {self.c_name}_node_factor,",
+                              f"\n        .equilibria = {self.c_name}_equilibrium,"])
+        if debug_only:
+            rows = "\n#ifdef TIDE_DEBUG" + rows + "\n#endif"
+            row_fields = "\n#ifdef TIDE_DEBUG" + row_fields + "\n#endif"
+        print(dedent(f"""
+                    /* Node factors and equilibrium arguments for {len(self.names)} constituents, {self.min_year}-{self.max_year} */
+                    const float {self.c_name}_speed [] = {{{float_seq(speeds)}}};
+                    const uint8_t {self.c_name}_astro [] = {{{", ".join([str(astro_id(c)) for c in self.names])}}};""") + rows + dedent(f"""
+                    tide_nodal_table {self.c_name} = {{
+                            .base_year = {self.min_year},
+                            .n_constituents = {len(self.names)},
+                            .speeds = {self.c_name}_speed,
+                            .astro = {self.c_name}_astro,""") + row_fields + "\n};\n", file=file)
+
+def select_constituents(station, min_year, max_year, constituents, min_amp, error_budget=None, max_event_error=None, max_constituents=None, 
+                        year_events=None, rng=random):
+    """Choose the constituents to store for a station. 
+    
+    Without an error budget or a constituent limit, this is every constituent
+    whose amplitude is over min_amp in any of the years. Otherwise constituents 
+    are added greedily, largest reduction in squared error first, until the RMS 
+    error is within error_budget and the largest error within max_event_error 
+    (if given), or there are max_constituents of them. Errors are measured against
+    the full prediction at every HW/LW event in the years, where errors matter most,
+    and at random times in between; both must be within the budget.
+    year_events maps each year to its events from find_year_events, if they are already known.
+    Returns the names (in the station's order), and the RMS and largest error at the events."""
+    candidates = [c for c in station["constituents"] 
+                  if any(station["constituents"][c]["amp"] * constituents[c]["years"][str(year)]["node_factor"] * level_scale(station) > min_amp 
+                         for year in range(min_year, max_year))]
+    
+    # the full prediction, at the events and at random times
+    times, truth = [], []
+    for year in range(min_year, max_year):
+        for event in (year_events[year] if year_events else find_year_events(station, year, constituents)):
+            # the event levels may be the device's, so take the reference level at the same time
+            times.append(event.time)
+            truth.append(predict_tide(event.time, constituents, station))
+    n_events = len(times)
+    for year in range(min_year, max_year):
+        for t in [rng.randint(epoch(year), epoch(year+1)) for _ in range(400)]:
+            times.append(t)
+            truth.append(predict_tide(t, constituents, station))
+            
+    # contribution of each candidate at each time
+    cycles = {year:extract_cycles(station, year, constituents, candidates) for year in range(min_year, max_year)}
+    terms = {c:[] for c in candidates}
+    for t in times:
+        year = min(max(time.gmtime(int(t))[0], min_year), max_year - 1)
+        amps, phases, speeds = cycles[year]
+        for c, amp, phase, speed in zip(candidates, amps, phases, speeds):
+            terms[c].append(amp * math.cos(speed * (t - epoch(year)) + phase))
+    offset = station["offset"] * level_scale(station)
+    residual = [level - offset for level in truth]
+
+    def errors(residual):
+        rms = math.sqrt(sum(r*r for r in residual) / max(1, len(residual)))
+        return rms, max([abs(r) for r in residual], default=0.0)
+
+    def within_budget(residual):
+        for part in (residual[:n_events], residual[n_events:]):
+            rms, worst = errors(part)
+            if rms > error_budget or (max_event_error is not None and worst > max_event_error):
+                return False
+        return True
+    
+    if error_budget is None and max_constituents is None:
+        chosen = candidates
+        for c in candidates:
+            residual = [r - term for r, term in zip(residual, terms[c])]
+    else:
+        chosen = []
+        remaining = list(candidates)
+        while remaining and (max_constituents is None or len(chosen) < max_constituents):
+            if error_budget is not None and within_budget(residual):
+                break
+            # sum((r - term)^2) = sum(r^2) - sum(2*r*term - term^2)
+            best = max(remaining, key=lambda c: sum(term * (2*r - term) for r, term in zip(residual, terms[c])))
+            residual = [r - term for r, term in zip(residual, terms[best])]
+            chosen.append(best)
+            remaining.remove(best)
+        chosen = [c for c in candidates if c in chosen]
+    rms, worst = errors(residual[:n_events])
+    return chosen, rms, worst
+
+def get_tidal_range(time, constituents, station, device=None):
+    """The range from the first HW to the first LW of those found around time,
+    predicted by device (a tide_lib.DeviceStation) if that is given"""
+    if device:
+        # the brackets find_tide_events searches
+        reach = 3.5 * 12.4206012 * 3600 * 0.25
+        events = device.events(time - reach, time + reach)
+    else:
+        events = find_tide_events(time, 3, constituents, station)
     highs = [e for e in events if e.event_type=="high"]
     lows = [e for e in events if e.event_type=="low"]
     return highs[0].level - lows[0].level
@@ -80,42 +278,216 @@ def get_tidal_range(time, constituents, station):
     
     
 
-def generate_tests(station, year, constituents, phases, speeds, amps, n_samples=400):
+def generate_tests(station, year, constituents, phases, speeds, amps, n_samples=400, rng=random):
     """Generate a set of test times and tides for the given station and year.
-    The tides are generated using the predict_tide function, and the quantized
-    tides are generated using the predict_c_tide function. The mean error is
-    returned, along with the test times and tide levels."""    
+    The tides are generated using the predict_tide function, and the mean error
+    is that of the stored constants, predicted by the C core if it is available
+    (and otherwise imitated by predict_c_tide). The neap and spring ranges are 
+    those the device will find. The mean error is returned, along with the test
+    times and tide levels."""    
     min_time = epoch(year)
     max_time = epoch(year+1)
-    test_times = [random.randint(min_time, max_time) for _ in range(0, 96)]
+    test_times = [rng.randint(min_time, max_time) for _ in range(0, 96)]
     test_tides = [predict_tide(t, constituents, station) for t in test_times]
-    total_error = 0
+    device = device_station(amps, phases, speeds, year, station["offset"])
 
-    # very slow but we only do it once
-    test_ranges = [get_tidal_range(time, constituents, station) for time in test_times]
+    # very slow in Python, but we only do it once
+    test_ranges = [get_tidal_range(time, constituents, station, device) for time in test_times]
     neaps_range, springs_range = min(test_ranges), max(test_ranges)
     
-    for i in range(n_samples):
-        time = random.randint(min_time, max_time)
-        tide = predict_tide(time, constituents, station)        
-        quantized = predict_c_tide(time, year,  quantize_seq(16, MAX_PHASE, phases), quantize_seq(32, MAX_SPEED, speeds),  quantize_seq(16, MAX_AMP, amps), station["offset"])
-        total_error += abs(tide - quantized)
+    sample_times = [rng.randint(min_time, max_time) for i in range(n_samples)]
+    if device:
+        quantized, _, _ = device.predict(sample_times)
+    else:
+        quantized = [predict_c_tide(time, year,  quantize_seq(16, MAX_PHASE, phases), quantize_seq(32, MAX_SPEED, speeds),  quantize_seq(16, MAX_AMP, amps), station["offset"]) 
+                     for time in sample_times]
+    total_error = sum(abs(predict_tide(time, constituents, station) - float(q)) for time, q in zip(sample_times, quantized))
     mean_error = total_error / n_samples
     return test_times, test_tides, mean_error, neaps_range, springs_range
 
+def add_event(events, event, mean, min_gap):
+    """Append event to events, keeping highs and lows alternating and at least 
+    min_gap apart. Of a repeated type the more extreme is kept, and of two that 
+    are too close the one further from the mean level."""
+    if events and event.time - events[-1].time < min_gap and event.event_type != events[-1].event_type:
+        if abs(event.level - mean) <= abs(events[-1].level - mean):
+            return
+        events.pop()
+    if events and event.event_type == events[-1].event_type:
+        if (event.level > events[-1].level) == (event.event_type == "high"):
+            events[-1] = event
+    else:
+        events.append(event)
+
+def find_year_events(station, year, constituents, step=3600, min_gap=3600):
+    """Find every HW/LW event in the given year, searching hour by hour, or
+    with the C core if it is available"""
+    events = []
+    t = epoch(year)
+    end = epoch(year+1)
+    # the constituents that are there at all
+    names = [c for c in station["constituents"] if station["constituents"][c]["amp"] > 0]
+    device = device_station(*extract_cycles(station, year, constituents, names), year, station["offset"])
+    if device:
+        # Around a stand it can find both ends, or only one (so two highs or 
+        # two lows in a row), which the hourly search would not
+        for event in device.events(t, end):
+            add_event(events, event, station["offset"], min_gap)
+        return events
+    while t < end:
+        res = find_tide_event(t, t+step, constituents, station, epoch_year=year)
+        if res:
+            high, t_event, level = res
+            add_event(events, TideEvent("high" if high else "low", t_event, level), station["offset"] * level_scale(station), min_gap)
+        t += step
+    return events
+
+def encode_almanac(events, start, offset, neaps_range, springs_range):
+    """Pack a sorted list of events into almanac entries (see tide_almanac.h).
+    Returns the minute of the first event of each block, and the packed events."""
+    blocks = []
+    entries = []
+    last_minute = None
+    for i, event in enumerate(events):
+        minute = int(round((event.time - start) / 60))
+        if i % ALMANAC_BLOCK == 0:
+            blocks.append(minute)
+            delta = 0
+        else:
+            delta = minute - last_minute
+        if not 0 <= delta < 2048:
+            raise ValueError(f"Events {delta} minutes apart cannot be stored in an almanac")
+        last_minute = minute
+        # same scale as find_tide_event in tide_base.c
+        if springs_range > neaps_range:
+            neap_spring = (abs(event.level - offset) - neaps_range) / (springs_range - neaps_range)
+        else:
+            neap_spring = 0.0
+        neap_spring = int(round(min(1.0, max(0.0, neap_spring)) * 15))
+        level = min(32767, max(-32768, int(round(event.level * 100))))
+        high = 1 if event.event_type == "high" else 0
+        entries.append(delta | (neap_spring << 11) | (high << 15) | ((level & 0xFFFF) << 16))
+    return blocks, entries
+
+def dump_almanac(station, c_name, min_year, max_year, constituents, neaps_range, springs_range, year_events=None, file=None):
+    """Write the event almanac for min_year to max_year and return its C name, 
+    and its start, block size, blocks and entries"""
+    events = []
+    for year in range(min_year, max_year):
+        events += year_events[year] if year_events else find_year_events(station, year, constituents)
+    start = epoch(min_year)
+    blocks, entries = encode_almanac(events, start, station["offset"], neaps_range, springs_range)
+    almanac_name = f"station_{c_name}_{min_year}_almanac"
+    print(dedent(f"""
+                    const uint32_t {almanac_name}_blocks [] = {{{", ".join([str(b) for b in blocks])}}};
+                    const uint32_t {almanac_name}_events [] = {{{", ".join([f"0x{e:08X}" for e in entries])}}};
+                    tide_almanac {almanac_name} = {{
+                            .start = {start:.0f},
+                            .n_events = {len(entries)},
+                            .n_blocks = {len(blocks)},
+                            .block_events = {ALMANAC_BLOCK},
+                            .blocks = {almanac_name}_blocks,
+                            .events = {almanac_name}_events,
+                    }};
+                """), file=file)
+    return almanac_name, (start, ALMANAC_BLOCK, blocks, entries)
+
+def chebyshev_fit(f, t0, t1, n):
+    """Coefficients c[0..n-1] of the Chebyshev series for f on [t0, t1],
+    interpolating f at the n Chebyshev nodes"""
+    mid, half = (t0 + t1) / 2, (t1 - t0) / 2
+    samples = [f(mid + half * math.cos(math.pi * (k + 0.5) / n)) for k in range(n)]
+    coeffs = [2.0 / n * sum(s * math.cos(math.pi * j * (k + 0.5) / n) for k, s in enumerate(samples)) for j in range(n)]
+    coeffs[0] /= 2
+    return coeffs
+
+def chebyshev_sum(coeffs, x):
+    """Evaluate a Chebyshev series at x in [-1, 1], as chebyshev_sum in tide_chebyshev.c"""
+    b1, b2 = 0.0, 0.0
+    for c in reversed(coeffs[1:]):
+        b1, b2 = c + 2 * x * b1 - b2, b1
+    return coeffs[0] + x * b1 - b2
+
+def fit_chebyshev_segments(f, start, n_segments, segment_seconds, max_error, n_checks=16):
+    """Fit f with n_segments Chebyshev segments, using the smallest order
+    that keeps every segment within max_error of f, including the error from 
+    quantizing the coefficients to 16 bits. Returns the quantized coefficients 
+    for each segment, the order, the quantization scale and the largest error 
+    seen at n_checks points in each segment."""
+    segments = []
+    for i in range(n_segments):
+        t0 = start + i * segment_seconds
+        segments.append(chebyshev_fit(f, t0, t0 + segment_seconds, MAX_CHEBYSHEV_ORDER))
+    # the dropped coefficients bound the truncation error; leave half the budget for quantization
+    order = 1
+    for coeffs in segments:
+        while order < MAX_CHEBYSHEV_ORDER and sum(abs(c) for c in coeffs[order:]) > max_error / 2:
+            order += 1
+    scale = max(abs(c) for coeffs in segments for c in coeffs[:order]) / 32767
+    quantized = [[int(round(c / scale)) for c in coeffs[:order]] for coeffs in segments]
+    # check the segments as they will be evaluated on the device
+    worst = 0.0
+    for i, coeffs in enumerate(quantized):
+        coeffs = [c * scale for c in coeffs]
+        t0 = start + i * segment_seconds
+        for k in range(n_checks):
+            x = -1 + 2 * (k + 0.5) / n_checks
+            t = t0 + (x + 1) / 2 * segment_seconds
+            worst = max(worst, abs(chebyshev_sum(coeffs, x) - f(t)))
+    return quantized, order, scale, worst
+
+def dump_chebyshev(c_name, min_year, max_year, year_data, offset, segment_hours, max_error, file=None):
+    """Write the piecewise Chebyshev curve for min_year to max_year, fitted to 
+    the unquantized harmonic prediction. Returns the C name, the curve's size in bytes,
+    multiplies per prediction, and the largest error seen when fitting"""
+    cycles = {y["year"]:(y["phases"], y["speeds"], y["amps"]) for y in year_data}
+    def level(t):
+        year = min(max(time.gmtime(int(t))[0], min_year), max_year - 1)
+        phases, speeds, amps = cycles[year]
+        return predict_c_tide(t, year, phases, speeds, amps, offset)
+    start = epoch(min_year)
+    segment_seconds = int(segment_hours * 3600)
+    n_segments = (epoch(max_year) - start + segment_seconds - 1) // segment_seconds
+    quantized, order, scale, worst = fit_chebyshev_segments(level, start, n_segments, segment_seconds, max_error)
+    if worst > max_error:
+        raise ValueError(f"Chebyshev fit error {worst:.4f}m is larger than {max_error}m; use shorter segments")
+    curve_name = f"station_{c_name}_{min_year}_chebyshev"
+    coeffs = ", ".join([str(c) for segment in quantized for c in segment])
+    print(dedent(f"""
+                    /* Chebyshev fit of order {order}, largest error {worst:.5f}m */
+                    const int16_t {curve_name}_coeffs [] = {{{coeffs}}};
+                    tide_chebyshev {curve_name} = {{
+                            .start = {start:.0f},
+                            .segment_seconds = {segment_seconds},
+                            .n_segments = {n_segments},
+                            .order = {order},
+                            .scale = {scale:.9e},
+                            .coeffs = {curve_name}_coeffs,
+                    }};
+                """), file=file)
+    return curve_name, n_segments * order * 2, order + 2, worst, lambda t: chebyshev_level(quantized, scale, start, segment_seconds, t)
+
+def chebyshev_level(quantized, scale, start, segment_seconds, t):
+    """Evaluate a quantized piecewise Chebyshev curve at t"""
+    i = min(max(int((t - start) // segment_seconds), 0), len(quantized) - 1)
+    x = 2 * (t - start - i * segment_seconds) / segment_seconds - 1
+    return chebyshev_sum([c * scale for c in quantized[i]], min(max(x, -1), 1))
+
 def make_c_name(name):
     c_name = re.sub(r'[^a-zA-Z0-9_]', '_', name).lower()
     c_name = re.sub(r"_+", "_", c_name)
     return c_name
 
-def dump_clock_station(constituents, file=None):
+def dump_clock_station(constituents, seed=None, file=None, db=None):
     # create a fake station with a single constituent, M2, with amplitude 1.0 and phase 0.0
     clock_station = {"name":"CLOCK", "lat":0.0, "lon":0.0, "offset":0.0, "units":"meters", "zone_offset":0.0, "constituents":{"M2":{"amp":1.0, "phase":0.0}}}
     clock_constituents = {"M2":constituents["M2"]}    
     # theoretically only valid for 2000 and 2001, but we don't care
-    return dump_station_years(clock_station, 2000, 2001, clock_constituents, 0.0, file=file)
+    return dump_station_years(clock_station, 2000, 2001, clock_constituents, 0.0, seed=seed, db=db, file=file)
 
-def dump_station_offset(name, reference_station_name,  time_offset, level_offset, level_scale, prev_name=None, file=None):
+def dump_station_offset(name, reference_station_name,  time_offset, level_offset, level_scale, prev_name=None, db=None, file=None):
+    if db:
+        db.add_station(name, reference_station_name, time_offset, level_offset, level_scale)
     prev_name = f"&{prev_name}" if prev_name is not None else "NULL"
     print(dedent(f"""
                     char station_{name}_name [] = "{name}";
@@ -137,15 +509,57 @@ def dump_station_offset(name, reference_station_name,  time_offset, level_offset
     
     
 
-def dump_station_years(station, min_year, max_year, constituents, min_amp,  include_tests=True, file=None):
-    name = station["name"]
-    c_name = make_c_name(name)
-    
+def analyse_station(station, min_year, max_year, constituents, min_amp, error_budget=None, max_event_error=None, max_constituents=None, seed=None):
+    """The slow part of dump_station_years: choose the constituents, and find the
+    events and generate the tests for each year. This writes nothing, so stations
+    can be analysed in parallel (see analyse_stations). With a seed, the random
+    test times depend only on it and the station's name, not on what came before."""
+    rng = random.Random(f"{seed}:{station['name']}") if seed is not None else random
+    year_events = {year:find_year_events(station, year, constituents) for year in range(min_year, max_year)}
+    names, event_rms, event_max = select_constituents(station, min_year, max_year, constituents, min_amp, error_budget, max_event_error, max_constituents, 
+                                                      year_events=year_events, rng=rng)
     year_data = []
     for year in range(min_year, max_year):
-        amps, phases, speeds = extract_cycles(station, year, constituents, min_amp)
-        test_times, test_tides, mean_error, neaps_range, springs_range = generate_tests(station, year, constituents, phases, speeds, amps)
+        amps, phases, speeds = extract_cycles(station, year, constituents, names)
+        test_times, test_tides, mean_error, neaps_range, springs_range = generate_tests(station, year, constituents, phases, speeds, amps, rng=rng)
         year_data.append({"year":year, "amps":amps, "phases":phases, "speeds":speeds, "mean_error":mean_error, "test_times":test_times, "test_tides":test_tides, "neaps_range":neaps_range, "springs_range":springs_range})
+    return {"names":names, "event_rms":event_rms, "event_max":event_max, "year_data":year_data, "year_events":year_events}
+
+_worker_constituents = None
+
+def _init_worker(constituents):
+    global _worker_constituents
+    _worker_constituents = constituents
+
+def _analyse_worker(args):
+    station, min_year, max_year, min_amp, options = args
+    return analyse_station(station, min_year, max_year, _worker_constituents, min_amp, **options)
+
+def analyse_stations(stations, min_year, max_year, constituents, min_amp, jobs=1, **options):
+    """analyse_station for each of the stations, using jobs processes. The 
+    results are in the order of the stations, and (given a seed) are the same 
+    however many jobs there are."""
+    if jobs <= 1 or len(stations) <= 1:
+        return [analyse_station(station, min_year, max_year, constituents, min_amp, **options) for station in stations]
+    # the constituents are large, so each worker is sent them once
+    with multiprocessing.Pool(min(jobs, len(stations)), initializer=_init_worker, initargs=(constituents,)) as pool:
+        return pool.map(_analyse_worker, [(station, min_year, max_year, min_amp, options) for station in stations], chunksize=1)
+
+def dump_station_years(station, min_year, max_year, constituents, min_amp,  include_tests=True, almanac=False, 
+                       encoding="harmonic", segment_hours=6, max_error=0.01, 
+                       error_budget=None, max_event_error=None, max_constituents=None, nodal=None, db=None, analysis=None, seed=None, file=None):
+    """Write the constants for station from min_year to max_year, in the given 
+    encoding. The nodal encoding needs a NodalTable covering the same years.
+    The station is also added to db (a TideDatabase), if that is given.
+    analysis is the station's analyse_station result, if it has already been made
+    (otherwise it is made here, with seed)."""
+    name = station["name"]
+    c_name = make_c_name(name)
+    
+    if analysis is None:
+        analysis = analyse_station(station, min_year, max_year, constituents, min_amp, error_budget, max_event_error, max_constituents, seed=seed)
+    names, event_rms, event_max = analysis["names"], analysis["event_rms"], analysis["event_max"]
+    year_data = analysis["year_data"]
     
     speeds = year_data[0]["speeds"] # always constant
     neaps_range = year_data[0]["neaps_range"]
@@ -162,51 +576,151 @@ def dump_station_years(station, min_year, max_year, constituents, min_amp,  incl
         phases += y["phases"]
         test_times += y["test_times"]
         test_tides += y["test_tides"]
+    # the device indexes these as [year * n_constituents + constituent]
+    assert len(amps) == len(phases) == n_constituents * len(year_data), f"{name}: per-year constants are misaligned"
     
     # quantize the amps and phases
+    db_arrays = dict(amps=quantize_ints(16, MAX_AMP, amps), phases=quantize_ints(16, MAX_PHASE, phases), speeds=speeds)
     amps = get_seq(16, MAX_AMP, amps)
     phases = get_seq(16, MAX_PHASE, phases)
     speeds = float_seq(speeds)
 
     
     speed_name = f"station_{c_name}_{min_year}_speed"
-    print(dedent(f"""                 
-                    /* Mean error for {name} in {min_year}-{max_year} is approximately {mean_error:.5f}m */
+    # size of the constants, and multiplies per prediction
+    harmonic_size = (n_constituents * 4 * (max_year - min_year) + n_constituents * 4, n_constituents * KERNEL_MULTIPLIES)
+    if encoding=="nodal":
+        # the yearly corrections are in the shared table
+        harmonic_size = (n_constituents * 5, n_constituents * KERNEL_MULTIPLIES)
+    chebyshev_size = None
+    if encoding=="chebyshev":
+        if db:
+            raise ValueError("The Chebyshev encoding can't be stored in a database")
+        curve_name, size, multiplies, worst, curve = dump_chebyshev(c_name, min_year, max_year, year_data, station["offset"], segment_hours, max_error, file=file)
+        chebyshev_size = (size, multiplies, worst)
+        mean_error = sum([abs(curve(t) - tide) for t, tide in zip(test_times, test_tides)]) / len(test_times)
+        constants = f"""
+                    char station_{c_name}_{min_year}_name [] = "{name}";
+                    tidal_harmonic station_{c_name}_{min_year}_data = {{
+                            .type = TIDE_ENCODING_CHEBYSHEV,
+                            .chebyshev = &{curve_name},
+                            .speeds = NULL,
+                            .amps = NULL,
+                            .phases = NULL,
+                            .n_constituents = 0,"""
+    elif encoding=="nodal":
+        if nodal is None or (nodal.min_year, nodal.max_year) != (min_year, max_year):
+            raise ValueError(f"The nodal encoding needs a nodal table for {min_year}-{max_year}")
+        base_amps, epochs = extract_epochs(station, constituents, names)
+        db_arrays = dict(amps=quantize_ints(16, MAX_AMP, base_amps), phases=quantize_ints(16, MAX_PHASE, epochs), 
+                         constituents=[nodal.index(c) for c in names])
+        indices = ", ".join([str(i) for i in db_arrays["constituents"]])
+        constants = f"""
+                    char station_{c_name}_{min_year}_name [] = "{name}";
+                    uint8_t station_{c_name}_{min_year}_constituent [] = {{{indices}}};
+                    uint16_t station_{c_name}_{min_year}_amp [] = {{{get_seq(16, MAX_AMP, base_amps)}}};
+                    uint16_t station_{c_name}_{min_year}_phase [] = {{{get_seq(16, MAX_PHASE, epochs)}}};
+                    tidal_harmonic station_{c_name}_{min_year}_data = {{
+                            .type = TIDE_ENCODING_NODAL,
+                            .chebyshev = NULL,
+                            .speeds = NULL,
+                            .amps = station_{c_name}_{min_year}_amp,
+                            .phases = station_{c_name}_{min_year}_phase,
+                            .constituents = station_{c_name}_{min_year}_constituent,
+                            .nodal = &{nodal.c_name},
+                            .n_constituents = {n_constituents},"""
+    else:
+        constants = f"""
                     char station_{c_name}_{min_year}_name [] = "{name}";                    
                     float station_{c_name}_{min_year}_speed [] = {{{speeds}}};                
                     uint16_t station_{c_name}_{min_year}_amp [] = {{{amps}}};
                     uint16_t station_{c_name}_{min_year}_phase [] = {{{phases}}};
                     tidal_harmonic station_{c_name}_{min_year}_data = {{
-                            .base_year = {min_year},
-                            .n_years = {max_year-min_year},
-                            .lat = {station["lat"]},
-                            .lon = {station["lon"]},
-                            .neaps_range = {neaps_range},
-                            .springs_range = {springs_range},
-                            .offset = {station["offset"]},
+                            .type = TIDE_ENCODING_HARMONIC,
+                            .chebyshev = NULL,
                             .speeds = {speed_name},
                             .amps = station_{c_name}_{min_year}_amp,
                             .phases = station_{c_name}_{min_year}_phase,
-                            .n_constituents = {n_constituents},
-                            .mean_error = {mean_error},
-                        
-                    }};                                                    
-"""), file=file)
-    
+                            .n_constituents = {n_constituents},"""
+    # nodal stations whose corrections can all be computed on the device work for any year
+    n_years = max_year - min_year
+    if encoding=="nodal" and all(astro_id(c) != ASTRO_NONE for c in names):
+        n_years = 0
+    almanac_field = "NULL"
+    almanac_data = None
+    if almanac:
+        almanac_name, almanac_data = dump_almanac(station, c_name, min_year, max_year, constituents, neaps_range, springs_range, 
+                                                  year_events=analysis["year_events"], file=file)
+        almanac_field = "&" + almanac_name
+    test_fields = ""
     if include_tests:
+        # the tests are written first, so the harmonic can point at them
         print(dedent(f"""
                     #ifdef TIDE_DEBUG
                     time_t station_{c_name}_{min_year}_test_times [] = {{{", ".join([str(t) for t in test_times])}}};
                     float station_{c_name}_{min_year}_test_tides [] = {{{", ".join([str(t) for t in test_tides])}}};
                     #endif
                 """), file=file)    
+        test_fields = "\n".join(["#ifdef TIDE_DEBUG",
+                                 f"        .test_times = station_{c_name}_{min_year}_test_times,",
+                                 f"        .test_tides = station_{c_name}_{min_year}_test_tides,",
+                                 f"        .n_tests = {len(test_times)},",
+                                 "#endif"])
+    print(dedent(f"""
+                    /* Mean error for {name} in {min_year}-{max_year} is approximately {mean_error:.5f}m */""" + constants + f"""
+                            .name = station_{c_name}_{min_year}_name,
+                            .base_year = {min_year},
+                            .n_years = {n_years},
+                            .lat = {station["lat"]},
+                            .lon = {station["lon"]},
+                            .neaps_range = {neaps_range},
+                            .springs_range = {springs_range},
+                            .offset = {station["offset"]},
+                            .mean_error = {mean_error},
+                            .almanac = {almanac_field},"""), file=file)
+    if test_fields:
+        print(test_fields, file=file)
+    print("};\n", file=file)
     
-    station_data = {"name":f"station_{c_name}_{min_year}", "mean_error":mean_error, "neaps_range":neaps_range, "springs_range":springs_range, "offset":station["offset"]}
+    if db:
+        db.add_harmonic(f"station_{c_name}_{min_year}", name, ENCODING_NODAL if encoding=="nodal" else ENCODING_HARMONIC, n_constituents, 
+                        min_year, n_years, station["lat"], station["lon"], neaps_range, springs_range, station["offset"], mean_error,
+                        db_arrays["amps"], db_arrays["phases"], speeds=db_arrays.get("speeds") if encoding!="nodal" else None,
+                        constituents=db_arrays.get("constituents"), almanac=almanac_data)
+    station_data = {"name":f"station_{c_name}_{min_year}", "lat":station["lat"], "lon":station["lon"], "mean_error":mean_error, "neaps_range":neaps_range, "springs_range":springs_range, "offset":station["offset"],
+                    "harmonic_size":harmonic_size, "chebyshev_size":chebyshev_size,
+                    "n_constituents":n_constituents, "event_rms":event_rms, "event_max":event_max}
     return station_data
 
 
 
-def finalise_tides(prev_name, file=None):
+def spatial_tree(points, axis=0):
+    """Order (x, y, z, station) points as the implicit k-d tree in tide_spatial.h"""
+    if len(points) < 2:
+        return points
+    points = sorted(points, key=lambda p: p[axis])
+    mid = len(points) // 2
+    return spatial_tree(points[:mid], (axis+1) % 3) + [points[mid]] + spatial_tree(points[mid+1:], (axis+1) % 3)
+
+def finalise_tides(prev_name, names, positions=None, file=None):
+    """Write the head of the station list, the index of the stations (by the 
+    names given to dump_station_offset) sorted as find_tidal_station expects,
+    and the tree of their positions for find_nearest_stations. positions maps
+    names to (lat, lon); stations without one (like clocks) are left out of the tree"""
+    names = sorted(names, key=name_key)
+    index = ", ".join([f"&station_{name}" for name in names])
+    points = []
+    for i, name in enumerate(names):
+        if positions and positions.get(name):
+            lat, lon = [math.radians(x) for x in positions[name]]
+            points.append((math.cos(lat) * math.cos(lon), math.cos(lat) * math.sin(lon), math.sin(lat), i))
+    tree = ", ".join([f"{{{float_seq(p[:3])}, {p[3]}}}" for p in spatial_tree(points)])
     print(dedent(f"""
                     tidal_station * tidal_stations  = &{prev_name};                    
+
+                    tidal_station *const tidal_station_index [] = {{{index}}};
+                    const uint32_t n_tidal_stations = {len(names)};
+
+                    const tide_spatial_point tidal_station_points [] = {{{tree if tree else "{0}"}}};
+                    const uint32_t n_tidal_station_points = {len(points)};
                 """), file=file)
@@ -1,10 +1,11 @@
 import json
-import click, time 
+import click, time, bisect, random, os
 from station_parser import parse_station
 from rich.table import Table
 from rich.console import Console
 from rich import print
-from dump_tides import  dump_station_years, dump_clock_station, finalise_tides, dump_station_offset
+from dump_tides import  dump_station_years, dump_clock_station, finalise_tides, dump_station_offset, NodalTable, analyse_stations
+from tide_db import TideDatabase
 from rich.logging import RichHandler
 import logging
 FORMAT = "%(message)s"
@@ -24,7 +25,17 @@ station_fields = {"latitude":"lat", "longitude":"lon", "name":"name", "station_i
 @click.option("--base-year", type=int, default=None, help="Base year to extract from")
 @click.option("--years", type=int, default=5, help="Number of years to extract")
 @click.option("--output-file", type=click.Path(), default="src/tide_data.c", help="Output file")
-def cli(input_file, stations, years, base_year, min_amplitude, output_file):        
+@click.option("--almanac", is_flag=True, default=False, help="Also write a table of every HW/LW event")
+@click.option("--encoding", type=click.Choice(["nodal", "harmonic", "chebyshev"]), default="harmonic", help="Store harmonic constituents with shared yearly corrections, constituents for every year, or a piecewise polynomial tide curve")
+@click.option("--segment-hours", type=float, default=6, help="Length of each Chebyshev segment, in hours")
+@click.option("--max-error", type=float, default=0.01, help="Largest error allowed in a Chebyshev fit (m)")
+@click.option("--error-budget", type=float, default=None, help="Keep only as many constituents as needed for this RMS error, at HW/LW and in between (m)")
+@click.option("--max-event-error", type=float, default=None, help="With --error-budget, also limit the largest error, at HW/LW and in between (m)")
+@click.option("--max-constituents", type=int, default=None, help="Keep at most this many constituents, choosing those that reduce the error most")
+@click.option("--database", type=click.Path(), default=None, help="Also write the stations to a binary database, for tide_db.c to read in place")
+@click.option("--jobs", type=int, default=os.cpu_count(), help="Number of stations to analyse at once")
+@click.option("--seed", type=int, default=None, help="Seed for the random test times, to make the output reproducible")
+def cli(input_file, stations, years, base_year, min_amplitude, output_file, almanac, encoding, segment_hours, max_error, error_budget, max_event_error, max_constituents, database, jobs, seed):        
     """Extracts tidal data form a TCD converted JSON file into
     a C source file.
     """
@@ -34,6 +45,9 @@ def cli(input_file, stations, years, base_year, min_amplitude, output_file):
         
     log.info(f"Extracting data from '{input_file}' to '{output_file}' for {base_year} to {base_year+years}")
     log.info(f"Minimum amplitude: {min_amplitude:.1e}")
+    if seed is None:
+        seed = random.randrange(2**31)
+    log.info(f"Seed: {seed}")
 
     # load the data
     with open(input_file, "r") as f:
@@ -46,6 +60,7 @@ def cli(input_file, stations, years, base_year, min_amplitude, output_file):
 
     # extract all of the base stations we need
     base_stations = {}
+    base_positions = {} # clocks have none
     for station in cli_stations:        
         alias, details = station        
         base_stations[details.base_station] = None
@@ -68,24 +83,68 @@ def cli(input_file, stations, years, base_year, min_amplitude, output_file):
     table.add_column("RMS error", justify="right", style="yellow")
     table.add_column("Np. range", justify="center", style="blue")
     table.add_column("Sp. range", justify="center", style="blue")
+    table.add_column("Constituents", justify="right", style="white")
+    table.add_column("HW/LW error", justify="right", style="yellow")
+    table.add_column("Size", justify="right", style="white")
+    table.add_column("Mult./pred.", justify="right", style="white")
+
+    if database and encoding=="chebyshev":
+        raise click.BadParameter("the database can't store the Chebyshev encoding", param_hint="--database")
+    db = TideDatabase() if database else None
 
     with open(output_file, "w") as f:
+        # the stations share one table of yearly corrections, written after them
+        nodal = NodalTable(constituents, base_year, base_year+years) if encoding=="nodal" else None
+        if nodal:
+            nodal.declare(file=f)
         # write the clock station
-        prev_name = dump_clock_station(constituents, file=f)        
-        table.add_row("CLOCK", "0.0°", "0.0°", "0.0m", "0.0m", "2.0m", "2.0m")
+        clock_data = dump_clock_station(constituents, seed=seed, file=f, db=db)
+        if "CLOCK" in base_stations:
+            base_stations["CLOCK"] = clock_data["name"]
+        size, multiplies = clock_data["harmonic_size"]
+        table.add_row("CLOCK", "0.0°", "0.0°", "0.0m", "0.0m", "2.0m", "2.0m", "1", "-", f"{size}B", f"{multiplies}")
         
+        # find the base (harmonic) stations by prefix, in a sorted list of the names;
+        # only process type 1 for now
+        reference_stations = sorted((station["name"], i) for i, station in enumerate(all_stations) if station["record_type"] == 1)
+        reference_names = [name for name, i in reference_stations]
+        matches = []
+        for possible_station in base_stations:
+            first = last = bisect.bisect_left(reference_names, possible_station)
+            while last < len(reference_names) and reference_names[last].startswith(possible_station):
+                last += 1
+            # in the order of the input file
+            matches += [(possible_station, all_stations[i]) for i in sorted(i for name, i in reference_stations[first:last])]
+        matched_data = []
+        for possible_station, station in matches:
+            station_data = {v:station[k] for k,v in station_fields.items()}                            
+            station_data["constituents"] = {c_name:{"amp":amp, "phase":epoch} for c_name, amp, epoch in zip(constituents.keys(), station["amplitude"], station["epoch"])}                                            
+            matched_data.append(station_data)
+        # the slow part, which can be done in parallel
+        analyses = analyse_stations(matched_data, base_year, base_year+years, constituents, min_amplitude, jobs=jobs, 
+                                    error_budget=error_budget, max_event_error=max_event_error, max_constituents=max_constituents, seed=seed)
+
         # write all of the base (harmonic) stations
-        for possible_station in base_stations:            
-            for station in all_stations:
-                # only process type 1 for now                         
-                if station["record_type"] == 1 and station["name"].startswith(possible_station):                                
-                    station_data = {v:station[k] for k,v in station_fields.items()}                            
-                    station_data["constituents"] = {c_name:{"amp":amp, "phase":epoch} for c_name, amp, epoch in zip(constituents.keys(), station["amplitude"], station["epoch"])}                                            
-                    processed_data = dump_station_years(station_data, base_year, base_year+years, constituents, min_amplitude, file=f)   
-                    base_stations[possible_station] = processed_data["name"]                    
-                    table.add_row(station["name"], f"{station_data['lat']:.2f}°", f"{station_data['lon']:.2f}°", f"{station_data['offset']:.1f}m", f"{processed_data['mean_error']:.4f}m", f"{processed_data['neaps_range']:.2f}m", f"{processed_data['springs_range']:.2f}m")
+        for (possible_station, station), station_data, analysis in zip(matches, matched_data, analyses):
+            processed_data = dump_station_years(station_data, base_year, base_year+years, constituents, min_amplitude, almanac=almanac, 
+                                                encoding=encoding, segment_hours=segment_hours, max_error=max_error, 
+                                                error_budget=error_budget, max_event_error=max_event_error, max_constituents=max_constituents, nodal=nodal, db=db, 
+                                                analysis=analysis, file=f)   
+            size, multiplies = processed_data["harmonic_size"]
+            if processed_data["chebyshev_size"]:
+                # report both, so the trade-off can be judged
+                log.info(f"{station['name']}: harmonic {size} bytes, {multiplies} multiplies per prediction")
+                size, multiplies, worst = processed_data["chebyshev_size"]
+                log.info(f"{station['name']}: Chebyshev {size} bytes, {multiplies} multiplies per prediction, largest error {worst:.4f}m")
+            base_stations[possible_station] = processed_data["name"]
+            base_positions[possible_station] = (processed_data["lat"], processed_data["lon"])
+            table.add_row(station["name"], f"{station_data['lat']:.2f}°", f"{station_data['lon']:.2f}°", f"{station_data['offset']:.1f}m", f"{processed_data['mean_error']:.4f}m", f"{processed_data['neaps_range']:.2f}m", f"{processed_data['springs_range']:.2f}m", 
+                          f"{processed_data['n_constituents']}", f"{processed_data['event_rms']:.3f}m/{processed_data['event_max']:.3f}m", f"{size}B", f"{multiplies}")
 
         print(table)
+        if nodal:
+            nodal.dump(file=f, db=db)
+            log.info(f"Shared nodal table: {len(nodal.names)} constituents, {nodal.size()} bytes")
 
         table = Table(title="Tidal Stations")
         table.add_column("Name", justify="left", style="white")
@@ -99,12 +158,16 @@ def cli(input_file, stations, years, base_year, min_amplitude, output_file):
         prev_name = None
         for station in cli_stations:
             alias, details = station
-            prev_name = dump_station_offset(alias, base_stations[details.base_station], details.seconds_offset, details.level_offset, details.level_scale, prev_name=prev_name, file=f)
+            prev_name = dump_station_offset(alias, base_stations[details.base_station], details.seconds_offset, details.level_offset, details.level_scale, prev_name=prev_name, db=db, file=f)
             table.add_row(alias, details.base_station, f"{details.level_offset:.2f}m", f"{details.level_scale:.2f}", f"{details.seconds_offset:.0f}s")
         print(table) 
         # now write all of the aliases/offsets
-        finalise_tides(prev_name, file=f)
+        finalise_tides(prev_name, [alias for alias, details in cli_stations], 
+                       {alias:base_positions.get(details.base_station) for alias, details in cli_stations}, file=f)
     log.info(f"Finished writing '{output_file}'")
+    if db:
+        size = db.write(database)
+        log.info(f"Wrote {len(db.stations)} stations to '{database}', {size} bytes")
     
 
 if __name__=="__main__":
@@ -1,11 +1,12 @@
-import math, time
+import math, time, calendar
 
 def unpack_tz(tz):
     return tz//100, tz%100
 
 def epoch(year):
-    """Return the Unix time at the start of the year"""
-    return time.mktime((year, 1, 1, 0, 0, 0, 0, 0, 0))
+    """Return the Unix time at 00:00 UTC at the start of the year
+    (matching year_start in tide_calendar.h)"""
+    return calendar.timegm((year, 1, 1, 0, 0, 0, 0, 0, 0))
 
 def rads_per_second(degrees_per_hour):
     return math.radians(degrees_per_hour/3600)
@@ -0,0 +1,94 @@
+"""Write the binary station database that tide_db.c reads in place.
+See tide_db.h for the layout; the record formats here must match its structs."""
+import struct
+
+DB_MAGIC = b"TIDE"
+DB_VERSION = 2 # as TIDE_DB_VERSION in tide_db.h
+DB_ALIGN = 8
+ENCODING_HARMONIC = 0 # as in tide_base.h
+ENCODING_NODAL = 2
+
+HEADER = struct.Struct("<4sHHIIIIII")
+STATION = struct.Struct("<IIiffI")
+HARMONIC = struct.Struct("<IBBHiffffffIIIII")
+NODAL = struct.Struct("<iiIIIIII")
+ALMANAC = struct.Struct("<qIHHII")
+
+def name_key(name):
+    """Sort key for station names, ignoring case as insensitive_compare in tide_base.c does"""
+    return name.encode("utf-8").lower()
+
+class TideDatabase:
+    """Stations collected by the dump_* functions, written out in one go by write()"""
+
+    def __init__(self):
+        self.harmonics = {} # by the name stations refer to them by
+        self.stations = []
+        self.nodal = None
+
+    def add_harmonic(self, key, name, encoding, n_constituents, base_year, n_years, lat, lon, neaps_range, springs_range, offset, mean_error,
+                     amps, phases, speeds=None, constituents=None, almanac=None):
+        """Add a harmonic station. amps and phases are the quantized values, as in
+        tide_data.c; speeds are for the harmonic encoding, constituents (indices into
+        the nodal table) for the nodal one. almanac is (start, block_events, blocks, events) or None."""
+        self.harmonics[key] = dict(name=name, encoding=encoding, n_constituents=n_constituents, base_year=base_year, n_years=n_years, lat=lat, lon=lon,
+                                   neaps_range=neaps_range, springs_range=springs_range, offset=offset, mean_error=mean_error,
+                                   amps=amps, phases=phases, speeds=speeds, constituents=constituents, almanac=almanac)
+
+    def add_station(self, name, harmonic, time_offset=0, level_offset=0.0, level_scale=1.0):
+        """Add a station that uses the harmonic added as harmonic, with its corrections"""
+        self.stations.append((name, harmonic, time_offset, level_offset, level_scale))
+
+    def set_nodal(self, base_year, n_years, speeds, astro, node_factors, equilibria):
+        """Set the shared nodal table; node_factors and equilibria are quantized, and empty if n_years is 0"""
+        self.nodal = (base_year, n_years, speeds, astro, node_factors, equilibria)
+
+    def write(self, path):
+        blob = bytearray(HEADER.size)
+
+        def place(data):
+            """Append data on an aligned boundary and return its offset, or 0 for nothing"""
+            if not data:
+                return 0
+            blob.extend(bytes(-len(blob) % DB_ALIGN))
+            offset = len(blob)
+            blob.extend(data)
+            return offset
+
+        def array(fmt, values):
+            return struct.pack(f"<{len(values)}{fmt}", *values) if values else b""
+
+        # the directory is sorted by name, for tide_db_find, and filled in once the harmonics are placed
+        self.stations.sort(key=lambda s: name_key(s[0]))
+        directory = place(bytes(STATION.size * len(self.stations)))
+        names = [s[0] for s in self.stations] + [h["name"] for h in self.harmonics.values()]
+        strings, string_offsets = bytearray(), {}
+        for name in names:
+            if name not in string_offsets:
+                string_offsets[name] = len(strings)
+                strings.extend(name.encode("utf-8") + b"\0")
+        strings_offset = place(strings)
+
+        nodal = 0
+        if self.nodal:
+            base_year, n_years, speeds, astro, node_factors, equilibria = self.nodal
+            nodal = place(NODAL.pack(base_year, n_years, len(speeds), place(array("f", speeds)), place(array("B", astro)),
+                                     place(array("H", node_factors)), place(array("H", equilibria)), 0))
+
+        harmonic_offsets = {}
+        for key, h in self.harmonics.items():
+            almanac = 0
+            if h["almanac"]:
+                start, block_events, blocks, events = h["almanac"]
+                almanac = place(ALMANAC.pack(int(start), len(events), len(blocks), block_events, place(array("I", blocks)), place(array("I", events))))
+            harmonic_offsets[key] = place(HARMONIC.pack(strings_offset + string_offsets[h["name"]], h["encoding"], h["n_constituents"], h["n_years"], h["base_year"], h["lat"], h["lon"], h["neaps_range"], h["springs_range"], h["offset"], h["mean_error"],
+                                                        place(array("f", h["speeds"] or [])), place(array("H", h["amps"])), place(array("H", h["phases"])),
+                                                        place(array("B", h["constituents"] or [])), almanac))
+
+        for i, (name, harmonic, time_offset, level_offset, level_scale) in enumerate(self.stations):
+            STATION.pack_into(blob, directory + i * STATION.size, strings_offset + string_offsets[name], harmonic_offsets[harmonic],
+                              int(round(time_offset)), level_offset, level_scale, 0)
+        HEADER.pack_into(blob, 0, DB_MAGIC, DB_VERSION, 0, len(blob), len(self.stations), directory, strings_offset, len(strings), nodal)
+        with open(path, "wb") as f:
+            f.write(blob)
+        return len(blob)
@@ -0,0 +1,82 @@
+"""Bindings to the C prediction core, so the generator predicts levels and finds
+events with the same code as the device. The core is built as a shared library
+with make -C src lib (or found at $TIDE_LIB); see tide_lib.h. Importing this
+needs NumPy; available() says whether the library could be loaded."""
+import ctypes, os
+import numpy as np
+from predict_tide import TideEvent
+
+LIB_PATH = os.environ.get("TIDE_LIB", os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "libtide.so"))
+MAX_CONSTITUENTS = 64 # MAX_TIDE_CONSTITUENTS in tide_base.h
+TIDE_HIGH = 1 # as in tide_base.h
+
+class _Station(ctypes.Structure):
+    # tide_lib_station
+    _fields_ = [("speeds", ctypes.POINTER(ctypes.c_float)),
+                ("amps", ctypes.POINTER(ctypes.c_uint16)),
+                ("phases", ctypes.POINTER(ctypes.c_uint16)),
+                ("base_year", ctypes.c_int32),
+                ("n_years", ctypes.c_uint32),
+                ("n_constituents", ctypes.c_uint32),
+                ("offset", ctypes.c_float)]
+
+_lib = None
+
+def load():
+    """The library, or None if it hasn't been built"""
+    global _lib
+    if _lib is None:
+        try:
+            lib = ctypes.CDLL(LIB_PATH)
+        except OSError:
+            _lib = False
+            return None
+        f32, i64, u8 = (np.ctypeslib.ndpointer(dtype=t, flags="C_CONTIGUOUS") for t in (np.float32, np.int64, np.uint8))
+        lib.tide_lib_predict.argtypes = [ctypes.POINTER(_Station), i64, ctypes.c_int32, f32, f32, f32]
+        lib.tide_lib_predict.restype = ctypes.c_int32
+        lib.tide_lib_events.argtypes = [ctypes.POINTER(_Station), ctypes.c_int64, ctypes.c_int64, i64, f32, u8, ctypes.c_int32]
+        lib.tide_lib_events.restype = ctypes.c_int32
+        _lib = lib
+    return _lib or None
+
+def available():
+    return load() is not None
+
+class DeviceStation:
+    """A harmonic station as the device sees it: speeds in radians/s, and amps
+    and phases quantized as in tide_data.c, [n_years][n_constituents] from base_year"""
+
+    def __init__(self, speeds, amps, phases, base_year, n_years, offset):
+        if len(speeds) > MAX_CONSTITUENTS:
+            raise ValueError(f"The C core takes at most {MAX_CONSTITUENTS} constituents")
+        # kept, so the arrays outlive the pointers to them
+        self.speeds = np.ascontiguousarray(speeds, dtype=np.float32)
+        self.amps = np.ascontiguousarray(amps, dtype=np.uint16)
+        self.phases = np.ascontiguousarray(phases, dtype=np.uint16)
+        # the C side reads n_years rows of every constituent, whatever it is given
+        if n_years < 1 or len(self.amps) != n_years * len(self.speeds) or len(self.phases) != n_years * len(self.speeds):
+            raise ValueError(f"Expected {n_years} years of {len(self.speeds)} amplitudes and phases, got {len(self.amps)} and {len(self.phases)}")
+        self.station = _Station(self.speeds.ctypes.data_as(ctypes.POINTER(ctypes.c_float)), 
+                                self.amps.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16)),
+                                self.phases.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16)),
+                                base_year, n_years, len(self.speeds), offset)
+
+    def predict(self, times):
+        """Levels (m), rates (m/s) and accelerations (m/s^2) at each of times (Unix seconds)"""
+        times = np.ascontiguousarray(times, dtype=np.int64)
+        levels, rates, accels = (np.empty(len(times), dtype=np.float32) for _ in range(3))
+        if load().tide_lib_predict(ctypes.byref(self.station), times, len(times), levels, rates, accels) != 0:
+            raise ValueError("The C core can't use this station")
+        return levels, rates, accels
+
+    def events(self, t0, t1):
+        """The HW/LW events in [t0, t1), as a list of TideEvent"""
+        # there are never more than a few an hour
+        max_events = int((t1 - t0) // 3600) + 8
+        times = np.empty(max_events, dtype=np.int64)
+        levels = np.empty(max_events, dtype=np.float32)
+        types = np.empty(max_events, dtype=np.uint8)
+        n = load().tide_lib_events(ctypes.byref(self.station), int(t0), int(t1), times, levels, types, max_events)
+        if n < 0:
+            raise ValueError("The C core can't use this station")
+        return [TideEvent("high" if types[i] == TIDE_HIGH else "low", int(times[i]), float(levels[i])) for i in range(n)]
@@ -0,0 +1,79 @@
+#include "tide_almanac.h"
+
+/* Unpack a single event, at minute (since the start of the almanac) */
+static void unpack_event(const tide_almanac *almanac, uint32_t entry, uint32_t minute, tidal_event *event)
+{
+    event->type = ALMANAC_HIGH(entry) ? TIDE_HIGH : TIDE_LOW;
+    event->time = almanac->start + (time_t)minute * MINUTE_SECONDS;
+    event->level = ALMANAC_LEVEL_CM(entry) / 100.0f;
+    event->neap_spring = ALMANAC_NEAP_SPRING(entry) / 15.0f;
+}
+
+static void clear_event(tidal_event *event)
+{
+    event->type = TIDE_NONE;
+    event->time = 0;
+    event->level = 0.0f;
+    event->neap_spring = 0.0f;
+}
+
+/* Find the last event at or before t and the first event after it, 
+in the harmonic station's own time and levels.
+Events that fall outside the almanac are set to TIDE_NONE. 
+Returns 1 if both were found. */
+int tide_almanac_find(const tide_almanac *almanac, time_t t, tidal_event *prev, tidal_event *next)
+{
+    int lo = 0, hi = almanac->n_blocks;
+    uint32_t minute;
+    clear_event(prev);
+    clear_event(next);
+    if(almanac->n_events==0) return 0;
+
+    /* Binary search for the last block starting at or before t */
+    while(hi-lo>1) {
+        int mid = (lo + hi) / 2;
+        if(almanac->start + (time_t)almanac->blocks[mid] * MINUTE_SECONDS <= t) lo = mid;
+        else hi = mid;
+    }
+    /* Then walk through the block */
+    uint32_t first = (uint32_t)lo * almanac->block_events;
+    uint32_t last = first + almanac->block_events;
+    if(last>almanac->n_events) last = almanac->n_events;
+    minute = almanac->blocks[lo];
+    for(uint32_t i=first; i<last; i++) {
+        minute += ALMANAC_DELTA(almanac->events[i]);
+        if(almanac->start + (time_t)minute * MINUTE_SECONDS > t) {
+            unpack_event(almanac, almanac->events[i], minute, next);
+            return prev->type!=TIDE_NONE;
+        }
+        unpack_event(almanac, almanac->events[i], minute, prev);
+    }
+    /* The next event is the first of the next block, if there is one */
+    if(lo+1<almanac->n_blocks) 
+        unpack_event(almanac, almanac->events[last], almanac->blocks[lo+1], next);
+    return next->type!=TIDE_NONE;
+}
+
+/* Find the events either side of t for a station, from its harmonic's almanac,
+with the station's time and level offsets applied. Returns 1 if both were found,
+0 if t is outside the almanac or the station has no almanac. */
+int get_almanac_events_near(tidal_station *station, time_t t, tidal_event *prev, tidal_event *next)
+{
+    tidal_offset *offset = station->offset;
+    const tide_almanac *almanac = station->harmonic->almanac;
+    int found;
+    if(!almanac) {
+        clear_event(prev);
+        clear_event(next);
+        return 0;
+    }
+    /* Station time runs time_offset ahead of the harmonic station (see prepare_station) */
+    found = tide_almanac_find(almanac, t + offset->time_offset, prev, next);
+    tidal_event *events[2] = {prev, next};
+    for(int i=0; i<2; i++) {
+        if(events[i]->type==TIDE_NONE) continue;
+        events[i]->time -= offset->time_offset;
+        events[i]->level = (events[i]->level + offset->level_offset) * offset->level_scale;
+    }
+    return found;
+}
@@ -0,0 +1,31 @@
+#ifndef __TIDE_ALMANAC_H__
+#define __TIDE_ALMANAC_H__
+#include "tide_base.h"
+
+/* Precomputed HW/LW events for a harmonic station, written by the generator
+(extract_tides.py --almanac). Each event is packed into 32 bits:
+    bits 0-10   minutes since the previous event (0 for the first event of a block),
+                at most 2047, far more than the longest gap between tides
+    bits 11-14  neap/spring, 0 (neaps) to 15 (springs)
+    bit 15      1 for high water, 0 for low water
+    bits 16-31  level in cm (signed), for the harmonic station
+Events are grouped into blocks of block_events, and the absolute time of 
+the first event in each block is kept so the blocks can be binary searched. */
+#define ALMANAC_DELTA(e) ((e) & 0x7FF)
+#define ALMANAC_NEAP_SPRING(e) (((e) >> 11) & 0xF)
+#define ALMANAC_HIGH(e) (((e) >> 15) & 0x1)
+#define ALMANAC_LEVEL_CM(e) ((int16_t)((e) >> 16))
+
+typedef struct tide_almanac {
+    time_t start; /* block times are in minutes since this */
+    uint32_t n_events;
+    uint16_t n_blocks;
+    uint16_t block_events; /* events per block; the last may have fewer */
+    const uint32_t *blocks; /* minutes since start of the first event in each block */
+    const uint32_t *events;
+} tide_almanac;
+
+int tide_almanac_find(const tide_almanac *almanac, time_t t, tidal_event *prev, tidal_event *next);
+int get_almanac_events_near(tidal_station *station, time_t t, tidal_event *prev, tidal_event *next);
+
+#endif
@@ -0,0 +1,305 @@
+#include "tide_astro.h"
+#include "tide_calendar.h"
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define DEG (M_PI / 180.0)
+#define OBLIQUITY (23.452 * DEG) /* of the ecliptic, omega */
+#define LUNAR_INCLINATION (5.145 * DEG) /* to the ecliptic, i */
+
+/* Node factor formulas, Schureman (73)-(78), (207), (215), (227) and (235) */
+enum { NODE_ONE, NODE_MM, NODE_MF, NODE_O1, NODE_K1, NODE_J1, NODE_OO1, NODE_M2, NODE_K2, NODE_L2, NODE_M3 };
+
+/* A constituent from Schureman's Table 2: the equilibrium argument is
+    V + u = v[0]*T + v[1]*s + v[2]*h + v[3]*p + v[4]*p1 + v[5]*90 degrees
+          + u[0]*xi + u[1]*nu + u[2]*nu' + u[3]*2nu'' (- R for L2) */
+typedef struct astro_constituent {
+    int8_t v[6];
+    int8_t u[4];
+    uint8_t f;
+} astro_constituent;
+
+/* A shallow water constituent, as na of constituent a plus nb of constituent b */
+typedef struct astro_compound {
+    uint8_t a;
+    int8_t na;
+    uint8_t b;
+    int8_t nb;
+} astro_compound;
+
+enum { M2, S2, N2, K1, O1, NU2, MU2, _2N2, OO1, LAM2, S1, J1, MM, SSA, SA, MF, RHO1, Q1, T2, R2, _2Q1, P1, L2, K2, M3, N_BASE };
+
+static const astro_constituent constituents[N_BASE] = {
+    [M2] = {{2, -2, 2, 0, 0, 0}, {2, -2, 0, 0}, NODE_M2},
+    [S2] = {{2, 0, 0, 0, 0, 0}, {0, 0, 0, 0}, NODE_ONE},
+    [N2] = {{2, -3, 2, 1, 0, 0}, {2, -2, 0, 0}, NODE_M2},
+    [K1] = {{1, 0, 1, 0, 0, -1}, {0, 0, -1, 0}, NODE_K1},
+    [O1] = {{1, -2, 1, 0, 0, 1}, {2, -1, 0, 0}, NODE_O1},
+    [NU2] = {{2, -3, 4, -1, 0, 0}, {2, -2, 0, 0}, NODE_M2},
+    [MU2] = {{2, -4, 4, 0, 0, 0}, {2, -2, 0, 0}, NODE_M2},
+    [_2N2] = {{2, -4, 2, 2, 0, 0}, {2, -2, 0, 0}, NODE_M2},
+    [OO1] = {{1, 2, 1, 0, 0, -1}, {-2, -1, 0, 0}, NODE_OO1},
+    [LAM2] = {{2, -1, 0, 1, 0, 2}, {2, -2, 0, 0}, NODE_M2},
+    [S1] = {{1, 0, 0, 0, 0, 0}, {0, 0, 0, 0}, NODE_ONE},
+    [J1] = {{1, 1, 1, -1, 0, -1}, {0, -1, 0, 0}, NODE_J1},
+    [MM] = {{0, 1, 0, -1, 0, 0}, {0, 0, 0, 0}, NODE_MM},
+    [SSA] = {{0, 0, 2, 0, 0, 0}, {0, 0, 0, 0}, NODE_ONE},
+    [SA] = {{0, 0, 1, 0, 0, 0}, {0, 0, 0, 0}, NODE_ONE},
+    [MF] = {{0, 2, 0, 0, 0, 0}, {-2, 0, 0, 0}, NODE_MF},
+    [RHO1] = {{1, -3, 3, -1, 0, 1}, {2, -1, 0, 0}, NODE_O1},
+    [Q1] = {{1, -3, 1, 1, 0, 1}, {2, -1, 0, 0}, NODE_O1},
+    [T2] = {{2, 0, -1, 0, 1, 0}, {0, 0, 0, 0}, NODE_ONE},
+    [R2] = {{2, 0, 1, 0, -1, 2}, {0, 0, 0, 0}, NODE_ONE},
+    [_2Q1] = {{1, -4, 1, 2, 0, 1}, {2, -1, 0, 0}, NODE_O1},
+    [P1] = {{1, 0, -1, 0, 0, 1}, {0, 0, 0, 0}, NODE_ONE},
+    [L2] = {{2, -1, 2, -1, 0, 2}, {2, -2, 0, 0}, NODE_L2},
+    [K2] = {{2, 0, 2, 0, 0, 0}, {0, 0, 0, -1}, NODE_K2},
+    [M3] = {{3, -3, 3, 0, 0, 0}, {3, -3, 0, 0}, NODE_M3},
+};
+
+static const astro_compound compounds[] = {
+    {M2, 2, M2, 0}, /* M4 */
+    {M2, 3, M2, 0}, /* M6 */
+    {M2, 4, M2, 0}, /* M8 */
+    {S2, 2, S2, 0}, /* S4 */
+    {S2, 3, S2, 0}, /* S6 */
+    {M2, 1, N2, 1}, /* MN4 */
+    {M2, 1, S2, 1}, /* MS4 */
+    {M2, 1, K1, 1}, /* MK3 */
+    {M2, 2, K1, -1}, /* 2MK3 */
+    {S2, 2, M2, -1}, /* 2SM2 */
+    {S2, 1, M2, -1}, /* MSF */
+};
+
+const char *const tide_astro_names[] = {
+    "M2", "S2", "N2", "K1", "O1", "NU2", "MU2", "2N2", "OO1", "LAM2", "S1", "J1", "MM", "SSA", "SA", "MF",
+    "RHO1", "Q1", "T2", "R2", "2Q1", "P1", "L2", "K2", "M3",
+    "M4", "M6", "M8", "S4", "S6", "MN4", "MS4", "MK3", "2MK3", "2SM2", "MSF",
+};
+const uint8_t tide_astro_count = sizeof(tide_astro_names) / sizeof(tide_astro_names[0]);
+
+/* The astronomical arguments at one time, in radians */
+typedef struct astro_arguments {
+    double v[6]; /* T, s, h, p, p1 and 90 degrees, as astro_constituent.v */
+    double u[4]; /* xi, nu, nu' and 2nu'', as astro_constituent.u */
+    double I; /* inclination of the moon's orbit to the equator */
+    double P; /* p - xi */
+    double R; /* the extra term in L2's u */
+} astro_arguments;
+
+/* The mean longitudes at t (from Meeus' polynomials), and the terms that
+depend on the longitude of the moon's node, Schureman (197)-(224) */
+static void get_astro_arguments(time_t t, astro_arguments *a)
+{
+    /* Julian centuries since J2000.0 */
+    double c = ((double)t / DAY_SECONDS - 10957.5) / 36525.0;
+    double N, xi, nu, e1, e2, cos_I, sin_I, sin_2I;
+    /* T is the hour angle of the mean sun, 180 degrees at midnight */
+    a->v[0] = (180.0 + 360.0 * fmod((double)t / DAY_SECONDS, 1.0)) * DEG;
+    a->v[1] = (218.3164477 + 481267.88123421 * c - 0.0015786 * c * c) * DEG;
+    a->v[2] = (280.46646 + 36000.76983 * c + 0.0003032 * c * c) * DEG;
+    a->v[3] = (83.3532465 + 4069.0137287 * c - 0.0103200 * c * c) * DEG;
+    a->v[4] = (282.93735 + 1.71946 * c + 0.00046 * c * c) * DEG;
+    a->v[5] = 90.0 * DEG;
+    N = fmod((125.04452 - 1934.136261 * c + 0.0020708 * c * c) * DEG, 2.0 * M_PI);
+
+    cos_I = cos(LUNAR_INCLINATION) * cos(OBLIQUITY) - sin(LUNAR_INCLINATION) * sin(OBLIQUITY) * cos(N);
+    a->I = acos(cos_I);
+    sin_I = sin(a->I);
+    sin_2I = sin(2.0 * a->I);
+    /* Napier's analogies give xi and nu together */
+    e1 = atan(cos(0.5 * (OBLIQUITY - LUNAR_INCLINATION)) / cos(0.5 * (OBLIQUITY + LUNAR_INCLINATION)) * tan(0.5 * N)) - 0.5 * N;
+    e2 = atan(sin(0.5 * (OBLIQUITY - LUNAR_INCLINATION)) / sin(0.5 * (OBLIQUITY + LUNAR_INCLINATION)) * tan(0.5 * N)) - 0.5 * N;
+    xi = -(e1 + e2);
+    nu = e1 - e2;
+    a->u[0] = xi;
+    a->u[1] = nu;
+    a->u[2] = atan2(sin_2I * sin(nu), sin_2I * cos(nu) + 0.3347);
+    a->u[3] = atan2(sin_I * sin_I * sin(2.0 * nu), sin_I * sin_I * cos(2.0 * nu) + 0.0727);
+    a->P = a->v[3] - xi;
+    a->R = atan2(sin(2.0 * a->P), 1.0 / (6.0 * pow(tan(0.5 * a->I), 2)) - cos(2.0 * a->P));
+}
+
+/* Node factor of one of the formulas */
+static double node_factor(const astro_arguments *a, int f)
+{
+    double I = a->I, w = OBLIQUITY, i = LUNAR_INCLINATION;
+    double m2 = pow(cos(0.5 * I), 4) / (pow(cos(0.5 * w), 4) * pow(cos(0.5 * i), 4));
+    double tan2;
+    switch(f) {
+    case NODE_MM:
+        return (2.0 / 3.0 - pow(sin(I), 2)) / ((2.0 / 3.0 - pow(sin(w), 2)) * (1.0 - 1.5 * pow(sin(i), 2)));
+    case NODE_MF:
+        return pow(sin(I), 2) / (pow(sin(w), 2) * pow(cos(0.5 * i), 4));
+    case NODE_O1:
+        return sin(I) * pow(cos(0.5 * I), 2) / (sin(w) * pow(cos(0.5 * w), 2) * pow(cos(0.5 * i), 4));
+    case NODE_J1:
+        return sin(2.0 * I) / (sin(2.0 * w) * (1.0 - 1.5 * pow(sin(i), 2)));
+    case NODE_OO1:
+        return sin(I) * pow(sin(0.5 * I), 2) / (sin(w) * pow(sin(0.5 * w), 2) * pow(cos(0.5 * i), 4));
+    case NODE_K1:
+        return sqrt(0.8965 * pow(sin(2.0 * I), 2) + 0.6001 * sin(2.0 * I) * cos(a->u[1]) + 0.1006);
+    case NODE_K2:
+        return sqrt(19.0444 * pow(sin(I), 4) + 2.7702 * pow(sin(I), 2) * cos(2.0 * a->u[1]) + 0.0981);
+    case NODE_M2:
+        return m2;
+    case NODE_L2:
+        tan2 = pow(tan(0.5 * I), 2);
+        return m2 * sqrt(1.0 - 12.0 * tan2 * cos(2.0 * a->P) + 36.0 * tan2 * tan2);
+    case NODE_M3:
+        return pow(m2, 1.5);
+    default:
+        return 1.0;
+    }
+}
+
+/* Node factor f and equilibrium argument V + u (radians, unreduced) of base constituent k */
+static void base_arguments(int k, const astro_arguments *start, const astro_arguments *middle, double *f, double *vu)
+{
+    const astro_constituent *c = &constituents[k];
+    *vu = 0.0;
+    for(int j=0; j<6; j++) *vu += c->v[j] * start->v[j];
+    for(int j=0; j<4; j++) *vu += c->u[j] * middle->u[j];
+    if(c->f==NODE_L2) *vu -= middle->R;
+    *f = node_factor(middle, c->f);
+}
+
+/* The node factor and equilibrium argument (radians, 0 to 2pi) of constituent id
+for the given year, as xtide tabulates them: V is at 00:00 UTC on 1 January,
+and u and f are for the middle of the year. */
+void tide_astro_arguments(uint8_t id, int32_t year, float *node_factor, float *equilibrium)
+{
+    astro_arguments start, middle;
+    double f, vu;
+    get_astro_arguments(year_start(year), &start);
+    get_astro_arguments(year_start(year) + (year_start(year+1) - year_start(year)) / 2, &middle);
+    if(id<N_BASE) {
+        base_arguments(id, &start, &middle, &f, &vu);
+    } else {
+        const astro_compound *c = &compounds[id - N_BASE];
+        double fa, vua, fb, vub;
+        base_arguments(c->a, &start, &middle, &fa, &vua);
+        base_arguments(c->b, &start, &middle, &fb, &vub);
+        f = pow(fa, abs(c->na)) * pow(fb, abs(c->nb));
+        vu = c->na * vua + c->nb * vub;
+    }
+    vu = fmod(vu, 2.0 * M_PI);
+    if(vu<0.0) vu += 2.0 * M_PI;
+    *node_factor = (float)f;
+    *equilibrium = (float)vu;
+}
+
+/* Check the computed corrections against the yearly rows of a nodal table,
+which the extractor takes from xtide's tables. Returns the number of 
+constituents out by more than 0.002 in f or 0.05 degrees in V + u. */
+int test_astro_arguments(const tide_nodal_table *nodal)
+{
+    int failures = 0, tested = 0;
+    float worst_f = 0.0f, worst_vu = 0.0f;
+    if(!nodal->astro || nodal->n_years==0) return 0;
+    for(int c=0; c<nodal->n_constituents; c++) {
+        int bad = 0;
+        if(nodal->astro[c]==TIDE_ASTRO_NONE) continue;
+        if(nodal->astro[c]>=tide_astro_count) {
+            printf("Constituent %d: no astro id %d\n", c, nodal->astro[c]);
+            failures++;
+            continue;
+        }
+        for(int year=0; year<nodal->n_years; year++) {
+            float f, vu, df, dvu;
+            int k = c + nodal->n_constituents * year;
+            tide_astro_arguments(nodal->astro[c], nodal->base_year + year, &f, &vu);
+            df = fabsf(f - UNQUANTIZE_NODE_FACTOR(nodal->node_factors[k]));
+            dvu = fabsf(remainderf(vu - UNQUANTIZE_PHASE(nodal->equilibria[k]), MAX_TIDE_PHASE)) / DEG;
+            if(df>worst_f) worst_f = df;
+            if(dvu>worst_vu) worst_vu = dvu;
+            if(df>0.002f || dvu>0.05f) bad = 1;
+        }
+        if(bad) printf("%s: computed corrections differ from the table\n", tide_astro_names[nodal->astro[c]]);
+        failures += bad;
+        tested++;
+    }
+    printf("Astronomical arguments: %d constituents over %d years, largest differences %.4f in f, %.3f degrees; %d failed\n", 
+        tested, nodal->n_years, worst_f, worst_vu, failures);
+    return failures;
+}
+
+/* Reference corrections for fixed years, independent of any station's data:
+Schureman's own formulas, evaluated in double precision from his Table 1
+polynomials (epoch 1900) rather than the J2000 ones used here. 2006 is at
+the node (N = 0), where f takes its extreme values: 0.963 for M2, 1.113 for
+K1, 1.183 for O1 and 1.316 for K2. */
+typedef struct astro_reference {
+    const char *name;
+    int32_t year;
+    float node_factor;
+    float equilibrium; /* degrees */
+} astro_reference;
+
+static const astro_reference references[] = {
+    {"M2", 2000, 1.0162f, 134.56f},
+    {"S2", 2000, 1.0000f, 0.00f},
+    {"N2", 2000, 1.0162f, 6.14f},
+    {"K1", 2000, 0.9629f, 1.46f},
+    {"O1", 2000, 0.9393f, 137.24f},
+    {"K2", 2000, 0.8936f, 183.37f},
+    {"MF", 2000, 0.8683f, 40.09f},
+    {"M4", 2000, 1.0327f, 269.13f},
+    {"M2", 2006, 0.9632f, 332.27f},
+    {"S2", 2006, 1.0000f, 0.00f},
+    {"N2", 2006, 0.9632f, 5.38f},
+    {"K1", 2006, 1.1128f, 10.60f},
+    {"O1", 2006, 1.1827f, 321.63f},
+    {"K2", 2006, 1.3162f, 201.21f},
+    {"MF", 2006, 1.4523f, 229.01f},
+    {"M4", 2006, 0.9278f, 304.54f},
+    {"M2", 2015, 1.0377f, 110.45f},
+    {"S2", 2015, 1.0000f, 0.00f},
+    {"N2", 2015, 1.0377f, 38.94f},
+    {"K1", 2015, 0.8824f, 11.30f},
+    {"O1", 2015, 0.8068f, 98.62f},
+    {"K2", 2015, 0.7472f, 202.40f},
+    {"MF", 2015, 0.6273f, 93.22f},
+    {"M4", 2015, 1.0768f, 220.90f},
+    {"M2", 2026, 0.9674f, 66.39f},
+    {"S2", 2026, 1.0000f, 0.00f},
+    {"N2", 2026, 0.9674f, 59.74f},
+    {"K1", 2026, 1.1031f, 14.26f},
+    {"O1", 2026, 1.1668f, 50.69f},
+    {"K2", 2026, 1.2815f, 208.93f},
+    {"MF", 2026, 1.4073f, 145.02f},
+    {"M4", 2026, 0.9358f, 132.79f},
+};
+
+/* Check the computed corrections against the reference values. Returns the
+number out by more than 0.001 in f or 0.05 degrees in V + u. */
+int test_astro_reference(void)
+{
+    int failures = 0, n = sizeof(references) / sizeof(references[0]);
+    float worst_f = 0.0f, worst_vu = 0.0f;
+    for(int i=0; i<n; i++) {
+        const astro_reference *r = &references[i];
+        int id = 0;
+        float f, vu, df, dvu;
+        while(id<tide_astro_count && strcmp(tide_astro_names[id], r->name)!=0) id++;
+        if(id==tide_astro_count) {
+            failures++;
+            continue;
+        }
+        tide_astro_arguments((uint8_t)id, r->year, &f, &vu);
+        df = fabsf(f - r->node_factor);
+        dvu = fabsf(remainderf(vu / (float)DEG - r->equilibrium, 360.0f));
+        if(df>worst_f) worst_f = df;
+        if(dvu>worst_vu) worst_vu = dvu;
+        if(df>0.001f || dvu>0.05f) {
+            printf("%s %d: computed f %.4f, V + u %.2f degrees; expected %.4f, %.2f\n", r->name, (int)r->year, 
+                f, vu / (float)DEG, r->node_factor, r->equilibrium);
+            failures++;
+        }
+    }
+    printf("Astronomical reference: %d values, largest differences %.4f in f, %.3f degrees; %d failed\n", 
+        n, worst_f, worst_vu, failures);
+    return failures;
+}
@@ -0,0 +1,21 @@
+#ifndef __TIDE_ASTRO_H__
+#define __TIDE_ASTRO_H__
+#include "tide_base.h"
+
+/* Node factors and equilibrium arguments of the standard constituents,
+computed from the date as in Schureman's Manual of Harmonic Analysis and
+Prediction of Tides (1958), which xtide's tables are also built from.
+TIDE_ENCODING_NODAL stations use these instead of their nodal table for any
+constituent the table gives an astro id, so those never run out of years.
+The ids index tide_astro_names, and dump_tides.py (ASTRO_CONSTITUENTS)
+must list the names in the same order. */
+#define TIDE_ASTRO_NONE 0xFF /* not computed on the device; use the nodal table */
+
+extern const char *const tide_astro_names[];
+extern const uint8_t tide_astro_count;
+
+void tide_astro_arguments(uint8_t id, int32_t year, float *node_factor, float *equilibrium);
+int test_astro_arguments(const tide_nodal_table *nodal);
+int test_astro_reference(void);
+
+#endif
@@ -1,4 +1,11 @@
 #include "tide_base.h"
+#include "tide_kernel.h"
+#include "tide_calendar.h"
+#include "tide_almanac.h"
+#include "tide_chebyshev.h"
+#include "tide_astro.h"
+#include "tide_spatial.h"
+#include "tide_stats.h"
 #include <math.h>
 #include <assert.h>
 #include <stdint.h>
@@ -10,59 +17,418 @@
 #include <math.h>
 #include "tide_data.c"
 
+/* Seconds since the epoch of a UTC date and time */
 time_t make_time(uint32_t year, uint32_t month, uint32_t day, uint32_t hour, uint32_t minute, uint32_t second) {
-    struct tm tm = {
-        .tm_year = year - 1900,
-        .tm_mon = month - 1,
-        .tm_mday = day,
-        .tm_hour = hour,
-        .tm_min = minute,
-        .tm_sec = second,
-        .tm_isdst = 0
-    };
-    return mktime(&tm);
+    return time_from_civil(year, month, day, hour, minute, second);
 }
 
-/* Take a time in seconds since the epoch (UTC) 
-    and predict the tide height in meters at that time. */
-float predict_tide(time_t t0, tidal_station *station, int d) {                 
-    int32_t year;           
-    int32_t n;
-    int32_t t;
+/* Write t as a UTC date and time, like "Sat Oct 17 04:47:48 2026", into buf,
+which must hold at least TIME_STRING_LENGTH characters. Returns buf. 
+Unlike ctime, this is reentrant and does not depend on the local time zone. */
+char *format_time(time_t t, char *buf)
+{
+    static const char *day_names[] = {"Thu", "Fri", "Sat", "Sun", "Mon", "Tue", "Wed"};
+    static const char *month_names[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    int32_t days = days_from_time(t);
+    int32_t seconds = t - (time_t)days * DAY_SECONDS;
+    int32_t year;
+    uint32_t month, day;
+    civil_from_days(days, &year, &month, &day);
+    snprintf(buf, TIME_STRING_LENGTH, "%s %s %2u %02d:%02d:%02d %4d", day_names[((days % 7) + 7) % 7], month_names[month-1], 
+        (unsigned)day, (int)(seconds / HOUR_SECONDS), (int)(seconds / MINUTE_SECONDS % 60), (int)(seconds % 60), (int)year);
+    return buf;
+}
+
+/* The year of constants to use for station at time t, clipped to the range 
+of the table, and the times [start, end) that year's constants are used for */
+int32_t station_year(tidal_station *station, time_t t, time_t *start, time_t *end)
+{
     tidal_harmonic *h_station = station->harmonic;
     tidal_offset *offset = station->offset;
-    t = t0 - make_time(h_station->base_year, 1, 1, 0, 0, 0);
-    t = t + offset->time_offset; /* TODO: check sign! */
-    /* clip the year to the range of the table */
-    if(t<0) year = 0;
-    if(t>=h_station->n_years*YEAR_SECONDS) year = h_station->n_years-1;
-    else year = t / YEAR_SECONDS;
-    /* Get the index into the table */
-    n = h_station->n_constituents * year;
-    float tide = (d>0) ? 0 : (h_station->offset + offset->level_offset);
+    int32_t year, last_year;
+    /* Years are in station time, so the station's time offset shifts them. */
+    year = year_of_time(t + offset->time_offset); /* TODO: check sign! */
+    if(h_station->n_years==0) {
+        *start = year_start(year) - offset->time_offset;
+        *end = year_start(year+1) - offset->time_offset;
+        return year;
+    }
+    last_year = h_station->base_year + h_station->n_years - 1;
+    if(year<h_station->base_year) year = h_station->base_year;
+    if(year>last_year) year = last_year;
+    *start = (year==h_station->base_year) ? TIDE_TIME_MIN : year_start(year) - offset->time_offset;
+    *end = (year==last_year) ? TIDE_TIME_MAX : year_start(year+1) - offset->time_offset;
+    return year;
+}
+
+/* Constituent i of h in the given year (as chosen by station_year): its speed (radians/s), amplitude (m, before any level scale) and 
+phase at the start of the year (radians, 0 to 2pi) */
+void harmonic_constituent(tidal_harmonic *h, int32_t year, int i, float *speed, float *amp, float *phase)
+{
+    if(h->type==TIDE_ENCODING_NODAL) {
+        const tide_nodal_table *nodal = h->nodal;
+        int c = h->constituents[i];
+        float node_factor, equilibrium;
+        if(nodal->astro && nodal->astro[c]!=TIDE_ASTRO_NONE) {
+            tide_astro_arguments(nodal->astro[c], year, &node_factor, &equilibrium);
+        } else {
+            /* Past the end of the table, the last year is the best there is */
+            int32_t row = year - nodal->base_year;
+            assert(nodal->n_years>0);
+            if(row<0) row = 0;
+            if(row>=nodal->n_years) row = nodal->n_years - 1;
+            node_factor = UNQUANTIZE_NODE_FACTOR(nodal->node_factors[c + nodal->n_constituents * row]);
+            equilibrium = UNQUANTIZE_PHASE(nodal->equilibria[c + nodal->n_constituents * row]);
+        }
+        *speed = nodal->speeds[c];
+        *amp = UNQUANTIZE_AMP(h->amps[i]) * node_factor;
+        *phase = equilibrium - UNQUANTIZE_PHASE(h->phases[i]);
+        if(*phase<0.0f) *phase += MAX_TIDE_PHASE;
+    } else {
+        /* speeds are the same for every year */
+        int n = h->n_constituents * (year - h->base_year);
+        *speed = h->speeds[i];
+        *amp = UNQUANTIZE_AMP(h->amps[i+n]);
+        *phase = UNQUANTIZE_PHASE(h->phases[i+n]);
+    }
+}
+
+/* Constituent i of the harmonic or nodal station p is prepared for: its speed 
+(radians/s), amplitude (m, including level scale) and phase at p->epoch (radians) */
+static void prepared_constituent(prepared_station *p, int i, float *speed, float *amp, float *phase)
+{
+    harmonic_constituent(p->station->harmonic, p->year, i, speed, amp, phase);
+    *amp *= p->station->offset->level_scale;
+}
+
+/* Make sure p holds the constants for station at time t0. 
+Does nothing if they are already there, so it is cheap to call before every prediction. 
+p must be zeroed before its first use. */
+void prepare_station(prepared_station *p, tidal_station *station, time_t t0)
+{
+    tidal_harmonic *h_station = station->harmonic;
+    tidal_offset *offset = station->offset;
+    int32_t year;
+
+    if(p->station==station && t0>=p->start && t0<p->end) return;
+    if(h_station->type==TIDE_ENCODING_CHEBYSHEV) {
+        prepare_chebyshev(p, station, t0);
+        return;
+    }
+    
+    year = station_year(station, t0, &p->start, &p->end);
+    TIDE_STAT(prepares);
+    TIDE_TRACE(TIDE_TRACE_PREPARE, t0, year);
+    p->station = station;
+    p->type = h_station->type;
+    p->year = year;
+    /* Phases are given relative to the start of their own year */
+    p->epoch = year_start(year) - offset->time_offset;
+    p->offset = (h_station->offset + offset->level_offset) * offset->level_scale;
+    p->n_constituents = h_station->n_constituents;
+    assert(p->n_constituents<=MAX_TIDE_CONSTITUENTS);
+    
+    /* Each constituent's acceleration is at most amp*speed^2, and its jerk amp*speed^3 */
+    p->accel_bound = 0.0f;
+    p->jerk_bound = 0.0f;
+    p->quarter_period = TIDE_QUARTER_PERIOD;
+    float largest = -1.0f;
+    for(int i=0; i<p->n_constituents; i++) {
+        float speed, amp, phase;
+        prepared_constituent(p, i, &speed, &amp, &phase);
+#ifndef TIDE_FIXED
+        p->speeds[i] = speed;
+        p->amps[i] = amp;
+        p->phases[i] = phase;
+#endif
+        speed = fabsf(speed);
+        p->accel_bound += amp * speed * speed;
+        p->jerk_bound += amp * speed * speed * speed;
+        if(speed>0.0f && amp>largest) {
+            largest = amp;
+            p->quarter_period = (time_t)(M_PI / 2.0 / speed);
+        }
+    }
+#ifdef TIDE_FIXED
+    /* The union may hold another station's constants, so always rebuild */
+    p->fixed.station = NULL;
+    prepare_fixed_station(&p->fixed, station, t0);
+#else
+    /* Pad to a whole number of kernel blocks with constituents that contribute nothing */
+    for(int i=p->n_constituents; i<TIDE_KERNEL_PAD(p->n_constituents); i++) {
+        p->speeds[i] = 0.0f;
+        p->amps[i] = 0.0f;
+        p->phases[i] = 0.0f;
+    }
+#endif
+}
+
+/* Take a time in seconds since the epoch (UTC) 
+    and predict the tide height in meters at that time. 
+    d>0 gives the d'th derivative, in m/s^d. */
+float predict_tide(time_t t0, prepared_station *p, int d) {                 
+    int32_t t;
+    float level, rate, accel;
+    prepare_station(p, p->station, t0);
+    p->evaluations++;
+    TIDE_STAT(predictions[d<3 ? d : 3]);
+    if(p->type==TIDE_ENCODING_CHEBYSHEV) 
+        return predict_chebyshev_derivative(t0, p, d);
+#ifdef TIDE_FIXED
+    if(d<=2) {
+        int32_t fixed[3];
+        predict_tide_fixed(t0, &p->fixed, &fixed[0], &fixed[1], &fixed[2]);
+        return (d==0) ? fixed[0] * 1e-3f : (d==1) ? fixed[1] * (1e-3f / HOUR_SECONDS) : fixed[2] * (1e-3f / HOUR_SECONDS / HOUR_SECONDS);
+    }
+#endif
+    t = t0 - p->epoch;
+#ifndef TIDE_FIXED
+    if(d==0) 
+        return tide_kernel_level(p->amps, p->speeds, p->phases, p->n_constituents, t) + p->offset;
+    if(d<=2) {
+        tide_kernel_derivatives(p->amps, p->speeds, p->phases, p->n_constituents, t, &level, &rate, &accel);
+        return (d==1) ? rate : accel;
+    }
+#else
+    (void)level; (void)rate; (void)accel;
+#endif
+    /* Higher derivatives are never needed in practice, so the constants 
+    are worked out again rather than kept for them */
+    float tide = 0;
     float phase_shift = d * M_PI / 2.0f;
-    for (int i=0; i<h_station->n_constituents; i++) {
-        float speed = h_station->speeds[i+n];
-        float amp = UNQUANTIZE_AMP(h_station->amps[i+n]);
-        float phase = UNQUANTIZE_PHASE(h_station->phases[i+n]);
+    for (int i=0; i<p->n_constituents; i++) {
+        float speed, amp, phase;
+        prepared_constituent(p, i, &speed, &amp, &phase);
         float term = amp * cosf(speed * t + phase + phase_shift);
-        term = d>0 ? term * powf(speed, d) : term;
+        for (int j=0; j<d; j++) term *= speed;
         tide += term;
     }            
-    return tide * offset->level_scale;
+    return tide;
 }
 
-/* Test the tide prediction for a station against a set of known times and levels. */
-void test_tides(tidal_station *station, time_t *times, float *levels) {
-    char *datetime;
-    printf("Testing %s\n", station->name);
-    for (int i=0; i<32; i++) {
-        datetime = ctime(&times[i]);
-        datetime[strlen(datetime)-1] = '\0';
-        float tide = predict_tide(times[i], station, 0);
-        printf("Time: %s, %2.2fm:%2.2fm\tError: %2.5fm\n", datetime, tide, levels[i], fabs(tide - levels[i]));
-        assert(fabs(tide - levels[i]) < MAX_TIDE_ERROR);                            
+/* Predict the tide level (m), rate (m/s) and acceleration (m/s^2) at t0 
+in a single pass over the constituents. */
+void predict_tide_derivatives(time_t t0, prepared_station *p, float *level, float *rate, float *accel)
+{
+    int32_t t;
+    prepare_station(p, p->station, t0);
+    p->evaluations++;
+    TIDE_STAT(fused_predictions);
+    if(p->type==TIDE_ENCODING_CHEBYSHEV) {
+        predict_chebyshev(t0, p, level, rate, accel);
+        return;
     }
+#ifdef TIDE_FIXED
+    int32_t level_mm, rate_mm_h, accel_mm_h2;
+    predict_tide_fixed(t0, &p->fixed, &level_mm, &rate_mm_h, &accel_mm_h2);
+    *level = level_mm * 1e-3f;
+    *rate = rate_mm_h * (1e-3f / HOUR_SECONDS);
+    *accel = accel_mm_h2 * (1e-3f / HOUR_SECONDS / HOUR_SECONDS);
+    (void)t;
+#else
+    t = t0 - p->epoch;
+    tide_kernel_derivatives(p->amps, p->speeds, p->phases, p->n_constituents, t, level, rate, accel);
+    *level += p->offset;
+#endif
+}
+
+/* Start predicting tides at t0, every step seconds. 
+Sets up one phasor per constituent; each subsequent sample
+costs one complex multiply per constituent. */
+void tide_iterator_init(tide_iterator *it, prepared_station *p, time_t t0, time_t step)
+{
+    int32_t t;
+    prepare_station(p, p->station, t0);
+    t = t0 - p->epoch;
+    
+    it->prepared = p;
+    it->t = t0;
+    it->step = step;
+    it->start = p->start;
+    it->end = p->end;
+    it->steps = 0;
+    it->n_constituents = p->n_constituents;
+    it->base = p->offset;
+#ifdef TIDE_FIXED
+    /* every sample is predicted directly; see tide_iterator_next_rate */
+    (void)t;
+#else
+    for(int i=0; i<it->n_constituents; i++) {
+        float speed = p->speeds[i];
+        float phase = speed * t + p->phases[i];
+        it->amp[i] = p->amps[i];
+        it->rate_amp[i] = -p->amps[i] * speed;
+        it->re[i] = cosf(phase);
+        it->im[i] = sinf(phase);
+        it->rot_re[i] = cosf(speed * step);
+        it->rot_im[i] = sinf(speed * step);
+    }
+#endif
+}
+
+/* Return the tide at the current time, and advance by one step */
+float tide_iterator_next(tide_iterator *it)
+{
+    float rate;
+    return tide_iterator_next_rate(it, &rate);
+}
+
+/* Return the tide at the current time and its rate of change (m/s) 
+in rate, and advance by one step */
+float tide_iterator_next_rate(tide_iterator *it, float *rate)
+{
+    float tide = it->base, tide_rate = 0.0f;
+    float re, im, k;
+    int renormalise;
+
+    /* Piecewise curves are cheap enough to evaluate directly, and the 
+    fixed-point predictor needs no floating point multiplies */
+#ifndef TIDE_FIXED
+    if(it->prepared->type==TIDE_ENCODING_CHEBYSHEV) 
+#endif
+    {
+        float accel;
+        predict_tide_derivatives(it->t, it->prepared, &tide, rate, &accel);
+        it->t += it->step;
+        return tide;
+    }
+    /* The constants change at the start of each year; start again from there */
+    if(it->t<it->start || it->t>=it->end)
+        tide_iterator_init(it, it->prepared, it->t, it->step);
+    
+    /* Rounding slowly changes the length of the phasors; pull them back to
+    unit length every so often (one Newton step for 1/sqrt is enough) */
+    renormalise = ++it->steps>=TIDE_ITERATOR_RENORMALISE;
+    if(renormalise) it->steps = 0;
+    for(int i=0; i<it->n_constituents; i++) {
+        tide += it->amp[i] * it->re[i];
+        tide_rate += it->rate_amp[i] * it->im[i];
+        re = it->re[i] * it->rot_re[i] - it->im[i] * it->rot_im[i];
+        im = it->re[i] * it->rot_im[i] + it->im[i] * it->rot_re[i];
+        if(renormalise) {
+            k = 1.5f - 0.5f * (re*re + im*im);
+            re *= k;
+            im *= k;
+        }
+        it->re[i] = re;
+        it->im[i] = im;
+    }
+    it->t += it->step;
+    *rate = tide_rate;
+    return tide;
+}
+
+/* Predict the tide at n times, writing levels (m), and optionally rates (m/s) 
+and accelerations (m/s^2) if those are not NULL. Times that share a year of 
+constants are worked through in blocks, one block of constituents at a time, 
+so the constants stay in cache. Gives exactly the same values as predict_tide. */
+void predict_tide_batch(prepared_station *p, const time_t *times, int n, float *levels, float *rates, float *accels)
+{
+#ifdef TIDE_FIXED
+    /* Each time is predicted on its own, with integers only */
+    for(int i=0; i<n; i++) {
+        float level, rate, accel;
+        predict_tide_derivatives(times[i], p, &level, &rate, &accel);
+        levels[i] = level;
+        if(rates) rates[i] = rate;
+        if(accels) accels[i] = accel;
+    }
+#else
+    float t[TIDE_BATCH_BLOCK];
+    float acc0[TIDE_BATCH_BLOCK*TIDE_KERNEL_LANES];
+    float acc1[TIDE_BATCH_BLOCK*TIDE_KERNEL_LANES];
+    float acc2[TIDE_BATCH_BLOCK*TIDE_KERNEL_LANES];
+    int derivatives = (rates!=NULL || accels!=NULL);
+    int i = 0, m;
+
+    while(i<n) {
+        prepare_station(p, p->station, times[i]);
+        if(p->type==TIDE_ENCODING_CHEBYSHEV) {
+            predict_chebyshev(times[i], p, levels+i, rates ? rates+i : NULL, accels ? accels+i : NULL);
+            i++;
+            continue;
+        }
+        /* Take the next run of times that use the same constants */
+        for(m=0; m<TIDE_BATCH_BLOCK && i+m<n && times[i+m]>=p->start && times[i+m]<p->end; m++)
+            t[m] = (int32_t)(times[i+m] - p->epoch);
+        memset(acc0, 0, sizeof(float) * m * TIDE_KERNEL_LANES);
+        if(derivatives) {
+            memset(acc1, 0, sizeof(float) * m * TIDE_KERNEL_LANES);
+            memset(acc2, 0, sizeof(float) * m * TIDE_KERNEL_LANES);
+        }
+        for(int c=0; c<p->n_constituents; c+=TIDE_KERNEL_LANES)
+            tide_kernel_accumulate(p->amps+c, p->speeds+c, p->phases+c, t, m, acc0, derivatives ? acc1 : NULL, derivatives ? acc2 : NULL);
+        for(int k=0; k<m; k++) {
+            levels[i+k] = tide_kernel_reduce(acc0 + k*TIDE_KERNEL_LANES) + p->offset;
+            if(rates) rates[i+k] = tide_kernel_reduce(acc1 + k*TIDE_KERNEL_LANES);
+            if(accels) accels[i+k] = tide_kernel_reduce(acc2 + k*TIDE_KERNEL_LANES);
+        }
+        i += m;
+    }
+#endif
+}
+
+/* As predict_tide_batch, for n times starting at t0 and step seconds apart */
+void predict_tide_steps(prepared_station *p, time_t t0, time_t step, int n, float *levels, float *rates, float *accels)
+{
+    time_t times[TIDE_BATCH_BLOCK];
+    int m;
+    for(int i=0; i<n; i+=m) {
+        m = (n-i<TIDE_BATCH_BLOCK) ? n-i : TIDE_BATCH_BLOCK;
+        for(int k=0; k<m; k++) times[k] = t0 + (time_t)(i+k) * step;
+        predict_tide_batch(p, times, m, levels+i, rates ? rates+i : NULL, accels ? accels+i : NULL);
+    }
+}
+
+/* Test the tide prediction for a harmonic station against its embedded
+set of known times and levels. Returns the number of levels that are out by 
+more than MAX_TIDE_ERROR. */
+int test_tides(tidal_harmonic *harmonic) {
+    char datetime[TIME_STRING_LENGTH];
+    int failures = 0;
+    tidal_offset no_offset = {.time_offset = 0, .level_offset = 0.0f, .level_scale = 1.0f};
+    tidal_station station = {.name = harmonic->name, .harmonic = harmonic, .offset = &no_offset};
+    prepared_station prepared = {0};
+    float levels[TIDE_BATCH_BLOCK];
+    prepared.station = &station;
+    printf("Testing %s\n", station.name);
+#ifdef TIDE_DEBUG
+    for (int i=0; i<harmonic->n_tests; i+=TIDE_BATCH_BLOCK) {
+        int m = (harmonic->n_tests-i<TIDE_BATCH_BLOCK) ? harmonic->n_tests-i : TIDE_BATCH_BLOCK;
+        predict_tide_batch(&prepared, harmonic->test_times+i, m, levels, NULL, NULL);
+        for (int k=0; k<m; k++) {
+            float error = fabs(levels[k] - harmonic->test_tides[i+k]);
+            if (error<MAX_TIDE_ERROR) continue;
+            format_time(harmonic->test_times[i+k], datetime);
+            printf("Time: %s, %2.2fm:%2.2fm\tError: %2.5fm\n", datetime, levels[k], harmonic->test_tides[i+k], error);
+            failures++;
+        }
+    }
+    printf("%d/%d outside %2.2fm\n", failures, harmonic->n_tests, MAX_TIDE_ERROR);
+    if(harmonic->type!=TIDE_ENCODING_CHEBYSHEV) {
+        /* Cross-check the fixed-point predictor against the same levels, and against the float predictor */
+        fixed_station fixed = {0};
+        float amps[MAX_TIDE_CONSTITUENTS] = {0}, speeds[MAX_TIDE_CONSTITUENTS] = {0}, phases[MAX_TIDE_CONSTITUENTS] = {0};
+        int fixed_failures = 0;
+        float largest = 0.0f;
+        fixed.station = &station;
+        for (int i=0; i<harmonic->n_tests; i++) {
+            int32_t level_mm;
+            predict_tide_fixed(harmonic->test_times[i], &fixed, &level_mm, NULL, NULL);
+            float error = fabs(level_mm * 1e-3f - harmonic->test_tides[i]);
+            /* always the float kernel, even when TIDE_FIXED is defined */
+            prepare_station(&prepared, &station, harmonic->test_times[i]);
+            for(int c=0; c<prepared.n_constituents; c++) harmonic_constituent(harmonic, prepared.year, c, &speeds[c], &amps[c], &phases[c]);
+            float level = tide_kernel_level(amps, speeds, phases, prepared.n_constituents, (int32_t)(harmonic->test_times[i] - prepared.epoch)) + prepared.offset;
+            float difference = fabs(level_mm * 1e-3f - level);
+            if (difference>largest) largest = difference;
+            if (error>=MAX_TIDE_ERROR) fixed_failures++;
+        }
+        printf("Fixed point: %d/%d outside %2.2fm, largest difference from float %2.4fm\n", fixed_failures, harmonic->n_tests, MAX_TIDE_ERROR, largest);
+        failures += fixed_failures;
+    }
+#endif
+    return failures;
 }
 
 /* Case insensitive string comparison */
@@ -75,33 +441,106 @@ int insenstive_is_prefix(char *s1, char *s2) {
     return *s1 == '\0';
 }
 
-/* Search the registry for a given station name. */
-tidal_station *find_tidal_station(char *name) {
-    tidal_station *station = tidal_stations;        
-    int match;
-    while (station != NULL) {
-        match = insenstive_is_prefix(name, station->name);
-        if (match) return station;                     
-        station = station->previous;
+/* Compare s1 with s2, ignoring (ASCII) case, as strcmp. With prefix set,
+s1 also compares equal to any string it is a prefix of. */
+int insensitive_compare(const char *s1, const char *s2, int prefix)
+{
+    while(*s1 && tolower((unsigned char)*s1)==tolower((unsigned char)*s2)) {
+        s1++;
+        s2++;
+    }
+    if(prefix && *s1=='\0') return 0;
+    return tolower((unsigned char)*s1) - tolower((unsigned char)*s2);
+}
+
+/* Find the names starting with prefix among n names sorted by insensitive_compare,
+where name(names, i) is the i-th. Sets *first to the first of them (or to where
+they would be), and returns how many there are. */
+uint32_t find_name_range(const char *prefix, const char *(*name)(const void *names, uint32_t i), const void *names, uint32_t n, uint32_t *first)
+{
+    uint32_t lo = 0, hi = n, end;
+    /* the first name not before prefix */
+    while(lo<hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if(insensitive_compare(prefix, name(names, mid), 1)>0) lo = mid + 1;
+        else hi = mid;
+    }
+    *first = lo;
+    /* then the first name after all of those starting with it */
+    hi = n;
+    while(lo<hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if(insensitive_compare(prefix, name(names, mid), 1)==0) lo = mid + 1;
+        else hi = mid;
     }
-    return NULL;
+    end = lo;
+    return end - *first;
+}
+
+static const char *index_station_name(const void *names, uint32_t i)
+{
+    return ((tidal_station *const *)names)[i]->name;
+}
+
+/* Find the stations whose names start with prefix, ignoring case. Sets *first
+to the position of the first of them in tidal_station_index, and returns how
+many there are. */
+uint32_t find_tidal_stations(const char *prefix, uint32_t *first)
+{
+    return find_name_range(prefix, index_station_name, tidal_station_index, n_tidal_stations, first);
+}
+
+/* Search the registry for a given station name. A station with exactly that
+name is found first, and otherwise the first (by name) that it is a prefix of. */
+tidal_station *find_tidal_station(char *name) {
+    uint32_t first;
+    /* an exact match sorts before any longer name it is a prefix of */
+    if(find_tidal_stations(name, &first)==0) return NULL;
+    return tidal_station_index[first];
+}
+
+/* The station after station in order of name, wrapping round at the end */
+tidal_station *next_tidal_station(tidal_station *station)
+{
+    uint32_t first, n = find_tidal_stations(station->name, &first);
+    /* several stations may share the name, case aside */
+    for(uint32_t i=first; i<first + n; i++)
+        if(tidal_station_index[i]==station) return tidal_station_index[(i + 1) % n_tidal_stations];
+    return tidal_station_index[0];
+}
+
+/* Fill in event, including the neap-spring value from 0.0 to 1.0 */
+static void set_tide_event(prepared_station *p, tidal_event *event, time_t t, float level, uint8_t type)
+{
+    tidal_harmonic *h_station = p->station->harmonic;
+    tidal_offset *offset = p->station->offset;
+    TIDE_STAT(events_found);
+    TIDE_TRACE(TIDE_TRACE_EVENT, t, type);
+    event->time = t;
+    event->level = level;
+    event->type = type;
+    event->neap_spring = (fabs(event->level - h_station->offset - offset->level_offset) - h_station->neaps_range) / ((h_station->springs_range - h_station->neaps_range) * offset->level_scale);
+    event->neap_spring = fmax(0.0, fmin(1.0, event->neap_spring));
 }
 
 #define N_NEWTON 3
 #define N_BINARY 2
-float find_tide_event(tidal_station *station, tidal_event *event, time_t t0, time_t t1, float ntide)
+/* Find the HW/LW event in [t0, t1], if the rate of change of the tide 
+changes sign in that interval. ntide is the rate at t0 if already known 
+(or 0), and the rate at t1 is returned so it can be passed on to the next interval. */
+float find_tide_event(prepared_station *p, tidal_event *event, time_t t0, time_t t1, float ntide)
 {
     float tide0, tide1;
-    float t_d, t_d2;
+    float level, t_d, t_d2;
     time_t t;
     int i;
 
     if(ntide==0)
-        tide0 = predict_tide(t0, station, 1);
+        predict_tide_derivatives(t0, p, &level, &tide0, &t_d2);
     else
         /* Re-use the previous tide prediction */
         tide0 = ntide;
-    tide1 = predict_tide(t1, station, 1);    
+    predict_tide_derivatives(t1, p, &level, &tide1, &t_d2);
     ntide = tide1; 
     /* No event in this interval */
     if(tide0*tide1>0)
@@ -116,32 +555,29 @@ float find_tide_event(tidal_station *station, tidal_event *event, time_t t0, tim
     for(i=0;i<N_BINARY;i++)
     {
         t = (t0 + t1) / 2;
-        tide1 = predict_tide(t, station, 1);    
-        if((tide1*tide0)<0)        
+        predict_tide_derivatives(t, p, &level, &t_d, &t_d2);
+        if((t_d*tide0)<0)        
             t1 = t;        
         else
             t0 = t;
     }              
-    /* Refine the event time via Newton steps*/
-    t_d = tide1;
-    t_d2 = predict_tide(t, station, 2);
-    for(i=0;i<N_NEWTON;i++)
+    /* Refine the event time via Newton steps; the last evaluation 
+    also gives the level at the event. The step is rounded to whole seconds 
+    before it is applied, as t is too large to hold in a float. */
+    for(i=0;i<=N_NEWTON;i++)
     {
-        t = t - t_d / t_d2;
-        t_d = predict_tide(t, station, 1);
-        t_d2 = predict_tide(t, station, 2);
+        t = t - (time_t)(t_d / t_d2);
+        predict_tide_derivatives(t, p, &level, &t_d, &t_d2);
+        TIDE_STAT(newton_steps);
     }    
-    t = t - t_d / t_d2;
-    /* Populate the event */
-    event->time = t;
-    event->level = predict_tide(t, station, 0);
-    event->type = (t_d2<0) ? TIDE_HIGH : TIDE_LOW;    
-    
-    /* Calculate the neap-spring value, from 0.0 to 1.0 */
-    tidal_harmonic *h_station = station->harmonic;
-    tidal_offset *offset = station->offset;
-    event->neap_spring = (fabs(event->level - h_station->offset - offset->level_offset) - h_station->neaps_range) / ((h_station->springs_range - h_station->neaps_range) * offset->level_scale);
-    event->neap_spring = fmax(0.0, fmin(1.0, event->neap_spring));
+#ifdef TIDE_STATS
+    /* Settled if the next step would be under a minute */
+    if(fabsf(t_d / t_d2)>=MINUTE_SECONDS) {
+        TIDE_STAT(unconverged);
+        TIDE_TRACE(TIDE_TRACE_UNCONVERGED, t, (int32_t)(t_d / t_d2));
+    }
+#endif
+    set_tide_event(p, event, t, level, (t_d2<0) ? TIDE_HIGH : TIDE_LOW);
 
     /* Return the tide at the right of the bracket 
     (this is the tide at the start of the next interval, 
@@ -160,101 +596,262 @@ void clear_tide_events(tidal_event *events)
     }
 }
 
-float add_tide_event(tidal_station *station, time_t t, tidal_event *event, tidal_event *events, float last_tide)
+/* Add event to a day's list, keeping it sorted by time. Events too close 
+to one already listed, or beyond the end of a full list, are dropped. 
+Returns 1 if the event was added. */
+static int insert_tide_event(tidal_event *event, tidal_event *events)
 {
     int i;
-    /* Find the event near t */
-    last_tide = find_tide_event(station, event, t-HOUR_SECONDS/2, t+HOUR_SECONDS/2, last_tide);
     /* Find the first empty slot */
     for(i=0;i<MAX_TIDE_EVENTS;i++) if(events[i].type==TIDE_NONE) break;
     /* If the list is full, we can't add any more events */
-    if(i==MAX_TIDE_EVENTS) return last_tide;        
-    /* If the event is outside the range, we can't add it */
-    if(event->type==TIDE_NONE) return last_tide;
+    if(i==MAX_TIDE_EVENTS) {
+        TIDE_STAT(overflowed_events);
+        TIDE_TRACE(TIDE_TRACE_REJECTED, event->time, 1);
+        return 0;
+    }
     /* If the event is a duplicate (or a near duplicate), we don't add it */
-    for(int j=0;j<i;j++) if(fabs(difftime(events[j].time, event->time))<MIN_EVENT_GAP_SECONDS) return last_tide;
-    /* Add the event */
-    events[i] = *event;
-    /* Sort the list */
-    for(int j=0;j<i;j++) for(int k=j+1;k<i;k++) if(events[j].time>events[k].time) {
-        tidal_event tmp = events[j];
-        events[j] = events[k];
-        events[k] = tmp;
+    for(int j=0;j<i;j++) if(fabs(difftime(events[j].time, event->time))<MIN_EVENT_GAP_SECONDS) {
+        TIDE_STAT(duplicate_events);
+        TIDE_TRACE(TIDE_TRACE_REJECTED, event->time, 0);
+        return 0;
+    }
+    /* Add the event, keeping the list sorted by time */
+    while(i>0 && events[i-1].time>event->time) {
+        events[i] = events[i-1];
+        i--;
     }
+    events[i] = *event;
+    return 1;
+}
+
+float add_tide_event(prepared_station *p, time_t t, tidal_event *event, tidal_event *events, float last_tide)
+{
+    /* Find the event near t */
+    last_tide = find_tide_event(p, event, t-HOUR_SECONDS/2, t+HOUR_SECONDS/2, last_tide);
+    /* If the event is outside the range, we can't add it */
+    if(event->type!=TIDE_NONE) insert_tide_event(event, events);
     return last_tide;
 }
 
+/* Seconds after a time with the given rate (m/s) and acceleration (m/s^2)
+in which the rate cannot reach zero. The rate changes no faster than 
+p->accel_bound, and departs from its tangent line by at most 
+p->jerk_bound * h^2 / 2 after h seconds. */
+static float event_free_seconds(prepared_station *p, float rate, float accel)
+{
+    float r = fabsf(rate);
+    /* The tangent heads away from zero if rate and accel share a sign */
+    float a = (rate*accel>0) ? fabsf(accel) : -fabsf(accel);
+    float h = (p->accel_bound>0.0f) ? r / p->accel_bound : 0.0f;
+    if(p->jerk_bound>0.0f) {
+        float h_jerk = (a + sqrtf(accel * accel + 2.0f * p->jerk_bound * r)) / p->jerk_bound;
+        if(h_jerk>h) h = h_jerk;
+    }
+    return h;
+}
 
-/* Populate the tide table for a single day */
-void fill_day_tide_table(tidal_event *events, float *levels, tidal_station *station, time_t t0)    
+#define MAX_REFINE_STEPS 16
+/* Home in on the event between ta, where the rate is rate_a, and *t, where 
+the rate has the opposite sign and *level, *rate and *accel are known. 
+Takes Newton steps, falling back to bisection whenever a step would leave 
+the bracket, until the step is under EVENT_TOLERANCE_SECONDS. Leaves *t and 
+the rest at the last point evaluated. */
+static void refine_tide_event(prepared_station *p, tidal_event *event, time_t ta, float rate_a, time_t *t, float *level, float *rate, float *accel)
 {
+    uint8_t type = (rate_a>0) ? TIDE_HIGH : TIDE_LOW;
+    time_t tb = *t;
+    float dt;
+
+    for(int i=0; ; i++) {
+        dt = (*accel!=0.0f) ? *rate / *accel : 0.0f;
+        if(fabsf(dt)<EVENT_TOLERANCE_SECONDS || tb - ta<=EVENT_TOLERANCE_SECONDS) break;
+        if(i==MAX_REFINE_STEPS) {
+            TIDE_STAT(unconverged);
+            TIDE_TRACE(TIDE_TRACE_UNCONVERGED, *t, (int32_t)dt);
+            break;
+        }
+        /* t is too large to hold in a float, so the step is rounded to whole seconds first */
+        if(*accel!=0.0f && fabsf(dt)<tb - ta && *t - (time_t)dt>ta && *t - (time_t)dt<tb)
+            *t -= (time_t)dt;
+        else
+            *t = ta + (tb - ta) / 2;
+        predict_tide_derivatives(*t, p, level, rate, accel);
+        TIDE_STAT(newton_steps);
+        if(*rate*rate_a>0) ta = *t; else tb = *t;
+    }
+    set_tide_event(p, event, *t, *level, type);
+}
+
+#define MAX_SEARCH_STEPS 512
+#define MAX_NEWTON_JUMP (MIN_EVENT_GAP_SECONDS / 2)
+#define STEP_STRETCH 1.6f /* steps are this much longer than the bounds allow, then checked */
+/* Find every HW/LW event in [t0, t1) and list them, sorted, in events.
+Returns the number listed. 
+Rather than bracketing hour by hour, this walks forward using bounds on how 
+fast the rate can change (event_free_seconds) to skip stretches that can't 
+hold a turning point. Each step goes a little further than the bounds from 
+its start allow, and is kept only if the bounds from its end cover the rest; 
+otherwise the walk steps back. Steps are capped at a quarter of the dominant 
+period, so the walk lands near each peak in the rate, and short of where 
+Newton's method puts the next event. Once that is within MAX_NEWTON_JUMP the 
+walk jumps just past it, and refine_tide_event homes in on the sign change.
+A sign change over a longer step is only refined if the rate is certain to 
+be monotonic there. So small extrema of mixed tides are never stepped over, 
+unless they are within MAX_NEWTON_JUMP of each other, when they'd be dropped 
+as duplicates anyway. */
+int find_tide_events(prepared_station *p, time_t t0, time_t t1, tidal_event *events)
+{
+    float level, rate, accel, h, reach;
+    float last_rate = 0.0f, last_accel = 0.0f, last_h = 0.0f;
+    time_t t = t0, last_t = t0, step;
     tidal_event event;
-    /* Clear all events */
+    int n = 0, checked = 1;
+
     clear_tide_events(events);
-    float last_tide = 0.0;
-    
-    /* Get the level, and any event in that hour */
-    for(int i=0; i<24; i++) {
-        levels[i] = predict_tide(t0, station, 0);
-        last_tide = add_tide_event(station, t0, &event, events, last_tide);
-        t0 += HOUR_SECONDS;
+    for(int i=0; i<MAX_SEARCH_STEPS; i++) {
+        predict_tide_derivatives(t, p, &level, &rate, &accel);
+        TIDE_STAT(search_steps);
+        event.type = TIDE_NONE;
+        if(!checked) {
+            /* The step needs the bounds from this end too: to cover it, or if 
+            it holds an event, to show that the rate is monotonic */
+            if(last_rate*rate<0) 
+                checked = t - last_t<=MAX_NEWTON_JUMP || (last_accel*accel>0 && fabsf(last_accel) + fabsf(accel)>=p->jerk_bound * (t - last_t));
+            else 
+                checked = last_h + event_free_seconds(p, rate, -accel)>=t - last_t;
+            if(!checked) {
+                t = last_t + ((last_h>EVENT_TOLERANCE_SECONDS) ? (time_t)last_h : EVENT_TOLERANCE_SECONDS);
+                checked = 1;
+                continue;
+            }
+        }
+        if(last_rate*rate<0) 
+            refine_tide_event(p, &event, last_t, last_rate, &t, &level, &rate, &accel);
+        h = event_free_seconds(p, rate, accel);
+        /* Close enough; the tangent's root is under a second ahead */
+        if(event.type==TIDE_NONE && h<EVENT_TOLERANCE_SECONDS && rate*accel<=0 && accel!=0.0f)
+            set_tide_event(p, &event, t, level, (accel<0) ? TIDE_HIGH : TIDE_LOW);
+        if(event.type!=TIDE_NONE) {
+            if(event.time>=t0 && event.time<t1) n += insert_tide_event(&event, events);
+            /* The next root of the rate is at least 2*|accel|/jerk_bound beyond this one */
+            h = (p->jerk_bound>0.0f) ? 2.0f * fabsf(accel) / p->jerk_bound - EVENT_TOLERANCE_SECONDS : 0.0f;
+            if(h<2*EVENT_TOLERANCE_SECONDS) h = 2*EVENT_TOLERANCE_SECONDS;
+            rate = 0.0f;
+        }
+        if(t>=t1) break;
+
+        reach = STEP_STRETCH * h;
+        if(rate*accel<0) {
+            float newton = -rate / accel;
+            if(newton<=MAX_NEWTON_JUMP) 
+                reach = newton + EVENT_TOLERANCE_SECONDS; /* just past the tangent's root */
+            else if(reach>0.85f * newton) 
+                reach = 0.85f * newton;
+        }
+        if(reach<h) reach = h;
+        step = (reach<p->quarter_period) ? (time_t)reach : p->quarter_period;
+        if(step<EVENT_TOLERANCE_SECONDS) step = EVENT_TOLERANCE_SECONDS;
+        /* The bounds only hold until the constants change */
+        if(p->end>t && step>p->end - t) step = p->end - t;
+        checked = step<=h;
+        last_t = t;
+        last_rate = rate;
+        last_accel = accel;
+        last_h = h;
+        t = (step<t1 - t) ? t + step : t1;
     }
+    return n;
+}
+
+/* Fill in a single day of the tide table, starting at the iterator's
+current time: TIDE_TABLE_DAY_TIMES levels (m) and rates (m/s), and the day's 
+events. The iterator must step TIDE_TABLE_STEP_SECONDS, and is left at the 
+start of the next day. */
+void fill_day_tide_table(tidal_event *events, float *levels, float *rates, tide_iterator *it)    
+{
+    time_t t0 = it->t;
+    assert(it->step==TIDE_TABLE_STEP_SECONDS);
+    for(int i=0; i<TIDE_TABLE_DAY_TIMES; i++) levels[i] = tide_iterator_next_rate(it, &rates[i]);
+    find_tide_events(it->prepared, t0, t0 + DAY_SECONDS, events);
+}
+
+/* Find where t falls in the table: the slot of its day, the sample i before it,
+and how far it is towards the next sample, from 0 to 1. 
+Returns 0 if t is outside the table. */
+static int find_tide_table_step(tide_table *table, time_t t, int *slot, int *i, float *s)
+{
+    time_t start = tide_table_start(table);
+    int32_t seconds;
+    if(t<start || t>=start+(time_t)TIDE_TABLE_DAYS*DAY_SECONDS) return 0;
+    *slot = tide_table_slot(table, (t-start) / DAY_SECONDS);
+    seconds = (t-start) % DAY_SECONDS;
+    *i = seconds / TIDE_TABLE_STEP_SECONDS;
+    *s = (float)(seconds - *i * TIDE_TABLE_STEP_SECONDS) / TIDE_TABLE_STEP_SECONDS;
+    return 1;
+}
+
+/* Coefficients of the cubic Hermite spline between samples i and i+1 of slot,
+as level = c[0] + c[1]*s + c[2]*s^2 + c[3]*s^3 (m) for s from 0 to 1 */
+static void tide_table_spline(tide_table *table, int slot, int i, float *c)
+{
+    float y0 = table->levels[slot][i] * 0.001f, y1 = table->levels[slot][i+1] * 0.001f;
+    /* Slopes in m per step */
+    float m0 = table->rates[slot][i] * (0.001f * TIDE_TABLE_STEP_HOURS);
+    float m1 = table->rates[slot][i+1] * (0.001f * TIDE_TABLE_STEP_HOURS);
+    c[0] = y0;
+    c[1] = m0;
+    c[2] = 3.0f * (y1 - y0) - 2.0f * m0 - m1;
+    c[3] = 2.0f * (y0 - y1) + m0 + m1;
 }
 
 /* Interpolate the tide table to get the tide at a given time */
 float interpolate_tide_level(time_t t, tide_table *table)
 {
-    /* Check if t is in range */
-    if(t<table->base_time-DAY_SECONDS || t>=table->base_time+DAY_SECONDS*2) return nanf("");
-    /* Get the index into the table */
-    int i = (t-table->base_time+DAY_SECONDS) / HOUR_SECONDS;
-    int j = i + 1;
-    if(j>=TIDE_TABLE_TIMES) j = i;
-    /* Interpolate */
-    float tide = table->levels[i] + (table->levels[j]-table->levels[i]) * (t-table->base_time+DAY_SECONDS-i*HOUR_SECONDS) / HOUR_SECONDS;
-    return tide;
+    int slot, i;
+    float s, c[4];
+    if(!find_tide_table_step(table, t, &slot, &i, &s)) return nanf("");
+    tide_table_spline(table, slot, i, c);
+    return c[0] + s * (c[1] + s * (c[2] + s * c[3]));
 }
 
-/* Interpolate the tide table to get the tide rate at a given time, in m/hr */
+/* Interpolate the tide table to get the tide rate at a given time, in m/hr. 
+This is the derivative of the curve interpolate_tide_level follows. */
 float interpolate_tide_rate(time_t t, tide_table *table)
 {
+    int slot, i;
+    float s, c[4];
+    if(!find_tide_table_step(table, t, &slot, &i, &s)) return nanf("");
+    tide_table_spline(table, slot, i, c);
+    return (c[1] + s * (2.0f * c[2] + s * 3.0f * c[3])) / TIDE_TABLE_STEP_HOURS;
+}
+
+/* Find the tide events just before and just after t. 
+Either has type TIDE_NONE if there is no such event in the table. */
+void get_tide_events_near(time_t t, tide_table *table, tidal_event *prev, tidal_event *next)
+{
+    time_t start = tide_table_start(table);
+    prev->type = TIDE_NONE;
+    next->type = TIDE_NONE;
     /* Check if t is in range */
-    if(t<table->base_time-DAY_SECONDS || t>=table->base_time+DAY_SECONDS*2) return nanf("");
-    /* Get the index into the table */
-    int i = (t-table->base_time+DAY_SECONDS) / HOUR_SECONDS;
-    /* Interpolate using a central difference */
-    if(i==TIDE_TABLE_TIMES-1) 
-        return (table->levels[i]-table->levels[i-1]);
-    else if(i==0)
-        return (table->levels[i+1]-table->levels[i]);
-    else 
-        return ((table->levels[i+1]-table->levels[i]) + (table->levels[i]-table->levels[i-1])) / 2.0;
-}
-
-/* Return the tide event just before and just after t 
-prev and next will be set to NULL
-*/
-void get_tide_events_near(time_t t, tide_table *table, tidal_event **prev, tidal_event **next)
-{
-    tidal_event *last_good = NULL;
-    *prev = NULL;
-    *next = NULL;
-    /* Check if t is in range */
-    if(t<table->base_time-DAY_SECONDS || t>=table->base_time+DAY_SECONDS*2-HOUR_SECONDS) return;
+    if(t<start || t>=start+(time_t)TIDE_TABLE_DAYS*DAY_SECONDS-HOUR_SECONDS) return;
     
-    for(int i=0;i<3;i++)
+    for(int i=0;i<TIDE_TABLE_DAYS;i++)
     {
         for(int j=0;j<MAX_TIDE_EVENTS;j++)
         {
-            if(table->events[i][j].time>t)
+            tidal_event event = tide_table_event(table, i, j);
+            if(event.type==TIDE_NONE) break;
+            if(event.time>t)
             {
-                *next = &(table->events[i][j]);
-                if(last_good) *prev = last_good;                
+                *next = event;
                 return;
             }
-            if(table->events[i][j].type!=TIDE_NONE) last_good = &table->events[i][j];
+            *prev = event;
         }
     }
+    /* Nothing after t, so the last event isn't known to be the one before it */
+    prev->type = TIDE_NONE;
 }   
 
 /* Set the min/max tides for this day, based on the events that occurred. */
@@ -270,54 +867,83 @@ void update_range(tidal_event *events, float *hw, float *lw)
     }
 }
 
+/* Rebuild days [first, first+n) of the table, which must be contiguous */
+static void fill_tide_table_days(tide_table *table, prepared_station *prepared, int first, int n)
+{
+    tide_iterator it;
+    float levels[TIDE_TABLE_DAY_TIMES + 1], rates[TIDE_TABLE_DAY_TIMES + 1];
+    tidal_event events[MAX_TIDE_EVENTS];
+    int slot = -1, last_slot;
+    /* One iterator runs over all of the days */
+    tide_iterator_init(&it, prepared, tide_table_start(table) + (time_t)first * DAY_SECONDS, TIDE_TABLE_STEP_SECONDS);
+    for(int day=first; day<first+n; day++) {
+        time_t day_start = tide_table_start(table) + (time_t)day * DAY_SECONDS;
+        last_slot = slot;
+        slot = tide_table_slot(table, day);
+        fill_day_tide_table(events, levels, rates, &it);
+        /* Pack to millimetres and minutes */
+        for(int i=0; i<TIDE_TABLE_DAY_TIMES; i++) {
+            table->levels[slot][i] = (int16_t)lroundf(levels[i] * 1000.0f);
+            table->rates[slot][i] = (int16_t)lroundf(rates[i] * (1000.0f * HOUR_SECONDS));
+        }
+        /* Each day ends with the first sample of the next */
+        if(last_slot>=0) {
+            table->levels[last_slot][TIDE_TABLE_DAY_TIMES] = table->levels[slot][0];
+            table->rates[last_slot][TIDE_TABLE_DAY_TIMES] = table->rates[slot][0];
+        }
+        for(int i=0; i<MAX_TIDE_EVENTS; i++) {
+            packed_tide_event *packed = &table->events[slot][i];
+            packed->type = events[i].type;
+            packed->minute = (events[i].type==TIDE_NONE) ? 0 : (uint16_t)((events[i].time - day_start + MINUTE_SECONDS/2) / MINUTE_SECONDS);
+            packed->level = (int16_t)lroundf(events[i].level * 100.0f);
+            packed->neap_spring = (uint8_t)lroundf(events[i].neap_spring * TIDE_NEAP_SPRING_MAX);
+        }
+    }
+    levels[0] = tide_iterator_next_rate(&it, &rates[0]);
+    table->levels[slot][TIDE_TABLE_DAY_TIMES] = (int16_t)lroundf(levels[0] * 1000.0f);
+    table->rates[slot][TIDE_TABLE_DAY_TIMES] = (int16_t)lroundf(rates[0] * (1000.0f * HOUR_SECONDS));
+}
+
 /* Populate the tide table for a given station and day. 
-Fills in tides for the previous day, the current day, and the next day. 
-A tide table has 72 entries, 24 for the previous day, 24 for the current day, and 24 for the next day.
-It also has three lists of tidal events, one for each day. */
-void populate_tide_table(tide_table *table, tidal_station *station, time_t base_time, int tz_hours, int tz_mins)
+Fills in tides for TIDE_TABLE_DAYS_BEFORE days before the day, the day itself,
+and TIDE_TABLE_DAYS_AFTER days after: the level (mm) and rate (mm/h) every 
+TIDE_TABLE_STEP_HOURS, for Hermite interpolation, and a list of tidal events 
+for each. If the table already holds some of those days for the same station, 
+it is moved along its ring and only the rest are computed. */
+void populate_tide_table(tide_table *table, prepared_station *prepared, tidal_station *station, time_t base_time, int tz_hours, int tz_mins)
 {
-    
     /* Get midnight UTC on the base day */
-    struct tm *tm = gmtime(&base_time);
-    tm->tm_hour = 0;
-    tm->tm_min = 0;
-    tm->tm_sec = 0;
-    time_t midnight = mktime(tm);
+    time_t midnight = day_start(base_time);
+    int32_t shift;
     
     /* adjust for time zone */
     midnight += (tz_hours * 60 * 60) + (tz_mins * 60);
     /* Already populated? */
     if(table->base_time==midnight && table->station==station) return;    
-    /* Have we moved one day forwards? If so, copy what we can from the previous day */
-    if(table->station==station && table->base_time==midnight-DAY_SECONDS) 
+    /* Switch the cached constants over if the station has changed */
+    prepare_station(prepared, station, midnight);
+    /* Days moved since the table was built; days still in range are kept */
+    shift = (table->base_time - midnight) % DAY_SECONDS==0 ? (int32_t)((midnight - table->base_time) / DAY_SECONDS) : TIDE_TABLE_DAYS;
+    if(table->station==station && shift>-TIDE_TABLE_DAYS && shift<TIDE_TABLE_DAYS) 
     {
-        /* Shift the table back one day */
-        for(int i=0; i<72; i++) table->levels[i] = table->levels[i+24];
-        for(int i=0; i<3; i++) for(int j=0; j<MAX_TIDE_EVENTS; j++) table->events[i][j] = table->events[i][j+1];
-        fill_day_tide_table(table->events[2], table->levels+48, station, midnight+DAY_SECONDS);  
         table->base_time = midnight;      
+        table->head = (table->head + shift + TIDE_TABLE_DAYS) % TIDE_TABLE_DAYS;
+        /* Moving forwards, the new days are at the end; moving backwards, at the start */
+        if(shift>0)
+            fill_tide_table_days(table, prepared, TIDE_TABLE_DAYS - shift, shift);
+        else
+            fill_tide_table_days(table, prepared, 0, -shift);
+        TIDE_STAT(incremental_rebuilds);
+        TIDE_TRACE(TIDE_TRACE_TABLE_SHIFT, midnight, shift);
         return;        
     }
-    /* Have we moved one day backwards? If so, copy what we can from the next day */
-    else if(table->station==station && table->base_time==midnight+DAY_SECONDS) 
-    {
-        /* Shift the table forward one day */
-        for(int i=71; i>=0; i--) table->levels[i+24] = table->levels[i];
-        for(int i=2; i>=0; i--) for(int j=MAX_TIDE_EVENTS-1; j>=0; j--) table->events[i][j+1] = table->events[i][j];
-        fill_day_tide_table(table->events[0], table->levels, station, midnight-DAY_SECONDS);                 
-        table->base_time = midnight;       
-        return;
-    }   
 
-    /* Populate the levels table */
-    time_t t0 = midnight - DAY_SECONDS;
-    for(int i=0;i<3;i++)
-    {
-        fill_day_tide_table(table->events[i], table->levels+i*24, station, t0);         
-        t0 += DAY_SECONDS; 
-    }
     table->base_time = midnight;
     table->station = station;
+    table->head = 0;
+    fill_tide_table_days(table, prepared, 0, TIDE_TABLE_DAYS);
+    TIDE_STAT(full_rebuilds);
+    TIDE_TRACE(TIDE_TRACE_TABLE_FULL, midnight, 0);
 }    
 
 
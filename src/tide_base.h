@@ -11,6 +11,8 @@
 #define MINUTE_SECONDS 60
 #define YEAR_SECONDS 31536000
 #define MIN_EVENT_GAP_SECONDS 3600
+#define TIDE_QUARTER_PERIOD 11180 /* of M2; the event search's default longest step */
+#define EVENT_TOLERANCE_SECONDS 1 /* event times are found to within this */
 
 #define M_PI 3.14159265358979323846
 
@@ -19,14 +21,28 @@
 #define MAX_TIDE_PHASE 6.283185307179586f
 #define UNQUANTIZE_AMP(X) ((X/65535.0f)*MAX_TIDE_AMP)
 #define UNQUANTIZE_PHASE(X) ((X/65535.0f)*MAX_TIDE_PHASE)
+#define MAX_NODE_FACTOR 4.0f
+#define UNQUANTIZE_NODE_FACTOR(X) ((X/65535.0f)*MAX_NODE_FACTOR)
 
 // meters
 #define MAX_TIDE_ERROR 0.1f 
 // per day
 #define MAX_TIDE_EVENTS 6
+/* Largest number of constituents any station may carry */
+#define MAX_TIDE_CONSTITUENTS 64
+/* Largest number of coefficients in a Chebyshev segment */
+#define MAX_CHEBYSHEV_ORDER 32
+
+/* Station encodings, for tidal_harmonic.type */
+#define TIDE_ENCODING_HARMONIC 0 /* per-year constituents */
+#define TIDE_ENCODING_CHEBYSHEV 1 /* piecewise polynomial curve, see tide_chebyshev.h */
+#define TIDE_ENCODING_NODAL 2 /* one set of constituents, corrected each year by a shared tide_nodal_table */
 
 
 struct tidal_harmonic;
+struct tide_nodal_table;
+struct tide_almanac;
+struct tide_chebyshev;
 
 /* Wrapper for a tidal station */
 typedef struct tidal_station
@@ -47,11 +63,29 @@ typedef struct tidal_offset
 } tidal_offset;
 
 
+/* The yearly corrections for every constituent used by TIDE_ENCODING_NODAL
+stations. These depend only on the year, not on the station, so one table
+is shared by all of them: a station's amplitude in a year is its base 
+amplitude times the node factor, and its phase at the start of the year is 
+the equilibrium argument less its epoch. Constituents with an astro id 
+have their corrections computed for any year (see tide_astro.h); the others 
+use the yearly rows, clipped to the years the table covers. */
+typedef struct tide_nodal_table {
+        int base_year;
+        int n_years;
+        uint8_t n_constituents;
+        const float *speeds; /* radians/s */
+        const uint8_t *astro; /* tide_astro id of each constituent, or TIDE_ASTRO_NONE; NULL for none */
+        /* [n_years, n_constituents] flattened, like the amplitudes of a TIDE_ENCODING_HARMONIC station */
+        const uint16_t *node_factors; /* quantized to MAX_NODE_FACTOR */
+        const uint16_t *equilibria; /* equilibrium argument at the start of the year, quantized as phases */
+} tide_nodal_table;
+
 typedef struct tidal_harmonic {
-        uint8_t type;
+        uint8_t type; /* TIDE_ENCODING_HARMONIC, TIDE_ENCODING_CHEBYSHEV or TIDE_ENCODING_NODAL */
         char *name;
         int base_year;
-        int n_years;
+        int n_years; /* 0 if every year can be computed (TIDE_ENCODING_NODAL only) */
         float lat;
         float lon; 
         float neaps_range;
@@ -61,11 +95,26 @@ typedef struct tidal_harmonic {
         /* Amplitudes and phases are per year, stored as a [n_years, n_constituents] flattened array */
         uint16_t *amps; // amplitude for year base_year+i = amps[n_constituents*i]
         uint16_t *phases;
+        /* For TIDE_ENCODING_NODAL, amps and phases hold a single year of base amplitudes 
+        and epochs (including the time zone), speeds is unused, and constituent i is 
+        constituent constituents[i] of the nodal table */
+        const uint8_t *constituents;
+        const struct tide_nodal_table *nodal;
         uint8_t n_constituents;
         float mean_error;        
+        const struct tide_almanac *almanac; /* precomputed events, or NULL */
+        const struct tide_chebyshev *chebyshev; /* the curve, for TIDE_ENCODING_CHEBYSHEV (speeds, amps and phases are unused) */
+#ifdef TIDE_DEBUG
+        time_t *test_times; /* known levels, to check predictions against */
+        float *test_tides;
+        uint16_t n_tests;
+#endif
 } tidal_harmonic;
 
-tidal_station  *tidal_stations;
+extern tidal_station *tidal_stations;
+/* The same stations sorted by name, ignoring case (as insensitive_compare) */
+extern tidal_station *const tidal_station_index[];
+extern const uint32_t n_tidal_stations;
 
 /* Tidal event enumeration */
 #define TIDE_NONE 0 
@@ -81,27 +130,208 @@ typedef struct tidal_event
     float neap_spring; /* 0.0 -> 1.0 */
 } tidal_event;
 
-#define TIDE_TABLE_TIMES 72 
+/* Days the tide table keeps before and after the day it is built for.
+Override at compile time, e.g. DEFS=-DTIDE_TABLE_DAYS_AFTER=6 to look a week ahead. */
+#ifndef TIDE_TABLE_DAYS_BEFORE
+#define TIDE_TABLE_DAYS_BEFORE 1
+#endif
+#ifndef TIDE_TABLE_DAYS_AFTER
+#define TIDE_TABLE_DAYS_AFTER 1
+#endif
+#define TIDE_TABLE_DAYS (TIDE_TABLE_DAYS_BEFORE + 1 + TIDE_TABLE_DAYS_AFTER)
+/* Hours between the table's samples; must divide 24. Each sample holds the 
+level and its slope, and is interpolated with a cubic Hermite spline, 
+so 2 hourly samples are more accurate than the old hourly linear table. */
+#ifndef TIDE_TABLE_STEP_HOURS
+#define TIDE_TABLE_STEP_HOURS 2
+#endif
+#if 24 % TIDE_TABLE_STEP_HOURS != 0
+#error "TIDE_TABLE_STEP_HOURS must divide 24"
+#endif
+#define TIDE_TABLE_STEP_SECONDS (TIDE_TABLE_STEP_HOURS * HOUR_SECONDS)
+#define TIDE_TABLE_DAY_TIMES (24 / TIDE_TABLE_STEP_HOURS)
+#define TIDE_TABLE_TIMES (TIDE_TABLE_DAYS * TIDE_TABLE_DAY_TIMES)
+
+/* A tidal event packed for the tide table */
+typedef struct packed_tide_event {
+    uint16_t minute; /* minutes from midnight at the start of its day of the table */
+    int16_t level; /* cm */
+    uint8_t type; /* TIDE_NONE, TIDE_HIGH, TIDE_LOW */
+    uint8_t neap_spring; /* 0 -> TIDE_NEAP_SPRING_MAX */
+} packed_tide_event;
+
+#define TIDE_NEAP_SPRING_MAX 127
 
-/* Tide prediction table for 24 hours before and 48 hours after midnight on a given day */
+/* Tide prediction table for the days around midnight on a given day.
+The days are held in a ring: moving the table by a day only rebuilds the 
+day that comes into range, and moves head. Each day holds its samples from
+midnight to the following midnight inclusive, so it can be interpolated 
+without the next. Levels are kept in millimetres, slopes in mm/h and events 
+to the minute, to save RAM. Read it through the accessors below, where day 0 
+is the first day of the table (TIDE_TABLE_DAYS_BEFORE days before base_time) 
+and sample 0 is midnight at its start. */
 typedef struct tide_table {
     time_t base_time; /* midnight on the day in question */
     tidal_station *station; /* tidal station */
-    float levels[TIDE_TABLE_TIMES]; /* hourly tide levels */
-    tidal_event events[3][MAX_TIDE_EVENTS]; /* HW/LW events for yesterday, today, tomorrow */    
+    uint8_t head; /* ring slot holding day 0 */
+    int16_t levels[TIDE_TABLE_DAYS][TIDE_TABLE_DAY_TIMES + 1]; /* tide levels in mm, by slot */
+    int16_t rates[TIDE_TABLE_DAYS][TIDE_TABLE_DAY_TIMES + 1]; /* their slopes in mm/h, by slot */
+    packed_tide_event events[TIDE_TABLE_DAYS][MAX_TIDE_EVENTS]; /* HW/LW events, by slot */
 } tide_table;
 
-float find_tide_event_near(tidal_station *station, tidal_event *event, time_t t0, time_t t1, float ntide);
-void populate_tide_table(tide_table *table, tidal_station *station, time_t base_time, int tz_hours, int tz_mins);
-float add_tide_event(tidal_station *station, time_t t, tidal_event *event, tidal_event *events, float last_tide);
-void fill_day_tide_table(tidal_event *events, float *levels, tidal_station *station, time_t t0);
-float predict_tide(time_t t, tidal_station *h_station, int d);
-void test_tides(tidal_station *station, time_t *times, float *levels);
-void get_tide_events_near(time_t t, tide_table *table, tidal_event **prev, tidal_event **next);
+/* Time of the first entry in the table */
+static inline time_t tide_table_start(const tide_table *table)
+{
+    return table->base_time - (time_t)TIDE_TABLE_DAYS_BEFORE * DAY_SECONDS;
+}
+
+/* Ring slot holding day of the table */
+static inline int tide_table_slot(const tide_table *table, int day)
+{
+    return (table->head + day) % TIDE_TABLE_DAYS;
+}
+
+/* Level (m) at sample i of the table, from 0 to TIDE_TABLE_TIMES-1 */
+static inline float tide_table_level(const tide_table *table, int i)
+{
+    return table->levels[tide_table_slot(table, i / TIDE_TABLE_DAY_TIMES)][i % TIDE_TABLE_DAY_TIMES] * 0.001f;
+}
+
+/* Rate of change (m/h) at sample i of the table */
+static inline float tide_table_rate(const tide_table *table, int i)
+{
+    return table->rates[tide_table_slot(table, i / TIDE_TABLE_DAY_TIMES)][i % TIDE_TABLE_DAY_TIMES] * 0.001f;
+}
+
+/* Event i (0 to MAX_TIDE_EVENTS-1) of day of the table. The events of each 
+day are sorted by time, followed by any unused entries with type TIDE_NONE. */
+static inline tidal_event tide_table_event(const tide_table *table, int day, int i)
+{
+    const packed_tide_event *packed = &table->events[tide_table_slot(table, day)][i];
+    tidal_event event;
+    event.type = packed->type;
+    event.time = (packed->type==TIDE_NONE) ? 0 : tide_table_start(table) + (time_t)day * DAY_SECONDS + packed->minute * MINUTE_SECONDS;
+    event.level = packed->level * 0.01f;
+    event.neap_spring = packed->neap_spring * (1.0f / TIDE_NEAP_SPRING_MAX);
+    return event;
+}
+
+/* Largest and smallest representable times, for open-ended ranges */
+#define TIDE_TIME_MAX ((time_t)(~(uint64_t)0 >> (65 - sizeof(time_t)*8)))
+#define TIDE_TIME_MIN (-TIDE_TIME_MAX - 1)
+
+/* Integer-only constants for the fixed-point predictor (tide_fixed.c), 
+for processors without an FPU. Angles are 32 bit binary angles 
+(2^32 is one turn), so they wrap around for free. Built by prepare_fixed_station
+for the same years as prepare_station. */
+#define TIDE_FIXED_RATE_SHIFT 4 /* rate and acceleration amplitudes are in 1/16 mm/h and mm/h^2 */
+
+typedef struct fixed_station {
+    tidal_station *station;
+    time_t start, end; /* times these constants are used for */
+    time_t epoch; /* time the phases are relative to */
+    int32_t offset_mm; /* datum offset, including level offset and scale */
+    int32_t level_k; /* stored amplitude to mm, including level scale, Q16 */
+    uint8_t n_constituents;
+    uint16_t amps[MAX_TIDE_CONSTITUENTS]; /* quantized amplitudes for the year */
+    uint32_t phases[MAX_TIDE_CONSTITUENTS]; /* binary angle at epoch */
+    int64_t speeds[MAX_TIDE_CONSTITUENTS]; /* binary angle per second, Q16 */
+    uint16_t rate_amps[MAX_TIDE_CONSTITUENTS]; /* amplitude of the rate, mm/h << TIDE_FIXED_RATE_SHIFT */
+    uint16_t accel_amps[MAX_TIDE_CONSTITUENTS]; /* amplitude of the acceleration, mm/h^2 << TIDE_FIXED_RATE_SHIFT */
+} fixed_station;
+
+int32_t station_year(tidal_station *station, time_t t, time_t *start, time_t *end);
+void harmonic_constituent(tidal_harmonic *h, int32_t year, int i, float *speed, float *amp, float *phase);
+void prepare_fixed_station(fixed_station *f, tidal_station *station, time_t t);
+void predict_tide_fixed(time_t t, fixed_station *f, int32_t *level_mm, int32_t *rate_mm_h, int32_t *accel_mm_h2);
+
+/* A station's constants for a single year, dequantized and with the 
+station offsets folded in. Built by prepare_station, and rebuilt whenever 
+a prediction falls outside [start, end) or the station changes. 
+Only one set of constants is kept, for the encoding and the predictor in 
+use, so it is no bigger than it needs to be where it is embedded (tide_face). */
+typedef struct prepared_station {
+    tidal_station *station;
+    uint32_t evaluations; /* calls to predict_tide and predict_tide_derivatives, for benchmarking */
+    uint8_t type; /* encoding of the station's harmonic */
+    int32_t year; /* calendar year of the constants */
+    time_t start, end; /* times these constants are used for */
+    time_t epoch; /* time the phases are relative to, including the station time offset */
+    float offset; /* datum offset, including level offset and scale */
+    uint8_t n_constituents;
+    /* For the event search: bounds on |acceleration| and its rate of change 
+    over [start, end), and a quarter of the dominant constituent's period */
+    float accel_bound; /* m/s^2 */
+    float jerk_bound; /* m/s^3 */
+    time_t quarter_period;
+    union {
+#ifdef TIDE_FIXED
+        fixed_station fixed; /* harmonic and nodal stations are predicted from here instead */
+#else
+        struct {
+            float amps[MAX_TIDE_CONSTITUENTS]; /* m, including level scale */
+            float phases[MAX_TIDE_CONSTITUENTS]; /* radians at epoch */
+            float speeds[MAX_TIDE_CONSTITUENTS]; /* radians/s */
+        };
+#endif
+        /* For Chebyshev stations, the segment holding [start, end), centred on epoch */
+        struct {
+            uint8_t order;
+            float half_width; /* seconds from epoch to either end of the segment */
+            float coeffs[3][MAX_CHEBYSHEV_ORDER]; /* level, rate and acceleration series, in m/s^d */
+        };
+    };
+} prepared_station;
+
+void prepare_station(prepared_station *p, tidal_station *station, time_t t);
+
+/* Streaming predictor for evenly spaced samples.
+Each constituent is held as a unit phasor which is rotated by a fixed
+amount every step, so no transcendental functions are needed after init. */
+#define TIDE_ITERATOR_RENORMALISE 16 /* steps between phasor renormalisations */
+
+typedef struct tide_iterator {
+    prepared_station *prepared;
+    time_t t; /* time of the next sample */
+    time_t step; /* seconds between samples */
+    time_t start, end; /* times the phasors' constants are valid for */
+    uint8_t n_constituents;
+    uint8_t steps; /* steps since the last renormalisation */
+    float base; /* datum offset, added to every sample */
+    float amp[MAX_TIDE_CONSTITUENTS];
+    float rate_amp[MAX_TIDE_CONSTITUENTS]; /* -amp * speed */
+    float re[MAX_TIDE_CONSTITUENTS], im[MAX_TIDE_CONSTITUENTS]; /* current phase */
+    float rot_re[MAX_TIDE_CONSTITUENTS], rot_im[MAX_TIDE_CONSTITUENTS]; /* rotation per step */
+} tide_iterator;
+
+void tide_iterator_init(tide_iterator *it, prepared_station *p, time_t t0, time_t step);
+float tide_iterator_next(tide_iterator *it);
+float tide_iterator_next_rate(tide_iterator *it, float *rate);
+
+float find_tide_event(prepared_station *p, tidal_event *event, time_t t0, time_t t1, float ntide);
+int find_tide_events(prepared_station *p, time_t t0, time_t t1, tidal_event *events);
+void populate_tide_table(tide_table *table, prepared_station *prepared, tidal_station *station, time_t base_time, int tz_hours, int tz_mins);
+float add_tide_event(prepared_station *p, time_t t, tidal_event *event, tidal_event *events, float last_tide);
+void fill_day_tide_table(tidal_event *events, float *levels, float *rates, tide_iterator *it);
+float predict_tide(time_t t, prepared_station *p, int d);
+void predict_tide_derivatives(time_t t, prepared_station *p, float *level, float *rate, float *accel);
+/* Times per block in batch predictions */
+#define TIDE_BATCH_BLOCK 32
+void predict_tide_batch(prepared_station *p, const time_t *times, int n, float *levels, float *rates, float *accels);
+void predict_tide_steps(prepared_station *p, time_t t0, time_t step, int n, float *levels, float *rates, float *accels);
+int test_tides(tidal_harmonic *harmonic);
+void get_tide_events_near(time_t t, tide_table *table, tidal_event *prev, tidal_event *next);
 float interpolate_tide_level(time_t t, tide_table *table);
 float interpolate_tide_rate(time_t t, tide_table *table);
+#define TIME_STRING_LENGTH 32
+char *format_time(time_t t, char *buf);
 time_t make_time(uint32_t year, uint32_t month, uint32_t day, uint32_t hour, uint32_t minute, uint32_t second);
 tidal_station *find_tidal_station(char *name);
+uint32_t find_tidal_stations(const char *prefix, uint32_t *first);
+tidal_station *next_tidal_station(tidal_station *station);
+int insenstive_is_prefix(char *s1, char *s2);
+int insensitive_compare(const char *s1, const char *s2, int prefix);
+uint32_t find_name_range(const char *prefix, const char *(*name)(const void *names, uint32_t i), const void *names, uint32_t n, uint32_t *first);
 void update_range(tidal_event *events, float *hw, float *lw);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include "tide_base.h"
+#include "tide_kernel.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+/* Benchmarks for the prediction core. Every run uses the same
+pseudo-random times over every station in tide_data.c, and the results
+are printed as JSON so they can be kept and compared between releases:
+    tide_bench > before.json
+    ...
+    tide_bench --compare before.json after.json [threshold %]
+All the figures are costs, so smaller is better. */
+
+#define BENCH_SEED 0x7469646575ull
+#define BENCH_PREDICTIONS 20000 /* per station, for each derivative */
+#define BENCH_TABLES 200 /* per station, for each kind of rebuild */
+#define BENCH_LOOKUPS 20000 /* per station */
+#define MAX_RESULTS 32
+
+typedef struct bench_result {
+    char name[48];
+    double value;
+} bench_result;
+
+/* Seconds on a monotonic clock */
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* xorshift64*, so the workload is the same on every machine */
+static uint64_t next_random(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1Dull;
+}
+
+/* A random time in the years covered by station's harmonic */
+static time_t random_time(tidal_station *station, uint64_t *state)
+{
+    tidal_harmonic *h = station->harmonic;
+    time_t start = make_time(h->base_year, 1, 1, 0, 0, 0);
+    time_t end = make_time(h->base_year + h->n_years, 1, 1, 0, 0, 0);
+    return start + (time_t)(next_random(state) % (uint64_t)(end - start));
+}
+
+static int count_stations(void)
+{
+    int n = 0;
+    for(tidal_station *station = tidal_stations; station!=NULL; station = station->previous) n++;
+    return n;
+}
+
+/* ns per predict_tide call, for derivative d */
+static double bench_predict(int d)
+{
+    uint64_t state = BENCH_SEED;
+    volatile float sink = 0.0f;
+    double elapsed = 0.0;
+    int n = 0;
+    time_t times[BENCH_PREDICTIONS];
+    for(tidal_station *station = tidal_stations; station!=NULL; station = station->previous) {
+        prepared_station prepared = {0};
+        prepared.station = station;
+        for(int i=0; i<BENCH_PREDICTIONS; i++) times[i] = random_time(station, &state);
+        double start = now_seconds();
+        for(int i=0; i<BENCH_PREDICTIONS; i++) sink += predict_tide(times[i], &prepared, d);
+        elapsed += now_seconds() - start;
+        n += BENCH_PREDICTIONS;
+    }
+    return elapsed / n * 1e9;
+}
+
+/* us per populate_tide_table: shift is 0 for a cold rebuild, or +1/-1
+to time a move of one day forwards or backwards from an existing table */
+static double bench_table(int shift)
+{
+    uint64_t state = BENCH_SEED;
+    double elapsed = 0.0;
+    int n = 0;
+    for(tidal_station *station = tidal_stations; station!=NULL; station = station->previous) {
+        prepared_station prepared = {0};
+        tide_table table;
+        for(int i=0; i<BENCH_TABLES; i++) {
+            time_t t = random_time(station, &state);
+            table.station = NULL;
+            table.base_time = 0;
+            if(shift) populate_tide_table(&table, &prepared, station, t, 0, 0);
+            double start = now_seconds();
+            populate_tide_table(&table, &prepared, station, t + shift * DAY_SECONDS, 0, 0);
+            elapsed += now_seconds() - start;
+            n++;
+        }
+    }
+    return elapsed / n * 1e6;
+}
+
+/* Predictions made by find_tide_events per event found, searching a day at
+a time as populate_tide_table does */
+static double bench_events(void)
+{
+    uint64_t state = BENCH_SEED;
+    uint32_t evaluations = 0;
+    int events = 0;
+    for(tidal_station *station = tidal_stations; station!=NULL; station = station->previous) {
+        prepared_station prepared = {0};
+        tidal_event day_events[MAX_TIDE_EVENTS];
+        prepared.station = station;
+        for(int i=0; i<BENCH_TABLES; i++) {
+            time_t t = random_time(station, &state);
+            prepare_station(&prepared, station, t);
+            uint32_t before = prepared.evaluations;
+            events += find_tide_events(&prepared, t, t + DAY_SECONDS, day_events);
+            evaluations += prepared.evaluations - before;
+        }
+    }
+    return events ? (double)evaluations / events : 0.0;
+}
+
+/* ns per find_tidal_station, looking up every station by its full name */
+static double bench_lookup(void)
+{
+    volatile uintptr_t sink = 0;
+    int n = 0;
+    double start = now_seconds();
+    for(int i=0; i<BENCH_LOOKUPS; i++) {
+        for(tidal_station *station = tidal_stations; station!=NULL; station = station->previous) {
+            sink += (uintptr_t)find_tidal_station(station->name);
+            n++;
+        }
+    }
+    return (now_seconds() - start) / n * 1e9;
+}
+
+static void print_results(bench_result *results, int n)
+{
+    printf("{\n    \"kernel\": \"%s\",\n    \"stations\": %d", tide_kernel_name(), count_stations());
+    for(int i=0; i<n; i++) printf(",\n    \"%s\": %.4f", results[i].name, results[i].value);
+    printf("\n}\n");
+}
+
+/* Read the numeric fields of a results file. Only understands the flat
+objects written by print_results. Returns the number read, or -1. */
+static int read_results(const char *filename, bench_result *results)
+{
+    char line[256];
+    int n = 0;
+    FILE *f = fopen(filename, "r");
+    if(!f) {
+        fprintf(stderr, "Can't read %s\n", filename);
+        return -1;
+    }
+    while(fgets(line, sizeof(line), f) && n<MAX_RESULTS) {
+        char name[48];
+        double value;
+        if(sscanf(line, " \"%47[^\"]\": %lf", name, &value)!=2) continue;
+        strcpy(results[n].name, name);
+        results[n].value = value;
+        n++;
+    }
+    fclose(f);
+    return n;
+}
+
+/* Print the change in every figure from before to after. Returns 1 if
+any got worse by more than threshold percent. */
+static int compare_results(const char *before_file, const char *after_file, double threshold)
+{
+    bench_result before[MAX_RESULTS], after[MAX_RESULTS];
+    int n_before = read_results(before_file, before);
+    int n_after = read_results(after_file, after);
+    int regressions = 0;
+    if(n_before<0 || n_after<0) return 1;
+    printf("%-40s %12s %12s %8s\n", "", before_file, after_file, "change");
+    for(int i=0; i<n_after; i++) {
+        for(int j=0; j<n_before; j++) {
+            if(strcmp(after[i].name, before[j].name)!=0) continue;
+            double change = before[j].value ? (after[i].value - before[j].value) / before[j].value * 100.0 : 0.0;
+            /* the station count is not a cost */
+            int regressed = strcmp(after[i].name, "stations")!=0 && change>threshold;
+            printf("%-40s %12.4f %12.4f %+7.1f%%%s\n", after[i].name, before[j].value, after[i].value, change, regressed ? "  <--" : "");
+            regressions += regressed;
+        }
+    }
+    if(regressions) printf("%d regressions over %.1f%%\n", regressions, threshold);
+    return regressions ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    bench_result results[MAX_RESULTS];
+    int n = 0;
+
+    if(argc>1 && strcmp(argv[1], "--compare")==0) {
+        if(argc<4) {
+            printf("Usage: %s --compare <before.json> <after.json> [threshold %%]\n", argv[0]);
+            return 1;
+        }
+        return compare_results(argv[2], argv[3], (argc>4) ? atof(argv[4]) : 10.0);
+    }
+
+    for(int d=0; d<3; d++) {
+        snprintf(results[n].name, sizeof(results[n].name), "predict_tide_d%d_ns", d);
+        results[n++].value = bench_predict(d);
+    }
+    strcpy(results[n].name, "table_cold_us");
+    results[n++].value = bench_table(0);
+    strcpy(results[n].name, "table_forward_us");
+    results[n++].value = bench_table(1);
+    strcpy(results[n].name, "table_backward_us");
+    results[n++].value = bench_table(-1);
+    strcpy(results[n].name, "evaluations_per_event");
+    results[n++].value = bench_events();
+    strcpy(results[n].name, "find_tidal_station_ns");
+    results[n++].value = bench_lookup();
+    print_results(results, n);
+    return 0;
+}
@@ -0,0 +1,73 @@
+#ifndef __TIDE_CALENDAR_H__
+#define __TIDE_CALENDAR_H__
+#include <stdint.h>
+#include <time.h>
+
+/* UTC calendar arithmetic on the proleptic Gregorian calendar.
+Pure integer functions with no library calls, locks or dependence on TZ,
+so they are safe to call from anywhere and fold away for constant arguments.
+Algorithms from H. Hinnant, "chrono-Compatible Low-Level Date Algorithms". */
+
+#define CALENDAR_DAY_SECONDS 86400
+
+/* Days since 1970-01-01 of year/month/day (month 1-12, day 1-31) */
+static inline int32_t days_from_civil(int32_t year, uint32_t month, uint32_t day)
+{
+    year -= month <= 2;
+    int32_t era = (year >= 0 ? year : year - 399) / 400;
+    uint32_t yoe = (uint32_t)(year - era * 400);
+    uint32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int32_t)doe - 719468;
+}
+
+/* Year/month/day of a count of days since 1970-01-01 */
+static inline void civil_from_days(int32_t days, int32_t *year, uint32_t *month, uint32_t *day)
+{
+    days += 719468;
+    int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+    uint32_t doe = (uint32_t)(days - era * 146097);
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp = (5 * doy + 2) / 153;
+    *day = doy - (153 * mp + 2) / 5 + 1;
+    *month = mp < 10 ? mp + 3 : mp - 9;
+    *year = (int32_t)yoe + era * 400 + (*month <= 2);
+}
+
+/* Whole days since 1970-01-01 at t (rounding down for times before 1970) */
+static inline int32_t days_from_time(time_t t)
+{
+    time_t days = t / CALENDAR_DAY_SECONDS;
+    if(t % CALENDAR_DAY_SECONDS < 0) days--;
+    return (int32_t)days;
+}
+
+/* Seconds since the epoch of a UTC date and time */
+static inline time_t time_from_civil(int32_t year, uint32_t month, uint32_t day, uint32_t hour, uint32_t minute, uint32_t second)
+{
+    return (time_t)days_from_civil(year, month, day) * CALENDAR_DAY_SECONDS + hour * 3600 + minute * 60 + second;
+}
+
+/* Midnight UTC at the start of the day containing t */
+static inline time_t day_start(time_t t)
+{
+    return (time_t)days_from_time(t) * CALENDAR_DAY_SECONDS;
+}
+
+/* 00:00 UTC on 1st January of year */
+static inline time_t year_start(int32_t year)
+{
+    return (time_t)days_from_civil(year, 1, 1) * CALENDAR_DAY_SECONDS;
+}
+
+/* UTC calendar year containing t */
+static inline int32_t year_of_time(time_t t)
+{
+    int32_t year;
+    uint32_t month, day;
+    civil_from_days(days_from_time(t), &year, &month, &day);
+    return year;
+}
+
+#endif
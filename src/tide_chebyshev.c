@@ -0,0 +1,120 @@
+#include "tide_chebyshev.h"
+#include <assert.h>
+#include <math.h>
+
+/* Sum c[0]*T_0(x) + ... + c[n-1]*T_{n-1}(x) by Clenshaw's recurrence */
+float chebyshev_sum(const float *c, int n, float x)
+{
+    float b1 = 0.0f, b2 = 0.0f, b;
+    float x2 = 2.0f * x;
+    for(int k=n-1; k>=1; k--) {
+        b = c[k] + x2 * b1 - b2;
+        b2 = b1;
+        b1 = b;
+    }
+    return c[0] + x * b1 - b2;
+}
+
+/* Coefficients d of the derivative (with respect to x) of the series c.
+Both have n coefficients; the last of d is always zero. */
+void chebyshev_derivative(const float *c, int n, float *d)
+{
+    float next = 0.0f, next2 = 0.0f, dk;
+    d[n-1] = 0.0f;
+    for(int k=n-1; k>=1; k--) {
+        dk = next2 + 2.0f * k * c[k];
+        d[k-1] = dk;
+        next2 = next;
+        next = dk;
+    }
+    d[0] *= 0.5f;
+}
+
+/* Load the segment containing t0 into p, with the station offsets applied.
+Called by prepare_station for Chebyshev stations. Times before the first
+segment or after the last use the end segments. */
+void prepare_chebyshev(prepared_station *p, tidal_station *station, time_t t0)
+{
+    const tide_chebyshev *curve = station->harmonic->chebyshev;
+    tidal_offset *offset = station->offset;
+    time_t segment_start;
+    int64_t segment;
+    const int16_t *c;
+    float jerk[MAX_CHEBYSHEV_ORDER];
+
+    assert(curve->order<=MAX_CHEBYSHEV_ORDER);
+    /* Segments are in harmonic station time */
+    segment = (t0 + offset->time_offset - curve->start);
+    segment = (segment<0) ? -1 : segment / curve->segment_seconds;
+    if(segment<0) segment = 0;
+    if(segment>=curve->n_segments) segment = curve->n_segments - 1;
+    segment_start = curve->start + (time_t)segment * curve->segment_seconds - offset->time_offset;
+
+    p->station = station;
+    p->type = TIDE_ENCODING_CHEBYSHEV;
+    p->start = (segment==0) ? TIDE_TIME_MIN : segment_start;
+    p->end = (segment==curve->n_segments-1) ? TIDE_TIME_MAX : segment_start + curve->segment_seconds;
+    p->epoch = segment_start + curve->segment_seconds / 2;
+    p->half_width = curve->segment_seconds * 0.5f;
+    p->offset = (station->harmonic->offset + offset->level_offset) * offset->level_scale;
+    p->n_constituents = 0;
+    p->order = curve->order;
+
+    c = curve->coeffs + segment * curve->order;
+    for(int k=0; k<p->order; k++)
+        p->coeffs[0][k] = c[k] * curve->scale * offset->level_scale;
+    p->coeffs[0][0] += offset->level_offset * offset->level_scale;
+    /* Differentiate once for the rate and again for the acceleration,
+    converting from per unit x to per second */
+    for(int d=1; d<3; d++) {
+        chebyshev_derivative(p->coeffs[d-1], p->order, p->coeffs[d]);
+        for(int k=0; k<p->order; k++) p->coeffs[d][k] /= p->half_width;
+    }
+    /* |T_k(x)| <= 1, so the sums of the magnitudes bound the acceleration and jerk */
+    chebyshev_derivative(p->coeffs[2], p->order, jerk);
+    p->accel_bound = 0.0f;
+    p->jerk_bound = 0.0f;
+    for(int k=0; k<p->order; k++) {
+        p->accel_bound += fabsf(p->coeffs[2][k]);
+        p->jerk_bound += fabsf(jerk[k]) / p->half_width;
+    }
+    p->quarter_period = TIDE_QUARTER_PERIOD;
+}
+
+/* Position of t0 in p's segment, from -1 to 1. Held at the ends,
+since the polynomials are meaningless outside their segment. */
+static float segment_x(time_t t0, prepared_station *p)
+{
+    float x = (int32_t)(t0 - p->epoch) / p->half_width;
+    if(x<-1.0f) x = -1.0f;
+    if(x>1.0f) x = 1.0f;
+    return x;
+}
+
+/* Predict the level (m), rate (m/s) and acceleration (m/s^2) at t0.
+rate and accel may be NULL. */
+void predict_chebyshev(time_t t0, prepared_station *p, float *level, float *rate, float *accel)
+{
+    float x;
+    prepare_station(p, p->station, t0);
+    x = segment_x(t0, p);
+    *level = chebyshev_sum(p->coeffs[0], p->order, x);
+    if(rate) *rate = chebyshev_sum(p->coeffs[1], p->order, x);
+    if(accel) *accel = chebyshev_sum(p->coeffs[2], p->order, x);
+}
+
+/* The d'th derivative at t0, in m/s^d, for any d */
+float predict_chebyshev_derivative(time_t t0, prepared_station *p, int d)
+{
+    float c[MAX_CHEBYSHEV_ORDER], dc[MAX_CHEBYSHEV_ORDER];
+    float x;
+    prepare_station(p, p->station, t0);
+    x = segment_x(t0, p);
+    if(d<=2) return chebyshev_sum(p->coeffs[d], p->order, x);
+    for(int k=0; k<p->order; k++) c[k] = p->coeffs[2][k];
+    for(int i=2; i<d; i++) {
+        chebyshev_derivative(c, p->order, dc);
+        for(int k=0; k<p->order; k++) c[k] = dc[k] / p->half_width;
+    }
+    return chebyshev_sum(c, p->order, x);
+}
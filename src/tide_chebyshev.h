@@ -0,0 +1,30 @@
+#ifndef __TIDE_CHEBYSHEV_H__
+#define __TIDE_CHEBYSHEV_H__
+#include "tide_base.h"
+
+/* Piecewise Chebyshev encoding of a harmonic station's tide curve, written by
+the generator (extract_tides.py --encoding chebyshev) and selected by
+type==TIDE_ENCODING_CHEBYSHEV in the tidal_harmonic.
+The curve is split into segments of equal length, and each segment is
+stored as order coefficients c[k] of
+    level(t) = sum c[k] * T_k(x), x = 2 * (t - segment start) / segment_seconds - 1
+quantized to int16 in steps of scale metres. The levels include the datum offset.
+A segment costs about one multiply per coefficient to evaluate, instead of a
+sin/cos per constituent. order must be at most MAX_CHEBYSHEV_ORDER. */
+
+typedef struct tide_chebyshev {
+    time_t start; /* start of the first segment */
+    uint32_t segment_seconds;
+    uint32_t n_segments;
+    uint8_t order; /* coefficients per segment */
+    float scale; /* metres per quantization step */
+    const int16_t *coeffs; /* [n_segments][order] */
+} tide_chebyshev;
+
+void prepare_chebyshev(prepared_station *p, tidal_station *station, time_t t0);
+void predict_chebyshev(time_t t0, prepared_station *p, float *level, float *rate, float *accel);
+float predict_chebyshev_derivative(time_t t0, prepared_station *p, int d);
+float chebyshev_sum(const float *c, int n, float x);
+void chebyshev_derivative(const float *c, int n, float *d);
+
+#endif
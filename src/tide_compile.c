@@ -0,0 +1,1714 @@
+#include "tide_lib.h"
+#include "tide_pool.h"
+#include "tide_calendar.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+
+/* Writes tide_data.c from a TCD JSON file (from tcd_extract.py) as
+scripts/extract_tides.py does with the harmonic encoding, byte for byte
+given the same --seed, in a fraction of the time:
+    tide_compile <tcd.json> --stations "Millport Arran=Millport+0:10" --seed 1
+        [--base-year Y] [--years N] [--min-amplitude m] [--output-file tide_data.c] [--jobs N]
+The JSON is read as a stream, keeping only the records of the requested
+stations: each record's name is looked up, a prefix at a time, in a hash
+table of the requested names. Stations are analysed in parallel. The test
+levels are predicted in double precision, as predict_tide.py does them,
+and the errors and ranges of the stored constants by the core (through
+tide_lib.c), as the script does when libtide.so is built. The random test
+times come from the generator behind Python's random.Random, seeded with
+the seed and the station's name. The other encodings, the almanac, the
+error budget and the database are only in the script. */
+
+#define MAX_AMP 12.0 /* as in dump_tides.py */
+#define MAX_PHASE (M_PI * 2)
+#define MAX_SPEED 0.001
+#define FEET 0.3048
+#define SELECTION_SAMPLES 400 /* per year, drawn by select_constituents */
+#define TEST_TIMES 96 /* per year */
+#define TEST_SAMPLES 400 /* per year, for the mean error */
+#define TIDAL_PERIOD (12.4206012 * 3600 * 0.25) /* the guess find_tide_events searches with */
+#define CLOCK_NAME "CLOCK"
+
+static const char *program = "tide_compile";
+
+static void die(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "%s: ", program);
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+    exit(1);
+}
+
+static void *checked_realloc(void *p, size_t size)
+{
+    p = realloc(p, size ? size : 1);
+    if(!p) die("out of memory");
+    return p;
+}
+
+static char *checked_strdup(const char *s)
+{
+    size_t n = strlen(s) + 1;
+    return memcpy(checked_realloc(NULL, n), s, n);
+}
+
+/* Growable text, for the output and the strings read from the JSON */
+typedef struct text_buffer {
+    char *data;
+    size_t length, size;
+} text_buffer;
+
+static void buffer_reserve(text_buffer *b, size_t extra)
+{
+    if(b->length + extra + 1 <= b->size) return;
+    while(b->length + extra + 1 > b->size) b->size = b->size ? b->size * 2 : 256;
+    b->data = checked_realloc(b->data, b->size);
+}
+
+static void buffer_append(text_buffer *b, const char *s, size_t n)
+{
+    buffer_reserve(b, n);
+    memcpy(b->data + b->length, s, n);
+    b->length += n;
+    b->data[b->length] = '\0';
+}
+
+static void buffer_printf(text_buffer *b, const char *format, ...)
+{
+    va_list args;
+    int n;
+    va_start(args, format);
+    n = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    buffer_reserve(b, (size_t)n);
+    va_start(args, format);
+    vsnprintf(b->data + b->length, (size_t)n + 1, format, args);
+    va_end(args);
+    b->length += (size_t)n;
+}
+
+static void buffer_clear(text_buffer *b)
+{
+    b->length = 0;
+    if(b->data) b->data[0] = '\0';
+}
+
+/* Python's numbers, as far as the output depends on them */
+
+/* A number from the JSON, which Python prints differently if it was an integer */
+typedef struct py_number {
+    double value;
+    int64_t integer;
+    int is_integer;
+} py_number;
+
+static py_number py_float(double value)
+{
+    py_number n = {value, 0, 0};
+    return n;
+}
+
+/* repr() of a float: the shortest digits that read back as x, in fixed
+notation unless the exponent is below -4 or above 15 */
+static void buffer_repr(text_buffer *b, double x)
+{
+    char text[32], digits[20];
+    int n_digits = 0, exponent, point;
+    if(isnan(x)) {
+        buffer_append(b, "nan", 3);
+        return;
+    }
+    if(isinf(x)) {
+        buffer_printf(b, "%sinf", x<0 ? "-" : "");
+        return;
+    }
+    if(x==0) {
+        buffer_printf(b, "%s0.0", signbit(x) ? "-" : "");
+        return;
+    }
+    /* the correctly rounded digits of the shortest length that round trips */
+    for(int precision=0; precision<17; precision++) {
+        snprintf(text, sizeof(text), "%.*e", precision, x);
+        if(strtod(text, NULL)==x) break;
+    }
+    for(char *c = text; *c && *c!='e'; c++) {
+        if(isdigit((unsigned char)*c)) digits[n_digits++] = *c;
+    }
+    while(n_digits>1 && digits[n_digits-1]=='0') n_digits--;
+    exponent = atoi(strchr(text, 'e') + 1);
+    point = exponent + 1; /* digits before the decimal point */
+    if(x<0) buffer_append(b, "-", 1);
+    if(point<=-4 || point>16) {
+        buffer_append(b, digits, 1);
+        if(n_digits>1) {
+            buffer_append(b, ".", 1);
+            buffer_append(b, digits + 1, (size_t)n_digits - 1);
+        }
+        buffer_printf(b, "e%c%02d", exponent<0 ? '-' : '+', abs(exponent));
+    } else if(point<=0) {
+        buffer_append(b, "0.", 2);
+        for(int i=0; i<-point; i++) buffer_append(b, "0", 1);
+        buffer_append(b, digits, (size_t)n_digits);
+    } else if(point>=n_digits) {
+        buffer_append(b, digits, (size_t)n_digits);
+        for(int i=n_digits; i<point; i++) buffer_append(b, "0", 1);
+        buffer_append(b, ".0", 2);
+    } else {
+        buffer_append(b, digits, (size_t)point);
+        buffer_append(b, ".", 1);
+        buffer_append(b, digits + point, (size_t)(n_digits - point));
+    }
+}
+
+/* str() of a number */
+static void buffer_number(text_buffer *b, py_number n)
+{
+    if(n.is_integer) buffer_printf(b, "%lld", (long long)n.integer);
+    else buffer_repr(b, n.value);
+}
+
+/* Python's float // and % (the remainder takes the sign of y) */
+static void py_divmod(double x, double y, double *quotient, double *remainder)
+{
+    double mod = fmod(x, y), div = (x - mod) / y, floor_div;
+    if(mod) {
+        if((y<0) != (mod<0)) {
+            mod += y;
+            div -= 1.0;
+        }
+    } else {
+        mod = copysign(0.0, y);
+    }
+    if(div) {
+        floor_div = floor(div);
+        if(div - floor_div > 0.5) floor_div += 1.0;
+    } else {
+        floor_div = copysign(0.0, x / y);
+    }
+    if(quotient) *quotient = floor_div;
+    if(remainder) *remainder = mod;
+}
+
+/* math.radians */
+static double radians(double degrees)
+{
+    static const double deg_to_rad = M_PI / 180.0;
+    return degrees * deg_to_rad;
+}
+
+/* rads_per_second in predict_tide.py */
+static double rads_per_second(double degrees_per_hour)
+{
+    return radians(degrees_per_hour / 3600);
+}
+
+/* seconds_tz in predict_tide.py: HHMM, split with floor division */
+static double seconds_tz(py_number tz)
+{
+    if(tz.is_integer) {
+        int64_t hour = tz.integer / 100, minute = tz.integer % 100;
+        if(minute<0) {
+            minute += 100;
+            hour--;
+        }
+        return (double)(hour * 3600 + minute * 60);
+    }
+    double hour, minute;
+    py_divmod(tz.value, 100, &hour, &minute);
+    return hour * 3600 + minute * 60;
+}
+
+/* int((val / max_val) * (2**bits - 1)), as quantize_ints does */
+static int64_t quantize(int bits, double max_val, double val)
+{
+    return (int64_t)((val / max_val) * (double)((1ull << bits) - 1));
+}
+
+/* The value quantize_seq gives back */
+static double dequantize(int bits, double max_val, double val)
+{
+    return ((double)quantize(bits, max_val, val) / ((double)((1ull << bits) - 1))) * max_val;
+}
+
+/* random.Random(str): SHA-512 and the Mersenne Twister */
+
+static uint64_t rotate_right(uint64_t x, int n)
+{
+    return (x >> n) | (x << (64 - n));
+}
+
+static void sha512_block(uint64_t state[8], const uint8_t block[128])
+{
+    static const uint64_t k[80] = {
+        0x428a2f98d728ae22ull, 0x7137449123ef65cdull, 0xb5c0fbcfec4d3b2full, 0xe9b5dba58189dbbcull,
+        0x3956c25bf348b538ull, 0x59f111f1b605d019ull, 0x923f82a4af194f9bull, 0xab1c5ed5da6d8118ull,
+        0xd807aa98a3030242ull, 0x12835b0145706fbeull, 0x243185be4ee4b28cull, 0x550c7dc3d5ffb4e2ull,
+        0x72be5d74f27b896full, 0x80deb1fe3b1696b1ull, 0x9bdc06a725c71235ull, 0xc19bf174cf692694ull,
+        0xe49b69c19ef14ad2ull, 0xefbe4786384f25e3ull, 0x0fc19dc68b8cd5b5ull, 0x240ca1cc77ac9c65ull,
+        0x2de92c6f592b0275ull, 0x4a7484aa6ea6e483ull, 0x5cb0a9dcbd41fbd4ull, 0x76f988da831153b5ull,
+        0x983e5152ee66dfabull, 0xa831c66d2db43210ull, 0xb00327c898fb213full, 0xbf597fc7beef0ee4ull,
+        0xc6e00bf33da88fc2ull, 0xd5a79147930aa725ull, 0x06ca6351e003826full, 0x142929670a0e6e70ull,
+        0x27b70a8546d22ffcull, 0x2e1b21385c26c926ull, 0x4d2c6dfc5ac42aedull, 0x53380d139d95b3dfull,
+        0x650a73548baf63deull, 0x766a0abb3c77b2a8ull, 0x81c2c92e47edaee6ull, 0x92722c851482353bull,
+        0xa2bfe8a14cf10364ull, 0xa81a664bbc423001ull, 0xc24b8b70d0f89791ull, 0xc76c51a30654be30ull,
+        0xd192e819d6ef5218ull, 0xd69906245565a910ull, 0xf40e35855771202aull, 0x106aa07032bbd1b8ull,
+        0x19a4c116b8d2d0c8ull, 0x1e376c085141ab53ull, 0x2748774cdf8eeb99ull, 0x34b0bcb5e19b48a8ull,
+        0x391c0cb3c5c95a63ull, 0x4ed8aa4ae3418acbull, 0x5b9cca4f7763e373ull, 0x682e6ff3d6b2b8a3ull,
+        0x748f82ee5defb2fcull, 0x78a5636f43172f60ull, 0x84c87814a1f0ab72ull, 0x8cc702081a6439ecull,
+        0x90befffa23631e28ull, 0xa4506cebde82bde9ull, 0xbef9a3f7b2c67915ull, 0xc67178f2e372532bull,
+        0xca273eceea26619cull, 0xd186b8c721c0c207ull, 0xeada7dd6cde0eb1eull, 0xf57d4f7fee6ed178ull,
+        0x06f067aa72176fbaull, 0x0a637dc5a2c898a6ull, 0x113f9804bef90daeull, 0x1b710b35131c471bull,
+        0x28db77f523047d84ull, 0x32caab7b40c72493ull, 0x3c9ebe0a15c9bebcull, 0x431d67c49c100d4cull,
+        0x4cc5d4becb3e42b6ull, 0x597f299cfc657e2aull, 0x5fcb6fab3ad6faecull, 0x6c44198c4a475817ull};
+    uint64_t w[80], v[8];
+    for(int i=0; i<16; i++) {
+        w[i] = 0;
+        for(int j=0; j<8; j++) w[i] = (w[i] << 8) | block[i * 8 + j];
+    }
+    for(int i=16; i<80; i++) {
+        uint64_t s0 = rotate_right(w[i-15], 1) ^ rotate_right(w[i-15], 8) ^ (w[i-15] >> 7);
+        uint64_t s1 = rotate_right(w[i-2], 19) ^ rotate_right(w[i-2], 61) ^ (w[i-2] >> 6);
+        w[i] = w[i-16] + s0 + w[i-7] + s1;
+    }
+    memcpy(v, state, sizeof(v));
+    for(int i=0; i<80; i++) {
+        uint64_t s1 = rotate_right(v[4], 14) ^ rotate_right(v[4], 18) ^ rotate_right(v[4], 41);
+        uint64_t choose = (v[4] & v[5]) ^ (~v[4] & v[6]);
+        uint64_t t1 = v[7] + s1 + choose + k[i] + w[i];
+        uint64_t s0 = rotate_right(v[0], 28) ^ rotate_right(v[0], 34) ^ rotate_right(v[0], 39);
+        uint64_t majority = (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
+        memmove(v + 1, v, 7 * sizeof(uint64_t));
+        v[4] += t1;
+        v[0] = t1 + s0 + majority;
+    }
+    for(int i=0; i<8; i++) state[i] += v[i];
+}
+
+static void sha512(const uint8_t *data, size_t n, uint8_t digest[64])
+{
+    uint64_t state[8] = {
+        0x6a09e667f3bcc908ull, 0xbb67ae8584caa73bull, 0x3c6ef372fe94f82bull, 0xa54ff53a5f1d36f1ull,
+        0x510e527fade682d1ull, 0x9b05688c2b3e6c1full, 0x1f83d9abfb41bd6bull, 0x5be0cd19137e2179ull};
+    uint8_t block[128];
+    size_t done = 0;
+    for(; n - done>=128; done+=128) sha512_block(state, data + done);
+    /* the padding: a 1 bit, zeros, and the length in bits in the last 16 bytes */
+    memset(block, 0, sizeof(block));
+    memcpy(block, data + done, n - done);
+    block[n - done] = 0x80;
+    if(n - done>=112) {
+        sha512_block(state, block);
+        memset(block, 0, sizeof(block));
+    }
+    for(int i=0; i<8; i++) block[127 - i] = (uint8_t)(((uint64_t)n * 8) >> (8 * i));
+    sha512_block(state, block);
+    for(int i=0; i<64; i++) digest[i] = (uint8_t)(state[i / 8] >> (56 - 8 * (i % 8)));
+}
+
+#define MT_N 624
+#define MT_M 397
+
+typedef struct py_random {
+    uint32_t mt[MT_N];
+    int index;
+} py_random;
+
+/* random.Random(seed) for a str seed: the seed's UTF-8 followed by its
+SHA-512, read as a big-endian integer, is split into 32 bit words, least
+significant first, for init_by_array */
+static void py_random_seed(py_random *r, const char *seed)
+{
+    size_t length = strlen(seed), n_bytes = length + 64, n_words;
+    uint8_t *bytes = checked_realloc(NULL, n_bytes);
+    uint32_t *key;
+    int bits;
+    memcpy(bytes, seed, length);
+    sha512((const uint8_t *)seed, length, bytes + length);
+    /* the first byte, a digit or '-', is never zero */
+    bits = 8;
+    while(!(bytes[0] & (1 << (bits - 1)))) bits--;
+    bits += (int)(n_bytes - 1) * 8;
+    n_words = (size_t)(bits - 1) / 32 + 1;
+    key = checked_realloc(NULL, n_words * sizeof(uint32_t));
+    for(size_t i=0; i<n_words; i++) {
+        key[i] = 0;
+        for(size_t j=0; j<4; j++) {
+            size_t byte = i * 4 + j; /* from the least significant end */
+            if(byte<n_bytes) key[i] |= (uint32_t)bytes[n_bytes - 1 - byte] << (8 * j);
+        }
+    }
+    r->mt[0] = 19650218u;
+    for(int i=1; i<MT_N; i++) r->mt[i] = 1812433253u * (r->mt[i-1] ^ (r->mt[i-1] >> 30)) + (uint32_t)i;
+    int i = 1;
+    size_t j = 0;
+    for(size_t k = (MT_N > n_words ? MT_N : n_words); k; k--) {
+        r->mt[i] = (r->mt[i] ^ ((r->mt[i-1] ^ (r->mt[i-1] >> 30)) * 1664525u)) + key[j] + (uint32_t)j;
+        i++;
+        j++;
+        if(i>=MT_N) {
+            r->mt[0] = r->mt[MT_N-1];
+            i = 1;
+        }
+        if(j>=n_words) j = 0;
+    }
+    for(int k=MT_N-1; k; k--) {
+        r->mt[i] = (r->mt[i] ^ ((r->mt[i-1] ^ (r->mt[i-1] >> 30)) * 1566083941u)) - (uint32_t)i;
+        i++;
+        if(i>=MT_N) {
+            r->mt[0] = r->mt[MT_N-1];
+            i = 1;
+        }
+    }
+    r->mt[0] = 0x80000000u;
+    r->index = MT_N;
+    free(key);
+    free(bytes);
+}
+
+static uint32_t py_random_uint32(py_random *r)
+{
+    uint32_t y;
+    if(r->index>=MT_N) {
+        for(int i=0; i<MT_N; i++) {
+            y = (r->mt[i] & 0x80000000u) | (r->mt[(i + 1) % MT_N] & 0x7fffffffu);
+            r->mt[i] = r->mt[(i + MT_M) % MT_N] ^ (y >> 1) ^ ((y & 1) ? 0x9908b0dfu : 0);
+        }
+        r->index = 0;
+    }
+    y = r->mt[r->index++];
+    y ^= y >> 11;
+    y ^= (y << 7) & 0x9d2c5680u;
+    y ^= (y << 15) & 0xefc60000u;
+    y ^= y >> 18;
+    return y;
+}
+
+/* randint(a, b): getrandbits of the width's bit length, until one is in range */
+static int64_t py_random_randint(py_random *r, int64_t a, int64_t b)
+{
+    uint64_t width = (uint64_t)(b - a) + 1, value;
+    int bits = 0;
+    while(bits<64 && (width >> bits)) bits++;
+    do {
+        value = 0;
+        for(int i=0, left=bits; left>0; i++, left-=32) {
+            uint32_t word = py_random_uint32(r);
+            if(left<32) word >>= 32 - left;
+            value |= (uint64_t)word << (32 * i);
+        }
+    } while(value>=width);
+    return a + (int64_t)value;
+}
+
+/* Streaming JSON */
+
+typedef struct json_reader {
+    FILE *file;
+    const char *path;
+    unsigned char data[1 << 16];
+    size_t position, length;
+    long line;
+} json_reader;
+
+static void json_error(json_reader *r, const char *message)
+{
+    die("%s:%ld: %s", r->path, r->line, message);
+}
+
+static int json_getc(json_reader *r)
+{
+    if(r->position==r->length) {
+        r->length = fread(r->data, 1, sizeof(r->data), r->file);
+        r->position = 0;
+        if(r->length==0) return EOF;
+    }
+    int c = r->data[r->position++];
+    if(c=='\n') r->line++;
+    return c;
+}
+
+/* The next character that isn't white space, left to be read */
+static int json_peek(json_reader *r)
+{
+    for(;;) {
+        if(r->position==r->length) {
+            r->length = fread(r->data, 1, sizeof(r->data), r->file);
+            r->position = 0;
+            if(r->length==0) return EOF;
+        }
+        int c = r->data[r->position];
+        if(c!=' ' && c!='\t' && c!='\n' && c!='\r') return c;
+        if(c=='\n') r->line++;
+        r->position++;
+    }
+}
+
+static void json_expect(json_reader *r, int expected)
+{
+    if(json_peek(r)!=expected) {
+        char message[32];
+        snprintf(message, sizeof(message), "expected '%c'", expected);
+        json_error(r, message);
+    }
+    json_getc(r);
+}
+
+static unsigned json_hex4(json_reader *r)
+{
+    unsigned value = 0;
+    for(int i=0; i<4; i++) {
+        int c = json_getc(r);
+        if(!isxdigit(c)) json_error(r, "bad \\u escape");
+        value = value * 16 + (unsigned)(isdigit(c) ? c - '0' : tolower(c) - 'a' + 10);
+    }
+    return value;
+}
+
+static void buffer_utf8(text_buffer *b, unsigned code)
+{
+    char out[4];
+    size_t n;
+    if(code<0x80) {
+        out[0] = (char)code;
+        n = 1;
+    } else if(code<0x800) {
+        out[0] = (char)(0xC0 | (code >> 6));
+        out[1] = (char)(0x80 | (code & 0x3F));
+        n = 2;
+    } else if(code<0x10000) {
+        out[0] = (char)(0xE0 | (code >> 12));
+        out[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (code & 0x3F));
+        n = 3;
+    } else {
+        out[0] = (char)(0xF0 | (code >> 18));
+        out[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+        out[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+        out[3] = (char)(0x80 | (code & 0x3F));
+        n = 4;
+    }
+    buffer_append(b, out, n);
+}
+
+/* A string, decoded to UTF-8 */
+static void json_string(json_reader *r, text_buffer *s)
+{
+    buffer_clear(s);
+    buffer_reserve(s, 0);
+    json_expect(r, '"');
+    for(;;) {
+        int c = json_getc(r);
+        if(c==EOF) json_error(r, "unterminated string");
+        if(c=='"') return;
+        if(c!='\\') {
+            char byte = (char)c;
+            buffer_append(s, &byte, 1);
+            continue;
+        }
+        c = json_getc(r);
+        switch(c) {
+            case 'b': buffer_append(s, "\b", 1); break;
+            case 'f': buffer_append(s, "\f", 1); break;
+            case 'n': buffer_append(s, "\n", 1); break;
+            case 'r': buffer_append(s, "\r", 1); break;
+            case 't': buffer_append(s, "\t", 1); break;
+            case 'u': {
+                unsigned code = json_hex4(r);
+                if(code>=0xD800 && code<0xDC00) {
+                    /* a surrogate pair */
+                    if(json_getc(r)!='\\' || json_getc(r)!='u') json_error(r, "unpaired surrogate");
+                    unsigned low = json_hex4(r);
+                    if(low<0xDC00 || low>=0xE000) json_error(r, "unpaired surrogate");
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+                buffer_utf8(s, code);
+                break;
+            }
+            case '"': case '\\': case '/': {
+                char byte = (char)c;
+                buffer_append(s, &byte, 1);
+                break;
+            }
+            default: json_error(r, "bad escape");
+        }
+    }
+}
+
+/* A number, as json.load reads it: an integer unless it has a fraction or exponent */
+static py_number json_number(json_reader *r)
+{
+    char text[64];
+    size_t n = 0;
+    py_number number = {0, 0, 1};
+    json_peek(r);
+    for(;;) {
+        int c = (r->position<r->length) ? r->data[r->position] : json_peek(r);
+        if(c==EOF || !(isalnum(c) || c=='-' || c=='+' || c=='.')) break;
+        if(n + 1>=sizeof(text)) json_error(r, "number too long");
+        text[n++] = (char)json_getc(r);
+        if(c=='.' || c=='e' || c=='E' || isalpha(c)) number.is_integer = 0;
+    }
+    text[n] = '\0';
+    if(strcmp(text, "NaN")==0) return py_float(NAN);
+    if(strcmp(text, "Infinity")==0) return py_float(INFINITY);
+    if(strcmp(text, "-Infinity")==0) return py_float(-INFINITY);
+    char *end;
+    errno = 0;
+    if(number.is_integer) {
+        number.integer = strtoll(text, &end, 10);
+        number.value = (double)number.integer;
+    } else {
+        number.value = strtod(text, &end);
+    }
+    if(n==0 || *end || errno) json_error(r, "bad number");
+    return number;
+}
+
+static void json_skip(json_reader *r)
+{
+    static text_buffer scratch;
+    int c = json_peek(r);
+    if(c=='{' || c=='[') {
+        int close = (c=='{') ? '}' : ']';
+        json_getc(r);
+        if(json_peek(r)==close) {
+            json_getc(r);
+            return;
+        }
+        for(;;) {
+            if(close=='}') {
+                json_string(r, &scratch);
+                json_expect(r, ':');
+            }
+            json_skip(r);
+            if(json_peek(r)==close) break;
+            json_expect(r, ',');
+        }
+        json_getc(r);
+    } else if(c=='"') {
+        json_string(r, &scratch);
+    } else if(c=='t' || c=='f' || c=='n') {
+        while(isalpha(json_peek(r))) json_getc(r);
+    } else {
+        json_number(r);
+    }
+}
+
+/* Steps through an object, reading the key of each member. Returns 0 at the end. */
+static int json_next_member(json_reader *r, int *first, text_buffer *key)
+{
+    if(*first) {
+        json_expect(r, '{');
+        *first = 0;
+        if(json_peek(r)=='}') {
+            json_getc(r);
+            return 0;
+        }
+    } else {
+        if(json_peek(r)=='}') {
+            json_getc(r);
+            return 0;
+        }
+        json_expect(r, ',');
+    }
+    json_string(r, key);
+    json_expect(r, ':');
+    return 1;
+}
+
+/* Steps through an array. Returns 0 at the end. */
+static int json_next_element(json_reader *r, int *first)
+{
+    if(*first) {
+        json_expect(r, '[');
+        *first = 0;
+    } else if(json_peek(r)!=']') {
+        json_expect(r, ',');
+    }
+    if(json_peek(r)==']') {
+        json_getc(r);
+        return 0;
+    }
+    return 1;
+}
+
+/* An array of numbers, as doubles */
+static int json_numbers(json_reader *r, double **values, int *size)
+{
+    int first = 1, n = 0;
+    while(json_next_element(r, &first)) {
+        if(n==*size) {
+            *size = *size ? *size * 2 : 64;
+            *values = checked_realloc(*values, (size_t)*size * sizeof(double));
+        }
+        (*values)[n++] = json_number(r).value;
+    }
+    return n;
+}
+
+/* The TCD data */
+
+typedef struct tcd_constituent {
+    char *name;
+    double speed; /* degrees/hour */
+    int first_year, n_years; /* of the yearly corrections */
+    uint8_t *present;
+    double *node_factors;
+    double *equilibria; /* degrees */
+} tcd_constituent;
+
+typedef struct tcd_station {
+    char *name;
+    py_number lat, lon, zone_offset, offset;
+    char *units;
+    int n_amps, n_epochs;
+    double *amps, *epochs;
+} tcd_station;
+
+/* A station requested with --stations, found by prefix */
+typedef struct base_station {
+    char *name;
+    size_t length;
+    uint32_t hash;
+    int *records; /* matching type 1 records, in the order of the file */
+    int n_records, size;
+    const char *harmonic; /* of the last match, written by dump_station_offset */
+    int task; /* of the last match, for its position; -1 if none */
+} base_station;
+
+typedef struct station_index {
+    base_station *bases;
+    int n_bases;
+    int *slots; /* open addressing, -1 if empty */
+    uint32_t mask;
+} station_index;
+
+/* FNV-1a, extended a byte at a time so every prefix of a name is hashed in one pass */
+#define HASH_START 2166136261u
+static uint32_t hash_byte(uint32_t hash, uint8_t byte)
+{
+    return (hash ^ byte) * 16777619u;
+}
+
+static void index_build(station_index *index)
+{
+    uint32_t size = 16;
+    while(size<(uint32_t)index->n_bases * 2) size *= 2;
+    index->slots = checked_realloc(NULL, size * sizeof(int));
+    index->mask = size - 1;
+    for(uint32_t i=0; i<size; i++) index->slots[i] = -1;
+    for(int b=0; b<index->n_bases; b++) {
+        base_station *base = &index->bases[b];
+        uint32_t slot;
+        base->hash = HASH_START;
+        for(size_t i=0; i<base->length; i++) base->hash = hash_byte(base->hash, (uint8_t)base->name[i]);
+        for(slot = base->hash & index->mask; index->slots[slot]>=0; slot = (slot + 1) & index->mask);
+        index->slots[slot] = b;
+    }
+}
+
+/* Adds record to every base station whose name it starts with */
+static int index_match(station_index *index, const char *name, int record)
+{
+    uint32_t hash = HASH_START;
+    int matched = 0;
+    for(size_t length=1; name[length - 1]; length++) {
+        hash = hash_byte(hash, (uint8_t)name[length - 1]);
+        for(uint32_t slot = hash & index->mask; index->slots[slot]>=0; slot = (slot + 1) & index->mask) {
+            base_station *base = &index->bases[index->slots[slot]];
+            if(base->hash!=hash || base->length!=length || memcmp(base->name, name, length)!=0) continue;
+            if(base->n_records==base->size) {
+                base->size = base->size ? base->size * 2 : 4;
+                base->records = checked_realloc(base->records, (size_t)base->size * sizeof(int));
+            }
+            base->records[base->n_records++] = record;
+            matched = 1;
+        }
+    }
+    return matched;
+}
+
+typedef struct tcd_data {
+    tcd_constituent *constituents; /* by first appearance, later duplicates replacing earlier */
+    int n_constituents;
+    tcd_station *stations; /* only the matched ones */
+    int n_stations;
+    int n_records;
+} tcd_data;
+
+static void read_years(json_reader *r, tcd_constituent *c, text_buffer *key)
+{
+    int first = 1, n = 0, size = 0;
+    long *years = NULL;
+    double *node_factors = NULL, *equilibria = NULL;
+    text_buffer field = {0};
+    while(json_next_member(r, &first, key)) {
+        char *end, check[24];
+        long year = strtol(key->data, &end, 10);
+        int inner = 1;
+        if(n==size) {
+            size = size ? size * 2 : 64;
+            years = checked_realloc(years, (size_t)size * sizeof(long));
+            node_factors = checked_realloc(node_factors, (size_t)size * sizeof(double));
+            equilibria = checked_realloc(equilibria, (size_t)size * sizeof(double));
+        }
+        node_factors[n] = equilibria[n] = NAN;
+        while(json_next_member(r, &inner, &field)) {
+            if(strcmp(field.data, "node_factor")==0) node_factors[n] = json_number(r).value;
+            else if(strcmp(field.data, "equilibrium")==0) equilibria[n] = json_number(r).value;
+            else json_skip(r);
+        }
+        /* only keys that are str(year) are ever looked up */
+        snprintf(check, sizeof(check), "%ld", year);
+        if(*end=='\0' && strcmp(check, key->data)==0 && year>-100000 && year<100000) years[n++] = year;
+    }
+    /* kept by year, from the first to the last */
+    c->n_years = 0;
+    for(int i=0; i<n; i++) {
+        if(i==0 || years[i]<c->first_year) c->first_year = (int)years[i];
+    }
+    for(int i=0; i<n; i++) {
+        if(years[i] - c->first_year + 1>c->n_years) c->n_years = (int)(years[i] - c->first_year + 1);
+    }
+    c->present = calloc((size_t)c->n_years + 1, 1);
+    c->node_factors = checked_realloc(NULL, (size_t)c->n_years * sizeof(double));
+    c->equilibria = checked_realloc(NULL, (size_t)c->n_years * sizeof(double));
+    if(!c->present) die("out of memory");
+    for(int i=0; i<n; i++) {
+        int y = (int)(years[i] - c->first_year);
+        c->present[y] = 1;
+        c->node_factors[y] = node_factors[i];
+        c->equilibria[y] = equilibria[i];
+    }
+    free(years);
+    free(node_factors);
+    free(equilibria);
+    free(field.data);
+}
+
+static void read_constituents(json_reader *r, tcd_data *data)
+{
+    int first = 1;
+    text_buffer key = {0}, name = {0};
+    while(json_next_element(r, &first)) {
+        tcd_constituent c = {0};
+        int members = 1, has_name = 0;
+        while(json_next_member(r, &members, &key)) {
+            if(strcmp(key.data, "constituent_name")==0) {
+                json_string(r, &name);
+                has_name = 1;
+            } else if(strcmp(key.data, "speed")==0) {
+                c.speed = json_number(r).value;
+            } else if(strcmp(key.data, "years")==0) {
+                read_years(r, &c, &key);
+            } else {
+                json_skip(r);
+            }
+        }
+        if(!has_name) json_error(r, "constituent without a name");
+        c.name = checked_strdup(name.data);
+        int i;
+        for(i=0; i<data->n_constituents && strcmp(data->constituents[i].name, c.name)!=0; i++);
+        if(i==data->n_constituents) {
+            data->constituents = checked_realloc(data->constituents, (size_t)(i + 1) * sizeof(tcd_constituent));
+            data->n_constituents++;
+        } else {
+            free(data->constituents[i].name);
+            free(data->constituents[i].present);
+            free(data->constituents[i].node_factors);
+            free(data->constituents[i].equilibria);
+        }
+        data->constituents[i] = c;
+    }
+    free(key.data);
+    free(name.data);
+}
+
+/* Reads the records, keeping the reference stations (type 1) that the index matches */
+static void read_records(json_reader *r, tcd_data *data, station_index *index)
+{
+    enum {FIELD_NAME = 1, FIELD_TYPE = 2, FIELD_LAT = 4, FIELD_LON = 8, FIELD_ID = 16, FIELD_ZONE = 32,
+          FIELD_OFFSET = 64, FIELD_UNITS = 128, FIELD_AMPS = 256, FIELD_EPOCHS = 512, FIELD_ALL = 1023};
+    int first = 1, amps_size = 0, epochs_size = 0;
+    text_buffer key = {0}, name = {0}, units = {0};
+    tcd_station s = {0};
+    while(json_next_element(r, &first)) {
+        int members = 1, fields = 0;
+        double record_type = 0;
+        while(json_next_member(r, &members, &key)) {
+            if(strcmp(key.data, "name")==0) {
+                json_string(r, &name);
+                fields |= FIELD_NAME;
+            } else if(strcmp(key.data, "record_type")==0) {
+                record_type = json_number(r).value;
+                fields |= FIELD_TYPE;
+            } else if(strcmp(key.data, "latitude")==0) {
+                s.lat = json_number(r);
+                fields |= FIELD_LAT;
+            } else if(strcmp(key.data, "longitude")==0) {
+                s.lon = json_number(r);
+                fields |= FIELD_LON;
+            } else if(strcmp(key.data, "zone_offset")==0) {
+                s.zone_offset = json_number(r);
+                fields |= FIELD_ZONE;
+            } else if(strcmp(key.data, "datum_offset")==0) {
+                s.offset = json_number(r);
+                fields |= FIELD_OFFSET;
+            } else if(strcmp(key.data, "level_units")==0) {
+                json_string(r, &units);
+                fields |= FIELD_UNITS;
+            } else if(strcmp(key.data, "amplitude")==0) {
+                s.n_amps = json_numbers(r, &s.amps, &amps_size);
+                fields |= FIELD_AMPS;
+            } else if(strcmp(key.data, "epoch")==0) {
+                s.n_epochs = json_numbers(r, &s.epochs, &epochs_size);
+                fields |= FIELD_EPOCHS;
+            } else {
+                if(strcmp(key.data, "station_id")==0) fields |= FIELD_ID;
+                json_skip(r);
+            }
+        }
+        int record = data->n_records++;
+        if(!(fields & FIELD_NAME) || !(fields & FIELD_TYPE) || record_type!=1) continue;
+        if(!index_match(index, name.data, data->n_stations)) continue;
+        if(fields!=FIELD_ALL) die("%s: record %d (%s) is missing fields", r->path, record, name.data);
+        /* kept, with its own copies of the arrays */
+        tcd_station *kept;
+        data->stations = checked_realloc(data->stations, (size_t)(data->n_stations + 1) * sizeof(tcd_station));
+        kept = &data->stations[data->n_stations++];
+        *kept = s;
+        kept->name = checked_strdup(name.data);
+        kept->units = checked_strdup(units.data);
+        kept->amps = memcpy(checked_realloc(NULL, (size_t)s.n_amps * sizeof(double)), s.amps, (size_t)s.n_amps * sizeof(double));
+        kept->epochs = memcpy(checked_realloc(NULL, (size_t)s.n_epochs * sizeof(double)), s.epochs, (size_t)s.n_epochs * sizeof(double));
+    }
+    free(key.data);
+    free(name.data);
+    free(units.data);
+    free(s.amps);
+    free(s.epochs);
+}
+
+static void read_tcd(const char *path, tcd_data *data, station_index *index)
+{
+    json_reader *r = checked_realloc(NULL, sizeof(json_reader));
+    text_buffer key = {0};
+    int first = 1;
+    r->file = fopen(path, "rb");
+    if(!r->file) die("can't open %s", path);
+    r->path = path;
+    r->position = r->length = 0;
+    r->line = 1;
+    while(json_next_member(r, &first, &key)) {
+        if(strcmp(key.data, "tide_records")==0) read_records(r, data, index);
+        else if(strcmp(key.data, "constituents")==0) read_constituents(r, data);
+        else json_skip(r);
+    }
+    fclose(r->file);
+    free(r);
+    free(key.data);
+}
+
+/* The stations to write, parsed as station_parser.py does */
+
+typedef struct station_spec {
+    char *alias;
+    int base; /* in the station index */
+    double seconds_offset, level_offset, level_scale;
+} station_spec;
+
+/* [a-zA-Z0-9,]+, or the same with spaces in quotes; the quotes are kept */
+static const char *match_station_name(const char *s)
+{
+    const char *start = s;
+    if(*s=='"') {
+        for(s++; isalnum((unsigned char)*s) || *s==' ' || *s==','; s++);
+        return (s>start + 1 && *s=='"') ? s + 1 : NULL;
+    }
+    while(isalnum((unsigned char)*s) || *s==',') s++;
+    return s>start ? s : NULL;
+}
+
+/* [-+][0-9]+:[0-9][0-9], or [-+][0-9]+ hours, as hour_format_to_seconds reads them */
+static const char *match_time_offset(const char *s, double *seconds)
+{
+    const char *digits = s + 1, *end = digits;
+    if(*s!='-' && *s!='+') return NULL;
+    while(isdigit((unsigned char)*end)) end++;
+    if(end==digits) return NULL;
+    long hours = strtol(s, NULL, 10);
+    if(end[0]==':' && isdigit((unsigned char)end[1]) && isdigit((unsigned char)end[2])) {
+        *seconds = (double)(hours * 3600 + ((end[1] - '0') * 10 + (end[2] - '0')) * 60);
+        return end + 3;
+    }
+    *seconds = (double)(hours * 3600);
+    return end;
+}
+
+static const char *match_digits(const char *s, int n, int *value)
+{
+    *value = 0;
+    for(int i=0; i<n; i++) {
+        if(!isdigit((unsigned char)s[i])) return NULL;
+        *value = *value * 10 + (s[i] - '0');
+    }
+    return s + n;
+}
+
+/* YYYY-MM-DDTHH:MM, then Z or an offset, or local time if neither, as seconds since the epoch */
+static const char *match_iso8601(const char *s, double *seconds)
+{
+    int year, month, day, hour, minute;
+    static const int month_days[] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if(!(s = match_digits(s, 4, &year)) || *s++!='-' || !(s = match_digits(s, 2, &month)) || *s++!='-' ||
+       !(s = match_digits(s, 2, &day)) || *s++!='T' || !(s = match_digits(s, 2, &hour)) || *s++!=':' ||
+       !(s = match_digits(s, 2, &minute))) return NULL;
+    if(month<1 || month>12 || day<1 || day>month_days[month-1] || hour>23 || minute>59 ||
+       (month==2 && day==29 && (year % 4!=0 || (year % 100==0 && year % 400!=0)))) die("bad date in --stations");
+    if(*s=='Z') {
+        *seconds = (double)time_from_civil(year, (uint32_t)month, (uint32_t)day, (uint32_t)hour, (uint32_t)minute, 0);
+        return s + 1;
+    }
+    double zone;
+    const char *end = match_time_offset(s, &zone);
+    if(end) {
+        if(end - s!=6) die("bad time zone in --stations");
+        *seconds = (double)time_from_civil(year, (uint32_t)month, (uint32_t)day, (uint32_t)hour, (uint32_t)minute, 0) - zone;
+        return end;
+    }
+    struct tm local = {0};
+    local.tm_year = year - 1900;
+    local.tm_mon = month - 1;
+    local.tm_mday = day;
+    local.tm_hour = hour;
+    local.tm_min = minute;
+    local.tm_isdst = -1;
+    *seconds = (double)mktime(&local);
+    return s;
+}
+
+/* [-+]?[0-9]+(\.[0-9]+)? */
+static const char *match_decimal(const char *s, double *value)
+{
+    const char *end = s + (*s=='-' || *s=='+');
+    if(!isdigit((unsigned char)*end)) return NULL;
+    while(isdigit((unsigned char)*end)) end++;
+    if(end[0]=='.' && isdigit((unsigned char)end[1])) for(end++; isdigit((unsigned char)*end); end++);
+    *value = strtod(s, NULL);
+    return end;
+}
+
+static int add_base(station_index *index, const char *name, size_t length)
+{
+    for(int b=0; b<index->n_bases; b++) {
+        if(index->bases[b].length==length && memcmp(index->bases[b].name, name, length)==0) return b;
+    }
+    index->bases = checked_realloc(index->bases, (size_t)(index->n_bases + 1) * sizeof(base_station));
+    base_station *base = &index->bases[index->n_bases];
+    memset(base, 0, sizeof(*base));
+    base->name = checked_realloc(NULL, length + 1);
+    memcpy(base->name, name, length);
+    base->name[length] = '\0';
+    base->length = length;
+    base->task = -1;
+    return index->n_bases++;
+}
+
+/* One station: name, or alias=name, alias=name+offset, alias=CLOCK:time or alias=CLOCK:time,hw,lw */
+static const char *parse_spec(const char *s, station_spec *spec, station_index *index)
+{
+    const char *end = match_station_name(s), *base;
+    spec->seconds_offset = spec->level_offset = 0.0;
+    spec->level_scale = 1.0;
+    if(end && *end=='=') {
+        spec->alias = checked_realloc(NULL, (size_t)(end - s) + 1);
+        memcpy(spec->alias, s, (size_t)(end - s));
+        spec->alias[end - s] = '\0';
+        s = end + 1;
+        if(strncmp(s, CLOCK_NAME ":", strlen(CLOCK_NAME) + 1)==0 && (end = match_iso8601(s + strlen(CLOCK_NAME) + 1, &spec->seconds_offset))) {
+            double high, low;
+            const char *levels = end;
+            spec->base = add_base(index, CLOCK_NAME, strlen(CLOCK_NAME));
+            if(*levels++==',' && (levels = match_decimal(levels, &high)) && *levels++==',' && (levels = match_decimal(levels, &low))) {
+                spec->level_offset = (high + low) / 2;
+                spec->level_scale = (low - high) / 2;
+                return levels;
+            }
+            return end;
+        }
+        if(!(end = match_station_name(s))) return NULL;
+        base = s;
+        spec->base = add_base(index, base, (size_t)(end - base));
+        const char *offset_end = match_time_offset(end, &spec->seconds_offset);
+        return offset_end ? offset_end : end;
+    }
+    if(*s==' ') s++;
+    if(!(end = match_station_name(s))) return NULL;
+    spec->alias = checked_realloc(NULL, (size_t)(end - s) + 1);
+    memcpy(spec->alias, s, (size_t)(end - s));
+    spec->alias[end - s] = '\0';
+    spec->base = add_base(index, s, (size_t)(end - s));
+    return end;
+}
+
+static int parse_stations(const char *s, station_spec **specs, station_index *index)
+{
+    int n = 0;
+    const char *start = s;
+    for(;;) {
+        *specs = checked_realloc(*specs, (size_t)(n + 1) * sizeof(station_spec));
+        s = parse_spec(s, &(*specs)[n++], index);
+        if(!s) break;
+        if(*s=='\0') return n;
+        const char *space = s;
+        while(isspace((unsigned char)*s)) s++;
+        if(s==space) break;
+    }
+    die("can't parse --stations at column %d: %s", (int)(s ? s - start : 0) + 1, start);
+    return 0;
+}
+
+/* The analysis and output of one reference station */
+
+/* A station as extract_tides.py passes it to dump_station_years */
+typedef struct source_station {
+    const char *name;
+    py_number lat, lon, zone_offset, offset;
+    const char *units;
+    int n_constituents; /* the constituent table zipped with the amplitudes and epochs */
+    const tcd_constituent *const *constituents;
+    const double *amps, *phases;
+} source_station;
+
+typedef struct compile_task {
+    source_station station;
+    const tcd_constituent **constituents;
+    int min_year, max_year;
+    long long seed;
+    double min_amp;
+    char *harmonic; /* station_<c name>_<year> */
+    text_buffer text;
+    int n_chosen;
+    double mean_error, neaps_range, springs_range;
+} compile_task;
+
+static void year_corrections(const source_station *s, const tcd_constituent *c, int32_t year, double *node_factor, double *equilibrium)
+{
+    int i = year - c->first_year;
+    if(i<0 || i>=c->n_years || !c->present[i]) die("%s: no corrections for %s in %d", s->name, c->name, (int)year);
+    *node_factor = c->node_factors[i];
+    *equilibrium = c->equilibria[i];
+}
+
+static double level_scale(const source_station *s)
+{
+    return strcmp(s->units, "feet")==0 ? FEET : 1.0;
+}
+
+/* predict_tide in predict_tide.py: the level (or its d'th derivative) at t,
+from every constituent of the station with the corrections for t's year,
+in double precision. An integer datum with nothing added stays an integer. */
+static py_number predict_reference(const source_station *s, double t, int d)
+{
+    int32_t year = year_of_time((time_t)floor(t));
+    double time_shift = seconds_tz(s->zone_offset);
+    double deriv_shift = (M_PI / 2) * d;
+    py_number tide = d==0 ? s->offset : (py_number){0, 0, 1};
+    t -= (double)year_start(year);
+    for(int k=0; k<s->n_constituents; k++) {
+        double node_factor, equilibrium;
+        year_corrections(s, s->constituents[k], year, &node_factor, &equilibrium);
+        double speed = rads_per_second(s->constituents[k]->speed);
+        double amp = s->amps[k] * node_factor;
+        double phase = radians(equilibrium - s->phases[k]);
+        double term = amp * cos(speed * (t - time_shift) + phase + deriv_shift);
+        tide.value += term * (d==0 ? 1.0 : pow(speed, d));
+        tide.is_integer = 0;
+    }
+    if(strcmp(s->units, "feet")==0) {
+        tide.value *= FEET;
+        tide.is_integer = 0;
+    }
+    if(tide.is_integer) tide.value = (double)tide.integer;
+    return tide;
+}
+
+/* The cycles for a year, from extract_cycles */
+typedef struct station_cycles {
+    double *amps, *phases, *speeds;
+    int n;
+} station_cycles;
+
+static void extract_cycles(const source_station *s, int32_t year, const int *chosen, int n, station_cycles *cycles)
+{
+    double scale, time_zone = seconds_tz(s->zone_offset);
+    if(strcmp(s->units, "feet")==0) scale = FEET;
+    else if(strcmp(s->units, "meters")==0) scale = 1.0;
+    else die("%s: unknown level units '%s'", s->name, s->units);
+    cycles->n = n;
+    cycles->amps = checked_realloc(NULL, (size_t)n * sizeof(double));
+    cycles->phases = checked_realloc(NULL, (size_t)n * sizeof(double));
+    cycles->speeds = checked_realloc(NULL, (size_t)n * sizeof(double));
+    for(int i=0; i<n; i++) {
+        const tcd_constituent *c = s->constituents[chosen[i]];
+        double node_factor, equilibrium, phase;
+        year_corrections(s, c, year, &node_factor, &equilibrium);
+        double time_offset = time_zone * rads_per_second(c->speed);
+        cycles->amps[i] = (s->amps[chosen[i]] * node_factor) * scale;
+        phase = radians(equilibrium - s->phases[chosen[i]]) - time_offset;
+        py_divmod(phase, 2 * M_PI, NULL, &phase);
+        if(phase<0) phase += 2 * M_PI;
+        cycles->phases[i] = phase;
+        cycles->speeds[i] = rads_per_second(c->speed);
+    }
+}
+
+/* find_tide_event, for stations the core can't take */
+static int find_reference_event(const source_station *s, double t0, double t1, double *time, double *level)
+{
+    double tide0 = predict_reference(s, t0, 1).value, tide1 = predict_reference(s, t1, 1).value, t = t0;
+    if(tide0 * tide1>0) return 0;
+    for(int i=0; i<3; i++) {
+        t = (t0 + t1) / 2;
+        double tide = predict_reference(s, t, 1).value;
+        if(tide * tide0<0) t1 = t;
+        else t0 = t;
+    }
+    double t_d = predict_reference(s, t, 1).value, t_d2 = predict_reference(s, t, 2).value;
+    for(int i=0; i<3; i++) {
+        t = t - t_d / t_d2;
+        t_d = predict_reference(s, t, 1).value;
+        t_d2 = predict_reference(s, t, 2).value;
+    }
+    *time = t;
+    *level = predict_reference(s, t, 0).value;
+    return t_d2<0 ? TIDE_HIGH : TIDE_LOW;
+}
+
+/* get_tidal_range: the first HW less the first LW around t */
+static double tidal_range(const source_station *s, const tide_lib_station *device, int64_t t)
+{
+    double high = NAN, low = NAN;
+    if(device) {
+        /* in the order get_tidal_range multiplies, so it rounds the same */
+        double reach = 3.5 * 12.4206012 * 3600 * 0.25, t0 = (double)t - reach, t1 = (double)t + reach, hours;
+        py_divmod(t1 - t0, 3600, &hours, NULL);
+        int32_t max_events = (int32_t)hours + 8;
+        int64_t times[64];
+        float levels[64];
+        uint8_t types[64];
+        if(max_events>64) die("%s: too many events", s->name);
+        int32_t n = tide_lib_events(device, (int64_t)t0, (int64_t)t1, times, levels, types, max_events);
+        if(n<0) die("%s: the core can't take this station", s->name);
+        for(int32_t i=0; i<n; i++) {
+            if(types[i]==TIDE_HIGH && isnan(high)) high = levels[i];
+            if(types[i]!=TIDE_HIGH && isnan(low)) low = levels[i];
+        }
+    } else {
+        /* find_tide_events(t, 3): a dict by time, so a later event at the same time replaces one */
+        double times[7], event_levels[7];
+        int types[7], n = 0;
+        for(int i=-3; i<=3; i++) {
+            double centre = (double)t + i * TIDAL_PERIOD, time, level;
+            int type = find_reference_event(s, centre - TIDAL_PERIOD / 2, centre + TIDAL_PERIOD / 2, &time, &level);
+            if(!type) continue;
+            int j;
+            for(j=0; j<n && times[j]!=time; j++);
+            if(j==n) n++;
+            times[j] = time;
+            event_levels[j] = level;
+            types[j] = type;
+        }
+        int first_high = -1, first_low = -1;
+        for(int j=0; j<n; j++) {
+            if(types[j]==TIDE_HIGH && (first_high<0 || times[j]<times[first_high])) first_high = j;
+            if(types[j]==TIDE_LOW && (first_low<0 || times[j]<times[first_low])) first_low = j;
+        }
+        if(first_high>=0) high = event_levels[first_high];
+        if(first_low>=0) low = event_levels[first_low];
+    }
+    if(isnan(high) || isnan(low)) die("%s: no high and low water near %lld", s->name, (long long)t);
+    return high - low;
+}
+
+/* generate_tests: the test times and levels for a year, and the mean error,
+neap range and spring range of the constants stored for it */
+static void generate_tests(compile_task *task, int32_t year, const station_cycles *cycles, py_random *rng,
+                           int64_t *test_times, py_number *test_tides, double *mean_error, double *neaps_range, double *springs_range)
+{
+    const source_station *s = &task->station;
+    int64_t min_time = year_start(year), max_time = year_start(year + 1), sample_times[TEST_SAMPLES];
+    float samples[TEST_SAMPLES], rates[TEST_SAMPLES], accels[TEST_SAMPLES];
+    uint16_t amps[MAX_TIDE_CONSTITUENTS], phases[MAX_TIDE_CONSTITUENTS];
+    float speeds[MAX_TIDE_CONSTITUENTS];
+    tide_lib_station device_station, *device = NULL;
+    double largest = 0.0, total_error = 0.0;
+
+    for(int i=0; i<TEST_TIMES; i++) {
+        test_times[i] = py_random_randint(rng, min_time, max_time);
+        test_tides[i] = predict_reference(s, (double)test_times[i], 0);
+    }
+    /* device_station: the core takes up to MAX_TIDE_CONSTITUENTS, of up to MAX_AMP */
+    for(int i=0; i<cycles->n; i++) if(cycles->amps[i]>largest) largest = cycles->amps[i];
+    if(cycles->n<=MAX_TIDE_CONSTITUENTS && !(largest>MAX_AMP)) {
+        for(int i=0; i<cycles->n; i++) {
+            amps[i] = (uint16_t)quantize(16, MAX_AMP, cycles->amps[i]);
+            phases[i] = (uint16_t)quantize(16, MAX_PHASE, cycles->phases[i]);
+            speeds[i] = (float)cycles->speeds[i];
+        }
+        device_station.speeds = speeds;
+        device_station.amps = amps;
+        device_station.phases = phases;
+        device_station.base_year = year;
+        device_station.n_years = 1;
+        device_station.n_constituents = (uint32_t)cycles->n;
+        device_station.offset = (float)s->offset.value;
+        device = &device_station;
+    }
+    for(int i=0; i<TEST_TIMES; i++) {
+        double range = tidal_range(s, device, test_times[i]);
+        if(i==0 || range<*neaps_range) *neaps_range = range;
+        if(i==0 || range>*springs_range) *springs_range = range;
+    }
+    for(int i=0; i<TEST_SAMPLES; i++) sample_times[i] = py_random_randint(rng, min_time, max_time);
+    if(device) {
+        if(tide_lib_predict(device, sample_times, TEST_SAMPLES, samples, rates, accels)!=0) die("%s: the core can't take this station", s->name);
+        for(int i=0; i<TEST_SAMPLES; i++) total_error += fabs(predict_reference(s, (double)sample_times[i], 0).value - (double)samples[i]);
+    } else {
+        /* predict_c_tide, from the constants as quantized */
+        for(int i=0; i<TEST_SAMPLES; i++) {
+            double tide = s->offset.value, t = (double)(sample_times[i] - min_time);
+            for(int j=0; j<cycles->n; j++) {
+                tide += dequantize(16, MAX_AMP, cycles->amps[j]) * cos(dequantize(32, MAX_SPEED, cycles->speeds[j]) * t + dequantize(16, MAX_PHASE, cycles->phases[j]));
+            }
+            total_error += fabs(predict_reference(s, (double)sample_times[i], 0).value - tide);
+        }
+    }
+    *mean_error = total_error / TEST_SAMPLES;
+}
+
+/* make_c_name: anything but [a-zA-Z0-9_] (a character, however many bytes) becomes _, runs of _ one _, in lower case */
+static char *make_c_name(const char *name)
+{
+    char *c_name = checked_realloc(NULL, strlen(name) + 1), *out = c_name;
+    for(const unsigned char *in = (const unsigned char *)name; *in; in++) {
+        char c = (char)*in;
+        if((*in & 0xC0)==0x80) continue;
+        if(!(*in<0x80 && (isalnum(*in) || *in=='_'))) c = '_';
+        if(c=='_' && out>c_name && out[-1]=='_') continue;
+        *out++ = (char)tolower((unsigned char)c);
+    }
+    *out = '\0';
+    return c_name;
+}
+
+static void buffer_hex_seq(text_buffer *b, int bits, double max_val, const double *values, int n)
+{
+    for(int i=0; i<n; i++) {
+        int64_t q = quantize(bits, max_val, values[i]);
+        buffer_printf(b, "%s0x%s%llX", i ? ", " : "", q<0 ? "-" : "", (unsigned long long)(q<0 ? -q : q));
+    }
+}
+
+static void buffer_float_seq(text_buffer *b, const double *values, int n)
+{
+    for(int i=0; i<n; i++) buffer_printf(b, "%s%0.16e", i ? ", " : "", values[i]);
+}
+
+/* analyse_station and dump_station_years, into task->text */
+static void compile_station(void *context, int index)
+{
+    compile_task *task = (compile_task *)context + index;
+    const source_station *s = &task->station;
+    int n_years = task->max_year - task->min_year, n_chosen = 0;
+    int *chosen = checked_realloc(NULL, (size_t)s->n_constituents * sizeof(int));
+    station_cycles *cycles = checked_realloc(NULL, (size_t)n_years * sizeof(station_cycles));
+    int64_t *test_times = checked_realloc(NULL, (size_t)n_years * TEST_TIMES * sizeof(int64_t));
+    py_number *test_tides = checked_realloc(NULL, (size_t)n_years * TEST_TIMES * sizeof(py_number));
+    double *amps, *phases, mean_error = 0.0, neaps_range = 0.0, springs_range = 0.0;
+    text_buffer *b = &task->text;
+    py_random rng;
+    char *c_name = make_c_name(s->name), *seed;
+
+    seed = checked_realloc(NULL, strlen(s->name) + 32);
+    sprintf(seed, "%lld:%s", task->seed, s->name);
+    py_random_seed(&rng, seed);
+    free(seed);
+
+    /* select_constituents without an error budget: those over the minimum amplitude in any year */
+    for(int k=0; k<s->n_constituents; k++) {
+        for(int year=task->min_year; year<task->max_year; year++) {
+            double node_factor, equilibrium;
+            year_corrections(s, s->constituents[k], year, &node_factor, &equilibrium);
+            if(s->amps[k] * node_factor * level_scale(s)>task->min_amp) {
+                chosen[n_chosen++] = k;
+                break;
+            }
+        }
+    }
+    /* it also measures the choice at random times, which must be drawn here too for the test times to match */
+    for(int year=task->min_year; year<task->max_year; year++) {
+        for(int i=0; i<SELECTION_SAMPLES; i++) py_random_randint(&rng, year_start(year), year_start(year + 1));
+    }
+    for(int y=0; y<n_years; y++) {
+        double year_error, neaps, springs;
+        extract_cycles(s, task->min_year + y, chosen, n_chosen, &cycles[y]);
+        generate_tests(task, task->min_year + y, &cycles[y], &rng, test_times + y * TEST_TIMES, test_tides + y * TEST_TIMES,
+                       &year_error, &neaps, &springs);
+        mean_error += year_error;
+        if(y==0) {
+            neaps_range = neaps;
+            springs_range = springs;
+        }
+    }
+    mean_error /= n_years;
+
+    amps = checked_realloc(NULL, (size_t)(n_years * n_chosen) * sizeof(double));
+    phases = checked_realloc(NULL, (size_t)(n_years * n_chosen) * sizeof(double));
+    for(int y=0; y<n_years; y++) {
+        memcpy(amps + y * n_chosen, cycles[y].amps, (size_t)n_chosen * sizeof(double));
+        memcpy(phases + y * n_chosen, cycles[y].phases, (size_t)n_chosen * sizeof(double));
+    }
+    task->harmonic = checked_realloc(NULL, strlen(c_name) + 32);
+    sprintf(task->harmonic, "station_%s_%d", c_name, task->min_year);
+    const char *h = task->harmonic;
+
+    /* the tests come first, so the harmonic can point at them */
+    buffer_printf(b, "\n#ifdef TIDE_DEBUG\ntime_t %s_test_times [] = {", h);
+    for(int i=0; i<n_years * TEST_TIMES; i++) buffer_printf(b, "%s%lld", i ? ", " : "", (long long)test_times[i]);
+    buffer_printf(b, "};\nfloat %s_test_tides [] = {", h);
+    for(int i=0; i<n_years * TEST_TIMES; i++) {
+        if(i) buffer_append(b, ", ", 2);
+        buffer_number(b, test_tides[i]);
+    }
+    buffer_printf(b, "};\n#endif\n\n");
+
+    buffer_printf(b, "\n/* Mean error for %s in %d-%d is approximately %.5fm */\n", s->name, task->min_year, task->max_year, mean_error);
+    buffer_printf(b, "char %s_name [] = \"%s\";                    \n", h, s->name);
+    buffer_printf(b, "float %s_speed [] = {", h);
+    buffer_float_seq(b, cycles[0].speeds, n_chosen);
+    buffer_printf(b, "};                \nuint16_t %s_amp [] = {", h);
+    buffer_hex_seq(b, 16, MAX_AMP, amps, n_years * n_chosen);
+    buffer_printf(b, "};\nuint16_t %s_phase [] = {", h);
+    buffer_hex_seq(b, 16, MAX_PHASE, phases, n_years * n_chosen);
+    buffer_printf(b, "};\ntidal_harmonic %s_data = {\n"
+                     "        .type = TIDE_ENCODING_HARMONIC,\n"
+                     "        .chebyshev = NULL,\n"
+                     "        .speeds = %s_speed,\n"
+                     "        .amps = %s_amp,\n"
+                     "        .phases = %s_phase,\n"
+                     "        .n_constituents = %d,\n"
+                     "        .name = %s_name,\n"
+                     "        .base_year = %d,\n"
+                     "        .n_years = %d,\n"
+                     "        .lat = ", h, h, h, h, n_chosen, h, task->min_year, n_years);
+    buffer_number(b, s->lat);
+    buffer_append(b, ",\n        .lon = ", 17);
+    buffer_number(b, s->lon);
+    buffer_append(b, ",\n        .neaps_range = ", 25);
+    buffer_repr(b, neaps_range);
+    buffer_append(b, ",\n        .springs_range = ", 27);
+    buffer_repr(b, springs_range);
+    buffer_append(b, ",\n        .offset = ", 20);
+    buffer_number(b, s->offset);
+    buffer_append(b, ",\n        .mean_error = ", 24);
+    buffer_repr(b, mean_error);
+    buffer_printf(b, ",\n        .almanac = NULL,\n"
+                     "#ifdef TIDE_DEBUG\n"
+                     "        .test_times = %s_test_times,\n"
+                     "        .test_tides = %s_test_tides,\n"
+                     "        .n_tests = %d,\n"
+                     "#endif\n"
+                     "};\n\n", h, h, n_years * TEST_TIMES);
+
+    task->n_chosen = n_chosen;
+    task->mean_error = mean_error;
+    task->neaps_range = neaps_range;
+    task->springs_range = springs_range;
+    for(int y=0; y<n_years; y++) {
+        free(cycles[y].amps);
+        free(cycles[y].phases);
+        free(cycles[y].speeds);
+    }
+    free(cycles);
+    free(chosen);
+    free(test_times);
+    free(test_tides);
+    free(amps);
+    free(phases);
+    free(c_name);
+}
+
+/* The list, index and position tree (finalise_tides) */
+
+typedef struct spatial_entry {
+    double p[3];
+    int station;
+    int order; /* for a stable sort */
+} spatial_entry;
+
+static int sort_axis;
+
+static int compare_axis(const void *a, const void *b)
+{
+    const spatial_entry *x = a, *y = b;
+    if(x->p[sort_axis]!=y->p[sort_axis]) return x->p[sort_axis]<y->p[sort_axis] ? -1 : 1;
+    return x->order - y->order;
+}
+
+/* spatial_tree: the implicit k-d tree of tide_spatial.h, median first */
+static void spatial_tree(spatial_entry *points, int n, int axis, spatial_entry *out, int *n_out)
+{
+    if(n<2) {
+        if(n==1) out[(*n_out)++] = points[0];
+        return;
+    }
+    for(int i=0; i<n; i++) points[i].order = i;
+    sort_axis = axis;
+    qsort(points, (size_t)n, sizeof(spatial_entry), compare_axis);
+    int mid = n / 2;
+    spatial_tree(points, mid, (axis + 1) % 3, out, n_out);
+    out[(*n_out)++] = points[mid];
+    spatial_tree(points + mid + 1, n - mid - 1, (axis + 1) % 3, out, n_out);
+}
+
+static const station_spec *sorted_specs;
+
+/* name_key: bytes, ignoring the case of ASCII letters, with the original order kept between equals */
+static int compare_names(const void *a, const void *b)
+{
+    int i = *(const int *)a, j = *(const int *)b;
+    const unsigned char *x = (const unsigned char *)sorted_specs[i].alias, *y = (const unsigned char *)sorted_specs[j].alias;
+    for(; *x && tolower(*x)==tolower(*y); x++, y++);
+    if(tolower(*x)!=tolower(*y)) return tolower(*x) - tolower(*y);
+    return i - j;
+}
+
+static void finalise_tides(text_buffer *b, const char *prev_name, const station_spec *specs, int n_specs,
+                           const station_index *index, const compile_task *tasks)
+{
+    int *order = checked_realloc(NULL, (size_t)n_specs * sizeof(int));
+    spatial_entry *points = checked_realloc(NULL, (size_t)n_specs * sizeof(spatial_entry));
+    spatial_entry *tree = checked_realloc(NULL, (size_t)n_specs * sizeof(spatial_entry));
+    int n_points = 0, n_tree = 0;
+    for(int i=0; i<n_specs; i++) order[i] = i;
+    sorted_specs = specs;
+    qsort(order, (size_t)n_specs, sizeof(int), compare_names);
+    buffer_printf(b, "\ntidal_station * tidal_stations  = &%s;                    \n\ntidal_station *const tidal_station_index [] = {", prev_name);
+    for(int i=0; i<n_specs; i++) buffer_printf(b, "%s&station_%s", i ? ", " : "", specs[order[i]].alias);
+    buffer_printf(b, "};\nconst uint32_t n_tidal_stations = %d;\n\n", n_specs);
+    for(int i=0; i<n_specs; i++) {
+        /* positions are by alias, so a repeated alias takes the last one's */
+        int last = order[i];
+        for(int j=0; j<n_specs; j++) if(strcmp(specs[j].alias, specs[order[i]].alias)==0) last = j;
+        int task = index->bases[specs[last].base].task;
+        if(task<0) continue;
+        double lat = radians(tasks[task].station.lat.value), lon = radians(tasks[task].station.lon.value);
+        points[n_points].p[0] = cos(lat) * cos(lon);
+        points[n_points].p[1] = cos(lat) * sin(lon);
+        points[n_points].p[2] = sin(lat);
+        points[n_points++].station = i;
+    }
+    spatial_tree(points, n_points, 0, tree, &n_tree);
+    buffer_printf(b, "const tide_spatial_point tidal_station_points [] = {");
+    for(int i=0; i<n_tree; i++) {
+        buffer_printf(b, "%s{", i ? ", " : "");
+        buffer_float_seq(b, tree[i].p, 3);
+        buffer_printf(b, ", %d}", tree[i].station);
+    }
+    if(n_tree==0) buffer_printf(b, "{0}");
+    buffer_printf(b, "};\nconst uint32_t n_tidal_station_points = %d;\n\n", n_points);
+    free(order);
+    free(points);
+    free(tree);
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: %s <tcd.json> --stations <stations> [--seed N] [--base-year YEAR] [--years N]\n"
+                    "       [--min-amplitude METRES] [--output-file FILE] [--jobs N]\n", program);
+    exit(1);
+}
+
+static double elapsed_seconds(const struct timespec *start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+    const char *input = NULL, *stations = NULL, *output = "src/tide_data.c";
+    static const char *unsupported[] = {"--almanac", "--segment-hours", "--max-error", "--error-budget",
+                                        "--max-event-error", "--max-constituents", "--database"};
+    long long seed = 0;
+    int have_seed = 0, base_year = 0, have_base_year = 0, years = 5, jobs = tide_pool_default_threads();
+    double min_amp = 1e-3;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for(int i=1; i<argc; i++) {
+        char *option = argv[i], *value = NULL, *end;
+        if(strncmp(option, "--", 2)!=0) {
+            if(input) usage();
+            input = option;
+            continue;
+        }
+        if((value = strchr(option, '='))) *value++ = '\0';
+        for(size_t u=0; u<sizeof(unsupported) / sizeof(unsupported[0]); u++) {
+            if(strcmp(option, unsupported[u])==0) die("%s is only in scripts/extract_tides.py", option);
+        }
+        if(!value && i + 1<argc) value = argv[++i];
+        if(!value) usage();
+        if(strcmp(option, "--encoding")==0) {
+            if(strcmp(value, "harmonic")!=0) die("the %s encoding is only in scripts/extract_tides.py", value);
+            continue;
+        }
+        errno = 0;
+        if(strcmp(option, "--stations")==0) stations = value;
+        else if(strcmp(option, "--output-file")==0) output = value;
+        else if(strcmp(option, "--seed")==0) {
+            seed = strtoll(value, &end, 10);
+            have_seed = 1;
+        } else if(strcmp(option, "--base-year")==0) {
+            base_year = (int)strtol(value, &end, 10);
+            have_base_year = 1;
+        } else if(strcmp(option, "--years")==0) years = (int)strtol(value, &end, 10);
+        else if(strcmp(option, "--jobs")==0) jobs = (int)strtol(value, &end, 10);
+        else if(strcmp(option, "--min-amplitude")==0) min_amp = strtod(value, &end);
+        else usage();
+        if(strcmp(option, "--stations")!=0 && strcmp(option, "--output-file")!=0 && (*end || errno || end==value)) {
+            die("bad value for %s: %s", option, value);
+        }
+    }
+    if(!input || !stations) usage();
+    if(years<1) die("--years must be at least 1");
+    if(!have_base_year) {
+        time_t now = time(NULL);
+        base_year = year_of_time(now);
+        fprintf(stderr, "No base year specified, using current year (%d)\n", base_year);
+    }
+    if(!have_seed) {
+        seed = (long long)((uint64_t)time(NULL) * 2654435761u % 2147483648u);
+    }
+    fprintf(stderr, "Extracting data from '%s' to '%s' for %d to %d, seed %lld\n", input, output, base_year, base_year + years, seed);
+
+    station_index index = {0};
+    station_spec *specs = NULL;
+    int n_specs = parse_stations(stations, &specs, &index);
+    index_build(&index);
+
+    tcd_data data = {0};
+    read_tcd(input, &data, &index);
+    fprintf(stderr, "Read %d stations and %d tidal constituents from %s in %.2fs\n", data.n_records, data.n_constituents, input, elapsed_seconds(&start));
+
+    /* the constituent table, which a station's amplitudes and epochs are zipped with */
+    const tcd_constituent **table = checked_realloc(NULL, (size_t)data.n_constituents * sizeof(tcd_constituent *));
+    const tcd_constituent *m2 = NULL;
+    for(int i=0; i<data.n_constituents; i++) {
+        table[i] = &data.constituents[i];
+        if(strcmp(data.constituents[i].name, "M2")==0) m2 = table[i];
+    }
+    if(!m2) die("%s has no M2, which the clock station needs", input);
+
+    /* the clock first, then every match, by requested station and then in the order of the file */
+    int n_tasks = 1;
+    for(int b=0; b<index.n_bases; b++) n_tasks += index.bases[b].n_records;
+    compile_task *tasks = calloc((size_t)n_tasks, sizeof(compile_task));
+    static const double clock_amp = 1.0, clock_phase = 0.0;
+    if(!tasks) die("out of memory");
+    tasks[0].station.name = CLOCK_NAME;
+    tasks[0].station.lat = tasks[0].station.lon = tasks[0].station.zone_offset = tasks[0].station.offset = py_float(0.0);
+    tasks[0].station.units = "meters";
+    tasks[0].station.n_constituents = 1;
+    tasks[0].station.constituents = &m2;
+    tasks[0].station.amps = &clock_amp;
+    tasks[0].station.phases = &clock_phase;
+    tasks[0].min_year = 2000;
+    tasks[0].max_year = 2001;
+    tasks[0].min_amp = 0.0;
+    int t = 1;
+    for(int b=0; b<index.n_bases; b++) {
+        for(int m=0; m<index.bases[b].n_records; m++, t++) {
+            const tcd_station *station = &data.stations[index.bases[b].records[m]];
+            source_station *s = &tasks[t].station;
+            s->name = station->name;
+            s->lat = station->lat;
+            s->lon = station->lon;
+            s->zone_offset = station->zone_offset;
+            s->offset = station->offset;
+            s->units = station->units;
+            s->n_constituents = data.n_constituents;
+            if(station->n_amps<s->n_constituents) s->n_constituents = station->n_amps;
+            if(station->n_epochs<s->n_constituents) s->n_constituents = station->n_epochs;
+            s->constituents = table;
+            s->amps = station->amps;
+            s->phases = station->epochs;
+            tasks[t].min_year = base_year;
+            tasks[t].max_year = base_year + years;
+            tasks[t].min_amp = min_amp;
+        }
+    }
+    for(t=0; t<n_tasks; t++) tasks[t].seed = seed;
+    tide_pool_run(n_tasks, jobs<1 ? 1 : jobs, compile_station, tasks);
+
+    FILE *out = fopen(output, "w");
+    if(!out) die("can't write %s", output);
+    for(t=0; t<n_tasks; t++) {
+        fwrite(tasks[t].text.data, 1, tasks[t].text.length, out);
+        fprintf(stderr, "%-24s %3d constituents, mean error %.4fm, neap range %.2fm, spring range %.2fm\n", tasks[t].station.name,
+                tasks[t].n_chosen, tasks[t].mean_error, tasks[t].neaps_range, tasks[t].springs_range);
+    }
+    /* the last match of each requested station is the one its offsets refer to */
+    for(int b=0; b<index.n_bases; b++) {
+        if(strcmp(index.bases[b].name, CLOCK_NAME)==0) index.bases[b].harmonic = tasks[0].harmonic;
+    }
+    t = 1;
+    for(int b=0; b<index.n_bases; b++) {
+        for(int m=0; m<index.bases[b].n_records; m++, t++) {
+            index.bases[b].harmonic = tasks[t].harmonic;
+            index.bases[b].task = t;
+        }
+    }
+
+    /* dump_station_offset for each station, as a linked list */
+    text_buffer text = {0};
+    char *prev_name = NULL;
+    for(int i=0; i<n_specs; i++) {
+        const station_spec *spec = &specs[i];
+        const char *harmonic = index.bases[spec->base].harmonic;
+        buffer_printf(&text, "\nchar station_%s_name [] = \"%s\";\n\n"
+                             "tidal_offset station_%s_offset = {\n"
+                             "    .time_offset = %.0f,\n"
+                             "    .level_offset = %.5f,\n"
+                             "    .level_scale= %.5f,\n"
+                             "};\n\n"
+                             "tidal_station station_%s = {                       \n"
+                             "        .name = station_%s_name,\n"
+                             "        .previous = %s%s,\n"
+                             "        .harmonic = &%s_data,                        \n"
+                             "        .offset = &station_%s_offset,\n"
+                             "};\n\n",
+                      spec->alias, spec->alias, spec->alias, spec->seconds_offset, spec->level_offset, spec->level_scale,
+                      spec->alias, spec->alias, prev_name ? "&" : "", prev_name ? prev_name : "NULL",
+                      harmonic ? harmonic : "None", spec->alias);
+        free(prev_name);
+        prev_name = checked_realloc(NULL, strlen(spec->alias) + 16);
+        sprintf(prev_name, "station_%s", spec->alias);
+    }
+    finalise_tides(&text, prev_name, specs, n_specs, &index, tasks);
+    fwrite(text.data, 1, text.length, out);
+    if(fclose(out)!=0) die("can't write %s", output);
+    fprintf(stderr, "Wrote %d reference stations and %d stations to '%s' in %.2fs\n", n_tasks - 1, n_specs, output, elapsed_seconds(&start));
+    return 0;
+}
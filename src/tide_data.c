@@ -1,10 +1,16 @@
 
+#ifdef TIDE_DEBUG
+time_t station_clock_2000_test_times [] = {957512471, 954023606, 961792937, 956100862, 969610049, 953649953, 976498412, 970742608, 958480642, 970762233, 968296098, 960714244, 954584531, 948225645, 961083683, 950176688, 958210685, 974173612, 948411649, 965745587, 976063174, 970679205, 965417847, 963702699, 973496453, 962414000, 972446484, 958430714, 954162882, 967958155, 965615267, 948237325, 948765607, 976190798, 947434990, 946763984, 958493619, 949678809, 966645523, 975522802, 947327498, 948228813, 978298370, 962455839, 951962862, 958809340, 959512336, 968354956, 955135259, 957899714, 947775503, 962380572, 949255397, 967431600, 967354069, 964192807, 964817810, 955438917, 976097750, 969344081, 960810774, 953297922, 956629162, 965290385, 953005996, 953219177, 971648716, 949671744, 964694924, 947930436, 967787721, 957269606, 949752209, 964830440, 976739161, 952343737, 968738398, 950748095, 975142428, 969758681, 951582696, 957238987, 968873459, 958742395, 967771822, 973301790, 974587540, 978060113, 948062158, 948168886, 962649265, 966594258, 965689042, 968516165, 947537456, 967517813};
+float station_clock_2000_test_tides [] = {-1.0018633618807562, -1.0161864825362315, -0.040196371020987096, 0.9795907955057146, 0.8893854416091035, 0.6261618598951858, 0.6785752690209877, -0.855350412305995, 0.43722906796249866, 0.5875843904891482, -0.345443803535257, 0.6857688984044071, 0.9749515237749663, 0.5096181854751605, -0.8003796213618671, -0.9947950750732253, 0.6387653410480005, 0.6420569216127521, 1.015340324190151, -0.5740360293805703, -0.8215354085482446, 1.0146696291085109, -0.4601604180898796, 0.9940977516566054, 1.016017213603353, 0.6181707811390047, -1.0115792769178424, 0.9385835322446228, -0.7596117693390978, 0.6626549696905729, -0.0641417844323201, 0.8411146645763795, 0.8561820477993057, -0.025933833534578805, 0.5911963290502144, 0.6247757179027239, -0.997514777212787, -0.5038821881917646, 0.1959275638198795, -0.4024910963949366, -0.017884010745863665, 0.838529427926168, -0.7763951822694053, 0.8854684070220241, -0.8706546298904126, -0.9978340381275459, -0.014700832744110454, 1.013723327958836, -0.6581997409640519, 0.3907940174194011, 0.10520938771532523, -0.8158087500993364, 0.6636899662237831, -0.6522831577907023, -0.7094812707685759, 0.9130155508589758, 0.8419035135337652, 0.5805120637765638, 0.4720600880978715, 0.6854240245694728, -0.258470720536515, -0.1363574667547418, 0.1412734616064267, -1.0028732162781704, -0.046553068286748496, -1.01405378340338, -0.4688506067256182, 0.4638011623273516, 0.559831746155718, 0.11803431458263607, -0.46312277992288364, 0.8395254149085254, 1.0027837895857943, 0.3867676027352089, -1.009847745317364, 0.924219100542064, -0.8697148473912709, 0.0231058393492631, 0.3623294040629729, -0.8383555155881226, 0.8635362724665534, -0.8596906517104925, -0.7948307525454545, 0.9942653255956949, 0.9978914351983741, -0.6304547437504177, -0.8159041443201464, 0.9449742758572973, 0.4479872095071829, -0.9345538418336576, -0.8491878639991962, -0.675016188806345, -0.7824750462817315, -0.7561654454184972, -0.95117914012808, -0.24662284844469706};
+#endif
+
 /* Mean error for CLOCK in 2000-2001 is approximately 0.00010m */
 char station_clock_2000_name [] = "CLOCK";                    
 float station_clock_2000_speed [] = {1.4051890250864362e-04};                
 uint16_t station_clock_2000_amp [] = {0x15AD};
 uint16_t station_clock_2000_phase [] = {0x5FAB};
 tidal_harmonic station_clock_2000_data = {
+        .name = station_clock_2000_name,
         .base_year = 2000,
         .n_years = 1,
         .lat = 0.0,
@@ -17,22 +23,29 @@ tidal_harmonic station_clock_2000_data = {
         .phases = station_clock_2000_phase,
         .n_constituents = 1,
         .mean_error = 0.00010139628687352463,
-
+        .almanac = NULL,
+#ifdef TIDE_DEBUG
+        .test_times = station_clock_2000_test_times,
+        .test_tides = station_clock_2000_test_tides,
+        .n_tests = 96,
+#endif
 };                                                    
 
 
+
+
 #ifdef TIDE_DEBUG
-time_t station_clock_2000_test_times [] = {957512471, 954023606, 961792937, 956100862, 969610049, 953649953, 976498412, 970742608, 958480642, 970762233, 968296098, 960714244, 954584531, 948225645, 961083683, 950176688, 958210685, 974173612, 948411649, 965745587, 976063174, 970679205, 965417847, 963702699, 973496453, 962414000, 972446484, 958430714, 954162882, 967958155, 965615267, 948237325, 948765607, 976190798, 947434990, 946763984, 958493619, 949678809, 966645523, 975522802, 947327498, 948228813, 978298370, 962455839, 951962862, 958809340, 959512336, 968354956, 955135259, 957899714, 947775503, 962380572, 949255397, 967431600, 967354069, 964192807, 964817810, 955438917, 976097750, 969344081, 960810774, 953297922, 956629162, 965290385, 953005996, 953219177, 971648716, 949671744, 964694924, 947930436, 967787721, 957269606, 949752209, 964830440, 976739161, 952343737, 968738398, 950748095, 975142428, 969758681, 951582696, 957238987, 968873459, 958742395, 967771822, 973301790, 974587540, 978060113, 948062158, 948168886, 962649265, 966594258, 965689042, 968516165, 947537456, 967517813};
-float station_clock_2000_test_tides [] = {-1.0018633618807562, -1.0161864825362315, -0.040196371020987096, 0.9795907955057146, 0.8893854416091035, 0.6261618598951858, 0.6785752690209877, -0.855350412305995, 0.43722906796249866, 0.5875843904891482, -0.345443803535257, 0.6857688984044071, 0.9749515237749663, 0.5096181854751605, -0.8003796213618671, -0.9947950750732253, 0.6387653410480005, 0.6420569216127521, 1.015340324190151, -0.5740360293805703, -0.8215354085482446, 1.0146696291085109, -0.4601604180898796, 0.9940977516566054, 1.016017213603353, 0.6181707811390047, -1.0115792769178424, 0.9385835322446228, -0.7596117693390978, 0.6626549696905729, -0.0641417844323201, 0.8411146645763795, 0.8561820477993057, -0.025933833534578805, 0.5911963290502144, 0.6247757179027239, -0.997514777212787, -0.5038821881917646, 0.1959275638198795, -0.4024910963949366, -0.017884010745863665, 0.838529427926168, -0.7763951822694053, 0.8854684070220241, -0.8706546298904126, -0.9978340381275459, -0.014700832744110454, 1.013723327958836, -0.6581997409640519, 0.3907940174194011, 0.10520938771532523, -0.8158087500993364, 0.6636899662237831, -0.6522831577907023, -0.7094812707685759, 0.9130155508589758, 0.8419035135337652, 0.5805120637765638, 0.4720600880978715, 0.6854240245694728, -0.258470720536515, -0.1363574667547418, 0.1412734616064267, -1.0028732162781704, -0.046553068286748496, -1.01405378340338, -0.4688506067256182, 0.4638011623273516, 0.559831746155718, 0.11803431458263607, -0.46312277992288364, 0.8395254149085254, 1.0027837895857943, 0.3867676027352089, -1.009847745317364, 0.924219100542064, -0.8697148473912709, 0.0231058393492631, 0.3623294040629729, -0.8383555155881226, 0.8635362724665534, -0.8596906517104925, -0.7948307525454545, 0.9942653255956949, 0.9978914351983741, -0.6304547437504177, -0.8159041443201464, 0.9449742758572973, 0.4479872095071829, -0.9345538418336576, -0.8491878639991962, -0.675016188806345, -0.7824750462817315, -0.7561654454184972, -0.95117914012808, -0.24662284844469706};
+time_t station_bangor_northern_ireland_2023_test_times [] = {1698045081, 1695866437, 1678064765, 1673616003, 1690524656, 1701224825, 1674139099, 1680278105, 1686131817, 1677326980, 1703155302, 1685959448, 1697473777, 1693308382, 1686031983, 1683732113, 1699496166, 1703807482, 1686816927, 1685050743, 1682081248, 1696303582, 1692665315, 1676179395, 1673258206, 1700455406, 1683499320, 1702523602, 1703145906, 1681492350, 1674813842, 1686732575, 1676064564, 1697029727, 1698278988, 1686381669, 1697231074, 1697100250, 1695952199, 1690247026, 1700476294, 1698748324, 1680447296, 1703808643, 1692822089, 1685209756, 1692527313, 1701207488, 1674555384, 1700077681, 1690268475, 1672732918, 1689878262, 1693237717, 1685787500, 1678815402, 1689567950, 1695538367, 1686626007, 1688783061, 1676344367, 1681159678, 1704008270, 1674235686, 1674579971, 1676911097, 1700919161, 1701625887, 1674933329, 1682364284, 1700002676, 1691207793, 1685146751, 1675596752, 1699270635, 1689420204, 1694698792, 1699324434, 1700580174, 1694056952, 1681330592, 1694837310, 1691456675, 1689075405, 1687965910, 1692924045, 1702899788, 1696120637, 1693274937, 1676276203, 1703993843, 1703857602, 1684656351, 1701943584, 1681276096, 1696625579, 1730109411, 1715091362, 1709774638, 1713755074, 1710679396, 1716960659, 1722970881, 1710723113, 1722984444, 1715470530, 1735330537, 1730413285, 1704964019, 1722251643, 1731646872, 1711863302, 1705106445, 1711548929, 1721091076, 1718309420, 1712321024, 1720844254, 1730734667, 1704769727, 1708020957, 1722619479, 1712371576, 1707721113, 1716698951, 1715708625, 1732178029, 1705443990, 1712007115, 1729857405, 1704520640, 1724460016, 1718142262, 1721126695, 1728178316, 1713937116, 1734935246, 1708353472, 1726097950, 1708398968, 1716516199, 1709136262, 1720726887, 1724913277, 1719401699, 1719895930, 1723576110, 1727500327, 1713808285, 1711356366, 1726237123, 1722844175, 1707288784, 1716475835, 1718003827, 1722195502, 1730840028, 1704206348, 1730961029, 1706924333, 1712541312, 1729049513, 1727772609, 1733869049, 1713026858, 1725617822, 1716894061, 1718817584, 1727408050, 1710839643, 1704670730, 1718699871, 1732937624, 1733515580, 1707236623, 1723162606, 1719532043, 1722553298, 1727530371, 1732345839, 1735085406, 1711311646, 1715486760, 1704448969, 1734064379, 1731265246, 1712189713, 1718748209, 1725187563, 1712371332, 1716672424, 1706537613, 1753134861, 1741964925, 1753739845, 1745782562, 1747370697, 1751453235, 1763620160, 1757972467, 1764345779, 1765167708, 1739517593, 1739294328, 1745666445, 1766106901, 1761897597, 1760556971, 1765632428, 1755080116, 1759426514, 1756708126, 1767159800, 1759740632, 1755681103, 1739436306, 1761398605, 1765828723, 1741930639, 1755257434, 1739947876, 1761034581, 1741840707, 1741245921, 1736747880, 1748871536, 1752928463, 1755045481, 1738994388, 1762031472, 1751532048, 1740111831, 1750633743, 1737572799, 1754275699, 1755442163, 1744671620, 1752243436, 1751577259, 1746421606, 1744914567, 1760070451, 1746126733, 1758992202, 1743640212, 1762627969, 1765965751, 1767191040, 1751829225, 1766787636, 1747604789, 1747673023, 1763700689, 1759940655, 1757155066, 1747693294, 1758682444, 1765511024, 1741326612, 1742329524, 1752858648, 1743800152, 1764669139, 1745129997, 1746976456, 1766225037, 1741641368, 1763588173, 1760180151, 1737107463, 1756890693, 1737268874, 1750994842, 1753166622, 1763849892, 1760791020, 1764714192, 1758316083, 1748911306, 1742138205, 1744265129, 1763900311, 1737605586, 1744721294, 1745394470, 1766417071, 1746597291, 1735998175, 1794139992, 1778672994, 1782959151, 1770446464, 1791247918, 1793804208, 1792791842, 1772358763, 1781234455, 1776620652, 1794633821, 1773318944, 1784744350, 1777994895, 1781974230, 1795933653, 1773151742, 1787787198, 1796432740, 1788572783, 1775224621, 1788991721, 1779809767, 1791179205, 1782182243, 1779820150, 1796156173, 1786428524, 1789629922, 1778007602, 1792232335, 1780094745, 1789035551, 1790337909, 1788449095, 1773569007, 1773874465, 1778221937, 1770580498, 1780945474, 1783749877, 1783871255, 1790240350, 1771445171, 1769041830, 1769849454, 1776424747, 1789791531, 1781312447, 1775514099, 1789481730, 1782703098, 1789114777, 1769982255, 1774399733, 1780195334, 1789438021, 1786548540, 1791829284, 1797691650, 1795967782, 1798344192, 1788226411, 1768922067, 1778193262, 1791077576, 1791224129, 1769637150, 1777057869, 1769182453, 1793463996, 1794868421, 1780316102, 1795013205, 1790538106, 1779831924, 1786419853, 1793309917, 1788170019, 1771389283, 1777336547, 1786477974, 1780552170, 1777427902, 1792529713, 1794624042, 1770211097, 1785396283, 1794158962, 1793703721, 1786287866, 1773592275, 1791852978, 1794949641, 1770598835, 1785789162, 1816319339, 1826673345, 1820480122, 1814211705, 1818116942, 1821813554, 1828127783, 1824333743, 1828884682, 1823356912, 1816782769, 1820105665, 1814606191, 1815664668, 1819671951, 1809849051, 1826095191, 1814551064, 1807317158, 1814115360, 1804313650, 1817439856, 1820373641, 1817196113, 1807170036, 1814013939, 1809756410, 1823158841, 1801429888, 1829914245, 1817533503, 1807884155, 1816298577, 1814802317, 1816532830, 1818223970, 1811992266, 1815483827, 1816524830, 1823588944, 1805472901, 1817671734, 1829932696, 1827515696, 1829831181, 1821766436, 1820470129, 1808312606, 1823229171, 1811728012, 1814258526, 1823272705, 1824025954, 1799188602, 1817936443, 1804124041, 1811421337, 1804975563, 1826199841, 1822059784, 1821866610, 1801314830, 1827526873, 1805007554, 1828138814, 1829154650, 1808720491, 1812226761, 1807849116, 1808358778, 1803907981, 1806830164, 1820924952, 1820420001, 1813688375, 1814850125, 1819326895, 1804621951, 1805717029, 1799645532, 1808674645, 1802239993, 1817028779, 1821984514, 1814148997, 1809995846, 1827336493, 1821558979, 1812985595, 1816770695, 1813456351, 1799920601, 1810709680, 1813410131, 1819964461, 1820757401};
+float station_bangor_northern_ireland_2023_test_tides [] = {2.641773127495468, 1.0304253159746974, 2.3470397850215803, 2.9527090898035935, 2.9257120609733436, 2.4151833897372668, 0.9647473266876916, 1.685603015248528, 1.7109828225085821, 2.4701807971411425, 1.4116710291347248, 2.902297998608174, 1.2019869325788848, 2.5952902439480816, 0.5323483976834517, 3.030328390472605, 0.994760229601777, 3.2069180355782225, 3.19258805148837, 1.2313182814291836, 3.251245212312021, 2.696775176620144, 3.046898182130821, 2.2479287363236486, 2.562995497925276, 3.0117942608562904, 2.9557779121998893, 1.597451628015951, 2.5795313140904113, 2.7859560735095736, 1.0275869295705358, 3.1105484534940664, 1.0151491886548694, 1.7562490494985739, 1.5917544525296883, 1.6386869022231954, 3.1498167650712654, 2.944566685971016, 1.6738712022625841, 2.4717502114635277, 1.3766688910984302, 2.931183241426944, 0.8635165764059223, 3.2256067047967227, 1.0908191083508574, 2.5350457772400246, 1.9845317761286705, 2.780157616967531, 2.689819984872565, 1.3151043481844351, 1.6774176260652967, 3.098933709508668, 0.878676812461172, 1.2354454703345892, 3.213723663901976, 2.5708753348047537, 0.7623492435552275, 2.6889254836224565, 1.8818510982773515, 3.5673366018034756, 2.738949622980893, 0.9023120853591906, 1.0393567826671202, 1.1891434798749108, 1.1994670097288402, 0.34073712328147954, 1.408966507390986, 2.3062989297072054, 2.20955374110776, 0.8745595239223225, 3.388346746971194, 2.380185303361853, 1.8677484493557213, 3.405983010457376, 1.5743313008962185, 2.6001410201950015, 2.2196866910234183, 1.6745695263030764, 2.816023531464626, 3.091285863504926, 1.2039935342615489, 0.9895722565828362, 2.4698494389122074, 0.6325938685165047, 1.7535643894304531, 1.7368814340255796, 2.268236200208462, 3.5079767775744517, 0.8808160646821513, 1.259219993425995, 2.558254697306367, 3.3174876655805696, 1.3918169774230735, 1.9885607300924966, 2.446887650854322, 1.3281862411555205, 2.8687444809093177, 1.1595972867675637, 1.1712576516851991, 1.0584502998418723, 1.5809371476212262, 2.2718659813965796, 0.952307551011749, 1.5356654857404306, 3.015050930101284, 2.8015708325786712, 3.029328702766257, 3.4181860937304727, 3.0675570976473843, 0.7362734125175142, 0.704637848350377, 1.896838564188768, 3.3076677341546814, 2.7357807723904535, 1.2881725812937208, 1.573661082799823, 1.0855707170541897, 3.083184279058477, 2.1723782685819293, 0.9977242838282835, 2.129217121911979, 1.4054988411425038, 0.884836185727283, 0.6477256710422548, 1.2932359060491256, 2.430737696712761, 1.2138834872826982, 0.793777492679069, 1.0926667394939618, 1.5384842769181977, 2.7863215712642213, 3.462017306430894, 1.2825799575727734, 1.3908037494393934, 3.207889459357139, 0.7674347540640056, 2.554789202989292, 1.2888655963428743, 1.3920836171305757, 1.36339262038877, 2.226439402936861, 2.2664573341820864, 1.0902150470942547, 2.8634606869436103, 2.070455831403819, 2.3540474290688693, 2.3396698853380187, 1.980961718832134, 0.9869213743145437, 2.39964475962449, 1.692004968571471, 1.3671292941552662, 2.6462247606519282, 1.3852119682902047, 0.5705714203008944, 1.963032722192678, 1.371769251192804, 3.3098882506831706, 1.4862091836177065, 2.1396892410786355, 1.5100785617533874, 0.3858273892443044, 2.762031990551376, 1.6921920372603894, 2.4439948138692773, 2.21191446643535, 1.6934835952026932, 1.4903567270900815, 1.874838052027966, 2.2058652254136866, 1.7242895761339794, 2.914062591957136, 0.9610114889463276, 0.9237976165531053, 1.6594020433916288, 3.084424539842221, 1.9007669633416477, 2.61435087838823, 1.3960918158003541, 2.3307985502239092, 1.1350187260696858, 2.0269346701995588, 2.3730252329333457, 1.553476228491578, 1.1745740932231723, 2.9799196225070324, 1.2457963114849306, 2.7631440828021328, 3.0212516299833303, 0.8845619704295362, 2.2519174733803435, 3.3451076954022336, 2.614823721533887, 1.4709690050737148, 1.7249764739830609, 1.8785802579092037, 1.6347953516294254, 0.8197223974762559, 1.402113231669299, 1.364826256294627, 3.2008548138407082, 1.9781227887669417, 1.064860970300976, 0.7035817561896371, 2.798790606375271, 2.2066491822589485, 2.507439419365822, 2.910276112540888, 1.6040294683094871, 1.5715127832991038, 2.7076744675756834, 2.4700303747647676, 2.613377406584552, 3.0545684233517494, 2.9884752855836596, 2.270997857700029, 3.2997154710198418, 3.160199497778684, 0.8113924310787444, 1.4206768956107425, 1.5241276711407798, 2.3269029527774143, 0.8527998622349005, 1.367178645646696, 1.3686318670622624, 2.038057781044443, 0.8413068533619465, 3.525635777097565, 2.8061356478982327, 2.823362212417854, 1.4539081298400334, 2.807481169033996, 2.1024451730169242, 2.461544623378587, 1.6732369123246549, 2.2887496401033145, 2.9766714472814266, 2.085778665870434, 1.6013154249520143, 3.09754770773585, 1.0094446193706328, 1.442932034268608, 0.7692681539539121, 2.188293729933434, 2.870153481063659, 0.5384946723894993, 3.1358116391288924, 1.0098695747915927, 2.763539967140063, 0.9180790319928925, 1.2319342213938023, 2.71541550002747, 0.9304157599430509, 0.7953683905657194, 3.077968511333243, 1.1971248124046376, 2.215671016793664, 2.759533133905129, 2.7961809210678497, 0.8419242500644583, 3.0187271027547076, 1.1981039216084455, 2.92864378155818, 2.070072992202741, 0.9107910957793494, 3.219948740498398, 2.972561023354753, 3.209930261899868, 2.3441583164427224, 1.9945296082670962, 2.4231319394694606, 1.362692662415027, 1.6054030157227084, 2.692850337916456, 2.6285014806400957, 2.0054346066757005, 2.942550063772132, 3.3679182572860125, 1.8182901643356486, 2.107106289530591, 1.773120349128174, 3.4183566135892454, 2.612729105686849, 3.2463262256511745, 2.835176427501612, 2.3727767720424637, 2.819071667275915, 3.600737680610626, 2.805625718340911, 1.4323669948028344, 2.6951488768337772, 1.2955591390105965, 0.9507386347963648, 1.674890570907412, 3.237249324731523, 3.3006731036619534, 1.257673814019445, 0.5008742423257679, 1.7072068213631943, 1.4004987485331533, 2.7589253371096123, 2.380829130970157, 2.7638359272320145, 1.508009084855961, 2.771873013941055, 3.0947122082453387, 1.0636946071015585, 2.3262820892249554, 2.644469359673673, 3.459340979154569, 1.1511515744632292, 2.922181316840143, 2.2372368132844875, 2.612906621357548, 1.802406113118405, 1.6777793666753817, 1.1192972924636415, 0.8519661561204428, 1.5785029871406349, 3.0859134485086313, 3.194307791356713, 2.6525142748283113, 3.177244263354791, 2.7400673120121155, 3.212254097556756, 1.6981343049868705, 1.2650834879407142, 2.256254758823169, 2.8547599333220397, 0.8480104728548544, 3.0298414630637276, 1.3210398772847138, 3.144522690271262, 3.276545943888113, 3.3016005646640254, 2.8184628717959277, 1.2384560004770795, 1.8188373371392272, 3.084168579468852, 1.1260531842907675, 2.0950494837429416, 2.979607143492216, 2.4050916523780197, 1.5510049154369818, 3.2969693743933624, 0.9902436741708094, 0.735757131616454, 1.9394212128238921, 3.2420423097501203, 2.194161186485558, 3.450580939031789, 2.165181778966229, 1.6365434174742277, 2.1912653980311068, 3.139006943340649, 2.1374042039296404, 2.5396732738805885, 3.0489261386704833, 2.9405742673692665, 1.2076321639527572, 3.064298661542984, 2.49542178031558, 1.8162887457870178, 2.6471496925030698, 0.6320058060716774, 1.868985846720135, 1.988636259515601, 0.8638793503985926, 1.6127232186371434, 2.7667300663112924, 1.1298195714554624, 1.210863444720685, 2.393171391091996, 2.9652480280889058, 3.613569439558797, 1.1795086662208416, 1.0798088984046759, 1.5135342007856287, 1.2130897622308037, 1.1730769802990022, 3.3407497038848084, 1.4785955913472812, 2.058382661395646, 0.8384090369718912, 1.671327791183071, 2.65729837093514, 1.8838015190984165, 2.4159966934810493, 1.4705995163702887, 2.5251056592682115, 1.4685157542103462, 0.9840169785972446, 1.816921341339879, 1.2811279891835048, 1.4883658228047032, 3.498869596168853, 3.1078289896694105, 1.0541257613192978, 2.479477762839948, 0.7925497862081037, 3.005687680217613, 1.7560688282374761, 3.32436372205114, 2.8178340381753206, 1.6908581480265354, 1.4044039964884165, 2.9324153114147338, 2.616803889563696, 1.4284522433722582, 1.7556639949187047, 0.5448766709385107, 2.541595104541759, 2.2187270090884383, 2.4205564211061534, 0.5794382284611881, 0.7094997203816654, 2.7432699172998727, 1.4128658499087507, 2.7419153774617717, 1.8750048605538383, 0.8294828385597786, 0.9105498159051346, 2.8168703548553133, 2.5627831093059594, 0.9139038771789857, 0.6810817351314444, 1.2570252549749026, 1.105596306413149, 1.3807514921390656, 2.641357685294049, 2.7512112567203983, 2.7921510942426426, 1.6211127672874182, 1.2922439322843988, 2.1567023215402368, 1.848411373666377, 1.7526207111231216, 3.0516239018434113, 1.2901745865725724, 1.3805562534605866, 1.7600280585890422, 1.2393471432387837, 2.2581572584319036, 1.1685386665457422, 1.7991917190561062, 1.6421019188313493, 3.0072634479836053, 1.1365604399419307, 1.256233495299345, 1.4395068122962704, 1.354425210802114, 2.1054533943958993, 2.3727231241035214, 2.4287523813281457, 1.586344779244931, 3.1307795998760715, 2.4788804944680733, 2.94417264366909, 0.9480093612912496, 0.6324336092003644, 1.1834845781109498, 1.2008584617010518, 3.292311896889652, 1.1839789067605422, 1.5306513940098738, 0.8635433367190923, 2.8017392225653683, 3.117971140387175, 2.2983226313808522, 3.0624074396881755, 1.0156403719899807, 0.8499014817478763, 1.0592260015309887, 1.1190234517016637, 2.581458588943936, 1.2358106256657955, 1.9346958089265525, 2.611619136200993, 1.9430152700878478, 1.3455814254262417};
 #endif
 
-
 /* Mean error for Bangor, Northern Ireland in 2023-2028 is approximately 0.00077m */
 char station_bangor_northern_ireland_2023_name [] = "Bangor, Northern Ireland";                    
 float station_bangor_northern_ireland_2023_speed [] = {7.2921158357870547e-05, 1.4584231720055478e-04, 1.4315810553074262e-04, 1.4051890250864362e-04, 2.1077835376296543e-04, 2.8103780501728725e-04, 4.2155670752593087e-04, 1.3787969948654463e-04, 1.3524049646444563e-04, 6.7597744150773076e-05, 7.2522945974990243e-05, 6.4958541128674080e-05, 6.2319338106575097e-05, 7.2722052166430395e-05, 1.4544410433286079e-04, 1.4524500735288060e-04, 1.4280490131076179e-04, 1.3559370068442646e-04, 1.3823290370652545e-04, 2.1344006135132787e-04, 2.7839860199518825e-04, 2.8596300684150439e-04, 1.5036930615707798e-04, 5.3234146919111522e-06, 1.9910619144015089e-07, 3.9821286769398287e-07, 4.2648190935014801e-04, 1.3066849886020929e-04, 1.4091711537633761e-04, 1.3295449766232746e-04, 2.2859988021181762e-06, 1.4808330735495979e-04, 1.3519548781673247e-04, 1.4012068964094966e-04, 2.1836526269073135e-04, 1.3330770188230829e-04, 1.5076751902477192e-04, 7.0259451254321812e-05, 1.3255628527944716e-04, 1.4071800918489746e-04};                
-uint16_t station_bangor_northern_ireland_2023_amp [] = {0x285, 0x24C, 0x184, 0x17F6, 0x8D, 0x44, 0x24, 0x487, 0x84, 0x26F, 0xD1, 0xD8, 0x2E, 0x33, 0x62E, 0x66, 0xB0, 0xEF, 0x12C, 0x37, 0x24, 0x5C, 0x75, 0x8D, 0x1C6, 0x93, 0x2F, 0x2E, 0x31, 0x4C, 0x67, 0x5C, 0x8B, 0x39, 0x35, 0x25, 0x50, 0x25, 0x37, 0x2B, 0x28B, 0x25D, 0xDD, 0x17DA, 0x8C, 0x43, 0x24, 0x481, 0x84, 0x278, 0xD1, 0xDB, 0x2F, 0x33, 0x62E, 0x66, 0xAF, 0xEE, 0x12B, 0x37, 0x24, 0x5B, 0x74, 0x91, 0x1C6, 0x93, 0x2F, 0x2D, 0x32, 0x4C, 0x66, 0x5B, 0x51, 0x3A, 0x36, 0x52, 0x24, 0x39, 0x2B, 0x28B, 0x25E, 0x176, 0x17D8, 0x8B, 0x43, 0x24, 0x481, 0x84, 0x278, 0xD1, 0xDC, 0x2F, 0x33, 0x62E, 0x66, 0xAF, 0xEE, 0x12A, 0x37, 0x24, 0x5B, 0x74, 0x92, 0x1C6, 0x93, 0x2F, 0x2D, 0x32, 0x4C, 0x65, 0x5B, 0x89, 0x3A, 0x36, 0x24, 0x52, 0x23, 0x39, 0x2B, 0x286, 0x250, 0x1F1, 0x17F1, 0x8C, 0x43, 0x24, 0x486, 0x84, 0x271, 0xD1, 0xD9, 0x2E, 0x33, 0x62E, 0x66, 0xB0, 0xEF, 0x12C, 0x37, 0x24, 0x5B, 0x75, 0x8E, 0x1C6, 0x93, 0x2F, 0x2E, 0x31, 0x4C, 0x67, 0x5B, 0xB3, 0x39, 0x35, 0x30, 0x50, 0x25, 0x37, 0x2B, 0x27B, 0x233, 0x198, 0x181F, 0x8E, 0x45, 0x25, 0x48E, 0x85, 0x261, 0xD1, 0xD3, 0x2D, 0x33, 0x62E, 0x66, 0xB1, 0xF1, 0x12E, 0x36, 0x24, 0x5C, 0x76, 0x85, 0x1C6, 0x93, 0x30, 0x2F, 0x2F, 0x4D, 0x6A, 0x5D, 0x8C, 0x37, 0x34, 0x28, 0x4D, 0x27, 0x34, 0x2C};
-uint16_t station_bangor_northern_ireland_2023_phase [] = {0x7F0B, 0x8926, 0x3E36, 0x863F, 0x49D9, 0x9061, 0xB10E, 0x5B76, 0x33C8, 0x48BE, 0x78C7, 0x3660, 0x1F33, 0x33F0, 0x8F, 0x586, 0x4B4C, 0x79B6, 0x3C49, 0xD0F4, 0x4C2A, 0x1B88, 0xE3F8, 0x8457, 0x1AE4, 0x2C92, 0x2D41, 0x95AD, 0x7A50, 0x49EB, 0xF0D5, 0x9C47, 0x895, 0x7A8B, 0x3505, 0x4A51, 0x6FC7, 0x3721, 0xCD7E, 0x2E1F, 0x80A1, 0x8C85, 0xB871, 0xCE60, 0x360B, 0x20A3, 0x8971, 0x647F, 0xFDB8, 0x8E91, 0x78F3, 0x3D1C, 0xE6D6, 0x33F0, 0x8F, 0x5B5, 0xCB1, 0x97E, 0xB28, 0x1AAC, 0x9D52, 0x63A9, 0x9BD8, 0x40D4, 0x1AB9, 0x2C3C, 0xBD82, 0x6E10, 0xC5D0, 0x9B13, 0x6A18, 0xDB5E, 0x8879, 0xC087, 0x369A, 0x2B05, 0xDB32, 0x1A0C, 0x7614, 0x8301, 0x917B, 0x26A2, 0x534, 0x846, 0x8E48, 0x2DEA, 0x52EF, 0xA3C7, 0xC249, 0x786C, 0x2872, 0x89CC, 0x33F0, 0x8F, 0x530, 0xC4D3, 0x769E, 0xC0AA, 0x53DD, 0xC297, 0x9A7C, 0x6504, 0x1036, 0x1B3F, 0x2D4C, 0x2B28, 0x1289, 0x199, 0xC058, 0xEB67, 0x23C1, 0xE025, 0xF3B8, 0x38FA, 0x30A3, 0xF927, 0x769C, 0x3919, 0xAD6E, 0x849C, 0x94E5, 0xBBEC, 0x4D56, 0xF479, 0x1E8E, 0x652, 0x5BFB, 0x6DBC, 0x819, 0x7896, 0x2F2A, 0x516B, 0x33F0, 0x8F, 0x55E, 0x8638, 0x668, 0x8F8A, 0x9D9D, 0x13C6, 0xE29E, 0x1CE2, 0xCCBB, 0x1B15, 0x2CF4, 0xBB6C, 0xEAF0, 0x4D27, 0x1187, 0x64AB, 0x62D7, 0x7B10, 0x39B2, 0x3A96, 0x5633, 0xB471, 0x1AAE, 0x859F, 0xF564, 0x8607, 0x97D9, 0x5159, 0x9563, 0xE08E, 0xAEAA, 0xDE7B, 0x64F2, 0x379B, 0x4E0E, 0x78C2, 0x3609, 0x1933, 0x33F0, 0x8F, 0x58D, 0x4789, 0x961B, 0x5E55, 0xE716, 0x64CA, 0x2AAC, 0xD4D5, 0x88DB, 0x1AEA, 0x2C9D, 0x4B8A, 0xC31A, 0x9827, 0x628B, 0xDDED, 0xA1F0, 0x1681, 0x7FD5, 0x3C00, 0x7BBD, 0x6F54, 0xBEB3, 0xD275, 0x3D48};
+uint16_t station_bangor_northern_ireland_2023_amp [] = {0x285, 0x24C, 0x184, 0x17F6, 0x8D, 0x44, 0x24, 0x487, 0x84, 0x26F, 0xD1, 0xD8, 0x2E, 0x33, 0x62E, 0x66, 0xB0, 0xEF, 0x12C, 0x37, 0x24, 0x5C, 0x75, 0x8D, 0x1C6, 0x93, 0x2F, 0x2E, 0x31, 0x4C, 0x67, 0x5C, 0x8B, 0x39, 0x35, 0x25, 0x50, 0x25, 0x37, 0x2B, 0x28B, 0x25D, 0xDD, 0x17DA, 0x8C, 0x43, 0x24, 0x481, 0x84, 0x278, 0xD1, 0xDB, 0x2F, 0x33, 0x62E, 0x66, 0xAF, 0xEE, 0x12B, 0x37, 0x24, 0x5B, 0x74, 0x91, 0x1C6, 0x93, 0x2F, 0x2D, 0x32, 0x4C, 0x66, 0x5B, 0x51, 0x3A, 0x36, 0x0, 0x52, 0x24, 0x39, 0x2B, 0x28B, 0x25E, 0x176, 0x17D8, 0x8B, 0x43, 0x24, 0x481, 0x84, 0x278, 0xD1, 0xDC, 0x2F, 0x33, 0x62E, 0x66, 0xAF, 0xEE, 0x12A, 0x37, 0x24, 0x5B, 0x74, 0x92, 0x1C6, 0x93, 0x2F, 0x2D, 0x32, 0x4C, 0x65, 0x5B, 0x89, 0x3A, 0x36, 0x24, 0x52, 0x23, 0x39, 0x2B, 0x286, 0x250, 0x1F1, 0x17F1, 0x8C, 0x43, 0x24, 0x486, 0x84, 0x271, 0xD1, 0xD9, 0x2E, 0x33, 0x62E, 0x66, 0xB0, 0xEF, 0x12C, 0x37, 0x24, 0x5B, 0x75, 0x8E, 0x1C6, 0x93, 0x2F, 0x2E, 0x31, 0x4C, 0x67, 0x5B, 0xB3, 0x39, 0x35, 0x30, 0x50, 0x25, 0x37, 0x2B, 0x27B, 0x233, 0x198, 0x181F, 0x8E, 0x45, 0x25, 0x48E, 0x85, 0x261, 0xD1, 0xD3, 0x2D, 0x33, 0x62E, 0x66, 0xB1, 0xF1, 0x12E, 0x36, 0x24, 0x5C, 0x76, 0x85, 0x1C6, 0x93, 0x30, 0x2F, 0x2F, 0x4D, 0x6A, 0x5D, 0x8C, 0x37, 0x34, 0x28, 0x4D, 0x27, 0x34, 0x2C};
+uint16_t station_bangor_northern_ireland_2023_phase [] = {0x7F0B, 0x8926, 0x3E36, 0x863F, 0x49D9, 0x9061, 0xB10E, 0x5B76, 0x33C8, 0x48BE, 0x78C7, 0x3660, 0x1F33, 0x33F0, 0x8F, 0x586, 0x4B4C, 0x79B6, 0x3C49, 0xD0F4, 0x4C2A, 0x1B88, 0xE3F8, 0x8457, 0x1AE4, 0x2C92, 0x2D41, 0x95AD, 0x7A50, 0x49EB, 0xF0D5, 0x9C47, 0x895, 0x7A8B, 0x3505, 0x4A51, 0x6FC7, 0x3721, 0xCD7E, 0x2E1F, 0x80A1, 0x8C85, 0xB871, 0xCE60, 0x360B, 0x20A3, 0x8971, 0x647F, 0xFDB8, 0x8E91, 0x78F3, 0x3D1C, 0xE6D6, 0x33F0, 0x8F, 0x5B5, 0xCB1, 0x97E, 0xB28, 0x1AAC, 0x9D52, 0x63A9, 0x9BD8, 0x40D4, 0x1AB9, 0x2C3C, 0xBD82, 0x6E10, 0xC5D0, 0x9B13, 0x6A18, 0xDB5E, 0x8879, 0xC087, 0x369A, 0x0, 0x2B05, 0xDB32, 0x1A0C, 0x7614, 0x8301, 0x917B, 0x26A2, 0x534, 0x846, 0x8E48, 0x2DEA, 0x52EF, 0xA3C7, 0xC249, 0x786C, 0x2872, 0x89CC, 0x33F0, 0x8F, 0x530, 0xC4D3, 0x769E, 0xC0AA, 0x53DD, 0xC297, 0x9A7C, 0x6504, 0x1036, 0x1B3F, 0x2D4C, 0x2B28, 0x1289, 0x199, 0xC058, 0xEB67, 0x23C1, 0xE025, 0xF3B8, 0x38FA, 0x30A3, 0xF927, 0x769C, 0x3919, 0xAD6E, 0x849C, 0x94E5, 0xBBEC, 0x4D56, 0xF479, 0x1E8E, 0x652, 0x5BFB, 0x6DBC, 0x819, 0x7896, 0x2F2A, 0x516B, 0x33F0, 0x8F, 0x55E, 0x8638, 0x668, 0x8F8A, 0x9D9D, 0x13C6, 0xE29E, 0x1CE2, 0xCCBB, 0x1B15, 0x2CF4, 0xBB6C, 0xEAF0, 0x4D27, 0x1187, 0x64AB, 0x62D7, 0x7B10, 0x39B2, 0x3A96, 0x5633, 0xB471, 0x1AAE, 0x859F, 0xF564, 0x8607, 0x97D9, 0x5159, 0x9563, 0xE08E, 0xAEAA, 0xDE7B, 0x64F2, 0x379B, 0x4E0E, 0x78C2, 0x3609, 0x1933, 0x33F0, 0x8F, 0x58D, 0x4789, 0x961B, 0x5E55, 0xE716, 0x64CA, 0x2AAC, 0xD4D5, 0x88DB, 0x1AEA, 0x2C9D, 0x4B8A, 0xC31A, 0x9827, 0x628B, 0xDDED, 0xA1F0, 0x1681, 0x7FD5, 0x3C00, 0x7BBD, 0x6F54, 0xBEB3, 0xD275, 0x3D48};
 tidal_harmonic station_bangor_northern_ireland_2023_data = {
+        .name = station_bangor_northern_ireland_2023_name,
         .base_year = 2023,
         .n_years = 5,
         .lat = 54.665,
@@ -45,22 +58,29 @@ tidal_harmonic station_bangor_northern_ireland_2023_data = {
         .phases = station_bangor_northern_ireland_2023_phase,
         .n_constituents = 40,
         .mean_error = 0.0007744273684852112,
-
+        .almanac = NULL,
+#ifdef TIDE_DEBUG
+        .test_times = station_bangor_northern_ireland_2023_test_times,
+        .test_tides = station_bangor_northern_ireland_2023_test_tides,
+        .n_tests = 480,
+#endif
 };                                                    
 
 
+
+
 #ifdef TIDE_DEBUG
-time_t station_bangor_northern_ireland_2023_test_times [] = {1698045081, 1695866437, 1678064765, 1673616003, 1690524656, 1701224825, 1674139099, 1680278105, 1686131817, 1677326980, 1703155302, 1685959448, 1697473777, 1693308382, 1686031983, 1683732113, 1699496166, 1703807482, 1686816927, 1685050743, 1682081248, 1696303582, 1692665315, 1676179395, 1673258206, 1700455406, 1683499320, 1702523602, 1703145906, 1681492350, 1674813842, 1686732575, 1676064564, 1697029727, 1698278988, 1686381669, 1697231074, 1697100250, 1695952199, 1690247026, 1700476294, 1698748324, 1680447296, 1703808643, 1692822089, 1685209756, 1692527313, 1701207488, 1674555384, 1700077681, 1690268475, 1672732918, 1689878262, 1693237717, 1685787500, 1678815402, 1689567950, 1695538367, 1686626007, 1688783061, 1676344367, 1681159678, 1704008270, 1674235686, 1674579971, 1676911097, 1700919161, 1701625887, 1674933329, 1682364284, 1700002676, 1691207793, 1685146751, 1675596752, 1699270635, 1689420204, 1694698792, 1699324434, 1700580174, 1694056952, 1681330592, 1694837310, 1691456675, 1689075405, 1687965910, 1692924045, 1702899788, 1696120637, 1693274937, 1676276203, 1703993843, 1703857602, 1684656351, 1701943584, 1681276096, 1696625579, 1730109411, 1715091362, 1709774638, 1713755074, 1710679396, 1716960659, 1722970881, 1710723113, 1722984444, 1715470530, 1735330537, 1730413285, 1704964019, 1722251643, 1731646872, 1711863302, 1705106445, 1711548929, 1721091076, 1718309420, 1712321024, 1720844254, 1730734667, 1704769727, 1708020957, 1722619479, 1712371576, 1707721113, 1716698951, 1715708625, 1732178029, 1705443990, 1712007115, 1729857405, 1704520640, 1724460016, 1718142262, 1721126695, 1728178316, 1713937116, 1734935246, 1708353472, 1726097950, 1708398968, 1716516199, 1709136262, 1720726887, 1724913277, 1719401699, 1719895930, 1723576110, 1727500327, 1713808285, 1711356366, 1726237123, 1722844175, 1707288784, 1716475835, 1718003827, 1722195502, 1730840028, 1704206348, 1730961029, 1706924333, 1712541312, 1729049513, 1727772609, 1733869049, 1713026858, 1725617822, 1716894061, 1718817584, 1727408050, 1710839643, 1704670730, 1718699871, 1732937624, 1733515580, 1707236623, 1723162606, 1719532043, 1722553298, 1727530371, 1732345839, 1735085406, 1711311646, 1715486760, 1704448969, 1734064379, 1731265246, 1712189713, 1718748209, 1725187563, 1712371332, 1716672424, 1706537613, 1753134861, 1741964925, 1753739845, 1745782562, 1747370697, 1751453235, 1763620160, 1757972467, 1764345779, 1765167708, 1739517593, 1739294328, 1745666445, 1766106901, 1761897597, 1760556971, 1765632428, 1755080116, 1759426514, 1756708126, 1767159800, 1759740632, 1755681103, 1739436306, 1761398605, 1765828723, 1741930639, 1755257434, 1739947876, 1761034581, 1741840707, 1741245921, 1736747880, 1748871536, 1752928463, 1755045481, 1738994388, 1762031472, 1751532048, 1740111831, 1750633743, 1737572799, 1754275699, 1755442163, 1744671620, 1752243436, 1751577259, 1746421606, 1744914567, 1760070451, 1746126733, 1758992202, 1743640212, 1762627969, 1765965751, 1767191040, 1751829225, 1766787636, 1747604789, 1747673023, 1763700689, 1759940655, 1757155066, 1747693294, 1758682444, 1765511024, 1741326612, 1742329524, 1752858648, 1743800152, 1764669139, 1745129997, 1746976456, 1766225037, 1741641368, 1763588173, 1760180151, 1737107463, 1756890693, 1737268874, 1750994842, 1753166622, 1763849892, 1760791020, 1764714192, 1758316083, 1748911306, 1742138205, 1744265129, 1763900311, 1737605586, 1744721294, 1745394470, 1766417071, 1746597291, 1735998175, 1794139992, 1778672994, 1782959151, 1770446464, 1791247918, 1793804208, 1792791842, 1772358763, 1781234455, 1776620652, 1794633821, 1773318944, 1784744350, 1777994895, 1781974230, 1795933653, 1773151742, 1787787198, 1796432740, 1788572783, 1775224621, 1788991721, 1779809767, 1791179205, 1782182243, 1779820150, 1796156173, 1786428524, 1789629922, 1778007602, 1792232335, 1780094745, 1789035551, 1790337909, 1788449095, 1773569007, 1773874465, 1778221937, 1770580498, 1780945474, 1783749877, 1783871255, 1790240350, 1771445171, 1769041830, 1769849454, 1776424747, 1789791531, 1781312447, 1775514099, 1789481730, 1782703098, 1789114777, 1769982255, 1774399733, 1780195334, 1789438021, 1786548540, 1791829284, 1797691650, 1795967782, 1798344192, 1788226411, 1768922067, 1778193262, 1791077576, 1791224129, 1769637150, 1777057869, 1769182453, 1793463996, 1794868421, 1780316102, 1795013205, 1790538106, 1779831924, 1786419853, 1793309917, 1788170019, 1771389283, 1777336547, 1786477974, 1780552170, 1777427902, 1792529713, 1794624042, 1770211097, 1785396283, 1794158962, 1793703721, 1786287866, 1773592275, 1791852978, 1794949641, 1770598835, 1785789162, 1816319339, 1826673345, 1820480122, 1814211705, 1818116942, 1821813554, 1828127783, 1824333743, 1828884682, 1823356912, 1816782769, 1820105665, 1814606191, 1815664668, 1819671951, 1809849051, 1826095191, 1814551064, 1807317158, 1814115360, 1804313650, 1817439856, 1820373641, 1817196113, 1807170036, 1814013939, 1809756410, 1823158841, 1801429888, 1829914245, 1817533503, 1807884155, 1816298577, 1814802317, 1816532830, 1818223970, 1811992266, 1815483827, 1816524830, 1823588944, 1805472901, 1817671734, 1829932696, 1827515696, 1829831181, 1821766436, 1820470129, 1808312606, 1823229171, 1811728012, 1814258526, 1823272705, 1824025954, 1799188602, 1817936443, 1804124041, 1811421337, 1804975563, 1826199841, 1822059784, 1821866610, 1801314830, 1827526873, 1805007554, 1828138814, 1829154650, 1808720491, 1812226761, 1807849116, 1808358778, 1803907981, 1806830164, 1820924952, 1820420001, 1813688375, 1814850125, 1819326895, 1804621951, 1805717029, 1799645532, 1808674645, 1802239993, 1817028779, 1821984514, 1814148997, 1809995846, 1827336493, 1821558979, 1812985595, 1816770695, 1813456351, 1799920601, 1810709680, 1813410131, 1819964461, 1820757401};
-float station_bangor_northern_ireland_2023_test_tides [] = {2.641773127495468, 1.0304253159746974, 2.3470397850215803, 2.9527090898035935, 2.9257120609733436, 2.4151833897372668, 0.9647473266876916, 1.685603015248528, 1.7109828225085821, 2.4701807971411425, 1.4116710291347248, 2.902297998608174, 1.2019869325788848, 2.5952902439480816, 0.5323483976834517, 3.030328390472605, 0.994760229601777, 3.2069180355782225, 3.19258805148837, 1.2313182814291836, 3.251245212312021, 2.696775176620144, 3.046898182130821, 2.2479287363236486, 2.562995497925276, 3.0117942608562904, 2.9557779121998893, 1.597451628015951, 2.5795313140904113, 2.7859560735095736, 1.0275869295705358, 3.1105484534940664, 1.0151491886548694, 1.7562490494985739, 1.5917544525296883, 1.6386869022231954, 3.1498167650712654, 2.944566685971016, 1.6738712022625841, 2.4717502114635277, 1.3766688910984302, 2.931183241426944, 0.8635165764059223, 3.2256067047967227, 1.0908191083508574, 2.5350457772400246, 1.9845317761286705, 2.780157616967531, 2.689819984872565, 1.3151043481844351, 1.6774176260652967, 3.098933709508668, 0.878676812461172, 1.2354454703345892, 3.213723663901976, 2.5708753348047537, 0.7623492435552275, 2.6889254836224565, 1.8818510982773515, 3.5673366018034756, 2.738949622980893, 0.9023120853591906, 1.0393567826671202, 1.1891434798749108, 1.1994670097288402, 0.34073712328147954, 1.408966507390986, 2.3062989297072054, 2.20955374110776, 0.8745595239223225, 3.388346746971194, 2.380185303361853, 1.8677484493557213, 3.405983010457376, 1.5743313008962185, 2.6001410201950015, 2.2196866910234183, 1.6745695263030764, 2.816023531464626, 3.091285863504926, 1.2039935342615489, 0.9895722565828362, 2.4698494389122074, 0.6325938685165047, 1.7535643894304531, 1.7368814340255796, 2.268236200208462, 3.5079767775744517, 0.8808160646821513, 1.259219993425995, 2.558254697306367, 3.3174876655805696, 1.3918169774230735, 1.9885607300924966, 2.446887650854322, 1.3281862411555205, 2.8687444809093177, 1.1595972867675637, 1.1712576516851991, 1.0584502998418723, 1.5809371476212262, 2.2718659813965796, 0.952307551011749, 1.5356654857404306, 3.015050930101284, 2.8015708325786712, 3.029328702766257, 3.4181860937304727, 3.0675570976473843, 0.7362734125175142, 0.704637848350377, 1.896838564188768, 3.3076677341546814, 2.7357807723904535, 1.2881725812937208, 1.573661082799823, 1.0855707170541897, 3.083184279058477, 2.1723782685819293, 0.9977242838282835, 2.129217121911979, 1.4054988411425038, 0.884836185727283, 0.6477256710422548, 1.2932359060491256, 2.430737696712761, 1.2138834872826982, 0.793777492679069, 1.0926667394939618, 1.5384842769181977, 2.7863215712642213, 3.462017306430894, 1.2825799575727734, 1.3908037494393934, 3.207889459357139, 0.7674347540640056, 2.554789202989292, 1.2888655963428743, 1.3920836171305757, 1.36339262038877, 2.226439402936861, 2.2664573341820864, 1.0902150470942547, 2.8634606869436103, 2.070455831403819, 2.3540474290688693, 2.3396698853380187, 1.980961718832134, 0.9869213743145437, 2.39964475962449, 1.692004968571471, 1.3671292941552662, 2.6462247606519282, 1.3852119682902047, 0.5705714203008944, 1.963032722192678, 1.371769251192804, 3.3098882506831706, 1.4862091836177065, 2.1396892410786355, 1.5100785617533874, 0.3858273892443044, 2.762031990551376, 1.6921920372603894, 2.4439948138692773, 2.21191446643535, 1.6934835952026932, 1.4903567270900815, 1.874838052027966, 2.2058652254136866, 1.7242895761339794, 2.914062591957136, 0.9610114889463276, 0.9237976165531053, 1.6594020433916288, 3.084424539842221, 1.9007669633416477, 2.61435087838823, 1.3960918158003541, 2.3307985502239092, 1.1350187260696858, 2.0269346701995588, 2.3730252329333457, 1.553476228491578, 1.1745740932231723, 2.9799196225070324, 1.2457963114849306, 2.7631440828021328, 3.0212516299833303, 0.8845619704295362, 2.2519174733803435, 3.3451076954022336, 2.614823721533887, 1.4709690050737148, 1.7249764739830609, 1.8785802579092037, 1.6347953516294254, 0.8197223974762559, 1.402113231669299, 1.364826256294627, 3.2008548138407082, 1.9781227887669417, 1.064860970300976, 0.7035817561896371, 2.798790606375271, 2.2066491822589485, 2.507439419365822, 2.910276112540888, 1.6040294683094871, 1.5715127832991038, 2.7076744675756834, 2.4700303747647676, 2.613377406584552, 3.0545684233517494, 2.9884752855836596, 2.270997857700029, 3.2997154710198418, 3.160199497778684, 0.8113924310787444, 1.4206768956107425, 1.5241276711407798, 2.3269029527774143, 0.8527998622349005, 1.367178645646696, 1.3686318670622624, 2.038057781044443, 0.8413068533619465, 3.525635777097565, 2.8061356478982327, 2.823362212417854, 1.4539081298400334, 2.807481169033996, 2.1024451730169242, 2.461544623378587, 1.6732369123246549, 2.2887496401033145, 2.9766714472814266, 2.085778665870434, 1.6013154249520143, 3.09754770773585, 1.0094446193706328, 1.442932034268608, 0.7692681539539121, 2.188293729933434, 2.870153481063659, 0.5384946723894993, 3.1358116391288924, 1.0098695747915927, 2.763539967140063, 0.9180790319928925, 1.2319342213938023, 2.71541550002747, 0.9304157599430509, 0.7953683905657194, 3.077968511333243, 1.1971248124046376, 2.215671016793664, 2.759533133905129, 2.7961809210678497, 0.8419242500644583, 3.0187271027547076, 1.1981039216084455, 2.92864378155818, 2.070072992202741, 0.9107910957793494, 3.219948740498398, 2.972561023354753, 3.209930261899868, 2.3441583164427224, 1.9945296082670962, 2.4231319394694606, 1.362692662415027, 1.6054030157227084, 2.692850337916456, 2.6285014806400957, 2.0054346066757005, 2.942550063772132, 3.3679182572860125, 1.8182901643356486, 2.107106289530591, 1.773120349128174, 3.4183566135892454, 2.612729105686849, 3.2463262256511745, 2.835176427501612, 2.3727767720424637, 2.819071667275915, 3.600737680610626, 2.805625718340911, 1.4323669948028344, 2.6951488768337772, 1.2955591390105965, 0.9507386347963648, 1.674890570907412, 3.237249324731523, 3.3006731036619534, 1.257673814019445, 0.5008742423257679, 1.7072068213631943, 1.4004987485331533, 2.7589253371096123, 2.380829130970157, 2.7638359272320145, 1.508009084855961, 2.771873013941055, 3.0947122082453387, 1.0636946071015585, 2.3262820892249554, 2.644469359673673, 3.459340979154569, 1.1511515744632292, 2.922181316840143, 2.2372368132844875, 2.612906621357548, 1.802406113118405, 1.6777793666753817, 1.1192972924636415, 0.8519661561204428, 1.5785029871406349, 3.0859134485086313, 3.194307791356713, 2.6525142748283113, 3.177244263354791, 2.7400673120121155, 3.212254097556756, 1.6981343049868705, 1.2650834879407142, 2.256254758823169, 2.8547599333220397, 0.8480104728548544, 3.0298414630637276, 1.3210398772847138, 3.144522690271262, 3.276545943888113, 3.3016005646640254, 2.8184628717959277, 1.2384560004770795, 1.8188373371392272, 3.084168579468852, 1.1260531842907675, 2.0950494837429416, 2.979607143492216, 2.4050916523780197, 1.5510049154369818, 3.2969693743933624, 0.9902436741708094, 0.735757131616454, 1.9394212128238921, 3.2420423097501203, 2.194161186485558, 3.450580939031789, 2.165181778966229, 1.6365434174742277, 2.1912653980311068, 3.139006943340649, 2.1374042039296404, 2.5396732738805885, 3.0489261386704833, 2.9405742673692665, 1.2076321639527572, 3.064298661542984, 2.49542178031558, 1.8162887457870178, 2.6471496925030698, 0.6320058060716774, 1.868985846720135, 1.988636259515601, 0.8638793503985926, 1.6127232186371434, 2.7667300663112924, 1.1298195714554624, 1.210863444720685, 2.393171391091996, 2.9652480280889058, 3.613569439558797, 1.1795086662208416, 1.0798088984046759, 1.5135342007856287, 1.2130897622308037, 1.1730769802990022, 3.3407497038848084, 1.4785955913472812, 2.058382661395646, 0.8384090369718912, 1.671327791183071, 2.65729837093514, 1.8838015190984165, 2.4159966934810493, 1.4705995163702887, 2.5251056592682115, 1.4685157542103462, 0.9840169785972446, 1.816921341339879, 1.2811279891835048, 1.4883658228047032, 3.498869596168853, 3.1078289896694105, 1.0541257613192978, 2.479477762839948, 0.7925497862081037, 3.005687680217613, 1.7560688282374761, 3.32436372205114, 2.8178340381753206, 1.6908581480265354, 1.4044039964884165, 2.9324153114147338, 2.616803889563696, 1.4284522433722582, 1.7556639949187047, 0.5448766709385107, 2.541595104541759, 2.2187270090884383, 2.4205564211061534, 0.5794382284611881, 0.7094997203816654, 2.7432699172998727, 1.4128658499087507, 2.7419153774617717, 1.8750048605538383, 0.8294828385597786, 0.9105498159051346, 2.8168703548553133, 2.5627831093059594, 0.9139038771789857, 0.6810817351314444, 1.2570252549749026, 1.105596306413149, 1.3807514921390656, 2.641357685294049, 2.7512112567203983, 2.7921510942426426, 1.6211127672874182, 1.2922439322843988, 2.1567023215402368, 1.848411373666377, 1.7526207111231216, 3.0516239018434113, 1.2901745865725724, 1.3805562534605866, 1.7600280585890422, 1.2393471432387837, 2.2581572584319036, 1.1685386665457422, 1.7991917190561062, 1.6421019188313493, 3.0072634479836053, 1.1365604399419307, 1.256233495299345, 1.4395068122962704, 1.354425210802114, 2.1054533943958993, 2.3727231241035214, 2.4287523813281457, 1.586344779244931, 3.1307795998760715, 2.4788804944680733, 2.94417264366909, 0.9480093612912496, 0.6324336092003644, 1.1834845781109498, 1.2008584617010518, 3.292311896889652, 1.1839789067605422, 1.5306513940098738, 0.8635433367190923, 2.8017392225653683, 3.117971140387175, 2.2983226313808522, 3.0624074396881755, 1.0156403719899807, 0.8499014817478763, 1.0592260015309887, 1.1190234517016637, 2.581458588943936, 1.2358106256657955, 1.9346958089265525, 2.611619136200993, 1.9430152700878478, 1.3455814254262417};
+time_t station_portpatrick_scotland_2023_test_times [] = {1699155373, 1681475912, 1676061487, 1700602808, 1686281477, 1675245171, 1688105632, 1702067965, 1682880736, 1682214322, 1700372707, 1673603627, 1699466821, 1674234757, 1688316640, 1683035605, 1700704833, 1699558914, 1701286195, 1700358662, 1692497264, 1688102661, 1701673343, 1690317294, 1699192149, 1690554284, 1680766045, 1679749881, 1675338785, 1688661160, 1693845139, 1693961820, 1691742198, 1686844797, 1673270801, 1682115171, 1695645750, 1702321224, 1699340170, 1693111865, 1674023676, 1684887825, 1686211053, 1674494360, 1701910756, 1685002471, 1681400549, 1675992227, 1684356225, 1689980001, 1677245492, 1703327835, 1682443710, 1673228956, 1683615641, 1681316582, 1675123426, 1702745390, 1692452848, 1675389610, 1682620106, 1681195769, 1694269695, 1693272856, 1686918585, 1674474762, 1677152507, 1685266631, 1680504845, 1698647260, 1682157216, 1677751347, 1687127692, 1683684309, 1685095874, 1689277612, 1682588096, 1688862414, 1684073354, 1682093603, 1680598423, 1682849246, 1697982656, 1680560371, 1692104892, 1683497995, 1691992630, 1699335998, 1675923154, 1678730438, 1688875542, 1692664120, 1675664919, 1703647293, 1686520048, 1703321852, 1734930878, 1722790742, 1715617716, 1710487855, 1711527039, 1709269963, 1727440852, 1719143203, 1705458440, 1716292890, 1717635173, 1730874422, 1728283191, 1727861406, 1714670826, 1727036343, 1720089716, 1726900580, 1722601683, 1721661781, 1708802612, 1723885072, 1717105428, 1726157291, 1720135399, 1717868037, 1721247344, 1706594293, 1712949819, 1732223949, 1705469935, 1724550460, 1722410044, 1734809861, 1731711955, 1729521713, 1733167666, 1724782411, 1705319759, 1733988442, 1707773930, 1713461788, 1713626926, 1735422982, 1715576929, 1716862014, 1720496947, 1728825375, 1732200936, 1723553016, 1717996830, 1716249659, 1705463231, 1710077043, 1711349382, 1722304214, 1710271854, 1717716768, 1730007020, 1728094681, 1729831133, 1729302618, 1708003169, 1729957954, 1728295563, 1734431467, 1706204084, 1704240931, 1718118793, 1731454616, 1730941801, 1724830778, 1726566345, 1725636235, 1714500866, 1715436732, 1711212064, 1715175032, 1708188087, 1732695499, 1704397135, 1724319626, 1729648101, 1735416438, 1733680400, 1733055955, 1733441851, 1728724182, 1715199859, 1709637779, 1709599067, 1729954969, 1731726601, 1705127897, 1724605121, 1731491977, 1759577257, 1743290979, 1751411214, 1763472473, 1764445015, 1737601104, 1755709512, 1736948810, 1753373084, 1764936227, 1739148463, 1741980459, 1766433410, 1754041899, 1763550144, 1767019297, 1743567434, 1746446011, 1758155309, 1748204422, 1737813068, 1760423454, 1761947009, 1763122195, 1763260269, 1762703153, 1763977041, 1757925626, 1760083221, 1762271794, 1756736868, 1747462990, 1767025473, 1752608061, 1763238770, 1741071419, 1760942707, 1742791348, 1740446071, 1739027771, 1756039905, 1761274026, 1755019287, 1747074829, 1754761350, 1742166829, 1747714197, 1736100514, 1741851170, 1743526663, 1750290319, 1737636650, 1743825078, 1744005734, 1740925879, 1750978125, 1738430330, 1755308427, 1747461162, 1755866055, 1754228499, 1744907648, 1760562107, 1758950760, 1763964158, 1762328358, 1736589979, 1754650581, 1744554914, 1739796282, 1755391249, 1759639595, 1736777801, 1739504391, 1765141454, 1748127763, 1756310820, 1766815030, 1761069711, 1746629542, 1762445974, 1736053142, 1751595498, 1755465531, 1738151365, 1744777651, 1741335513, 1752792295, 1763208974, 1760597268, 1754050949, 1737842975, 1749043743, 1741382870, 1760184110, 1752140756, 1782970194, 1796620592, 1798702567, 1788263254, 1774218802, 1784319408, 1783917124, 1792575806, 1780379772, 1784392041, 1791843047, 1781139434, 1777990813, 1798572190, 1784131416, 1784052348, 1796138647, 1773588149, 1794047221, 1786330169, 1768093619, 1783461384, 1778352087, 1768099882, 1777392431, 1791413170, 1794954358, 1785859950, 1782472368, 1789369692, 1791213146, 1775280213, 1779769199, 1795883502, 1796196980, 1795938106, 1772033710, 1789580671, 1778940506, 1768979996, 1796306669, 1787706423, 1780333505, 1793329779, 1797555521, 1785876721, 1779133491, 1773810904, 1795390885, 1780199671, 1790899715, 1770941240, 1794101773, 1774178558, 1784813262, 1783441375, 1772058913, 1768565032, 1797586848, 1795978951, 1775308779, 1775460787, 1787516301, 1791067463, 1795385398, 1775840942, 1794013527, 1791909720, 1784521027, 1768132312, 1797975070, 1796812698, 1768797903, 1775211089, 1794469449, 1778322686, 1788726939, 1796629714, 1796650490, 1795589132, 1768334848, 1784545287, 1788718242, 1784142283, 1785206438, 1797772231, 1791682331, 1779553623, 1796298300, 1784246842, 1790505656, 1791651837, 1781782428, 1768036481, 1783953479, 1783147384, 1802721230, 1800470923, 1802681048, 1829489479, 1807343945, 1815212443, 1811596772, 1807753153, 1829804736, 1824782989, 1829413605, 1814396295, 1802880540, 1817819972, 1811790245, 1814630672, 1816031580, 1809065593, 1800138237, 1811019155, 1818074295, 1817759852, 1820064910, 1799327048, 1817948593, 1819110819, 1823065824, 1820592036, 1818813683, 1827440381, 1827176066, 1811732761, 1827637789, 1800103146, 1824494649, 1818169213, 1829539331, 1829299027, 1803879579, 1806452942, 1826387364, 1815449160, 1823142263, 1810625720, 1818029684, 1800534223, 1799383070, 1815447350, 1810931720, 1806088513, 1810990532, 1804445144, 1808687644, 1825787848, 1823534301, 1827905769, 1830276493, 1824581160, 1803561317, 1815858027, 1807340505, 1805662907, 1806930840, 1798990532, 1808777041, 1826034455, 1802652651, 1813450321, 1805513325, 1818705617, 1830253487, 1812284823, 1818883671, 1808680120, 1814581183, 1829862663, 1812647546, 1813466748, 1823240615, 1802521171, 1807077126, 1800310389, 1823183377, 1812190397, 1812747714, 1827652422, 1822089795, 1828182629, 1826850473, 1818993205, 1799127746, 1807366192, 1829435748, 1815947529, 1814450473, 1800563745};
+float station_portpatrick_scotland_2023_test_tides [] = {2.9320801741402747, 0.9725453414694404, 0.6187534219689845, 1.997013412350703, 3.7112642708316743, 2.994061870808947, 2.5825520478518817, 3.341378228143693, 2.613646644270559, 3.639056442031319, 2.63942436791828, 1.165361335114604, 2.8160075740431485, 0.8650668789624433, 0.7141527779777952, 1.1656683585595051, 0.7195548889005362, 3.2203306544191403, 0.7493649163619424, 3.1685501820532687, 3.6886978805064325, 2.1252121284382635, 2.2517011659391044, 1.548789496632607, 2.483634898856368, 1.2494221892021387, 1.1898086229611868, 3.753172368226545, 2.719081504701373, 2.3184708637898517, 2.889382386737603, 2.524713483529896, 3.0613776622135545, 0.6087937593947506, 3.854691037047428, 2.587149915808494, 1.4397507618758654, 2.0351089111699783, 2.942943811708322, 2.3323755202790206, 2.9806529783736977, 3.105556335434632, 0.44950561047897286, 0.7560592380703256, 1.1968479039737567, 0.8960622061647759, 2.9319112047807745, 3.3359769188185453, 3.090674701741464, 2.2072282819070463, 3.8491355158958545, 2.8460628072383236, 2.444805860445075, 3.3574745861997055, 0.5742450270107462, 3.3046377933724522, 1.31653306599878, 2.361106575913736, 3.3993817116327487, 1.7906765000045615, 2.5813505135068926, 1.2036714415702543, 1.555342705848308, 1.4408158695942592, 2.625402542711905, 4.052069398222188, 3.2064129495719595, 1.5647701544300432, 2.086601605593286, 0.38888209988696365, 2.1595482520354734, 2.6183073168294055, 3.348849110191618, 3.6908858258810895, 0.9296543633020216, 3.165272901883174, 1.1114068900105338, 2.13742259191063, 0.7158788184927942, 1.275180259333398, 3.0114038613375955, 2.3499555244592334, 2.4541301066226104, 3.29592555902778, 2.8417498146855107, 2.642516176249375, 1.1925352107860512, 2.7462710388313663, 1.1337136715661333, 2.2739715046200097, 3.8230409739354236, 2.873529120497632, 0.859122837738594, 1.604746515562886, 1.7137508628896314, 3.433311710504917, 3.0693937181037163, 0.9090544577306924, 3.0376824470342556, 0.7756150378565551, 0.9542772921529243, 2.45323039407514, 1.599934329159913, 3.4169209013292834, 3.2417801752854913, 2.80500314167017, 2.781066094114346, 1.3439383308182504, 0.982079396660298, 2.8577920133987647, 2.9286762661495787, 0.4750879892822388, 3.418004245632364, 0.3300599623979074, 2.6107750461137473, 1.9716722562159315, 0.8904517323384047, 3.1501139601515025, 1.309773817301472, 2.803193152779231, 3.42824415457033, 0.959537411437622, 3.0685480749678375, 1.645585320399628, 0.6126829677580375, 0.9440750534303434, 2.9812332826624677, 3.6017848639885157, 3.225368004856429, 1.7269827891190364, 4.120181035800729, 3.787853581795624, 1.113367924274045, 3.2089714313332176, 3.0037999826671866, 3.331437401467151, 0.994036504167594, 1.98672271872586, 0.7324644928287246, 3.399280876711074, 2.5968705066009568, 3.6464871071558913, 2.6592707843632386, 1.3968709818298732, 3.7251702110406693, 1.460722949581946, 1.6781945861391712, 2.7465716204529804, 3.60210876726869, 3.169557411813466, 0.8534107003537598, 1.3434625732298007, 0.003509611505994513, 3.7090154716838226, 2.252570505096608, 3.1758399702772904, 2.923173815758866, 3.45147053581601, 2.982720585404865, 2.291256295909181, 1.7977034843938708, 3.162458770096061, 0.7447146666790089, 1.690319887458216, 3.1607510888334533, 2.2087362319788215, 3.141144103825725, 3.01419370067387, 3.479725648245144, 2.8429921526292077, 2.4970133476180227, 3.5889657101229777, 0.6109144350510712, 2.945269110653128, 3.308549193003039, 3.2013699491882273, 2.5492342404055974, 1.406400279126152, 3.166377042933014, 2.8534278319440083, 3.368269841630209, 3.6081428892810403, 2.341730785219282, 2.326334683832632, 1.7524292209831847, 1.4941124007751247, 1.3846960130216557, 1.9477781146727542, 1.2262571162971345, 0.6873898790636088, 3.226127430231788, 3.5187677245262825, 2.7649494399585213, 3.7616273033684466, 1.1854268326528035, 2.314520508858694, 3.1303528772587557, 2.195991810698112, 1.477886473383152, 3.6316044459754266, 0.9696423946029212, 3.8826070189241713, 2.3047438479343523, 0.8051215131109709, 0.9025166692797111, 0.9371328612141301, 3.6679838688529087, 2.023179887793157, 2.591952995774894, 0.8904112102501741, 1.6469232117151673, 3.0466155744706107, 1.4556983672556838, 2.992748620431209, 2.4464860791176952, 1.5861600636404456, 0.8964783521512883, 3.296879574450848, 1.8048691408314637, 1.9628504495609251, 0.4962327429735446, 0.7073471735893028, 2.177006679490702, 1.281855534670394, 3.0037470159789925, 0.9568551740956909, 3.524761470585591, 0.757382004628718, 1.326570073791397, 2.621590836432294, 1.7614994930013266, 1.2584675680513762, 3.4708425671936647, 2.885133196090042, 1.4742979636656581, 0.86438158946047, 0.7501061184680512, 2.811397766730058, 3.3256346113182986, 2.495687231168729, 1.7155888351040405, 1.77019903909407, 1.1823157372138486, 1.4891424405971816, 3.3089539175499043, 2.98383329199684, 3.6657492683909467, 3.407441781263672, 1.544284571612563, 2.756408596223507, 1.5952730554761039, 3.1336811652718186, 1.434162217834552, 2.4010014934250563, 2.6835267651902655, 2.0373583665382444, 1.3864252927590541, 2.068205829714664, 3.377416698247443, 3.340357190124791, 2.3167254802106783, 3.2081629435311902, 1.4388074281559269, 0.7131251202514509, 2.1539094155120844, 2.1464650593465135, 1.1644724617681141, 2.956405717966106, 2.731158774532196, 2.9058931736419407, 0.7962788025014246, 0.8244763740660226, 0.8391198974270063, 2.943307249476132, 1.906194583198701, 1.8814251381779181, 3.8428182973378924, 1.9505127198608836, 1.8667797854324075, 0.8949744439531545, 1.8536626932913092, 3.0333877800627924, 1.3701780293470234, 2.8932697553245834, 0.9825553771164398, 1.8595347803021125, 2.9997582661328233, 2.9273744864096396, 1.0127906958940143, 1.1001694237730149, 2.591674445490365, 2.7313165928730587, 1.7032492882963353, 0.6468466839420098, 0.6883873574708944, 2.6758254321221013, 0.7225784626029947, 2.886169841435542, 2.8052841485830617, 1.0813071245191277, 3.324164611657555, 1.6996039843035151, 1.4457847421276437, 0.7169151390368627, 3.3906048352875273, 0.9117578056317854, 3.6246200721811164, 0.8716881926717748, 1.50732359745204, 1.0296852956852813, 2.5176316675077883, 2.440668542999115, 0.5399124035132953, 3.279162408284138, 1.3178821346287255, 3.2592737603629574, 2.562065157696301, 0.4157317578264817, 2.0778393335220056, 0.8129522085223951, 2.0250505781221912, 2.776837789328807, 2.967720479286063, 1.157603676768877, 2.7893050535197617, 2.120027763716568, 1.7675225328179731, 0.8098002202216141, 1.4267080029171852, 2.3680913480842007, 0.9662541526529296, 3.495308182529553, 1.3152806657352745, 0.7861271454770362, 0.7429294335697775, 0.6896228512227742, 2.988659720281631, 1.09681480823713, 2.6502562821465903, 1.9235757694364997, 2.1049029014686504, 2.917748268460764, 1.187797625239525, 3.2462867110131706, 1.4144073031471616, 3.0315719327888853, 1.823576654598015, 1.484800571357408, 3.7113731116733457, 0.5796435779472986, 3.075869237669851, 1.0087720029005502, 3.685888714668232, 2.798931171807917, 1.9784524809239188, 1.6325107616887848, 3.639301089237581, 1.2744402529870593, 3.70360878793759, 3.610039631061492, 1.0837349350069567, 2.899590336794272, 1.0444338131673392, 0.9832689156632834, 2.928839563020978, 2.583978792097195, 2.2838448557782254, 1.0071037400092329, 3.1185848530731364, 0.7279714510064269, 3.171636407557544, 0.7417132090164412, 1.5994603105396552, 1.3187190513897398, 2.987385746316655, 3.0440986253910047, 1.5318937720715458, 3.7852514659545475, 3.480999603705698, 0.6214427881591132, 2.449460546160532, 1.3036110818328488, 1.2455330903515127, 0.9737682110124454, 2.7180847646516004, 2.235185051906028, 1.922382589672403, 2.1970006739502224, 0.5224699452381182, 0.4858417182028936, 1.165193170387896, 1.5915264757503318, 2.128346563387826, 0.47833838104795207, 3.648616804350353, 2.3249476302454606, 1.4333558840324288, 2.188149353884358, 2.9545662899976457, 0.7112248170933771, 2.2666176064277845, 2.994422262820025, 1.2084832016726834, 1.555611381631064, 1.507893980537618, 0.8284529824096305, 3.6744891267910225, 3.3077067654262313, 1.400437611198985, 2.0621167567142566, 2.8372867284031194, 2.061102007972522, 3.701264301921135, 3.4506683756631733, 3.7702570358672745, 1.624080031203847, 1.5328997410406915, 1.6543238850051243, 3.612732759742303, 1.2619281012005383, 2.591498531376178, 1.0738306695440067, 3.041002436715499, 1.587793375061429, 0.8272614320062563, 1.916957160028576, 1.923867839315324, 2.7338355086987445, 1.3719308363756826, 3.0171893210532623, 1.1664441475113068, 1.6361796824204722, 1.738141912567266, 0.7240250544042587, 3.4749116816279986, 0.8310667056361508, 1.0243428095709504, 3.250923975592918, 0.9094323093240656, 1.5244281571386442, 1.2836034700012962, 3.6757933593209238, 3.609463697020022, 2.858527452629521, 0.45374539118496143, 2.6947647712683866, 2.4546036225007546, 1.3747414818973887, 1.238451510732394, 1.0149349531061962, 1.4811806304140218, 3.656626978160795, 0.7888514607201756, 0.9816115490960132, 3.2614228048946816, 3.675855875952411, 1.218784177300842, 1.0671905552289145, 1.3325070391058376, 3.581186680094988, 3.2341721834936656, 1.0266996033931655, 2.93706313975494, 2.121681673548233, 0.5770086241075911, 2.5227201626830573, 1.8604748955186912, 3.2819850853929173, 1.6475071236903756, 1.7280797721817163, 2.4654811624878374, 1.5823316446032434, 1.8084767414100118, 3.317195795722714, 1.6222864309040526, 3.675068602033348, 0.8225309949193476, 3.0680151581382846, 0.93701022086126, 2.8099429818074735};
 #endif
 
-
 /* Mean error for Portpatrick, Scotland in 2023-2028 is approximately 0.00073m */
 char station_portpatrick_scotland_2023_name [] = "Portpatrick, Scotland";                    
 float station_portpatrick_scotland_2023_speed [] = {7.2921158357870547e-05, 1.4584231720055478e-04, 1.4315810553074262e-04, 1.4051890250864362e-04, 2.1077835376296543e-04, 1.3787969948654463e-04, 1.3524049646444563e-04, 6.7597744150773076e-05, 7.2522945974990243e-05, 6.4958541128674080e-05, 6.2319338106575097e-05, 7.2722052166430395e-05, 1.4544410433286079e-04, 1.4524500735288060e-04, 1.4280490131076179e-04, 1.3559370068442646e-04, 1.3823290370652545e-04, 6.5311745348654892e-05, 2.1344006135132787e-04, 2.0811664665941671e-04, 2.8596300684150439e-04, 1.5036930615707798e-04, 5.3234146919111522e-06, 4.9252018242171696e-06, 2.6392030220989930e-06, 1.9910619144015089e-07, 3.9821286769398287e-07, 1.3066849886020929e-04, 1.3295449766232746e-04, 6.7995957018467053e-05, 2.2859988021181762e-06, 1.4808330735495979e-04, 1.3519548781673247e-04, 1.4012068964094966e-04, 2.1836526269073135e-04, 1.3330770188230829e-04, 1.5076751902477192e-04, 7.0259451254321812e-05, 1.3255628527944716e-04, 1.4071800918489746e-04};                
-uint16_t station_portpatrick_scotland_2023_amp [] = {0x288, 0x2F1, 0x17C, 0x1B95, 0x6A, 0x546, 0x9D, 0x271, 0xD1, 0xCF, 0x2B, 0x3B, 0x7F1, 0x7F, 0xB1, 0xA8, 0x14B, 0x30, 0x2E, 0x22, 0x2E, 0x74, 0x9D, 0x25, 0x22, 0x20F, 0x86, 0x2F, 0x38, 0x27, 0x38, 0x5A, 0x80, 0x34, 0x26, 0x1E, 0x4C, 0x21, 0x34, 0x24, 0x28E, 0x307, 0xD8, 0x1B75, 0x69, 0x540, 0x9C, 0x27A, 0xD1, 0xD2, 0x2C, 0x3B, 0x7F1, 0x7F, 0xB0, 0xA7, 0x149, 0x30, 0x2E, 0x22, 0x2D, 0x74, 0xA2, 0x25, 0x21, 0x20F, 0x86, 0x2E, 0x38, 0x28, 0x37, 0x59, 0x4A, 0x35, 0x26, 0x4E, 0x20, 0x36, 0x24, 0x28F, 0x308, 0x16E, 0x1B73, 0x69, 0x540, 0x9C, 0x27B, 0xD1, 0xD2, 0x2C, 0x3B, 0x7F1, 0x7F, 0xB0, 0xA7, 0x149, 0x31, 0x2E, 0x22, 0x2D, 0x74, 0xA2, 0x25, 0x21, 0x20F, 0x86, 0x2E, 0x38, 0x28, 0x37, 0x59, 0x7E, 0x35, 0x26, 0x1C, 0x4E, 0x20, 0x36, 0x24, 0x28A, 0x2F5, 0x1E6, 0x1B8F, 0x6A, 0x545, 0x9D, 0x273, 0xD1, 0xCF, 0x2B, 0x3B, 0x7F1, 0x7F, 0xB0, 0xA8, 0x14A, 0x30, 0x2E, 0x22, 0x2D, 0x74, 0x9E, 0x25, 0x22, 0x20F, 0x86, 0x2E, 0x38, 0x27, 0x38, 0x59, 0xA4, 0x34, 0x26, 0x26, 0x4D, 0x21, 0x34, 0x24, 0x27F, 0x2D1, 0x18F, 0x1BC5, 0x6B, 0x54F, 0x9E, 0x263, 0xD1, 0xCA, 0x2A, 0x3B, 0x7F1, 0x7F, 0xB2, 0xA9, 0x14D, 0x2F, 0x2E, 0x22, 0x2E, 0x75, 0x95, 0x25, 0x23, 0x20F, 0x86, 0x30, 0x39, 0x26, 0x3A, 0x5B, 0x81, 0x33, 0x25, 0x20, 0x4A, 0x23, 0x32, 0x24};
-uint16_t station_portpatrick_scotland_2023_phase [] = {0x7C8E, 0x7D42, 0x3695, 0x7BDC, 0x5669, 0x50A7, 0x275C, 0x4681, 0x74D3, 0x349B, 0x19A0, 0x333F, 0xF42F, 0xFAA9, 0x450C, 0x70AE, 0x32C5, 0x12DB, 0xDE53, 0xB6EC, 0x2BE1, 0xDFE5, 0x886C, 0x931, 0x84A0, 0x197C, 0x21FB, 0x8F2F, 0x411D, 0x9B41, 0xECF5, 0x9797, 0xFFAE, 0x7271, 0x3F25, 0x410B, 0x6A80, 0x3834, 0xC733, 0x3541, 0x7E24, 0x80A1, 0xB0D0, 0xC3FC, 0x429B, 0x59B0, 0xF14C, 0x8C54, 0x74FF, 0x3B57, 0xE143, 0x333F, 0xF42F, 0xFAD9, 0x671, 0x76, 0x1A4, 0xDF69, 0x280A, 0x4596, 0x7402, 0x97C5, 0x44E9, 0xC110, 0xC3B7, 0x1950, 0x21A6, 0x6792, 0x9245, 0xE535, 0x6638, 0xD6AE, 0x7F94, 0xB86E, 0x40BB, 0x25BE, 0xDC45, 0x13C1, 0x7D35, 0x8084, 0x8598, 0x1F01, 0xFACF, 0x14D7, 0x4820, 0x975B, 0xC00B, 0x7478, 0x26AD, 0x8438, 0x333F, 0xF42F, 0xFA54, 0xBE93, 0x6D96, 0xB726, 0x91D3, 0x613C, 0xB0DD, 0xAAD5, 0x60F1, 0x144B, 0x8A3C, 0xC1A, 0x19D7, 0x22B5, 0xC0B, 0xB78A, 0x1E9E, 0xE786, 0x1F11, 0xD740, 0xEB9F, 0x431B, 0x275D, 0xF3E1, 0x77AF, 0x32CE, 0xB490, 0x821F, 0x8901, 0xB44A, 0x42F3, 0x10B, 0x512C, 0x6150, 0x5DC, 0x74A2, 0x2D65, 0x4BD8, 0x333F, 0xF42F, 0xFA81, 0x7FF8, 0xFD5F, 0x8607, 0x5E5E, 0xAAFB, 0x3F87, 0xF2F7, 0x18CF, 0xD0D0, 0x421A, 0x4B31, 0x19AD, 0x225E, 0xE472, 0x8B9, 0x6898, 0x60CB, 0x5E28, 0x722A, 0x3199, 0x44B6, 0x4CED, 0xAF2A, 0x1BC1, 0x7F54, 0xFC86, 0x838A, 0x8BF5, 0x49B8, 0x8AFF, 0xED1F, 0x5A23, 0x2B2F, 0x4BD1, 0x74CE, 0x3444, 0x13A0, 0x333F, 0xF42F, 0xFAB0, 0x4149, 0x8D13, 0x54D1, 0x2B12, 0xF474, 0xCE38, 0x3B05, 0xD0C1, 0x8CF0, 0xFA0D, 0x8A49, 0x1981, 0x2206, 0xBC9C, 0x59BD, 0xB254, 0xDA0D, 0x9D40, 0xD9C, 0x77BC, 0x4620, 0x7277, 0x6A0D, 0xBFC6, 0xCC29, 0x446A};
+uint16_t station_portpatrick_scotland_2023_amp [] = {0x288, 0x2F1, 0x17C, 0x1B95, 0x6A, 0x546, 0x9D, 0x271, 0xD1, 0xCF, 0x2B, 0x3B, 0x7F1, 0x7F, 0xB1, 0xA8, 0x14B, 0x30, 0x2E, 0x22, 0x2E, 0x74, 0x9D, 0x25, 0x22, 0x20F, 0x86, 0x2F, 0x38, 0x27, 0x38, 0x5A, 0x80, 0x34, 0x26, 0x1E, 0x4C, 0x21, 0x34, 0x24, 0x28E, 0x307, 0xD8, 0x1B75, 0x69, 0x540, 0x9C, 0x27A, 0xD1, 0xD2, 0x2C, 0x3B, 0x7F1, 0x7F, 0xB0, 0xA7, 0x149, 0x30, 0x2E, 0x22, 0x2D, 0x74, 0xA2, 0x25, 0x21, 0x20F, 0x86, 0x2E, 0x38, 0x28, 0x37, 0x59, 0x4A, 0x35, 0x26, 0x0, 0x4E, 0x20, 0x36, 0x24, 0x28F, 0x308, 0x16E, 0x1B73, 0x69, 0x540, 0x9C, 0x27B, 0xD1, 0xD2, 0x2C, 0x3B, 0x7F1, 0x7F, 0xB0, 0xA7, 0x149, 0x31, 0x2E, 0x22, 0x2D, 0x74, 0xA2, 0x25, 0x21, 0x20F, 0x86, 0x2E, 0x38, 0x28, 0x37, 0x59, 0x7E, 0x35, 0x26, 0x1C, 0x4E, 0x20, 0x36, 0x24, 0x28A, 0x2F5, 0x1E6, 0x1B8F, 0x6A, 0x545, 0x9D, 0x273, 0xD1, 0xCF, 0x2B, 0x3B, 0x7F1, 0x7F, 0xB0, 0xA8, 0x14A, 0x30, 0x2E, 0x22, 0x2D, 0x74, 0x9E, 0x25, 0x22, 0x20F, 0x86, 0x2E, 0x38, 0x27, 0x38, 0x59, 0xA4, 0x34, 0x26, 0x26, 0x4D, 0x21, 0x34, 0x24, 0x27F, 0x2D1, 0x18F, 0x1BC5, 0x6B, 0x54F, 0x9E, 0x263, 0xD1, 0xCA, 0x2A, 0x3B, 0x7F1, 0x7F, 0xB2, 0xA9, 0x14D, 0x2F, 0x2E, 0x22, 0x2E, 0x75, 0x95, 0x25, 0x23, 0x20F, 0x86, 0x30, 0x39, 0x26, 0x3A, 0x5B, 0x81, 0x33, 0x25, 0x20, 0x4A, 0x23, 0x32, 0x24};
+uint16_t station_portpatrick_scotland_2023_phase [] = {0x7C8E, 0x7D42, 0x3695, 0x7BDC, 0x5669, 0x50A7, 0x275C, 0x4681, 0x74D3, 0x349B, 0x19A0, 0x333F, 0xF42F, 0xFAA9, 0x450C, 0x70AE, 0x32C5, 0x12DB, 0xDE53, 0xB6EC, 0x2BE1, 0xDFE5, 0x886C, 0x931, 0x84A0, 0x197C, 0x21FB, 0x8F2F, 0x411D, 0x9B41, 0xECF5, 0x9797, 0xFFAE, 0x7271, 0x3F25, 0x410B, 0x6A80, 0x3834, 0xC733, 0x3541, 0x7E24, 0x80A1, 0xB0D0, 0xC3FC, 0x429B, 0x59B0, 0xF14C, 0x8C54, 0x74FF, 0x3B57, 0xE143, 0x333F, 0xF42F, 0xFAD9, 0x671, 0x76, 0x1A4, 0xDF69, 0x280A, 0x4596, 0x7402, 0x97C5, 0x44E9, 0xC110, 0xC3B7, 0x1950, 0x21A6, 0x6792, 0x9245, 0xE535, 0x6638, 0xD6AE, 0x7F94, 0xB86E, 0x40BB, 0x0, 0x25BE, 0xDC45, 0x13C1, 0x7D35, 0x8084, 0x8598, 0x1F01, 0xFACF, 0x14D7, 0x4820, 0x975B, 0xC00B, 0x7478, 0x26AD, 0x8438, 0x333F, 0xF42F, 0xFA54, 0xBE93, 0x6D96, 0xB726, 0x91D3, 0x613C, 0xB0DD, 0xAAD5, 0x60F1, 0x144B, 0x8A3C, 0xC1A, 0x19D7, 0x22B5, 0xC0B, 0xB78A, 0x1E9E, 0xE786, 0x1F11, 0xD740, 0xEB9F, 0x431B, 0x275D, 0xF3E1, 0x77AF, 0x32CE, 0xB490, 0x821F, 0x8901, 0xB44A, 0x42F3, 0x10B, 0x512C, 0x6150, 0x5DC, 0x74A2, 0x2D65, 0x4BD8, 0x333F, 0xF42F, 0xFA81, 0x7FF8, 0xFD5F, 0x8607, 0x5E5E, 0xAAFB, 0x3F87, 0xF2F7, 0x18CF, 0xD0D0, 0x421A, 0x4B31, 0x19AD, 0x225E, 0xE472, 0x8B9, 0x6898, 0x60CB, 0x5E28, 0x722A, 0x3199, 0x44B6, 0x4CED, 0xAF2A, 0x1BC1, 0x7F54, 0xFC86, 0x838A, 0x8BF5, 0x49B8, 0x8AFF, 0xED1F, 0x5A23, 0x2B2F, 0x4BD1, 0x74CE, 0x3444, 0x13A0, 0x333F, 0xF42F, 0xFAB0, 0x4149, 0x8D13, 0x54D1, 0x2B12, 0xF474, 0xCE38, 0x3B05, 0xD0C1, 0x8CF0, 0xFA0D, 0x8A49, 0x1981, 0x2206, 0xBC9C, 0x59BD, 0xB254, 0xDA0D, 0x9D40, 0xD9C, 0x77BC, 0x4620, 0x7277, 0x6A0D, 0xBFC6, 0xCC29, 0x446A};
 tidal_harmonic station_portpatrick_scotland_2023_data = {
+        .name = station_portpatrick_scotland_2023_name,
         .base_year = 2023,
         .n_years = 5,
         .lat = 54.8426,
@@ -73,22 +93,29 @@ tidal_harmonic station_portpatrick_scotland_2023_data = {
         .phases = station_portpatrick_scotland_2023_phase,
         .n_constituents = 40,
         .mean_error = 0.0007275186731911409,
-
+        .almanac = NULL,
+#ifdef TIDE_DEBUG
+        .test_times = station_portpatrick_scotland_2023_test_times,
+        .test_tides = station_portpatrick_scotland_2023_test_tides,
+        .n_tests = 480,
+#endif
 };                                                    
 
 
+
+
 #ifdef TIDE_DEBUG
-time_t station_portpatrick_scotland_2023_test_times [] = {1699155373, 1681475912, 1676061487, 1700602808, 1686281477, 1675245171, 1688105632, 1702067965, 1682880736, 1682214322, 1700372707, 1673603627, 1699466821, 1674234757, 1688316640, 1683035605, 1700704833, 1699558914, 1701286195, 1700358662, 1692497264, 1688102661, 1701673343, 1690317294, 1699192149, 1690554284, 1680766045, 1679749881, 1675338785, 1688661160, 1693845139, 1693961820, 1691742198, 1686844797, 1673270801, 1682115171, 1695645750, 1702321224, 1699340170, 1693111865, 1674023676, 1684887825, 1686211053, 1674494360, 1701910756, 1685002471, 1681400549, 1675992227, 1684356225, 1689980001, 1677245492, 1703327835, 1682443710, 1673228956, 1683615641, 1681316582, 1675123426, 1702745390, 1692452848, 1675389610, 1682620106, 1681195769, 1694269695, 1693272856, 1686918585, 1674474762, 1677152507, 1685266631, 1680504845, 1698647260, 1682157216, 1677751347, 1687127692, 1683684309, 1685095874, 1689277612, 1682588096, 1688862414, 1684073354, 1682093603, 1680598423, 1682849246, 1697982656, 1680560371, 1692104892, 1683497995, 1691992630, 1699335998, 1675923154, 1678730438, 1688875542, 1692664120, 1675664919, 1703647293, 1686520048, 1703321852, 1734930878, 1722790742, 1715617716, 1710487855, 1711527039, 1709269963, 1727440852, 1719143203, 1705458440, 1716292890, 1717635173, 1730874422, 1728283191, 1727861406, 1714670826, 1727036343, 1720089716, 1726900580, 1722601683, 1721661781, 1708802612, 1723885072, 1717105428, 1726157291, 1720135399, 1717868037, 1721247344, 1706594293, 1712949819, 1732223949, 1705469935, 1724550460, 1722410044, 1734809861, 1731711955, 1729521713, 1733167666, 1724782411, 1705319759, 1733988442, 1707773930, 1713461788, 1713626926, 1735422982, 1715576929, 1716862014, 1720496947, 1728825375, 1732200936, 1723553016, 1717996830, 1716249659, 1705463231, 1710077043, 1711349382, 1722304214, 1710271854, 1717716768, 1730007020, 1728094681, 1729831133, 1729302618, 1708003169, 1729957954, 1728295563, 1734431467, 1706204084, 1704240931, 1718118793, 1731454616, 1730941801, 1724830778, 1726566345, 1725636235, 1714500866, 1715436732, 1711212064, 1715175032, 1708188087, 1732695499, 1704397135, 1724319626, 1729648101, 1735416438, 1733680400, 1733055955, 1733441851, 1728724182, 1715199859, 1709637779, 1709599067, 1729954969, 1731726601, 1705127897, 1724605121, 1731491977, 1759577257, 1743290979, 1751411214, 1763472473, 1764445015, 1737601104, 1755709512, 1736948810, 1753373084, 1764936227, 1739148463, 1741980459, 1766433410, 1754041899, 1763550144, 1767019297, 1743567434, 1746446011, 1758155309, 1748204422, 1737813068, 1760423454, 1761947009, 1763122195, 1763260269, 1762703153, 1763977041, 1757925626, 1760083221, 1762271794, 1756736868, 1747462990, 1767025473, 1752608061, 1763238770, 1741071419, 1760942707, 1742791348, 1740446071, 1739027771, 1756039905, 1761274026, 1755019287, 1747074829, 1754761350, 1742166829, 1747714197, 1736100514, 1741851170, 1743526663, 1750290319, 1737636650, 1743825078, 1744005734, 1740925879, 1750978125, 1738430330, 1755308427, 1747461162, 1755866055, 1754228499, 1744907648, 1760562107, 1758950760, 1763964158, 1762328358, 1736589979, 1754650581, 1744554914, 1739796282, 1755391249, 1759639595, 1736777801, 1739504391, 1765141454, 1748127763, 1756310820, 1766815030, 1761069711, 1746629542, 1762445974, 1736053142, 1751595498, 1755465531, 1738151365, 1744777651, 1741335513, 1752792295, 1763208974, 1760597268, 1754050949, 1737842975, 1749043743, 1741382870, 1760184110, 1752140756, 1782970194, 1796620592, 1798702567, 1788263254, 1774218802, 1784319408, 1783917124, 1792575806, 1780379772, 1784392041, 1791843047, 1781139434, 1777990813, 1798572190, 1784131416, 1784052348, 1796138647, 1773588149, 1794047221, 1786330169, 1768093619, 1783461384, 1778352087, 1768099882, 1777392431, 1791413170, 1794954358, 1785859950, 1782472368, 1789369692, 1791213146, 1775280213, 1779769199, 1795883502, 1796196980, 1795938106, 1772033710, 1789580671, 1778940506, 1768979996, 1796306669, 1787706423, 1780333505, 1793329779, 1797555521, 1785876721, 1779133491, 1773810904, 1795390885, 1780199671, 1790899715, 1770941240, 1794101773, 1774178558, 1784813262, 1783441375, 1772058913, 1768565032, 1797586848, 1795978951, 1775308779, 1775460787, 1787516301, 1791067463, 1795385398, 1775840942, 1794013527, 1791909720, 1784521027, 1768132312, 1797975070, 1796812698, 1768797903, 1775211089, 1794469449, 1778322686, 1788726939, 1796629714, 1796650490, 1795589132, 1768334848, 1784545287, 1788718242, 1784142283, 1785206438, 1797772231, 1791682331, 1779553623, 1796298300, 1784246842, 1790505656, 1791651837, 1781782428, 1768036481, 1783953479, 1783147384, 1802721230, 1800470923, 1802681048, 1829489479, 1807343945, 1815212443, 1811596772, 1807753153, 1829804736, 1824782989, 1829413605, 1814396295, 1802880540, 1817819972, 1811790245, 1814630672, 1816031580, 1809065593, 1800138237, 1811019155, 1818074295, 1817759852, 1820064910, 1799327048, 1817948593, 1819110819, 1823065824, 1820592036, 1818813683, 1827440381, 1827176066, 1811732761, 1827637789, 1800103146, 1824494649, 1818169213, 1829539331, 1829299027, 1803879579, 1806452942, 1826387364, 1815449160, 1823142263, 1810625720, 1818029684, 1800534223, 1799383070, 1815447350, 1810931720, 1806088513, 1810990532, 1804445144, 1808687644, 1825787848, 1823534301, 1827905769, 1830276493, 1824581160, 1803561317, 1815858027, 1807340505, 1805662907, 1806930840, 1798990532, 1808777041, 1826034455, 1802652651, 1813450321, 1805513325, 1818705617, 1830253487, 1812284823, 1818883671, 1808680120, 1814581183, 1829862663, 1812647546, 1813466748, 1823240615, 1802521171, 1807077126, 1800310389, 1823183377, 1812190397, 1812747714, 1827652422, 1822089795, 1828182629, 1826850473, 1818993205, 1799127746, 1807366192, 1829435748, 1815947529, 1814450473, 1800563745};
-float station_portpatrick_scotland_2023_test_tides [] = {2.9320801741402747, 0.9725453414694404, 0.6187534219689845, 1.997013412350703, 3.7112642708316743, 2.994061870808947, 2.5825520478518817, 3.341378228143693, 2.613646644270559, 3.639056442031319, 2.63942436791828, 1.165361335114604, 2.8160075740431485, 0.8650668789624433, 0.7141527779777952, 1.1656683585595051, 0.7195548889005362, 3.2203306544191403, 0.7493649163619424, 3.1685501820532687, 3.6886978805064325, 2.1252121284382635, 2.2517011659391044, 1.548789496632607, 2.483634898856368, 1.2494221892021387, 1.1898086229611868, 3.753172368226545, 2.719081504701373, 2.3184708637898517, 2.889382386737603, 2.524713483529896, 3.0613776622135545, 0.6087937593947506, 3.854691037047428, 2.587149915808494, 1.4397507618758654, 2.0351089111699783, 2.942943811708322, 2.3323755202790206, 2.9806529783736977, 3.105556335434632, 0.44950561047897286, 0.7560592380703256, 1.1968479039737567, 0.8960622061647759, 2.9319112047807745, 3.3359769188185453, 3.090674701741464, 2.2072282819070463, 3.8491355158958545, 2.8460628072383236, 2.444805860445075, 3.3574745861997055, 0.5742450270107462, 3.3046377933724522, 1.31653306599878, 2.361106575913736, 3.3993817116327487, 1.7906765000045615, 2.5813505135068926, 1.2036714415702543, 1.555342705848308, 1.4408158695942592, 2.625402542711905, 4.052069398222188, 3.2064129495719595, 1.5647701544300432, 2.086601605593286, 0.38888209988696365, 2.1595482520354734, 2.6183073168294055, 3.348849110191618, 3.6908858258810895, 0.9296543633020216, 3.165272901883174, 1.1114068900105338, 2.13742259191063, 0.7158788184927942, 1.275180259333398, 3.0114038613375955, 2.3499555244592334, 2.4541301066226104, 3.29592555902778, 2.8417498146855107, 2.642516176249375, 1.1925352107860512, 2.7462710388313663, 1.1337136715661333, 2.2739715046200097, 3.8230409739354236, 2.873529120497632, 0.859122837738594, 1.604746515562886, 1.7137508628896314, 3.433311710504917, 3.0693937181037163, 0.9090544577306924, 3.0376824470342556, 0.7756150378565551, 0.9542772921529243, 2.45323039407514, 1.599934329159913, 3.4169209013292834, 3.2417801752854913, 2.80500314167017, 2.781066094114346, 1.3439383308182504, 0.982079396660298, 2.8577920133987647, 2.9286762661495787, 0.4750879892822388, 3.418004245632364, 0.3300599623979074, 2.6107750461137473, 1.9716722562159315, 0.8904517323384047, 3.1501139601515025, 1.309773817301472, 2.803193152779231, 3.42824415457033, 0.959537411437622, 3.0685480749678375, 1.645585320399628, 0.6126829677580375, 0.9440750534303434, 2.9812332826624677, 3.6017848639885157, 3.225368004856429, 1.7269827891190364, 4.120181035800729, 3.787853581795624, 1.113367924274045, 3.2089714313332176, 3.0037999826671866, 3.331437401467151, 0.994036504167594, 1.98672271872586, 0.7324644928287246, 3.399280876711074, 2.5968705066009568, 3.6464871071558913, 2.6592707843632386, 1.3968709818298732, 3.7251702110406693, 1.460722949581946, 1.6781945861391712, 2.7465716204529804, 3.60210876726869, 3.169557411813466, 0.8534107003537598, 1.3434625732298007, 0.003509611505994513, 3.7090154716838226, 2.252570505096608, 3.1758399702772904, 2.923173815758866, 3.45147053581601, 2.982720585404865, 2.291256295909181, 1.7977034843938708, 3.162458770096061, 0.7447146666790089, 1.690319887458216, 3.1607510888334533, 2.2087362319788215, 3.141144103825725, 3.01419370067387, 3.479725648245144, 2.8429921526292077, 2.4970133476180227, 3.5889657101229777, 0.6109144350510712, 2.945269110653128, 3.308549193003039, 3.2013699491882273, 2.5492342404055974, 1.406400279126152, 3.166377042933014, 2.8534278319440083, 3.368269841630209, 3.6081428892810403, 2.341730785219282, 2.326334683832632, 1.7524292209831847, 1.4941124007751247, 1.3846960130216557, 1.9477781146727542, 1.2262571162971345, 0.6873898790636088, 3.226127430231788, 3.5187677245262825, 2.7649494399585213, 3.7616273033684466, 1.1854268326528035, 2.314520508858694, 3.1303528772587557, 2.195991810698112, 1.477886473383152, 3.6316044459754266, 0.9696423946029212, 3.8826070189241713, 2.3047438479343523, 0.8051215131109709, 0.9025166692797111, 0.9371328612141301, 3.6679838688529087, 2.023179887793157, 2.591952995774894, 0.8904112102501741, 1.6469232117151673, 3.0466155744706107, 1.4556983672556838, 2.992748620431209, 2.4464860791176952, 1.5861600636404456, 0.8964783521512883, 3.296879574450848, 1.8048691408314637, 1.9628504495609251, 0.4962327429735446, 0.7073471735893028, 2.177006679490702, 1.281855534670394, 3.0037470159789925, 0.9568551740956909, 3.524761470585591, 0.757382004628718, 1.326570073791397, 2.621590836432294, 1.7614994930013266, 1.2584675680513762, 3.4708425671936647, 2.885133196090042, 1.4742979636656581, 0.86438158946047, 0.7501061184680512, 2.811397766730058, 3.3256346113182986, 2.495687231168729, 1.7155888351040405, 1.77019903909407, 1.1823157372138486, 1.4891424405971816, 3.3089539175499043, 2.98383329199684, 3.6657492683909467, 3.407441781263672, 1.544284571612563, 2.756408596223507, 1.5952730554761039, 3.1336811652718186, 1.434162217834552, 2.4010014934250563, 2.6835267651902655, 2.0373583665382444, 1.3864252927590541, 2.068205829714664, 3.377416698247443, 3.340357190124791, 2.3167254802106783, 3.2081629435311902, 1.4388074281559269, 0.7131251202514509, 2.1539094155120844, 2.1464650593465135, 1.1644724617681141, 2.956405717966106, 2.731158774532196, 2.9058931736419407, 0.7962788025014246, 0.8244763740660226, 0.8391198974270063, 2.943307249476132, 1.906194583198701, 1.8814251381779181, 3.8428182973378924, 1.9505127198608836, 1.8667797854324075, 0.8949744439531545, 1.8536626932913092, 3.0333877800627924, 1.3701780293470234, 2.8932697553245834, 0.9825553771164398, 1.8595347803021125, 2.9997582661328233, 2.9273744864096396, 1.0127906958940143, 1.1001694237730149, 2.591674445490365, 2.7313165928730587, 1.7032492882963353, 0.6468466839420098, 0.6883873574708944, 2.6758254321221013, 0.7225784626029947, 2.886169841435542, 2.8052841485830617, 1.0813071245191277, 3.324164611657555, 1.6996039843035151, 1.4457847421276437, 0.7169151390368627, 3.3906048352875273, 0.9117578056317854, 3.6246200721811164, 0.8716881926717748, 1.50732359745204, 1.0296852956852813, 2.5176316675077883, 2.440668542999115, 0.5399124035132953, 3.279162408284138, 1.3178821346287255, 3.2592737603629574, 2.562065157696301, 0.4157317578264817, 2.0778393335220056, 0.8129522085223951, 2.0250505781221912, 2.776837789328807, 2.967720479286063, 1.157603676768877, 2.7893050535197617, 2.120027763716568, 1.7675225328179731, 0.8098002202216141, 1.4267080029171852, 2.3680913480842007, 0.9662541526529296, 3.495308182529553, 1.3152806657352745, 0.7861271454770362, 0.7429294335697775, 0.6896228512227742, 2.988659720281631, 1.09681480823713, 2.6502562821465903, 1.9235757694364997, 2.1049029014686504, 2.917748268460764, 1.187797625239525, 3.2462867110131706, 1.4144073031471616, 3.0315719327888853, 1.823576654598015, 1.484800571357408, 3.7113731116733457, 0.5796435779472986, 3.075869237669851, 1.0087720029005502, 3.685888714668232, 2.798931171807917, 1.9784524809239188, 1.6325107616887848, 3.639301089237581, 1.2744402529870593, 3.70360878793759, 3.610039631061492, 1.0837349350069567, 2.899590336794272, 1.0444338131673392, 0.9832689156632834, 2.928839563020978, 2.583978792097195, 2.2838448557782254, 1.0071037400092329, 3.1185848530731364, 0.7279714510064269, 3.171636407557544, 0.7417132090164412, 1.5994603105396552, 1.3187190513897398, 2.987385746316655, 3.0440986253910047, 1.5318937720715458, 3.7852514659545475, 3.480999603705698, 0.6214427881591132, 2.449460546160532, 1.3036110818328488, 1.2455330903515127, 0.9737682110124454, 2.7180847646516004, 2.235185051906028, 1.922382589672403, 2.1970006739502224, 0.5224699452381182, 0.4858417182028936, 1.165193170387896, 1.5915264757503318, 2.128346563387826, 0.47833838104795207, 3.648616804350353, 2.3249476302454606, 1.4333558840324288, 2.188149353884358, 2.9545662899976457, 0.7112248170933771, 2.2666176064277845, 2.994422262820025, 1.2084832016726834, 1.555611381631064, 1.507893980537618, 0.8284529824096305, 3.6744891267910225, 3.3077067654262313, 1.400437611198985, 2.0621167567142566, 2.8372867284031194, 2.061102007972522, 3.701264301921135, 3.4506683756631733, 3.7702570358672745, 1.624080031203847, 1.5328997410406915, 1.6543238850051243, 3.612732759742303, 1.2619281012005383, 2.591498531376178, 1.0738306695440067, 3.041002436715499, 1.587793375061429, 0.8272614320062563, 1.916957160028576, 1.923867839315324, 2.7338355086987445, 1.3719308363756826, 3.0171893210532623, 1.1664441475113068, 1.6361796824204722, 1.738141912567266, 0.7240250544042587, 3.4749116816279986, 0.8310667056361508, 1.0243428095709504, 3.250923975592918, 0.9094323093240656, 1.5244281571386442, 1.2836034700012962, 3.6757933593209238, 3.609463697020022, 2.858527452629521, 0.45374539118496143, 2.6947647712683866, 2.4546036225007546, 1.3747414818973887, 1.238451510732394, 1.0149349531061962, 1.4811806304140218, 3.656626978160795, 0.7888514607201756, 0.9816115490960132, 3.2614228048946816, 3.675855875952411, 1.218784177300842, 1.0671905552289145, 1.3325070391058376, 3.581186680094988, 3.2341721834936656, 1.0266996033931655, 2.93706313975494, 2.121681673548233, 0.5770086241075911, 2.5227201626830573, 1.8604748955186912, 3.2819850853929173, 1.6475071236903756, 1.7280797721817163, 2.4654811624878374, 1.5823316446032434, 1.8084767414100118, 3.317195795722714, 1.6222864309040526, 3.675068602033348, 0.8225309949193476, 3.0680151581382846, 0.93701022086126, 2.8099429818074735};
+time_t station_dover_england_2023_test_times [] = {1686032794, 1686781164, 1680443479, 1689918503, 1695469250, 1693847915, 1673146729, 1691242082, 1679259621, 1677224476, 1695643094, 1701916150, 1692815790, 1699484296, 1699214847, 1684737997, 1678996421, 1686321206, 1694184589, 1698328237, 1675930689, 1701850604, 1683977558, 1698039131, 1681586299, 1700716672, 1695552839, 1699434029, 1696171717, 1696573681, 1691636975, 1694988286, 1679310129, 1677342325, 1688536468, 1685805014, 1673667377, 1701529089, 1676767028, 1692159578, 1678177256, 1692432073, 1684256003, 1673844190, 1687966409, 1675127201, 1696905798, 1676547921, 1682252526, 1697325635, 1674420279, 1693447861, 1689363147, 1688308902, 1674987110, 1673786208, 1695282393, 1693489587, 1673221406, 1682346553, 1680319613, 1698400198, 1682832353, 1704044257, 1692168569, 1692664720, 1677411979, 1688072356, 1698759642, 1690432830, 1696773165, 1698069370, 1676476631, 1703777906, 1692263686, 1691469910, 1701777925, 1688266800, 1694596626, 1680135954, 1674480460, 1703880185, 1678145271, 1697769884, 1694509927, 1682272701, 1696412825, 1699660537, 1677926944, 1701516518, 1678912094, 1687202841, 1677467654, 1691921967, 1699816057, 1693398423, 1716970257, 1729624615, 1721149661, 1722046373, 1733226758, 1707019753, 1707458839, 1731414503, 1709808346, 1705202007, 1722903930, 1711609474, 1722205584, 1734574565, 1710315306, 1733736118, 1717088846, 1720351391, 1721499164, 1720606843, 1707391767, 1705364678, 1718224810, 1725400239, 1731376415, 1724925323, 1706971965, 1730281331, 1735093850, 1720191652, 1710880291, 1717378065, 1731832021, 1734164192, 1716268461, 1732741123, 1718142876, 1726031218, 1725572335, 1707947161, 1724681646, 1728280898, 1719711968, 1722154834, 1718833110, 1714113014, 1707709674, 1714867456, 1712952166, 1704510365, 1713121356, 1723895294, 1714644488, 1714617938, 1725220087, 1705550074, 1710486267, 1729366373, 1729840220, 1709018311, 1726453196, 1713982459, 1719858984, 1716768183, 1712670299, 1709225055, 1710390105, 1706676723, 1719775837, 1707142383, 1713603116, 1732159702, 1720409616, 1708016683, 1733292031, 1732281577, 1729929409, 1718901211, 1704823598, 1731149310, 1731399423, 1709516040, 1724264260, 1724228089, 1716920450, 1704160717, 1725686408, 1715760325, 1729720332, 1712247033, 1718742903, 1718744059, 1735675419, 1734683566, 1724434170, 1730641021, 1743797389, 1759219814, 1744933443, 1758992633, 1762293578, 1749051199, 1737696775, 1744334222, 1739428732, 1749109492, 1762178622, 1759923428, 1752298324, 1743253170, 1750773293, 1737650229, 1752477279, 1758365377, 1761119472, 1738031419, 1742040922, 1737267704, 1743097650, 1747144686, 1744623493, 1743603763, 1736682146, 1748140690, 1750304025, 1743567194, 1761276475, 1756590612, 1756399181, 1736252752, 1764150742, 1750704109, 1757519727, 1762223658, 1761443536, 1744375684, 1748065712, 1737253915, 1765834787, 1741772869, 1758155190, 1762619999, 1738551717, 1765548545, 1738413200, 1738530312, 1749045961, 1764578850, 1748692213, 1765277057, 1755416321, 1756467102, 1748413845, 1744886015, 1755533842, 1757633951, 1741122824, 1746108611, 1743056570, 1752078377, 1756106558, 1761255224, 1744935421, 1749867529, 1759191237, 1755062337, 1748043782, 1762959992, 1765338624, 1742582463, 1751285445, 1738471946, 1765388656, 1760074138, 1754760995, 1737011593, 1760659962, 1747810828, 1742240655, 1747381566, 1752547022, 1736389737, 1737772796, 1742577047, 1767127538, 1750998334, 1764290599, 1736444857, 1736861020, 1743644046, 1753947297, 1766074618, 1792173210, 1795718691, 1770358202, 1770174400, 1773650271, 1789939920, 1770472580, 1781606600, 1781210106, 1785270905, 1767788584, 1773880345, 1782043439, 1785003905, 1796169844, 1770980433, 1769145906, 1770476314, 1767471803, 1768472345, 1794599932, 1773346028, 1781187601, 1773124376, 1772705336, 1773864038, 1778863536, 1782555102, 1773388966, 1771676851, 1796364331, 1798195729, 1775013910, 1792973487, 1794002133, 1784407685, 1780866699, 1797011577, 1788742685, 1777280909, 1768377084, 1791457635, 1786148918, 1767552320, 1785412954, 1772396496, 1786102948, 1787144538, 1773694717, 1774691744, 1790164762, 1779989701, 1790245757, 1771495172, 1784065108, 1798313808, 1795066342, 1777810899, 1768666789, 1779648120, 1770587509, 1797537338, 1787718994, 1768300315, 1771107042, 1768598575, 1794550482, 1795492369, 1794714491, 1772853057, 1783644216, 1769819564, 1791643962, 1773130427, 1780190057, 1793433507, 1777372587, 1794414135, 1768505346, 1772765846, 1794281875, 1777830269, 1797527769, 1777587581, 1783972667, 1794092028, 1771165424, 1778683543, 1789758791, 1776823085, 1768306729, 1772355496, 1792109744, 1781877961, 1773043357, 1784508097, 1812581879, 1821940206, 1805980557, 1818698075, 1802351227, 1821805125, 1816132402, 1805499827, 1812736845, 1807764923, 1808843429, 1820997358, 1818127491, 1800883065, 1824801465, 1828564545, 1816677761, 1821181650, 1798833739, 1803891217, 1803302892, 1822320414, 1809557263, 1802525642, 1813386179, 1828653943, 1824199569, 1828336866, 1808756758, 1806989316, 1829639261, 1819452550, 1802714067, 1818951780, 1805259575, 1806934231, 1828983625, 1809547838, 1805924375, 1800195350, 1806347012, 1809557200, 1811672959, 1822181720, 1827234184, 1815254736, 1799964621, 1822897360, 1819197547, 1818101822, 1815166514, 1813153940, 1811963136, 1807530629, 1806606667, 1805483486, 1819870780, 1800803927, 1808846371, 1798800545, 1801004793, 1816090274, 1800041142, 1823497228, 1818591092, 1829920479, 1825895029, 1829048505, 1798893844, 1827350404, 1809681411, 1806919757, 1823860214, 1812064667, 1818763042, 1818657068, 1801910282, 1801829309, 1828477619, 1816499596, 1811804256, 1822469827, 1821551237, 1827853521, 1825731138, 1815189687, 1819288765, 1808665669, 1816516141, 1807012854, 1824826478, 1829856696, 1804681139, 1821990140, 1825418747, 1823499518};
+float station_dover_england_2023_test_tides [] = {1.2071629722035697, 5.2912959049496555, 2.810237769331823, 2.5653234493649526, 2.322791638302342, 4.201783268646837, 3.9924999453948535, 6.926073807884003, 6.12743409533464, 1.12863839640456, 2.782421770338321, 3.1393081550773805, 3.7024574913632664, 4.275103562465586, 3.6804058868640293, 1.2930227552743985, 4.624171735016904, 6.088542818766928, 3.984793097335874, 2.3058910144541858, 1.127679605453605, 4.073531686706955, 2.018784972554755, 5.281895162058824, 5.540187370425503, 4.672584382182323, 2.6562775053266936, 4.978654168564223, 5.122787920519648, 3.9626822404013184, 3.9957827291340546, 3.529108796772079, 6.290424009552841, 5.571093774158925, 1.4603871261698822, 2.5129087571735713, 5.896342167416466, 5.718995121951806, 4.676379934014433, 2.1774156153359088, 2.7055868731877473, 1.2778284693829087, 1.7654199001836384, 5.681511082962293, 3.507681993603177, 2.2443916292040322, 2.4620354439137473, 2.8951544766048767, 6.311719167185702, 6.400574716515674, 2.6296410221050337, 4.069127664620925, 5.2944680957534445, 2.638054931795217, 2.0925276062175597, 2.4037596285073173, 2.076732312549775, 5.01031911551165, 6.159771974675601, 6.003928197605225, 2.6031825956363894, 6.6440383126329285, 4.249429187158102, 3.4017882728220825, 1.4582528744185166, 5.311485338558985, 2.040089046549149, 5.2387488760500815, 6.337921813399627, 5.3983981248010755, 2.9340825436203604, 2.8536450182704387, 4.205169413026339, 3.4952426034609934, 3.694751750989887, 5.90635600034857, 2.455458756743972, 2.0045306002542875, 5.847724182590952, 2.5727745888346605, 6.372613804853854, 1.4819846717786005, 6.245252423844457, 5.8540332281939955, 5.815686127457234, 2.2122275958685456, 1.4095672920486841, 4.75852264304993, 5.275848037652918, 3.7459254632264227, 3.314441116000153, 1.3859323513496455, 5.969842578103393, 5.38438763708246, 2.2098922624614925, 5.451931755059744, 2.190780555809319, 2.4747730742087444, 4.653551512827127, 6.188797912522463, 6.272402593080556, 5.328989761684648, 1.258439597489692, 2.5460481446398755, 4.826133786538856, 5.19684433832064, 6.246534760811462, 1.1163685404249368, 1.6857018683529856, 6.162975941668614, 0.4502585712289947, 2.8382479857705523, 5.583734748119905, 6.122866947814881, 1.6393165938596703, 2.2891065165742233, 5.480724690899376, 5.118276485828598, 2.138977710129972, 4.95880955936834, 1.9610751730108136, 4.25370626851392, 4.824391153026854, 6.182942365984752, 3.0047505693462018, 2.8372222626236994, 4.75857248840731, 1.672933681465632, 2.290143685095307, 5.574266626733327, 1.498357104492375, 5.713634929637678, 1.6280296660471525, 4.8494662622363185, 2.632115397576207, 0.8980798990333594, 5.388805985740068, 2.4267474441533685, 2.220806115772274, 2.981440675571039, 5.834650280377723, 1.2063031582814754, 4.204055796991424, 3.2290390859417077, 1.0628379491846807, 3.6761190544221036, 3.121827472444459, 4.439743816198916, 2.740211549174294, 4.1734328068655735, 3.4821538985151537, 6.426901565843064, 2.2838537094642075, 0.5269678821558913, 4.441193617338411, 1.0781737592415448, 2.401687952843115, 1.1253803606182589, 5.995478669720178, 5.8613116876756255, 5.350758968909114, 4.322230072961604, 4.765959772023038, 4.5690460376565, 5.446022060011493, 2.361041594602474, 5.618744193882539, 5.76517554683882, 4.0661951377571475, 5.340140388350687, 2.0332616012783293, 4.084754525609771, 4.766061161997153, 1.5891531472625462, 2.4573402009166823, 2.1672492448261935, 5.867457174404846, 3.797891587049493, 1.0312548781974953, 1.184371744956671, 3.2157332282376734, 5.8243739406856205, 3.0832632667656967, 3.3841377478113164, 2.0159767428155977, 3.122651529793152, 5.693418718780131, 5.671750794667702, 2.120311186324104, 1.5704763026762207, 3.410666901284732, 5.648114484367399, 2.638236112576198, 3.2331067893589207, 4.679334782701096, 4.077314644637414, 6.732287216753084, 4.068885315837547, 5.034835324834161, 4.1198558005265244, 0.9451584223497773, 5.0997488898199395, 2.2015832675282603, 7.086055424461567, 1.7460646649934375, 5.585000907514248, 3.178910518268105, 4.849099236439825, 1.4660072874735126, 6.293508357585614, 2.023092561267753, 2.940581664904244, 6.372689346341902, 3.2329653230001796, 1.571528624226407, 4.773672288608112, 4.016133562965889, 6.4921244199537504, 5.296916680730897, 1.532592089138252, 5.5337153069457985, 4.691424627975053, 3.992344991587856, 2.0034402248526426, 4.705300654644987, 1.8332841681038115, 1.9660680101027357, 3.7390953915378193, 4.249903667382399, 2.228483812816655, 6.011364724584739, 4.957140567727853, 3.694895978296748, 6.309109982124766, 5.147642050413914, 5.988167920259048, 3.176564555168963, 3.3039889196999397, 6.452571564481542, 3.4779759424442904, 6.619092426052877, 0.9667775828464727, 2.7596917606423204, 5.4017308742868755, 4.172457043624112, 2.2111516970438907, 4.135993661885589, 3.1073860225842513, 0.7675613884007656, 3.104888308205097, 4.407656785154349, 4.688518586964423, 0.9593663564081456, 6.355467764503758, 2.71399932246788, 1.741837250181875, 1.0753419345328563, 3.5194713449579, 5.48613627566412, 5.472847811855397, 3.140645749486718, 3.4693371118485876, 3.2884141290364823, 5.021151712365008, 5.870223614058487, 3.4969730029039856, 4.009897293413522, 3.9598601469474612, 4.577833150684825, 2.3127776652677947, 1.2875330819569895, 1.1758266630610736, 3.1806718183201292, 4.805770550736663, 1.100117720297352, 1.2769823285751785, 6.014215147161013, 2.702313937128147, 2.544300683496361, 4.637473815837728, 5.25292538532378, 2.808310281152843, 3.381693094052877, 5.319793597347218, 5.425848273981065, 6.6272942202368315, 2.8567878228520156, 1.7244271108770013, 3.486778688005067, 0.9927175495677844, 2.8201310702008415, 4.96582325796351, 5.583716531926433, 3.764562595315404, 6.0400797191854405, 6.178923379028104, 5.652651429517548, 4.283854857895408, 5.484480983502846, 5.899205867959107, 1.9716299251914244, 4.400456338310702, 1.9853575434264477, 4.140096180021572, 3.5383668077780865, 6.1474828522475775, 3.2401653237202774, 5.014004803840055, 1.5627882725563453, 3.943682316276866, 1.8119483429511993, 3.4360551020958385, 4.105225567103692, 2.688990781343373, 1.1661332884320421, 5.574088703563926, 4.36050742456221, 6.140601361678841, 5.484389184737134, 6.3839540982447325, 2.2360316207737387, 5.741768769749593, 6.167627465046579, 0.8836750275572923, 2.1633966411609795, 1.9262250047870633, 2.265934920276747, 5.542475199628545, 5.3261612542115095, 5.613628241335772, 1.8887662721857768, 0.9887703206599951, 6.293697278696792, 5.1482490862410195, 1.9569883371571226, 4.278592511104035, 5.817251254089262, 4.401677573371916, 4.141763955362492, 2.0362956419147222, 5.82684603831038, 3.7871395813179274, 5.519752684863901, 0.9888200430890753, 5.255777194719073, 6.243808641544952, 1.8140287401875073, 5.467720534602563, 1.758128766580195, 3.7998979564264053, 1.6909637859536202, 3.5051626254502373, 5.629275272659362, 5.743351345775838, 2.0885019526569084, 1.729999751680887, 5.198883762618633, 5.5992603413125375, 1.7257018182436223, 4.035953714917265, 3.133017661454474, 2.255653062270119, 4.697332825139238, 1.8198777070449754, 5.469859110986064, 2.910384813666898, 4.758238141511468, 5.33104954416735, 2.8775592796949008, 1.6081506798990783, 5.318857064172495, 6.348439220937582, 4.157045720526171, 6.181256577529562, 3.0093966187185632, 1.7671175823340046, 3.521443862537143, 6.473042641614265, 2.5167125181212295, 5.901529736166559, 5.3498331544187785, 6.476205794842088, 1.7771025006631325, 3.9194702723478967, 1.4125012783960347, 5.374088013428509, 6.609079627477401, 1.7814543974905677, 6.270279746097942, 5.360176894020907, 6.057893435408784, 4.593727997422948, 5.4895428255863035, 5.297914713669744, 5.066891935954551, 4.48633809107595, 2.377963821941982, 6.893135539632885, 6.202382390310095, 5.604392115727974, 2.9332461285989453, 6.57530855411116, 4.779536691959331, 3.3279537282796725, 6.3813098991726935, 1.969007638860971, 6.3075820779215235, 5.215987196163782, 1.3955539520220583, 5.759251022987202, 1.912496263470433, 5.492731797673534, 4.831744229110769, 0.9906316375536469, 5.713936009247339, 3.5136204410075313, 5.269148558879354, 4.818884748534836, 5.227923194912241, 3.360320443022733, 1.3835708837082623, 4.131329462419033, 2.6569905053130265, 2.871333693893641, 3.534390014769005, 6.31304337603531, 3.09546853191284, 3.707560102111206, 3.717849425769073, 1.919684086061928, 1.7640200029335495, 2.7773456341455334, 3.0188393470775683, 5.281316168509156, 1.513508885603439, 2.6633634286019716, 4.445530490279976, 3.3327748142340434, 5.039825763022954, 4.884462869838668, 0.6212617163345241, 4.695016387680157, 4.549631991079082, 2.3169143321801062, 2.543368321887138, 5.8918402865601545, 3.5104659915429526, 2.69993878473136, 6.406889014096572, 2.8115645005208023, 3.170223444468115, 6.451332558518724, 2.0593930554313564, 5.8085847653240466, 4.198730082886259, 6.115185780377125, 6.620439942911699, 5.749979161542332, 6.267827569546216, 1.3415109605248752, 6.045495119976136, 5.44985280976596, 5.052001681989494, 2.798237230565798, 3.708002323832921, 3.440840307449241, 2.8381111619845907, 4.192397695704414, 3.08503447054262, 6.3121337155658495, 3.371851778268414, 5.535124995124678, 2.9771358963044015, 5.896095691536754, 1.6258239677175899, 5.8842856063992, 6.51089623074192, 5.805649940672634, 4.015043234167467, 3.7974547371852654};
 #endif
 
-
 /* Mean error for Dover, England in 2023-2028 is approximately 0.00040m */
 char station_dover_england_2023_name [] = "Dover, England";                    
 float station_dover_england_2023_speed [] = {7.2921158357870547e-05, 1.4584231720055478e-04, 1.4315810553074262e-04, 1.4051890250864362e-04, 2.8103780501728725e-04, 4.2155670752593087e-04, 5.6207561051938818e-04, 1.3787969948654463e-04, 1.3524049646444563e-04, 6.7597744150773076e-05, 7.2522945974990243e-05, 6.4958541128674080e-05, 1.4544410433286079e-04, 1.4524500735288060e-04, 1.4280490131076179e-04, 1.3559370068442646e-04, 1.3823290370652545e-04, 2.7839860199518825e-04, 2.8596300684150439e-04, 1.5036930615707798e-04, 4.9252018242171696e-06, 1.9910619144015089e-07, 4.2688012221784200e-04, 4.1891750450383182e-04, 4.2648190935014801e-04, 1.3066849886020929e-04, 2.7611260319307011e-04, 5.6700081185879169e-04, 2.8636121970919838e-04, 1.3295449766232746e-04, 1.4031979631720350e-04, 1.4808330735495979e-04, 1.3519548781673247e-04, 1.4012068964094966e-04, 2.8332380381940539e-04, 1.5076751902477192e-04, 2.7875180621516905e-04, 2.8367700803938624e-04, 2.7575939897308925e-04, 2.8860220986360338e-04};                
 uint16_t station_dover_england_2023_amp [] = {0x126, 0x58C, 0x2B2, 0x2E66, 0x528, 0x146, 0x62, 0x876, 0xE7, 0x16D, 0x69, 0x8E, 0xEFA, 0xD0, 0x14C, 0x1D8, 0x20E, 0x1E2, 0x36C, 0xE3, 0x5C, 0x14C, 0x76, 0xB4, 0x144, 0x5D, 0x7E, 0x8B, 0x14C, 0x7E, 0x90, 0xB1, 0xF9, 0x7E, 0x5C, 0x93, 0x7D, 0x9B, 0x5D, 0x70, 0x128, 0x5B6, 0x188, 0x2E30, 0x51C, 0x142, 0x60, 0x86C, 0xE6, 0x173, 0x69, 0x90, 0xEFA, 0xD0, 0x14A, 0x1D6, 0x20C, 0x1DD, 0x368, 0xE2, 0x5C, 0x14C, 0x79, 0xB2, 0x141, 0x5C, 0x7C, 0x89, 0x154, 0x7D, 0x8F, 0xB0, 0x91, 0x80, 0x5B, 0x97, 0x46, 0x58, 0x5C, 0x3F, 0x128, 0x5B9, 0x298, 0x2E2D, 0x51B, 0x141, 0x60, 0x86C, 0xE6, 0x173, 0x69, 0x90, 0xEFA, 0xD0, 0x14A, 0x1D6, 0x20C, 0x1DD, 0x367, 0xE2, 0x5C, 0x14C, 0x79, 0xB1, 0x141, 0x5C, 0x7C, 0x89, 0x155, 0x7D, 0x8F, 0xAF, 0xF6, 0x80, 0x5B, 0x97, 0x77, 0x95, 0x5C, 0x6C, 0x126, 0x595, 0x372, 0x2E5B, 0x526, 0x145, 0x62, 0x874, 0xE7, 0x16F, 0x69, 0x8E, 0xEFA, 0xD0, 0x14B, 0x1D8, 0x20E, 0x1E1, 0x36B, 0xE3, 0x5C, 0x14C, 0x77, 0xB3, 0x144, 0x5D, 0x7E, 0x8A, 0x14E, 0x7E, 0x90, 0xB1, 0x141, 0x7E, 0x5B, 0x94, 0x9F, 0xC6, 0x5D, 0x8F, 0x121, 0x550, 0x2D4, 0x2EB6, 0x53A, 0x14D, 0x65, 0x885, 0xE9, 0x165, 0x69, 0x8B, 0xEFA, 0xD0, 0x14E, 0x1DB, 0x212, 0x1E8, 0x372, 0xE5, 0x5D, 0x14C, 0x73, 0xB8, 0x149, 0x5F, 0x80, 0x8E, 0x140, 0x80, 0x91, 0xB4, 0xFC, 0x7B, 0x5C, 0x8E, 0x85, 0xA4, 0x5E, 0x75};
 uint16_t station_dover_england_2023_phase [] = {0xE8E8, 0x78B1, 0x4439, 0x7C19, 0x3355, 0xEEE8, 0x98A3, 0x4DEA, 0x1C0D, 0xE450, 0xE5E2, 0xD3A6, 0xEF02, 0xFD40, 0x5789, 0xACB8, 0x3815, 0x5F3, 0xA56F, 0xF769, 0xF7B4, 0x2C7E, 0xEC6B, 0xC11B, 0x6565, 0xADD0, 0x68E3, 0xE33, 0x2E68, 0x75A8, 0xDC03, 0xACBB, 0x1CC3, 0x8FF8, 0x5EF2, 0x84BF, 0x37D, 0xFC5E, 0xD9B5, 0x6E83, 0xEA7E, 0x7C10, 0xBE74, 0xC43A, 0xC396, 0xC74A, 0xB924, 0x56F4, 0xE5FD, 0x2A23, 0xE60E, 0xDA62, 0xEF02, 0xFD6F, 0x18EE, 0x3C80, 0x6F4, 0x571C, 0xED90, 0xAF49, 0xAF93, 0x2C52, 0x800C, 0x5A65, 0xF5A6, 0x8632, 0x4145, 0xE694, 0x79E7, 0xC6D1, 0x2450, 0xEBD2, 0x9CA7, 0xD5F4, 0x67FB, 0x3FFD, 0xDF9, 0xBEBB, 0xEBC7, 0xE8BE, 0xECDE, 0x8107, 0x2CA4, 0xFB0D, 0x313C, 0x6BC4, 0x9471, 0x4563, 0x8C0D, 0x5DDB, 0xE587, 0xC5B8, 0xEF02, 0xFCEA, 0xD110, 0xA9A0, 0xBC76, 0x7C60, 0x2464, 0x7875, 0x78C0, 0x2CD9, 0xF2A7, 0xB67B, 0x634C, 0x2AAC, 0xE5BE, 0x8B0E, 0xB5AF, 0xEC15, 0x5A9B, 0x3435, 0xF453, 0x926, 0x566B, 0xE21, 0xE9CF, 0x63BD, 0xC8AA, 0x56EE, 0xEE79, 0x8471, 0xC1EE, 0x4331, 0xC181, 0x442C, 0xB4FD, 0x4E6F, 0x5601, 0xA3AA, 0xE5B1, 0xCC70, 0xEF02, 0xFD18, 0x9275, 0x396A, 0x8B57, 0xCD8E, 0x6C87, 0x3053, 0x309E, 0x2CAF, 0x8659, 0x4FCE, 0xF390, 0x314, 0xBE25, 0x6376, 0x13E, 0x3D44, 0xA2E9, 0x734C, 0x8F3E, 0x4F1F, 0x5F77, 0xC969, 0xF5F, 0x412A, 0xDAC1, 0xEC38, 0xEFE3, 0x8764, 0x575B, 0x8B3D, 0x519E, 0x1C56, 0xD533, 0x5766, 0x1FE0, 0xE99F, 0xE5DC, 0xD34F, 0xEF02, 0xFD47, 0x53C6, 0xC91D, 0x5A21, 0x1E93, 0xB493, 0xE846, 0xE890, 0x2C83, 0x1966, 0xE8DF, 0x83AE, 0xDB3D, 0x964F, 0x3BA0, 0x4C3E, 0x8E48, 0xEB23, 0xB264, 0x2AAF, 0x9542, 0x686E, 0x844C, 0x34E9, 0x1EA5, 0xECAC, 0x81A5};
 tidal_harmonic station_dover_england_2023_data = {
+        .name = station_dover_england_2023_name,
         .base_year = 2023,
         .n_years = 5,
         .lat = 51.1144,
@@ -101,22 +128,29 @@ tidal_harmonic station_dover_england_2023_data = {
         .phases = station_dover_england_2023_phase,
         .n_constituents = 40,
         .mean_error = 0.0003952010435799831,
-
+        .almanac = NULL,
+#ifdef TIDE_DEBUG
+        .test_times = station_dover_england_2023_test_times,
+        .test_tides = station_dover_england_2023_test_tides,
+        .n_tests = 480,
+#endif
 };                                                    
 
 
+
+
 #ifdef TIDE_DEBUG
-time_t station_dover_england_2023_test_times [] = {1686032794, 1686781164, 1680443479, 1689918503, 1695469250, 1693847915, 1673146729, 1691242082, 1679259621, 1677224476, 1695643094, 1701916150, 1692815790, 1699484296, 1699214847, 1684737997, 1678996421, 1686321206, 1694184589, 1698328237, 1675930689, 1701850604, 1683977558, 1698039131, 1681586299, 1700716672, 1695552839, 1699434029, 1696171717, 1696573681, 1691636975, 1694988286, 1679310129, 1677342325, 1688536468, 1685805014, 1673667377, 1701529089, 1676767028, 1692159578, 1678177256, 1692432073, 1684256003, 1673844190, 1687966409, 1675127201, 1696905798, 1676547921, 1682252526, 1697325635, 1674420279, 1693447861, 1689363147, 1688308902, 1674987110, 1673786208, 1695282393, 1693489587, 1673221406, 1682346553, 1680319613, 1698400198, 1682832353, 1704044257, 1692168569, 1692664720, 1677411979, 1688072356, 1698759642, 1690432830, 1696773165, 1698069370, 1676476631, 1703777906, 1692263686, 1691469910, 1701777925, 1688266800, 1694596626, 1680135954, 1674480460, 1703880185, 1678145271, 1697769884, 1694509927, 1682272701, 1696412825, 1699660537, 1677926944, 1701516518, 1678912094, 1687202841, 1677467654, 1691921967, 1699816057, 1693398423, 1716970257, 1729624615, 1721149661, 1722046373, 1733226758, 1707019753, 1707458839, 1731414503, 1709808346, 1705202007, 1722903930, 1711609474, 1722205584, 1734574565, 1710315306, 1733736118, 1717088846, 1720351391, 1721499164, 1720606843, 1707391767, 1705364678, 1718224810, 1725400239, 1731376415, 1724925323, 1706971965, 1730281331, 1735093850, 1720191652, 1710880291, 1717378065, 1731832021, 1734164192, 1716268461, 1732741123, 1718142876, 1726031218, 1725572335, 1707947161, 1724681646, 1728280898, 1719711968, 1722154834, 1718833110, 1714113014, 1707709674, 1714867456, 1712952166, 1704510365, 1713121356, 1723895294, 1714644488, 1714617938, 1725220087, 1705550074, 1710486267, 1729366373, 1729840220, 1709018311, 1726453196, 1713982459, 1719858984, 1716768183, 1712670299, 1709225055, 1710390105, 1706676723, 1719775837, 1707142383, 1713603116, 1732159702, 1720409616, 1708016683, 1733292031, 1732281577, 1729929409, 1718901211, 1704823598, 1731149310, 1731399423, 1709516040, 1724264260, 1724228089, 1716920450, 1704160717, 1725686408, 1715760325, 1729720332, 1712247033, 1718742903, 1718744059, 1735675419, 1734683566, 1724434170, 1730641021, 1743797389, 1759219814, 1744933443, 1758992633, 1762293578, 1749051199, 1737696775, 1744334222, 1739428732, 1749109492, 1762178622, 1759923428, 1752298324, 1743253170, 1750773293, 1737650229, 1752477279, 1758365377, 1761119472, 1738031419, 1742040922, 1737267704, 1743097650, 1747144686, 1744623493, 1743603763, 1736682146, 1748140690, 1750304025, 1743567194, 1761276475, 1756590612, 1756399181, 1736252752, 1764150742, 1750704109, 1757519727, 1762223658, 1761443536, 1744375684, 1748065712, 1737253915, 1765834787, 1741772869, 1758155190, 1762619999, 1738551717, 1765548545, 1738413200, 1738530312, 1749045961, 1764578850, 1748692213, 1765277057, 1755416321, 1756467102, 1748413845, 1744886015, 1755533842, 1757633951, 1741122824, 1746108611, 1743056570, 1752078377, 1756106558, 1761255224, 1744935421, 1749867529, 1759191237, 1755062337, 1748043782, 1762959992, 1765338624, 1742582463, 1751285445, 1738471946, 1765388656, 1760074138, 1754760995, 1737011593, 1760659962, 1747810828, 1742240655, 1747381566, 1752547022, 1736389737, 1737772796, 1742577047, 1767127538, 1750998334, 1764290599, 1736444857, 1736861020, 1743644046, 1753947297, 1766074618, 1792173210, 1795718691, 1770358202, 1770174400, 1773650271, 1789939920, 1770472580, 1781606600, 1781210106, 1785270905, 1767788584, 1773880345, 1782043439, 1785003905, 1796169844, 1770980433, 1769145906, 1770476314, 1767471803, 1768472345, 1794599932, 1773346028, 1781187601, 1773124376, 1772705336, 1773864038, 1778863536, 1782555102, 1773388966, 1771676851, 1796364331, 1798195729, 1775013910, 1792973487, 1794002133, 1784407685, 1780866699, 1797011577, 1788742685, 1777280909, 1768377084, 1791457635, 1786148918, 1767552320, 1785412954, 1772396496, 1786102948, 1787144538, 1773694717, 1774691744, 1790164762, 1779989701, 1790245757, 1771495172, 1784065108, 1798313808, 1795066342, 1777810899, 1768666789, 1779648120, 1770587509, 1797537338, 1787718994, 1768300315, 1771107042, 1768598575, 1794550482, 1795492369, 1794714491, 1772853057, 1783644216, 1769819564, 1791643962, 1773130427, 1780190057, 1793433507, 1777372587, 1794414135, 1768505346, 1772765846, 1794281875, 1777830269, 1797527769, 1777587581, 1783972667, 1794092028, 1771165424, 1778683543, 1789758791, 1776823085, 1768306729, 1772355496, 1792109744, 1781877961, 1773043357, 1784508097, 1812581879, 1821940206, 1805980557, 1818698075, 1802351227, 1821805125, 1816132402, 1805499827, 1812736845, 1807764923, 1808843429, 1820997358, 1818127491, 1800883065, 1824801465, 1828564545, 1816677761, 1821181650, 1798833739, 1803891217, 1803302892, 1822320414, 1809557263, 1802525642, 1813386179, 1828653943, 1824199569, 1828336866, 1808756758, 1806989316, 1829639261, 1819452550, 1802714067, 1818951780, 1805259575, 1806934231, 1828983625, 1809547838, 1805924375, 1800195350, 1806347012, 1809557200, 1811672959, 1822181720, 1827234184, 1815254736, 1799964621, 1822897360, 1819197547, 1818101822, 1815166514, 1813153940, 1811963136, 1807530629, 1806606667, 1805483486, 1819870780, 1800803927, 1808846371, 1798800545, 1801004793, 1816090274, 1800041142, 1823497228, 1818591092, 1829920479, 1825895029, 1829048505, 1798893844, 1827350404, 1809681411, 1806919757, 1823860214, 1812064667, 1818763042, 1818657068, 1801910282, 1801829309, 1828477619, 1816499596, 1811804256, 1822469827, 1821551237, 1827853521, 1825731138, 1815189687, 1819288765, 1808665669, 1816516141, 1807012854, 1824826478, 1829856696, 1804681139, 1821990140, 1825418747, 1823499518};
-float station_dover_england_2023_test_tides [] = {1.2071629722035697, 5.2912959049496555, 2.810237769331823, 2.5653234493649526, 2.322791638302342, 4.201783268646837, 3.9924999453948535, 6.926073807884003, 6.12743409533464, 1.12863839640456, 2.782421770338321, 3.1393081550773805, 3.7024574913632664, 4.275103562465586, 3.6804058868640293, 1.2930227552743985, 4.624171735016904, 6.088542818766928, 3.984793097335874, 2.3058910144541858, 1.127679605453605, 4.073531686706955, 2.018784972554755, 5.281895162058824, 5.540187370425503, 4.672584382182323, 2.6562775053266936, 4.978654168564223, 5.122787920519648, 3.9626822404013184, 3.9957827291340546, 3.529108796772079, 6.290424009552841, 5.571093774158925, 1.4603871261698822, 2.5129087571735713, 5.896342167416466, 5.718995121951806, 4.676379934014433, 2.1774156153359088, 2.7055868731877473, 1.2778284693829087, 1.7654199001836384, 5.681511082962293, 3.507681993603177, 2.2443916292040322, 2.4620354439137473, 2.8951544766048767, 6.311719167185702, 6.400574716515674, 2.6296410221050337, 4.069127664620925, 5.2944680957534445, 2.638054931795217, 2.0925276062175597, 2.4037596285073173, 2.076732312549775, 5.01031911551165, 6.159771974675601, 6.003928197605225, 2.6031825956363894, 6.6440383126329285, 4.249429187158102, 3.4017882728220825, 1.4582528744185166, 5.311485338558985, 2.040089046549149, 5.2387488760500815, 6.337921813399627, 5.3983981248010755, 2.9340825436203604, 2.8536450182704387, 4.205169413026339, 3.4952426034609934, 3.694751750989887, 5.90635600034857, 2.455458756743972, 2.0045306002542875, 5.847724182590952, 2.5727745888346605, 6.372613804853854, 1.4819846717786005, 6.245252423844457, 5.8540332281939955, 5.815686127457234, 2.2122275958685456, 1.4095672920486841, 4.75852264304993, 5.275848037652918, 3.7459254632264227, 3.314441116000153, 1.3859323513496455, 5.969842578103393, 5.38438763708246, 2.2098922624614925, 5.451931755059744, 2.190780555809319, 2.4747730742087444, 4.653551512827127, 6.188797912522463, 6.272402593080556, 5.328989761684648, 1.258439597489692, 2.5460481446398755, 4.826133786538856, 5.19684433832064, 6.246534760811462, 1.1163685404249368, 1.6857018683529856, 6.162975941668614, 0.4502585712289947, 2.8382479857705523, 5.583734748119905, 6.122866947814881, 1.6393165938596703, 2.2891065165742233, 5.480724690899376, 5.118276485828598, 2.138977710129972, 4.95880955936834, 1.9610751730108136, 4.25370626851392, 4.824391153026854, 6.182942365984752, 3.0047505693462018, 2.8372222626236994, 4.75857248840731, 1.672933681465632, 2.290143685095307, 5.574266626733327, 1.498357104492375, 5.713634929637678, 1.6280296660471525, 4.8494662622363185, 2.632115397576207, 0.8980798990333594, 5.388805985740068, 2.4267474441533685, 2.220806115772274, 2.981440675571039, 5.834650280377723, 1.2063031582814754, 4.204055796991424, 3.2290390859417077, 1.0628379491846807, 3.6761190544221036, 3.121827472444459, 4.439743816198916, 2.740211549174294, 4.1734328068655735, 3.4821538985151537, 6.426901565843064, 2.2838537094642075, 0.5269678821558913, 4.441193617338411, 1.0781737592415448, 2.401687952843115, 1.1253803606182589, 5.995478669720178, 5.8613116876756255, 5.350758968909114, 4.322230072961604, 4.765959772023038, 4.5690460376565, 5.446022060011493, 2.361041594602474, 5.618744193882539, 5.76517554683882, 4.0661951377571475, 5.340140388350687, 2.0332616012783293, 4.084754525609771, 4.766061161997153, 1.5891531472625462, 2.4573402009166823, 2.1672492448261935, 5.867457174404846, 3.797891587049493, 1.0312548781974953, 1.184371744956671, 3.2157332282376734, 5.8243739406856205, 3.0832632667656967, 3.3841377478113164, 2.0159767428155977, 3.122651529793152, 5.693418718780131, 5.671750794667702, 2.120311186324104, 1.5704763026762207, 3.410666901284732, 5.648114484367399, 2.638236112576198, 3.2331067893589207, 4.679334782701096, 4.077314644637414, 6.732287216753084, 4.068885315837547, 5.034835324834161, 4.1198558005265244, 0.9451584223497773, 5.0997488898199395, 2.2015832675282603, 7.086055424461567, 1.7460646649934375, 5.585000907514248, 3.178910518268105, 4.849099236439825, 1.4660072874735126, 6.293508357585614, 2.023092561267753, 2.940581664904244, 6.372689346341902, 3.2329653230001796, 1.571528624226407, 4.773672288608112, 4.016133562965889, 6.4921244199537504, 5.296916680730897, 1.532592089138252, 5.5337153069457985, 4.691424627975053, 3.992344991587856, 2.0034402248526426, 4.705300654644987, 1.8332841681038115, 1.9660680101027357, 3.7390953915378193, 4.249903667382399, 2.228483812816655, 6.011364724584739, 4.957140567727853, 3.694895978296748, 6.309109982124766, 5.147642050413914, 5.988167920259048, 3.176564555168963, 3.3039889196999397, 6.452571564481542, 3.4779759424442904, 6.619092426052877, 0.9667775828464727, 2.7596917606423204, 5.4017308742868755, 4.172457043624112, 2.2111516970438907, 4.135993661885589, 3.1073860225842513, 0.7675613884007656, 3.104888308205097, 4.407656785154349, 4.688518586964423, 0.9593663564081456, 6.355467764503758, 2.71399932246788, 1.741837250181875, 1.0753419345328563, 3.5194713449579, 5.48613627566412, 5.472847811855397, 3.140645749486718, 3.4693371118485876, 3.2884141290364823, 5.021151712365008, 5.870223614058487, 3.4969730029039856, 4.009897293413522, 3.9598601469474612, 4.577833150684825, 2.3127776652677947, 1.2875330819569895, 1.1758266630610736, 3.1806718183201292, 4.805770550736663, 1.100117720297352, 1.2769823285751785, 6.014215147161013, 2.702313937128147, 2.544300683496361, 4.637473815837728, 5.25292538532378, 2.808310281152843, 3.381693094052877, 5.319793597347218, 5.425848273981065, 6.6272942202368315, 2.8567878228520156, 1.7244271108770013, 3.486778688005067, 0.9927175495677844, 2.8201310702008415, 4.96582325796351, 5.583716531926433, 3.764562595315404, 6.0400797191854405, 6.178923379028104, 5.652651429517548, 4.283854857895408, 5.484480983502846, 5.899205867959107, 1.9716299251914244, 4.400456338310702, 1.9853575434264477, 4.140096180021572, 3.5383668077780865, 6.1474828522475775, 3.2401653237202774, 5.014004803840055, 1.5627882725563453, 3.943682316276866, 1.8119483429511993, 3.4360551020958385, 4.105225567103692, 2.688990781343373, 1.1661332884320421, 5.574088703563926, 4.36050742456221, 6.140601361678841, 5.484389184737134, 6.3839540982447325, 2.2360316207737387, 5.741768769749593, 6.167627465046579, 0.8836750275572923, 2.1633966411609795, 1.9262250047870633, 2.265934920276747, 5.542475199628545, 5.3261612542115095, 5.613628241335772, 1.8887662721857768, 0.9887703206599951, 6.293697278696792, 5.1482490862410195, 1.9569883371571226, 4.278592511104035, 5.817251254089262, 4.401677573371916, 4.141763955362492, 2.0362956419147222, 5.82684603831038, 3.7871395813179274, 5.519752684863901, 0.9888200430890753, 5.255777194719073, 6.243808641544952, 1.8140287401875073, 5.467720534602563, 1.758128766580195, 3.7998979564264053, 1.6909637859536202, 3.5051626254502373, 5.629275272659362, 5.743351345775838, 2.0885019526569084, 1.729999751680887, 5.198883762618633, 5.5992603413125375, 1.7257018182436223, 4.035953714917265, 3.133017661454474, 2.255653062270119, 4.697332825139238, 1.8198777070449754, 5.469859110986064, 2.910384813666898, 4.758238141511468, 5.33104954416735, 2.8775592796949008, 1.6081506798990783, 5.318857064172495, 6.348439220937582, 4.157045720526171, 6.181256577529562, 3.0093966187185632, 1.7671175823340046, 3.521443862537143, 6.473042641614265, 2.5167125181212295, 5.901529736166559, 5.3498331544187785, 6.476205794842088, 1.7771025006631325, 3.9194702723478967, 1.4125012783960347, 5.374088013428509, 6.609079627477401, 1.7814543974905677, 6.270279746097942, 5.360176894020907, 6.057893435408784, 4.593727997422948, 5.4895428255863035, 5.297914713669744, 5.066891935954551, 4.48633809107595, 2.377963821941982, 6.893135539632885, 6.202382390310095, 5.604392115727974, 2.9332461285989453, 6.57530855411116, 4.779536691959331, 3.3279537282796725, 6.3813098991726935, 1.969007638860971, 6.3075820779215235, 5.215987196163782, 1.3955539520220583, 5.759251022987202, 1.912496263470433, 5.492731797673534, 4.831744229110769, 0.9906316375536469, 5.713936009247339, 3.5136204410075313, 5.269148558879354, 4.818884748534836, 5.227923194912241, 3.360320443022733, 1.3835708837082623, 4.131329462419033, 2.6569905053130265, 2.871333693893641, 3.534390014769005, 6.31304337603531, 3.09546853191284, 3.707560102111206, 3.717849425769073, 1.919684086061928, 1.7640200029335495, 2.7773456341455334, 3.0188393470775683, 5.281316168509156, 1.513508885603439, 2.6633634286019716, 4.445530490279976, 3.3327748142340434, 5.039825763022954, 4.884462869838668, 0.6212617163345241, 4.695016387680157, 4.549631991079082, 2.3169143321801062, 2.543368321887138, 5.8918402865601545, 3.5104659915429526, 2.69993878473136, 6.406889014096572, 2.8115645005208023, 3.170223444468115, 6.451332558518724, 2.0593930554313564, 5.8085847653240466, 4.198730082886259, 6.115185780377125, 6.620439942911699, 5.749979161542332, 6.267827569546216, 1.3415109605248752, 6.045495119976136, 5.44985280976596, 5.052001681989494, 2.798237230565798, 3.708002323832921, 3.440840307449241, 2.8381111619845907, 4.192397695704414, 3.08503447054262, 6.3121337155658495, 3.371851778268414, 5.535124995124678, 2.9771358963044015, 5.896095691536754, 1.6258239677175899, 5.8842856063992, 6.51089623074192, 5.805649940672634, 4.015043234167467, 3.7974547371852654};
+time_t station_millport_scotland_2023_test_times [] = {1703130101, 1675810691, 1698131509, 1698910983, 1695818643, 1694278575, 1688624771, 1693516532, 1687081931, 1677012967, 1700783665, 1693761388, 1700511764, 1700246920, 1698913864, 1681475375, 1699945444, 1689876378, 1675716902, 1688270088, 1679102518, 1688646963, 1677869838, 1679016582, 1695695110, 1698746064, 1698434529, 1702965041, 1701259534, 1692231362, 1702769747, 1675290674, 1700189756, 1698517493, 1676770451, 1678803973, 1703016277, 1694026007, 1686132467, 1685377400, 1673527012, 1680751273, 1691377594, 1680906700, 1691548857, 1692331112, 1682819965, 1695414640, 1677966300, 1683618332, 1683034458, 1672692614, 1693469364, 1675272132, 1684065842, 1689592036, 1673726481, 1684042828, 1673220302, 1693404211, 1693829878, 1684574334, 1683223570, 1693609307, 1673118908, 1678410218, 1691864872, 1693543002, 1686528497, 1687530663, 1677601413, 1674053848, 1680886834, 1693272671, 1673143317, 1695270799, 1673571363, 1702038011, 1678471527, 1681050330, 1691966027, 1687544242, 1696389431, 1678568524, 1700610547, 1698114692, 1676199415, 1698744433, 1702018678, 1698279092, 1686349964, 1697260999, 1676777800, 1694134750, 1687566806, 1683170829, 1723044494, 1724349528, 1711478641, 1710211136, 1730378744, 1721410783, 1724706711, 1716401763, 1732353618, 1710019515, 1707063833, 1726895195, 1704236520, 1704638459, 1729283124, 1730426129, 1724334134, 1719496237, 1731861392, 1723729820, 1714210137, 1733786154, 1726125670, 1720715448, 1716256003, 1735105445, 1731365400, 1712437935, 1722096056, 1734807275, 1734646594, 1729249055, 1713786952, 1705625873, 1714473418, 1705812438, 1735419421, 1710909364, 1714421702, 1719336620, 1707510234, 1727129749, 1728957555, 1716811887, 1726957812, 1729990918, 1719287989, 1709294113, 1720056430, 1725188051, 1728807755, 1708140433, 1722192639, 1709852178, 1735126024, 1725181347, 1727736655, 1721948285, 1724049121, 1706627607, 1708299681, 1706246238, 1724170074, 1708818340, 1713322140, 1711127844, 1734104937, 1719159572, 1713873258, 1707763455, 1720875412, 1735406358, 1716725612, 1710212029, 1735585465, 1711934027, 1719716243, 1730519089, 1712812252, 1724963833, 1731882517, 1720616459, 1718615813, 1712395142, 1722043452, 1722057409, 1722450914, 1709447185, 1721189858, 1712777329, 1730255719, 1710449205, 1717853668, 1733436628, 1711492218, 1725549877, 1738538978, 1743370862, 1748586444, 1736869685, 1745694399, 1757227993, 1754857793, 1750870322, 1739042042, 1759978179, 1741236897, 1747457780, 1760689688, 1745469775, 1754855629, 1745420279, 1747813406, 1735818449, 1764517378, 1756720113, 1741619663, 1744035913, 1759768486, 1741597977, 1753827276, 1739660313, 1739030434, 1741219833, 1736182166, 1758396794, 1745895356, 1764351371, 1759829180, 1750171319, 1750161859, 1737673467, 1744936974, 1737190957, 1757821814, 1743688921, 1759599771, 1750865440, 1737499238, 1747060081, 1764324198, 1743898477, 1736758032, 1750072406, 1762875885, 1760931780, 1757644085, 1756816071, 1765460576, 1750599592, 1748727512, 1765015759, 1745570691, 1763876330, 1757083794, 1750304868, 1747667757, 1755750732, 1752914275, 1758086357, 1750067766, 1745716279, 1741988375, 1759329598, 1760028574, 1750016313, 1742714347, 1758387366, 1747122419, 1746940515, 1764551300, 1746721868, 1759071925, 1752537447, 1739155966, 1743154281, 1736607407, 1754065504, 1747935007, 1763040718, 1754047796, 1748737765, 1751689250, 1741627312, 1760374577, 1753792937, 1757735044, 1739205438, 1740116267, 1736188577, 1751396582, 1736409259, 1769187836, 1798490745, 1797122235, 1790667894, 1771613225, 1782261643, 1783047240, 1772910063, 1786647832, 1779235258, 1798243733, 1774716678, 1776573964, 1778498865, 1789711626, 1788162098, 1767763229, 1775444567, 1784880914, 1790173834, 1774368819, 1783136669, 1771222623, 1767756429, 1773064062, 1789521446, 1784016802, 1767585343, 1798643417, 1779600576, 1774996324, 1789625854, 1769902222, 1782230438, 1785526090, 1778778936, 1789039527, 1767915422, 1775882455, 1798091550, 1778583281, 1791546591, 1793874810, 1770312482, 1794701032, 1771481951, 1793503353, 1788315027, 1773829794, 1795092391, 1768996395, 1785099663, 1794623542, 1774736497, 1770087921, 1779873224, 1778381501, 1798705857, 1772855974, 1792025256, 1775923944, 1772287604, 1798045012, 1785347960, 1794600906, 1793789497, 1777621325, 1773852599, 1788557961, 1772783857, 1769024068, 1768039455, 1788638081, 1780629062, 1795495161, 1786841424, 1780586099, 1794616654, 1781461979, 1771943215, 1790487154, 1782124025, 1781516015, 1784480304, 1788117379, 1782170411, 1779398163, 1790244497, 1773539066, 1777984652, 1784507371, 1773226571, 1779869701, 1784538346, 1794604922, 1782439518, 1803062893, 1810964082, 1823037018, 1827313363, 1814643066, 1802374708, 1825196380, 1806534461, 1802096124, 1827106171, 1818580525, 1812037998, 1823793261, 1824858134, 1819513260, 1824899245, 1809344749, 1822033331, 1813694420, 1803353691, 1814682999, 1829110331, 1828869706, 1802661559, 1808386645, 1806307038, 1816477134, 1808345752, 1825878508, 1802748160, 1800439202, 1823186232, 1810563305, 1810923294, 1822350745, 1827730504, 1802057209, 1828943197, 1811974847, 1814971341, 1804522158, 1820266955, 1804136055, 1818827769, 1819596301, 1811045498, 1827394710, 1806118389, 1818058945, 1816372353, 1800741814, 1798965741, 1812434512, 1818627211, 1817495819, 1806328830, 1820182239, 1799083350, 1807785030, 1817699931, 1818186088, 1802996419, 1828167357, 1803721421, 1818803725, 1823699698, 1807474050, 1801007898, 1817020637, 1816376783, 1827357792, 1820845083, 1817793324, 1807166687, 1801999197, 1811127625, 1816284676, 1804892895, 1806430050, 1809879323, 1803920443, 1814266811, 1821669966, 1813174652, 1813577161, 1811492627, 1808646153, 1828179188, 1812193735, 1811207015, 1812805973, 1816589776, 1800795968, 1827378607, 1805798837, 1812885379};
+float station_millport_scotland_2023_test_tides [] = {2.004434999616974, 2.100215005322211, 2.810096822432964, 0.9478130238425428, 2.4072485132844164, 2.3032122885525026, 0.6059262255550154, 2.2847393186239153, 2.2825671041280136, 1.1930118951796838, 2.0664147400875716, 2.0670342056752378, 2.0899739794574654, 1.209369908905086, 0.8831056146200466, 0.8370418319235806, 1.0756373216736235, 1.1944740698242484, 1.548989000280686, 0.7746312852806472, 1.3144327254508812, 2.554361429420993, 1.912651419389199, 1.243191188067764, 0.7866374628834614, 1.9345749092412317, 2.127723275210263, 2.949193945716096, 3.303755656246208, 3.3131127495811974, 2.039621595003159, 2.809971109363961, 3.2670795560212547, 1.0792265342642828, 2.306997699844219, 2.5890662712664216, 2.1453479888521056, 2.3534322985590634, 1.3477206016130225, 1.7712427625129559, 2.4949719909809547, 1.9130286523430349, 3.368481307343264, 2.1326509263420936, 2.2272801910127527, 2.002969522651527, 1.2940163380700593, 1.4956297026845664, 2.5949830966113425, 0.43516269033033333, 1.4260736838257018, 3.144542291551659, 1.5304393806612426, 1.73342814267074, 0.8225567246489603, 2.776312733335688, 1.8116724550305683, 2.759998847780959, 2.463071110328649, 2.2482000866837546, 1.9622593978697163, 1.9984220690383045, 0.8398173062618677, 2.728074957461241, 1.0235306558498414, 2.8678371251289665, 2.1840106797990626, 0.8710937414158624, 0.9760246475446102, 2.5751676993385035, 2.485072841016971, 1.1641777005750564, 0.9726916421979508, 1.6639858176793518, 2.965321857884543, 3.0286797169872157, 2.0979840450318163, 1.8345774166431688, 0.9730909453699963, 3.3400461497114096, 3.000299001018187, 1.9894166948306085, 3.4682458711540916, 0.6748384232538767, 0.9073971511312892, 1.1756246686820697, 1.1726828930250905, 1.6893695318251143, 2.5389764300396416, 2.1486077858452215, 0.9660523443742609, 0.6146033292703326, 1.0447549772059517, 1.3235120210613707, 2.15639605107322, 1.1086198037973032, 2.7789031033710416, 1.0925361991015137, 0.5135276055344042, 3.0756924106708317, 3.077908382064009, 1.2768482660112441, 1.2341947076817668, 0.9895370484403301, 1.8681660644334486, 2.3591759988990177, 2.4411320705094695, 1.7593161385199865, 1.1377335957592527, 1.3335542954970028, 1.7369885679951549, 2.443497617730312, 3.2268681489150217, 2.1703442116260088, 1.3419346928494036, 1.269423836566266, 1.2380290864574048, 0.9659569864907067, 2.393159141781966, 2.744212914590565, 1.8465917000173457, 2.4227528745371387, 2.1865071592187255, 2.689864891293009, 3.0151366575490153, 2.2040524736034244, 1.183425526602015, 2.9521463483319494, 3.05380770477211, 0.9185769466045232, 0.8250522498421741, 1.941093296496635, 2.7542250889687225, 1.8557100723352078, 1.0605152744542132, 1.9339612732642804, 1.8256698350809415, 0.8135774732073555, 0.9902209006791751, 2.217078935207485, 1.7558901794757114, 1.2065833308242826, 2.721850508777157, 1.9210841402587655, 1.8254044111206205, 2.936352754224596, 2.7475743527267515, 2.533049195913599, 2.7846848762719425, 2.8223539602976966, 1.8376147998255048, 2.2403991115133777, 3.264353744274614, 1.6358072487362967, 0.8688379956228957, 3.4213240884728373, 1.5708949887225154, 1.0432261900498427, 1.4862316974326297, 2.7398125805807023, 1.858118002892973, 0.8144118474180728, 0.8358934230245408, 1.6872515832585, 3.144887374208294, 0.37304767173662207, 1.4251329009401503, 1.2551113876550755, 2.5810564163877743, 2.9473163388208445, 1.2528714062852355, 2.2402464428527473, 2.1020536901884537, 1.5316819475351993, 1.2651233369899926, 2.8184072875105675, 2.4954208684606676, 2.1426857989669426, 2.5970986347157754, 2.9787968281694726, 2.458774323134983, 3.2099118557239197, 2.450640323241323, 2.471187005991727, 1.6521061186832149, 0.23897274193248916, 1.293668455058191, 0.3393058486749193, 3.095998916192826, 1.2929359356577304, 2.053699745161093, 2.694786361038946, 1.6094545300357315, 1.8769336929508391, 0.7094082392763351, 1.7748099481070025, 1.5276711504908336, 1.0329372757352147, 1.5385500202804152, 0.6577033668299882, 2.5900285207534193, 2.970542077855833, 3.1775423202528685, 2.334341233291271, 2.804511420463032, 1.750167477983017, 1.1849566755031367, 0.8354040576951252, 2.46019656345056, 2.91290037648389, 2.0624440652807436, 1.4677951927923159, 0.8461749549434234, 0.9253491397621504, 0.6995934725678558, 2.8412676887022768, 1.0880849083499566, 1.7428931895709157, 1.4474345494197243, 1.3769320015101147, 3.4279582832919258, 1.9002173771001256, 2.4394200298120032, 3.082943140474687, 2.4117734872883103, 2.4686662816013096, 1.276817440766592, 1.5028610311118236, 2.5020214698520586, 0.9390549243335532, 3.227951971092664, 2.8027668760870457, 1.7375267160818808, 1.464280532361711, 1.0251818152690186, 2.1154991171900304, 1.4089931746893654, 1.1664380091888669, 2.4924903790135637, 1.3014638491609318, 3.427926110653635, 0.8670361886443559, 3.5068212608911282, 1.4521311884852826, 2.3586840074048996, 0.7615463731464677, 0.9035078700562106, 2.683998232030786, 2.858519342489262, 1.311765879953395, 1.3358388762925186, 2.8087099814440606, 2.5558406985872733, 0.7313313765893485, 2.262127528884886, 2.1156259908048924, 0.7137220360866023, 2.5411062583120274, 1.7784397341788905, 1.9290018507038005, 1.5370179687663104, 0.9890958887308785, 2.400497546034307, 0.7776021588605964, 1.1617887732912195, 0.7181692488382477, 0.8143579317318757, 0.9366413208053199, 3.056387946446949, 2.3903815864136284, 1.2506417329455963, 2.786654251624365, 1.0500269653445038, 2.697199814934232, 2.2337831027324566, 1.5671606203031656, 1.009146356656408, 2.1991316160862913, 2.077469655084351, 1.330796344569957, 3.2468433133178283, 1.9304888474805362, 3.463230407858656, 0.753895183841276, 2.8201389402137105, 2.8401216883272475, 2.2010731134253323, 2.9552645976675267, 2.758582444062296, 0.5104623715038265, 2.6437249923457404, 0.5423373748867195, 0.5978305397150513, 1.0359413006975762, 3.135181845418359, 0.879687952241164, 0.7982281074046795, 2.6430920955326416, 3.030732769867522, 1.5794610412353514, 1.1476390501169667, 1.1562352984030917, 2.44173997851803, 0.3535500757394109, 2.408753411611074, 3.1721171129772485, 2.6892731300885013, 1.3788781224068785, 3.2659793709863436, 2.9972920005962935, 1.2234818425045142, 3.2338019610912205, 2.64069694499622, 2.8994641580312495, 1.847902611527665, 2.3404404905688887, 3.113458684441994, 3.0811126086862206, 2.7672639047494814, 2.0089596466241715, 3.1629491240609298, 1.7952780211635533, 0.8360268997507884, 0.9589512143214624, 3.131348830421922, 1.2162202133940903, 2.6063949189426068, 0.7403865718389687, 1.8628309712790285, 3.239498394829766, 2.9741313049189344, 2.0019734828198277, 1.9818050296678036, 0.6908577384430676, 3.000948422157718, 3.2297438261799747, 2.9367579598941544, 1.457909540683717, 2.869657638865432, 2.729278512525954, 3.14218219439879, 2.773311630802945, 2.737435364309045, 2.991435507437042, 2.3097392969502892, 2.229903013751342, 2.8293012436917433, 2.8528877427546036, 1.9979901608160642, 1.1420637689159632, 0.6860020113443982, 0.8531780807228757, 0.7975865851184439, 2.3498130358826868, 1.4932284600204337, 0.4363448194831619, 1.0511191228108565, 0.5605935834540843, 0.5005474452858429, 1.1300411399792054, 2.463975909970498, 3.18482936140838, 0.5514282745563419, 3.2078099078781195, 2.834385613894579, 2.5628643997368328, 1.1488674741655192, 2.5312612587161074, 0.35579530823254185, 0.8244605219719555, 2.4173220214717253, 2.938757886544285, 0.6405331684775243, 1.0462802450788966, 0.8118761237739834, 2.8771889667077257, 1.5038813011616419, 2.627038781179931, 1.873906012281703, 1.1151083610201014, 2.884366930059878, 0.6663821664083265, 1.0831028736373678, 1.1401527011408135, 1.4126768560032714, 0.7526678704845685, 1.4227941972373868, 3.2965761910126212, 1.7812673283824347, 0.8381606536771751, 1.8182646525960993, 1.720203684875185, 3.325369196987094, 1.1064857374212678, 1.6961773459884117, 0.6336359649920934, 1.0919721097612713, 3.2496555412768986, 1.0204330614463055, 3.3823672214682388, 2.438082455595441, 2.693513013913098, 0.8735085158878966, 2.7935833778595724, 0.8211363428418713, 2.2002836312212715, 3.0952091874254397, 2.3943479166017623, 1.9562334035579658, 1.5113430512031691, 2.3642845892315454, 2.227463288878823, 2.885013655331757, 1.9256724410217574, 3.1364536603638156, 2.0105223085444677, 0.7779412043603178, 0.7122996245729107, 3.585691980660025, 1.1915765511369776, 2.416373344381702, 0.8382533998543107, 2.9872608159239156, 3.184886577988749, 1.3012612392696525, 0.7223805953459372, 1.6548557945086686, 1.3065796892156096, 0.5751389932737672, 2.1537247796758106, 2.5820874231485713, 3.2118966865135175, 2.6837414366038295, 0.8565630251320768, 2.0548145386944587, 2.954484139081749, 1.1861154581685436, 2.3169221609491983, 0.40326354237100775, 2.0750354319253472, 0.8665969957467702, 1.5028757233203014, 1.4029498278889057, 3.407930094705276, 2.496323775811961, 2.6821635336556144, 2.357984417485033, 0.80546394889606, 2.3249241842298654, 2.1320557494726446, 0.7670194838986968, 1.6788416090250184, 2.454349568381388, 0.8621394469620908, 3.378225784521218, 1.7250548801354273, 2.700876519310926, 0.5776434945810583, 2.9940319624390046, 3.1671944449329836, 0.8035188786854681, 1.7371675967666884, 2.559851278293226, 2.509558257338482, 2.6194635884973, 1.3932296666329447, 2.904251655037097, 2.089225007944344, 2.2808031223143432, 1.6715228070627925, 0.8884073646903493, 1.4500410837307391, 2.8544263147814806, 2.8069971493892445, 0.7336029395870409, 1.3870616207227753, 3.7291144462538743, 0.7719221668968198, 2.8512860610323196, 1.0947118976279666};
 #endif
 
-
 /* Mean error for Millport, Scotland in 2023-2028 is approximately 0.00036m */
 char station_millport_scotland_2023_name [] = "Millport, Scotland";                    
 float station_millport_scotland_2023_speed [] = {7.2921158357870547e-05, 1.4584231720055478e-04, 1.4315810553074262e-04, 1.4051890250864362e-04, 2.1077835376296543e-04, 2.8103780501728725e-04, 4.2155670752593087e-04, 1.3787969948654463e-04, 1.3524049646444563e-04, 6.7597744150773076e-05, 7.2522945974990243e-05, 6.4958541128674080e-05, 7.2722052166430395e-05, 1.4544410433286079e-04, 2.9088820866572158e-04, 1.4524500735288060e-04, 1.4280490131076179e-04, 1.3559370068442646e-04, 1.3823290370652545e-04, 2.1344006135132787e-04, 2.0811664665941671e-04, 2.7839860199518825e-04, 2.8596300684150439e-04, 1.5036930615707798e-04, 5.3234146919111522e-06, 1.9910619144015089e-07, 3.9821286769398287e-07, 4.1891750450383182e-04, 4.2648190935014801e-04, 1.3066849886020929e-04, 2.8636121970919838e-04, 1.3295449766232746e-04, 2.2859988021181762e-06, 1.4808330735495979e-04, 1.3519548781673247e-04, 1.4012068964094966e-04, 2.1836526269073135e-04, 1.5076751902477192e-04, 2.7575939897308925e-04, 7.0259451254321812e-05};                
 uint16_t station_millport_scotland_2023_amp [] = {0x28D, 0x259, 0x16A, 0x170E, 0x10B, 0x1C2, 0x78, 0x45B, 0x7A, 0x266, 0xD0, 0xCD, 0x3E, 0x63F, 0x47, 0x68, 0xB1, 0xBD, 0x123, 0x6B, 0x48, 0xB7, 0x1C2, 0x7F, 0x93, 0x229, 0x6B, 0x38, 0x86, 0x2E, 0xAD, 0x3A, 0x39, 0x60, 0x7E, 0x3C, 0x66, 0x55, 0x3B, 0x27, 0x293, 0x26B, 0xCE, 0x16F3, 0x10A, 0x1BE, 0x77, 0x456, 0x7A, 0x26F, 0xD0, 0xD0, 0x3E, 0x63F, 0x47, 0x68, 0xB0, 0xBC, 0x122, 0x6C, 0x48, 0xB6, 0x1BF, 0x7E, 0x98, 0x229, 0x6B, 0x37, 0x84, 0x2D, 0xB1, 0x39, 0x38, 0x5F, 0x49, 0x3D, 0x67, 0x57, 0x3A, 0x25, 0x294, 0x26C, 0x15D, 0x16F1, 0x10A, 0x1BE, 0x77, 0x456, 0x7A, 0x270, 0xD0, 0xD0, 0x3E, 0x63F, 0x47, 0x68, 0xB0, 0xBC, 0x121, 0x6C, 0x48, 0xB6, 0x1BF, 0x7E, 0x98, 0x229, 0x6B, 0x37, 0x84, 0x2D, 0xB1, 0x39, 0x38, 0x5F, 0x7D, 0x3D, 0x67, 0x57, 0x3A, 0x25, 0x28E, 0x25D, 0x1CF, 0x1708, 0x10B, 0x1C1, 0x78, 0x45A, 0x7A, 0x268, 0xD0, 0xCD, 0x3E, 0x63F, 0x47, 0x68, 0xB0, 0xBD, 0x123, 0x6B, 0x48, 0xB7, 0x1C1, 0x7F, 0x94, 0x229, 0x6B, 0x37, 0x85, 0x2D, 0xAD, 0x3A, 0x39, 0x60, 0xA2, 0x3D, 0x66, 0x55, 0x3B, 0x26, 0x284, 0x240, 0x17C, 0x1735, 0x10E, 0x1C8, 0x7B, 0x463, 0x7B, 0x259, 0xD0, 0xC8, 0x3E, 0x63F, 0x47, 0x68, 0xB2, 0xBF, 0x125, 0x6A, 0x48, 0xBA, 0x1C5, 0x80, 0x8B, 0x229, 0x6B, 0x39, 0x87, 0x2F, 0xA6, 0x3B, 0x3B, 0x61, 0x80, 0x3B, 0x64, 0x52, 0x3C, 0x29};
 uint16_t station_millport_scotland_2023_phase [] = {0x7B7F, 0x7055, 0x33B2, 0x7468, 0x512A, 0x9053, 0x6080, 0x4955, 0x202F, 0x455E, 0x73EC, 0x3379, 0x35DD, 0xE705, 0x784F, 0xF179, 0x42C5, 0x7C16, 0x2DDF, 0xD131, 0xA4CC, 0x5971, 0x13D8, 0xDC69, 0x88F8, 0x14AA, 0x18B2, 0x3542, 0xD6FE, 0x9001, 0x9D84, 0x4773, 0xFA24, 0x94B6, 0xCB, 0x734F, 0x3AD9, 0x685A, 0x2D77, 0x3D61, 0x7D15, 0x73B3, 0xADED, 0xBC88, 0x3D5C, 0x2095, 0x38E3, 0x525F, 0xEA1F, 0x8B30, 0x7418, 0x3A35, 0x35DD, 0xE705, 0x784F, 0xF1A9, 0x42A, 0xBDE, 0xFCBD, 0x1AE8, 0x3376, 0xAA99, 0x5BF9, 0x9449, 0x4575, 0x147E, 0x185C, 0xCE8B, 0x6740, 0x6863, 0xE903, 0x989B, 0x7367, 0xD3CD, 0x80B0, 0xB94C, 0x3C6F, 0x2399, 0x3F89, 0xE172, 0x7F75, 0x78AA, 0x1C1D, 0xF35C, 0xF98, 0x8E3A, 0xDD5B, 0x40CF, 0x902E, 0xBEE8, 0x7391, 0x258B, 0x35DD, 0xE705, 0x784F, 0xF124, 0xBC4C, 0x78FE, 0xB240, 0x541A, 0x9EBD, 0xCFDE, 0x92CC, 0x5D75, 0x14D7, 0x1505, 0x196B, 0x2AA3, 0xD4E5, 0xCDD, 0x24CC, 0xBDE0, 0xF4B5, 0x1C30, 0xD85B, 0xEC7D, 0x3ECF, 0xF1BB, 0x1C6C, 0x7CDC, 0x8110, 0x7C14, 0xB167, 0x3B7F, 0xFBCB, 0x1E7F, 0xB5C3, 0x49DA, 0x5A23, 0x4B8, 0x73BB, 0x2C44, 0x35DD, 0xE705, 0x784F, 0xF151, 0x7DB1, 0x8C8, 0x8120, 0x9DD9, 0x2D67, 0x210D, 0xDAEE, 0x1553, 0xD15C, 0x14DB, 0x1914, 0xC3F5, 0x652B, 0xE544, 0x705A, 0xF0F, 0x6DFA, 0x5B46, 0x7346, 0x3277, 0x406B, 0xAD04, 0x2E83, 0x20EE, 0x827A, 0x7F07, 0x46D5, 0x838B, 0xE7E0, 0xAE9C, 0x8DED, 0x52D2, 0x2402, 0x4AAE, 0x73E6, 0x3322, 0x35DD, 0xE705, 0x784F, 0xF180, 0x3F02, 0x987B, 0x4FEB, 0xE752, 0xBC17, 0x7211, 0x22FC, 0xCD45, 0x8D7C, 0x14AF, 0x18BD, 0x5D06, 0xF547, 0xBD6E, 0xBB5A, 0x6013, 0xE73C, 0x9A5F, 0xEB8, 0x789A, 0x41D5, 0x67E7, 0x406E, 0xC4F4};
 tidal_harmonic station_millport_scotland_2023_data = {
+        .name = station_millport_scotland_2023_name,
         .base_year = 2023,
         .n_years = 5,
         .lat = 55.7496,
@@ -129,14 +163,15 @@ tidal_harmonic station_millport_scotland_2023_data = {
         .phases = station_millport_scotland_2023_phase,
         .n_constituents = 40,
         .mean_error = 0.00036224996856515314,
-
+        .almanac = NULL,
+#ifdef TIDE_DEBUG
+        .test_times = station_millport_scotland_2023_test_times,
+        .test_tides = station_millport_scotland_2023_test_tides,
+        .n_tests = 480,
+#endif
 };                                                    
 
 
-#ifdef TIDE_DEBUG
-time_t station_millport_scotland_2023_test_times [] = {1703130101, 1675810691, 1698131509, 1698910983, 1695818643, 1694278575, 1688624771, 1693516532, 1687081931, 1677012967, 1700783665, 1693761388, 1700511764, 1700246920, 1698913864, 1681475375, 1699945444, 1689876378, 1675716902, 1688270088, 1679102518, 1688646963, 1677869838, 1679016582, 1695695110, 1698746064, 1698434529, 1702965041, 1701259534, 1692231362, 1702769747, 1675290674, 1700189756, 1698517493, 1676770451, 1678803973, 1703016277, 1694026007, 1686132467, 1685377400, 1673527012, 1680751273, 1691377594, 1680906700, 1691548857, 1692331112, 1682819965, 1695414640, 1677966300, 1683618332, 1683034458, 1672692614, 1693469364, 1675272132, 1684065842, 1689592036, 1673726481, 1684042828, 1673220302, 1693404211, 1693829878, 1684574334, 1683223570, 1693609307, 1673118908, 1678410218, 1691864872, 1693543002, 1686528497, 1687530663, 1677601413, 1674053848, 1680886834, 1693272671, 1673143317, 1695270799, 1673571363, 1702038011, 1678471527, 1681050330, 1691966027, 1687544242, 1696389431, 1678568524, 1700610547, 1698114692, 1676199415, 1698744433, 1702018678, 1698279092, 1686349964, 1697260999, 1676777800, 1694134750, 1687566806, 1683170829, 1723044494, 1724349528, 1711478641, 1710211136, 1730378744, 1721410783, 1724706711, 1716401763, 1732353618, 1710019515, 1707063833, 1726895195, 1704236520, 1704638459, 1729283124, 1730426129, 1724334134, 1719496237, 1731861392, 1723729820, 1714210137, 1733786154, 1726125670, 1720715448, 1716256003, 1735105445, 1731365400, 1712437935, 1722096056, 1734807275, 1734646594, 1729249055, 1713786952, 1705625873, 1714473418, 1705812438, 1735419421, 1710909364, 1714421702, 1719336620, 1707510234, 1727129749, 1728957555, 1716811887, 1726957812, 1729990918, 1719287989, 1709294113, 1720056430, 1725188051, 1728807755, 1708140433, 1722192639, 1709852178, 1735126024, 1725181347, 1727736655, 1721948285, 1724049121, 1706627607, 1708299681, 1706246238, 1724170074, 1708818340, 1713322140, 1711127844, 1734104937, 1719159572, 1713873258, 1707763455, 1720875412, 1735406358, 1716725612, 1710212029, 1735585465, 1711934027, 1719716243, 1730519089, 1712812252, 1724963833, 1731882517, 1720616459, 1718615813, 1712395142, 1722043452, 1722057409, 1722450914, 1709447185, 1721189858, 1712777329, 1730255719, 1710449205, 1717853668, 1733436628, 1711492218, 1725549877, 1738538978, 1743370862, 1748586444, 1736869685, 1745694399, 1757227993, 1754857793, 1750870322, 1739042042, 1759978179, 1741236897, 1747457780, 1760689688, 1745469775, 1754855629, 1745420279, 1747813406, 1735818449, 1764517378, 1756720113, 1741619663, 1744035913, 1759768486, 1741597977, 1753827276, 1739660313, 1739030434, 1741219833, 1736182166, 1758396794, 1745895356, 1764351371, 1759829180, 1750171319, 1750161859, 1737673467, 1744936974, 1737190957, 1757821814, 1743688921, 1759599771, 1750865440, 1737499238, 1747060081, 1764324198, 1743898477, 1736758032, 1750072406, 1762875885, 1760931780, 1757644085, 1756816071, 1765460576, 1750599592, 1748727512, 1765015759, 1745570691, 1763876330, 1757083794, 1750304868, 1747667757, 1755750732, 1752914275, 1758086357, 1750067766, 1745716279, 1741988375, 1759329598, 1760028574, 1750016313, 1742714347, 1758387366, 1747122419, 1746940515, 1764551300, 1746721868, 1759071925, 1752537447, 1739155966, 1743154281, 1736607407, 1754065504, 1747935007, 1763040718, 1754047796, 1748737765, 1751689250, 1741627312, 1760374577, 1753792937, 1757735044, 1739205438, 1740116267, 1736188577, 1751396582, 1736409259, 1769187836, 1798490745, 1797122235, 1790667894, 1771613225, 1782261643, 1783047240, 1772910063, 1786647832, 1779235258, 1798243733, 1774716678, 1776573964, 1778498865, 1789711626, 1788162098, 1767763229, 1775444567, 1784880914, 1790173834, 1774368819, 1783136669, 1771222623, 1767756429, 1773064062, 1789521446, 1784016802, 1767585343, 1798643417, 1779600576, 1774996324, 1789625854, 1769902222, 1782230438, 1785526090, 1778778936, 1789039527, 1767915422, 1775882455, 1798091550, 1778583281, 1791546591, 1793874810, 1770312482, 1794701032, 1771481951, 1793503353, 1788315027, 1773829794, 1795092391, 1768996395, 1785099663, 1794623542, 1774736497, 1770087921, 1779873224, 1778381501, 1798705857, 1772855974, 1792025256, 1775923944, 1772287604, 1798045012, 1785347960, 1794600906, 1793789497, 1777621325, 1773852599, 1788557961, 1772783857, 1769024068, 1768039455, 1788638081, 1780629062, 1795495161, 1786841424, 1780586099, 1794616654, 1781461979, 1771943215, 1790487154, 1782124025, 1781516015, 1784480304, 1788117379, 1782170411, 1779398163, 1790244497, 1773539066, 1777984652, 1784507371, 1773226571, 1779869701, 1784538346, 1794604922, 1782439518, 1803062893, 1810964082, 1823037018, 1827313363, 1814643066, 1802374708, 1825196380, 1806534461, 1802096124, 1827106171, 1818580525, 1812037998, 1823793261, 1824858134, 1819513260, 1824899245, 1809344749, 1822033331, 1813694420, 1803353691, 1814682999, 1829110331, 1828869706, 1802661559, 1808386645, 1806307038, 1816477134, 1808345752, 1825878508, 1802748160, 1800439202, 1823186232, 1810563305, 1810923294, 1822350745, 1827730504, 1802057209, 1828943197, 1811974847, 1814971341, 1804522158, 1820266955, 1804136055, 1818827769, 1819596301, 1811045498, 1827394710, 1806118389, 1818058945, 1816372353, 1800741814, 1798965741, 1812434512, 1818627211, 1817495819, 1806328830, 1820182239, 1799083350, 1807785030, 1817699931, 1818186088, 1802996419, 1828167357, 1803721421, 1818803725, 1823699698, 1807474050, 1801007898, 1817020637, 1816376783, 1827357792, 1820845083, 1817793324, 1807166687, 1801999197, 1811127625, 1816284676, 1804892895, 1806430050, 1809879323, 1803920443, 1814266811, 1821669966, 1813174652, 1813577161, 1811492627, 1808646153, 1828179188, 1812193735, 1811207015, 1812805973, 1816589776, 1800795968, 1827378607, 1805798837, 1812885379};
-float station_millport_scotland_2023_test_tides [] = {2.004434999616974, 2.100215005322211, 2.810096822432964, 0.9478130238425428, 2.4072485132844164, 2.3032122885525026, 0.6059262255550154, 2.2847393186239153, 2.2825671041280136, 1.1930118951796838, 2.0664147400875716, 2.0670342056752378, 2.0899739794574654, 1.209369908905086, 0.8831056146200466, 0.8370418319235806, 1.0756373216736235, 1.1944740698242484, 1.548989000280686, 0.7746312852806472, 1.3144327254508812, 2.554361429420993, 1.912651419389199, 1.243191188067764, 0.7866374628834614, 1.9345749092412317, 2.127723275210263, 2.949193945716096, 3.303755656246208, 3.3131127495811974, 2.039621595003159, 2.809971109363961, 3.2670795560212547, 1.0792265342642828, 2.306997699844219, 2.5890662712664216, 2.1453479888521056, 2.3534322985590634, 1.3477206016130225, 1.7712427625129559, 2.4949719909809547, 1.9130286523430349, 3.368481307343264, 2.1326509263420936, 2.2272801910127527, 2.002969522651527, 1.2940163380700593, 1.4956297026845664, 2.5949830966113425, 0.43516269033033333, 1.4260736838257018, 3.144542291551659, 1.5304393806612426, 1.73342814267074, 0.8225567246489603, 2.776312733335688, 1.8116724550305683, 2.759998847780959, 2.463071110328649, 2.2482000866837546, 1.9622593978697163, 1.9984220690383045, 0.8398173062618677, 2.728074957461241, 1.0235306558498414, 2.8678371251289665, 2.1840106797990626, 0.8710937414158624, 0.9760246475446102, 2.5751676993385035, 2.485072841016971, 1.1641777005750564, 0.9726916421979508, 1.6639858176793518, 2.965321857884543, 3.0286797169872157, 2.0979840450318163, 1.8345774166431688, 0.9730909453699963, 3.3400461497114096, 3.000299001018187, 1.9894166948306085, 3.4682458711540916, 0.6748384232538767, 0.9073971511312892, 1.1756246686820697, 1.1726828930250905, 1.6893695318251143, 2.5389764300396416, 2.1486077858452215, 0.9660523443742609, 0.6146033292703326, 1.0447549772059517, 1.3235120210613707, 2.15639605107322, 1.1086198037973032, 2.7789031033710416, 1.0925361991015137, 0.5135276055344042, 3.0756924106708317, 3.077908382064009, 1.2768482660112441, 1.2341947076817668, 0.9895370484403301, 1.8681660644334486, 2.3591759988990177, 2.4411320705094695, 1.7593161385199865, 1.1377335957592527, 1.3335542954970028, 1.7369885679951549, 2.443497617730312, 3.2268681489150217, 2.1703442116260088, 1.3419346928494036, 1.269423836566266, 1.2380290864574048, 0.9659569864907067, 2.393159141781966, 2.744212914590565, 1.8465917000173457, 2.4227528745371387, 2.1865071592187255, 2.689864891293009, 3.0151366575490153, 2.2040524736034244, 1.183425526602015, 2.9521463483319494, 3.05380770477211, 0.9185769466045232, 0.8250522498421741, 1.941093296496635, 2.7542250889687225, 1.8557100723352078, 1.0605152744542132, 1.9339612732642804, 1.8256698350809415, 0.8135774732073555, 0.9902209006791751, 2.217078935207485, 1.7558901794757114, 1.2065833308242826, 2.721850508777157, 1.9210841402587655, 1.8254044111206205, 2.936352754224596, 2.7475743527267515, 2.533049195913599, 2.7846848762719425, 2.8223539602976966, 1.8376147998255048, 2.2403991115133777, 3.264353744274614, 1.6358072487362967, 0.8688379956228957, 3.4213240884728373, 1.5708949887225154, 1.0432261900498427, 1.4862316974326297, 2.7398125805807023, 1.858118002892973, 0.8144118474180728, 0.8358934230245408, 1.6872515832585, 3.144887374208294, 0.37304767173662207, 1.4251329009401503, 1.2551113876550755, 2.5810564163877743, 2.9473163388208445, 1.2528714062852355, 2.2402464428527473, 2.1020536901884537, 1.5316819475351993, 1.2651233369899926, 2.8184072875105675, 2.4954208684606676, 2.1426857989669426, 2.5970986347157754, 2.9787968281694726, 2.458774323134983, 3.2099118557239197, 2.450640323241323, 2.471187005991727, 1.6521061186832149, 0.23897274193248916, 1.293668455058191, 0.3393058486749193, 3.095998916192826, 1.2929359356577304, 2.053699745161093, 2.694786361038946, 1.6094545300357315, 1.8769336929508391, 0.7094082392763351, 1.7748099481070025, 1.5276711504908336, 1.0329372757352147, 1.5385500202804152, 0.6577033668299882, 2.5900285207534193, 2.970542077855833, 3.1775423202528685, 2.334341233291271, 2.804511420463032, 1.750167477983017, 1.1849566755031367, 0.8354040576951252, 2.46019656345056, 2.91290037648389, 2.0624440652807436, 1.4677951927923159, 0.8461749549434234, 0.9253491397621504, 0.6995934725678558, 2.8412676887022768, 1.0880849083499566, 1.7428931895709157, 1.4474345494197243, 1.3769320015101147, 3.4279582832919258, 1.9002173771001256, 2.4394200298120032, 3.082943140474687, 2.4117734872883103, 2.4686662816013096, 1.276817440766592, 1.5028610311118236, 2.5020214698520586, 0.9390549243335532, 3.227951971092664, 2.8027668760870457, 1.7375267160818808, 1.464280532361711, 1.0251818152690186, 2.1154991171900304, 1.4089931746893654, 1.1664380091888669, 2.4924903790135637, 1.3014638491609318, 3.427926110653635, 0.8670361886443559, 3.5068212608911282, 1.4521311884852826, 2.3586840074048996, 0.7615463731464677, 0.9035078700562106, 2.683998232030786, 2.858519342489262, 1.311765879953395, 1.3358388762925186, 2.8087099814440606, 2.5558406985872733, 0.7313313765893485, 2.262127528884886, 2.1156259908048924, 0.7137220360866023, 2.5411062583120274, 1.7784397341788905, 1.9290018507038005, 1.5370179687663104, 0.9890958887308785, 2.400497546034307, 0.7776021588605964, 1.1617887732912195, 0.7181692488382477, 0.8143579317318757, 0.9366413208053199, 3.056387946446949, 2.3903815864136284, 1.2506417329455963, 2.786654251624365, 1.0500269653445038, 2.697199814934232, 2.2337831027324566, 1.5671606203031656, 1.009146356656408, 2.1991316160862913, 2.077469655084351, 1.330796344569957, 3.2468433133178283, 1.9304888474805362, 3.463230407858656, 0.753895183841276, 2.8201389402137105, 2.8401216883272475, 2.2010731134253323, 2.9552645976675267, 2.758582444062296, 0.5104623715038265, 2.6437249923457404, 0.5423373748867195, 0.5978305397150513, 1.0359413006975762, 3.135181845418359, 0.879687952241164, 0.7982281074046795, 2.6430920955326416, 3.030732769867522, 1.5794610412353514, 1.1476390501169667, 1.1562352984030917, 2.44173997851803, 0.3535500757394109, 2.408753411611074, 3.1721171129772485, 2.6892731300885013, 1.3788781224068785, 3.2659793709863436, 2.9972920005962935, 1.2234818425045142, 3.2338019610912205, 2.64069694499622, 2.8994641580312495, 1.847902611527665, 2.3404404905688887, 3.113458684441994, 3.0811126086862206, 2.7672639047494814, 2.0089596466241715, 3.1629491240609298, 1.7952780211635533, 0.8360268997507884, 0.9589512143214624, 3.131348830421922, 1.2162202133940903, 2.6063949189426068, 0.7403865718389687, 1.8628309712790285, 3.239498394829766, 2.9741313049189344, 2.0019734828198277, 1.9818050296678036, 0.6908577384430676, 3.000948422157718, 3.2297438261799747, 2.9367579598941544, 1.457909540683717, 2.869657638865432, 2.729278512525954, 3.14218219439879, 2.773311630802945, 2.737435364309045, 2.991435507437042, 2.3097392969502892, 2.229903013751342, 2.8293012436917433, 2.8528877427546036, 1.9979901608160642, 1.1420637689159632, 0.6860020113443982, 0.8531780807228757, 0.7975865851184439, 2.3498130358826868, 1.4932284600204337, 0.4363448194831619, 1.0511191228108565, 0.5605935834540843, 0.5005474452858429, 1.1300411399792054, 2.463975909970498, 3.18482936140838, 0.5514282745563419, 3.2078099078781195, 2.834385613894579, 2.5628643997368328, 1.1488674741655192, 2.5312612587161074, 0.35579530823254185, 0.8244605219719555, 2.4173220214717253, 2.938757886544285, 0.6405331684775243, 1.0462802450788966, 0.8118761237739834, 2.8771889667077257, 1.5038813011616419, 2.627038781179931, 1.873906012281703, 1.1151083610201014, 2.884366930059878, 0.6663821664083265, 1.0831028736373678, 1.1401527011408135, 1.4126768560032714, 0.7526678704845685, 1.4227941972373868, 3.2965761910126212, 1.7812673283824347, 0.8381606536771751, 1.8182646525960993, 1.720203684875185, 3.325369196987094, 1.1064857374212678, 1.6961773459884117, 0.6336359649920934, 1.0919721097612713, 3.2496555412768986, 1.0204330614463055, 3.3823672214682388, 2.438082455595441, 2.693513013913098, 0.8735085158878966, 2.7935833778595724, 0.8211363428418713, 2.2002836312212715, 3.0952091874254397, 2.3943479166017623, 1.9562334035579658, 1.5113430512031691, 2.3642845892315454, 2.227463288878823, 2.885013655331757, 1.9256724410217574, 3.1364536603638156, 2.0105223085444677, 0.7779412043603178, 0.7122996245729107, 3.585691980660025, 1.1915765511369776, 2.416373344381702, 0.8382533998543107, 2.9872608159239156, 3.184886577988749, 1.3012612392696525, 0.7223805953459372, 1.6548557945086686, 1.3065796892156096, 0.5751389932737672, 2.1537247796758106, 2.5820874231485713, 3.2118966865135175, 2.6837414366038295, 0.8565630251320768, 2.0548145386944587, 2.954484139081749, 1.1861154581685436, 2.3169221609491983, 0.40326354237100775, 2.0750354319253472, 0.8665969957467702, 1.5028757233203014, 1.4029498278889057, 3.407930094705276, 2.496323775811961, 2.6821635336556144, 2.357984417485033, 0.80546394889606, 2.3249241842298654, 2.1320557494726446, 0.7670194838986968, 1.6788416090250184, 2.454349568381388, 0.8621394469620908, 3.378225784521218, 1.7250548801354273, 2.700876519310926, 0.5776434945810583, 2.9940319624390046, 3.1671944449329836, 0.8035188786854681, 1.7371675967666884, 2.559851278293226, 2.509558257338482, 2.6194635884973, 1.3932296666329447, 2.904251655037097, 2.089225007944344, 2.2808031223143432, 1.6715228070627925, 0.8884073646903493, 1.4500410837307391, 2.8544263147814806, 2.8069971493892445, 0.7336029395870409, 1.3870616207227753, 3.7291144462538743, 0.7719221668968198, 2.8512860610323196, 1.0947118976279666};
-#endif
 
 
 char station_Bangor_name [] = "Bangor";
@@ -237,3 +272,9 @@ tidal_station station_LochGoil = {
 
 tidal_station * tidal_stations  = &station_LochGoil;                    
 
+tidal_station *const tidal_station_index [] = {&station_Bangor, &station_Dover, &station_LittleCumbrae, &station_LochGoil, &station_Millport, &station_Portpatrick};
+const uint32_t n_tidal_stations = 6;
+
+const tide_spatial_point tidal_station_points [] = {{5.6074892264733889e-01, -4.8130322516627751e-02, 8.2658581998743130e-01, 2}, {5.6074892264733889e-01, -4.8130322516627751e-02, 8.2658581998743130e-01, 3}, {5.6074892264733889e-01, -4.8130322516627751e-02, 8.2658581998743130e-01, 4}, {5.7352704659120290e-01, -5.1387724882154429e-02, 8.1757325577577955e-01, 5}, {5.7552742048536398e-01, -5.7130797875677715e-02, 8.1578444469329725e-01, 0}, {6.2760022113676373e-01, 1.4488828549110563e-02, 7.7840094827560413e-01, 1}};
+const uint32_t n_tidal_station_points = 6;
+
@@ -0,0 +1,220 @@
+#include "tide_db.h"
+#include "tide_astro.h"
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* The records are read in place, so their layout must match the writer's */
+_Static_assert(sizeof(tide_db_header)==32, "tide_db_header layout");
+_Static_assert(sizeof(tide_db_station_record)==24, "tide_db_station_record layout");
+_Static_assert(sizeof(tide_db_harmonic_record)==56, "tide_db_harmonic_record layout");
+_Static_assert(sizeof(tide_db_nodal_record)==32, "tide_db_nodal_record layout");
+_Static_assert(sizeof(tide_db_almanac_record)==24, "tide_db_almanac_record layout");
+
+/* The part of db at offset, if size bytes starting there lie in the blob and
+it is aligned for elements of align bytes; otherwise NULL */
+static const void *db_part(const tide_db *db, uint32_t offset, size_t size, size_t align)
+{
+    if(offset==0 || offset % align!=0 || offset>db->size || size>db->size - offset) return NULL;
+    return db->data + offset;
+}
+
+/* The string at offset in the string table, or NULL if it is not there */
+static const char *db_string(const tide_db *db, uint32_t offset)
+{
+    const tide_db_header *header = (const tide_db_header *)db->data;
+    if(offset<header->strings || offset>=header->strings + header->strings_size) return NULL;
+    if(!memchr(db->data + offset, 0, header->strings + header->strings_size - offset)) return NULL;
+    return (const char *)db->data + offset;
+}
+
+/* Check the header of the blob at data, and find the nodal table */
+static int db_check(tide_db *db, const void *data, size_t size)
+{
+    const tide_db_header *header = data;
+    const uint16_t one = 1;
+    db->data = data;
+    db->size = size;
+    /* The records are little-endian */
+    if(*(const uint8_t *)&one!=1) return -1;
+    if(size<sizeof(tide_db_header) || (uintptr_t)data % TIDE_DB_ALIGN!=0) return -1;
+    if(memcmp(header->magic, TIDE_DB_MAGIC, 4)!=0 || header->version!=TIDE_DB_VERSION) return -1;
+    if(header->size>size) return -1;
+    db->size = header->size;
+    if(header->n_stations>0 && !db_part(db, header->stations, (size_t)header->n_stations * sizeof(tide_db_station_record), TIDE_DB_ALIGN)) return -1;
+    if(header->strings_size>0 && !db_part(db, header->strings, header->strings_size, 1)) return -1;
+    if(header->nodal) {
+        const tide_db_nodal_record *nodal = db_part(db, header->nodal, sizeof(tide_db_nodal_record), TIDE_DB_ALIGN);
+        size_t n, rows;
+        /* tide_nodal_table keeps the count in a uint8_t */
+        if(!nodal || nodal->n_years<0 || nodal->n_constituents>255) return -1;
+        n = nodal->n_constituents;
+        rows = n * (size_t)nodal->n_years * sizeof(uint16_t);
+        db->nodal.base_year = nodal->base_year;
+        db->nodal.n_years = nodal->n_years;
+        db->nodal.n_constituents = (uint8_t)n;
+        db->nodal.speeds = db_part(db, nodal->speeds, n * sizeof(float), sizeof(float));
+        db->nodal.astro = nodal->astro ? db_part(db, nodal->astro, n, 1) : NULL;
+        db->nodal.node_factors = rows ? db_part(db, nodal->node_factors, rows, sizeof(uint16_t)) : NULL;
+        db->nodal.equilibria = rows ? db_part(db, nodal->equilibria, rows, sizeof(uint16_t)) : NULL;
+        if(!db->nodal.speeds || (nodal->astro && !db->nodal.astro) || (rows && (!db->nodal.node_factors || !db->nodal.equilibria))) return -1;
+        /* Constituents not computed on the device need a year of the table */
+        for(size_t c=0; c<n; c++) {
+            uint8_t astro = db->nodal.astro ? db->nodal.astro[c] : TIDE_ASTRO_NONE;
+            if(astro==TIDE_ASTRO_NONE ? nodal->n_years==0 : astro>=tide_astro_count) return -1;
+        }
+    }
+    return 0;
+}
+
+/* Use the database blob at data, which must be 8 byte aligned and stay
+there until the database is closed. Returns 0, or -1 if it is not a
+database this version can read. */
+int tide_db_attach(tide_db *db, const void *data, size_t size)
+{
+    memset(db, 0, sizeof(*db));
+    if(db_check(db, data, size)!=0) {
+        memset(db, 0, sizeof(*db));
+        return -1;
+    }
+    return 0;
+}
+
+/* Map the database file at path. Returns 0, or -1 if it can't be read or
+is not a database this version can read. */
+int tide_db_open(tide_db *db, const char *path)
+{
+    struct stat st;
+    void *data;
+    int fd = open(path, O_RDONLY);
+    memset(db, 0, sizeof(*db));
+    if(fd<0) return -1;
+    if(fstat(fd, &st)!=0 || st.st_size<(off_t)sizeof(tide_db_header)) {
+        close(fd);
+        return -1;
+    }
+    data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(data==MAP_FAILED) return -1;
+    if(tide_db_attach(db, data, st.st_size)!=0) {
+        munmap(data, st.st_size);
+        return -1;
+    }
+    db->mapped = st.st_size;
+    return 0;
+}
+
+/* Unmap the database if tide_db_open mapped it. Any views of it are then invalid. */
+void tide_db_close(tide_db *db)
+{
+    if(db->mapped) munmap((void *)db->data, db->mapped);
+    memset(db, 0, sizeof(*db));
+}
+
+/* Number of stations in the database */
+uint32_t tide_db_count(const tide_db *db)
+{
+    return db->data ? ((const tide_db_header *)db->data)->n_stations : 0;
+}
+
+/* Name of station i, without building a view of it; NULL if i is out of range */
+const char *tide_db_name(const tide_db *db, uint32_t i)
+{
+    const tide_db_header *header = (const tide_db_header *)db->data;
+    if(i>=tide_db_count(db)) return NULL;
+    return db_string(db, ((const tide_db_station_record *)(db->data + header->stations))[i].name);
+}
+
+static const char *db_station_name(const void *db, uint32_t i)
+{
+    const char *name = tide_db_name(db, i);
+    return name ? name : "";
+}
+
+/* Find the stations whose names start with prefix, ignoring case, in the
+sorted directory. Sets *first to the first of them, and returns how many there are. */
+uint32_t tide_db_find_range(const tide_db *db, const char *prefix, uint32_t *first)
+{
+    return find_name_range(prefix, db_station_name, db, tide_db_count(db), first);
+}
+
+/* Index of the station with exactly that name (ignoring case), or else the
+first whose name starts with it, as find_tidal_station; -1 if there is none */
+int tide_db_find(const tide_db *db, const char *name)
+{
+    uint32_t first;
+    if(tide_db_find_range(db, name, &first)==0) return -1;
+    return (int)first;
+}
+
+/* Fill view with station i of the database. Returns 0, or -1 if i is out
+of range or the station's records don't fit in the database. */
+int tide_db_station(const tide_db *db, uint32_t i, tide_db_view *view)
+{
+    const tide_db_header *header = (const tide_db_header *)db->data;
+    const tide_db_station_record *record;
+    const tide_db_harmonic_record *harmonic;
+    tidal_harmonic *h = &view->harmonic;
+    size_t n, years;
+    memset(view, 0, sizeof(*view));
+    if(i>=tide_db_count(db)) return -1;
+    record = (const tide_db_station_record *)(db->data + header->stations) + i;
+    harmonic = db_part(db, record->harmonic, sizeof(tide_db_harmonic_record), TIDE_DB_ALIGN);
+    if(!harmonic) return -1;
+
+    view->offset.time_offset = record->time_offset;
+    view->offset.level_offset = record->level_offset;
+    view->offset.level_scale = record->level_scale;
+    view->station.name = (char *)db_string(db, record->name);
+    view->station.offset = &view->offset;
+    view->station.harmonic = h;
+    view->station.previous = NULL;
+
+    /* The arrays are only read, though tidal_harmonic does not say so */
+    n = harmonic->n_constituents;
+    /* prepare_station has room for no more */
+    if(n>MAX_TIDE_CONSTITUENTS) return -1;
+    years = (harmonic->type==TIDE_ENCODING_NODAL) ? 1 : harmonic->n_years;
+    h->type = harmonic->type;
+    h->name = (char *)db_string(db, harmonic->name);
+    h->base_year = harmonic->base_year;
+    h->n_years = harmonic->n_years;
+    h->lat = harmonic->lat;
+    h->lon = harmonic->lon;
+    h->neaps_range = harmonic->neaps_range;
+    h->springs_range = harmonic->springs_range;
+    h->offset = harmonic->offset;
+    h->mean_error = harmonic->mean_error;
+    h->n_constituents = (uint8_t)n;
+    h->amps = (uint16_t *)db_part(db, harmonic->amps, n * years * sizeof(uint16_t), sizeof(uint16_t));
+    h->phases = (uint16_t *)db_part(db, harmonic->phases, n * years * sizeof(uint16_t), sizeof(uint16_t));
+    if(!view->station.name || !h->name || !h->amps || !h->phases) return -1;
+    if(harmonic->type==TIDE_ENCODING_NODAL) {
+        h->constituents = db_part(db, harmonic->constituents, n, 1);
+        h->nodal = &db->nodal;
+        if(!h->constituents || !db->nodal.speeds) return -1;
+        for(size_t c=0; c<n; c++)
+            if(h->constituents[c]>=db->nodal.n_constituents) return -1;
+    } else if(harmonic->type==TIDE_ENCODING_HARMONIC) {
+        h->speeds = (float *)db_part(db, harmonic->speeds, n * sizeof(float), sizeof(float));
+        if(!h->speeds || harmonic->n_years==0) return -1;
+    } else {
+        return -1;
+    }
+    if(harmonic->almanac) {
+        const tide_db_almanac_record *almanac = db_part(db, harmonic->almanac, sizeof(tide_db_almanac_record), TIDE_DB_ALIGN);
+        /* tide_almanac_find trusts the blocks to cover the events exactly */
+        if(!almanac || almanac->block_events==0 || almanac->n_blocks!=(almanac->n_events + almanac->block_events - 1) / almanac->block_events) return -1;
+        view->almanac.start = (time_t)almanac->start;
+        view->almanac.n_events = almanac->n_events;
+        view->almanac.n_blocks = almanac->n_blocks;
+        view->almanac.block_events = almanac->block_events;
+        view->almanac.blocks = db_part(db, almanac->blocks, (size_t)almanac->n_blocks * sizeof(uint32_t), sizeof(uint32_t));
+        view->almanac.events = db_part(db, almanac->events, (size_t)almanac->n_events * sizeof(uint32_t), sizeof(uint32_t));
+        if(!view->almanac.blocks || !view->almanac.events) return -1;
+        h->almanac = &view->almanac;
+    }
+    return 0;
+}
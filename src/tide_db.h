@@ -0,0 +1,114 @@
+#ifndef __TIDE_DB_H__
+#define __TIDE_DB_H__
+#include "tide_base.h"
+#include "tide_almanac.h"
+#include <stddef.h>
+
+/* Binary station database, written by extract_tides.py --database, and used
+in place without copying: mapped from a file on a host, or read from a fixed
+flash address on a device.
+
+Everything is little-endian. The blob starts with a tide_db_header; every
+other part is found by its offset from the start of the blob (0 for none),
+and starts on an 8 byte boundary so it can be read in place:
+    station directory   n_stations tide_db_station_record, sorted by name as insensitive_compare
+    harmonic records    tide_db_harmonic_record, shared by a reference station and its secondaries
+    nodal table         a tide_db_nodal_record, for TIDE_ENCODING_NODAL harmonics
+    almanacs            tide_db_almanac_record
+    arrays              speeds, amplitudes, phases, ... as in tide_data.c
+    string table        NUL terminated names */
+#define TIDE_DB_MAGIC "TIDE"
+#define TIDE_DB_VERSION 2 /* 2: almanac events have a 4 bit neap/spring */
+#define TIDE_DB_ALIGN 8
+
+typedef struct tide_db_header {
+    char magic[4]; /* TIDE_DB_MAGIC */
+    uint16_t version; /* TIDE_DB_VERSION */
+    uint16_t reserved;
+    uint32_t size; /* of the whole blob, in bytes */
+    uint32_t n_stations;
+    uint32_t stations; /* the station directory */
+    uint32_t strings; /* the string table */
+    uint32_t strings_size;
+    uint32_t nodal; /* tide_db_nodal_record, or 0 */
+} tide_db_header;
+
+/* A station, as a tidal_station and its tidal_offset */
+typedef struct tide_db_station_record {
+    uint32_t name; /* in the string table */
+    uint32_t harmonic; /* tide_db_harmonic_record */
+    int32_t time_offset;
+    float level_offset;
+    float level_scale;
+    uint32_t reserved;
+} tide_db_station_record;
+
+/* A tidal_harmonic; TIDE_ENCODING_CHEBYSHEV is not stored */
+typedef struct tide_db_harmonic_record {
+    uint32_t name; /* in the string table */
+    uint8_t type;
+    uint8_t n_constituents;
+    uint16_t n_years;
+    int32_t base_year;
+    float lat, lon;
+    float neaps_range, springs_range;
+    float offset;
+    float mean_error;
+    uint32_t speeds; /* float[n_constituents], or 0 for TIDE_ENCODING_NODAL */
+    uint32_t amps; /* uint16_t, as tidal_harmonic */
+    uint32_t phases; /* uint16_t, as tidal_harmonic */
+    uint32_t constituents; /* uint8_t[n_constituents] for TIDE_ENCODING_NODAL, or 0 */
+    uint32_t almanac; /* tide_db_almanac_record, or 0 */
+} tide_db_harmonic_record;
+
+/* A tide_nodal_table */
+typedef struct tide_db_nodal_record {
+    int32_t base_year;
+    int32_t n_years;
+    uint32_t n_constituents;
+    uint32_t speeds; /* float[n_constituents] */
+    uint32_t astro; /* uint8_t[n_constituents], or 0 */
+    uint32_t node_factors; /* uint16_t[n_years][n_constituents], or 0 if n_years is 0 */
+    uint32_t equilibria;
+    uint32_t reserved;
+} tide_db_nodal_record;
+
+/* A tide_almanac */
+typedef struct tide_db_almanac_record {
+    int64_t start;
+    uint32_t n_events;
+    uint16_t n_blocks;
+    uint16_t block_events;
+    uint32_t blocks; /* uint32_t[n_blocks] */
+    uint32_t events; /* uint32_t[n_events] */
+} tide_db_almanac_record;
+
+/* An open database */
+typedef struct tide_db {
+    const uint8_t *data;
+    size_t size;
+    size_t mapped; /* bytes mapped by tide_db_open, to be unmapped by tide_db_close */
+    tide_nodal_table nodal; /* the nodal record, if any, as the harmonics see it */
+} tide_db;
+
+/* One station of a database, in the structures the rest of the code uses.
+The arrays and names point into the database, which must stay open.
+prepared_station and tide_table remember a station by its address, so use
+one view per station, or zero them before reusing a view for another. */
+typedef struct tide_db_view {
+    tidal_station station;
+    tidal_offset offset;
+    tidal_harmonic harmonic;
+    tide_almanac almanac;
+} tide_db_view;
+
+int tide_db_attach(tide_db *db, const void *data, size_t size);
+int tide_db_open(tide_db *db, const char *path);
+void tide_db_close(tide_db *db);
+int tide_db_station(const tide_db *db, uint32_t i, tide_db_view *view);
+uint32_t tide_db_count(const tide_db *db);
+const char *tide_db_name(const tide_db *db, uint32_t i);
+int tide_db_find(const tide_db *db, const char *name);
+uint32_t tide_db_find_range(const tide_db *db, const char *prefix, uint32_t *first);
+
+#endif
@@ -1,9 +1,18 @@
 #include "tide_base.h"
+#include "tide_pool.h"
+#include "tide_stats.h"
+#include "tide_astro.h"
+#include "tide_db.h"
+#include "tide_spatial.h"
+#include "tide_export.h"
+#include "tide_kernel.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
 #include <time.h>
+#include <stddef.h>
+#include <unistd.h>
 
 /* These functions are only used for debugging */
 /* Print a single event */
@@ -16,14 +25,15 @@ void print_tide_event(tidal_event *event)
         case TIDE_NONE: event_type = "--"; break;
         case TIDE_HIGH: event_type = "HW"; break;
         case TIDE_LOW: event_type = "LW"; break;
+        default: event_type = "??"; break;
     }
     
     if(event->neap_spring<0.25) neap_spring = "Neap";
     else if(event->neap_spring>0.75) neap_spring = "Spring";
     else neap_spring = "Mid";
 
-    char *datetime = ctime(&event->time);
-    datetime[strlen(datetime)-1] = '\0';
+    char datetime[TIME_STRING_LENGTH];
+    format_time(event->time, datetime);
     if(event->type==TIDE_NONE) 
         printf("--\n");
     else
@@ -32,89 +42,740 @@ void print_tide_event(tidal_event *event)
 
 /* Print a tide table; this includes
 the hourly tide predictions, and the
-daily HW/LW events */
-void print_tide_table(tide_table *table)
+daily HW/LW events, and the
+interpolated tide at now */
+void print_tide_table(tide_table *table, time_t now)
 {
-    char *datetime;
+    char datetime[TIME_STRING_LENGTH];
     time_t t;
     printf("Tide table for %s\n", table->station->name);
-    t = table->base_time;
-    for(int i=0;i<72;i++)
+    /* The table starts at midnight TIDE_TABLE_DAYS_BEFORE days before */
+    t = tide_table_start(table);
+    for(int i=0;i<TIDE_TABLE_TIMES;i++)
     {
-        datetime = ctime(&t);
-        datetime[strlen(datetime)-1] = '\0';
-        printf("%s %2.2fm\n", datetime, table->levels[i]);
-        t += 3600;
+        printf("%s %2.2fm\n", format_time(t, datetime), tide_table_level(table, i));
+        t += TIDE_TABLE_STEP_SECONDS;
     }
     /* And then the events */
-    printf("\nYesterday\n");
-    for(int i=0;i<MAX_TIDE_EVENTS;i++)    
-        print_tide_event(&table->events[0][i]);        
-    printf("\nToday\n");
-    for(int i=0;i<MAX_TIDE_EVENTS;i++)    
-        print_tide_event(&table->events[1][i]);        
-   printf("\nTomorrow\n");
-    for(int i=0;i<MAX_TIDE_EVENTS;i++)    
-        print_tide_event(&table->events[2][i]);        
+    for(int day=0;day<TIDE_TABLE_DAYS;day++)
+    {
+        int offset = day - TIDE_TABLE_DAYS_BEFORE;
+        if(offset==-1) printf("\nYesterday\n");
+        else if(offset==0) printf("\nToday\n");
+        else if(offset==1) printf("\nTomorrow\n");
+        else printf("\n%+d days\n", offset);
+        for(int i=0;i<MAX_TIDE_EVENTS;i++) {
+            tidal_event event = tide_table_event(table, day, i);
+            print_tide_event(&event);        
+        }
+    }
    
     printf("\n");
    printf("Tide interpolated now\n");
-    t = time(NULL);
-    datetime = ctime(&t);
-    datetime[strlen(datetime)-1] = '\0';
-    printf("%s %2.2fm %+2.2fm/h\n", datetime, interpolate_tide_level(t, table), interpolate_tide_rate(t, table));
+    t = now;
+    printf("%s %2.2fm %+2.2fm/h\n", format_time(t, datetime), interpolate_tide_level(t, table), interpolate_tide_rate(t, table));
     
     printf("\n");
     float hw, lw;
-    update_range(table->events[1], &hw, &lw);
+    tidal_event today[MAX_TIDE_EVENTS];
+    for(int i=0;i<MAX_TIDE_EVENTS;i++) today[i] = tide_table_event(table, TIDE_TABLE_DAYS_BEFORE, i);
+    update_range(today, &hw, &lw);
     printf("Todays range: HW %2.2fm LW %2.2fm\n", hw, lw);
     printf("\n");
 
     printf("Tide events before and after now\n");
-    tidal_event *prev, *next;
+    tidal_event prev, next;
     get_tide_events_near(t, table, &prev, &next);
-    print_tide_event(prev);
-    print_tide_event(next);
+    print_tide_event(&prev);
+    print_tide_event(&next);
 }
 
-/* Iterate over all stations and print their tide tables */
-void print_all_tables()
+/* Print n evenly spaced tide predictions, step seconds apart, starting at t */
+void print_tide_levels(tidal_station *station, time_t t, time_t step, int n)
 {
-    tide_table table;
-    tidal_station *station = tidal_stations;
-    table.station = NULL;
-    table.base_time = 0;
+    char datetime[TIME_STRING_LENGTH];
+    tide_iterator it;
+    prepared_station prepared = {0};
+    printf("Tide levels for %s\n", station->name);
+    prepare_station(&prepared, station, t);
+    tide_iterator_init(&it, &prepared, t, step);
+    for(int i=0;i<n;i++)
+    {
+        format_time(it.t, datetime);
+        printf("%s %2.2fm\n", datetime, tide_iterator_next(&it));
+    }
+}
+
+/* Check that the packed tide table for station around t interpolates to
+within a centimetre of the same table kept in floats, and that its events 
+match to the minute and centimetre. Keeps the worst difference between the 
+packed table and predict_tide in worst_prediction. Returns 1 on failure. */
+int test_tide_table(tidal_station *station, time_t t, float *worst_prediction)
+{
+    tide_table table = {0};
+    prepared_station prepared = {0};
+    tide_iterator it;
+    float levels[TIDE_TABLE_TIMES + 1], rates[TIDE_TABLE_TIMES + 1];
+    tidal_event events[TIDE_TABLE_DAYS][MAX_TIDE_EVENTS];
+    float worst_level = 0.0f;
+    time_t worst_time = 0;
+    int bad_events = 0;
+
+    populate_tide_table(&table, &prepared, station, t, 0, 0);
+    /* The float table, built the same way */
+    time_t start = tide_table_start(&table);
+    tide_iterator_init(&it, &prepared, start, TIDE_TABLE_STEP_SECONDS);
+    for(int day=0; day<TIDE_TABLE_DAYS; day++) 
+        fill_day_tide_table(events[day], levels + day * TIDE_TABLE_DAY_TIMES, rates + day * TIDE_TABLE_DAY_TIMES, &it);
+    levels[TIDE_TABLE_TIMES] = tide_iterator_next_rate(&it, &rates[TIDE_TABLE_TIMES]);
+    for(time_t s=start; s<start+(time_t)TIDE_TABLE_DAYS*DAY_SECONDS; s+=MINUTE_SECONDS) {
+        int i = (s - start) / TIDE_TABLE_STEP_SECONDS;
+        float u = (float)(s - start - i * TIDE_TABLE_STEP_SECONDS) / TIDE_TABLE_STEP_SECONDS;
+        float m0 = rates[i] * TIDE_TABLE_STEP_SECONDS, m1 = rates[i+1] * TIDE_TABLE_STEP_SECONDS;
+        float level = (2*u*u*u - 3*u*u + 1) * levels[i] + (u*u*u - 2*u*u + u) * m0 
+            + (-2*u*u*u + 3*u*u) * levels[i+1] + (u*u*u - u*u) * m1;
+        float packed = interpolate_tide_level(s, &table);
+        float error = fabsf(packed - level);
+        if(error>worst_level) {
+            worst_level = error;
+            worst_time = s;
+        }
+        error = fabsf(packed - predict_tide(s, &prepared, 0));
+        if(error>*worst_prediction) *worst_prediction = error;
+    }
+    for(int day=0; day<TIDE_TABLE_DAYS; day++) {
+        for(int i=0; i<MAX_TIDE_EVENTS; i++) {
+            tidal_event packed = tide_table_event(&table, day, i);
+            if(packed.type!=events[day][i].type) bad_events++;
+            else if(packed.type!=TIDE_NONE && (fabs(difftime(packed.time, events[day][i].time))>MINUTE_SECONDS/2 || fabsf(packed.level - events[day][i].level)>0.005f)) bad_events++;
+        }
+    }
+    if(worst_level>0.01f || bad_events) {
+        char datetime[TIME_STRING_LENGTH];
+        printf("%s: packed table off by %.4fm at %s, %d events differ\n", station->name, worst_level, format_time(worst_time, datetime), bad_events);
+        return 1;
+    }
+    return 0;
+}
+
+/* Check that the name index is sorted, holds every station in the list, and
+finds each one by its name. Returns the number of failures. */
+int test_station_index(void)
+{
+    int failures = 0;
+    uint32_t n = 0, first;
+    for(tidal_station *station = tidal_stations; station!=NULL; station = station->previous) {
+        tidal_station *found = find_tidal_station(station->name);
+        n++;
+        /* another station may have the same name, case aside */
+        if(!found || insensitive_compare(found->name, station->name, 0)!=0) failures++;
+        if(find_tidal_stations(station->name, &first)==0) failures++;
+    }
+    if(n!=n_tidal_stations) failures++;
+    for(uint32_t i=1; i<n_tidal_stations; i++)
+        if(insensitive_compare(tidal_station_index[i-1]->name, tidal_station_index[i]->name, 0)>0) failures++;
+    /* cycling visits every station once */
+    tidal_station *station = tidal_station_index[0];
+    for(uint32_t i=0; i<n_tidal_stations; i++) {
+        if(station!=tidal_station_index[i]) failures++;
+        station = next_tidal_station(station);
+    }
+    if(find_tidal_stations("", &first)!=n_tidal_stations || find_tidal_stations("\x7f", &first)!=0) failures++;
+    printf("Station index: %u stations, %d failed\n", n_tidal_stations, failures);
+    return failures;
+}
+
+/* Convert a station stored with the per-year encoding to the nodal encoding,
+with its own table, and check the two agree. The base amplitudes are the
+largest of any year, the node factors the rest of each year's amplitude, and
+the epochs zero, so the equilibria are each year's phases. Returns the number
+of failures, and the largest difference between the two forms in worst. */
+static int test_nodal_form(tidal_station *station, float *worst)
+{
+    tidal_harmonic *h = station->harmonic;
+    int n = h->n_constituents, failures = 0;
+    char name[128];
+    uint16_t *base_amps = calloc(n, sizeof(uint16_t)), *epochs = calloc(n, sizeof(uint16_t));
+    uint16_t *node_factors = calloc((size_t)n * h->n_years, sizeof(uint16_t));
+    uint8_t *constituents = calloc(n, 1);
+    tide_nodal_table table = {.base_year = h->base_year, .n_years = h->n_years, .n_constituents = (uint8_t)n,
+                              .speeds = h->speeds, .astro = NULL, .node_factors = node_factors, .equilibria = h->phases};
+    tidal_harmonic nodal = *h;
+    tidal_station nodal_station = *station;
+    prepared_station p[2] = {{0}, {0}};
+    float table_worst = 0.0f;
+
+    for(int i=0; i<n; i++) {
+        constituents[i] = (uint8_t)i;
+        for(int year=0; year<h->n_years; year++)
+            if(h->amps[i + n * year]>base_amps[i]) base_amps[i] = h->amps[i + n * year];
+        for(int year=0; year<h->n_years; year++) {
+            float f = base_amps[i] ? (float)h->amps[i + n * year] / base_amps[i] : 0.0f;
+            node_factors[i + n * year] = (uint16_t)(f / MAX_NODE_FACTOR * 65535.0f + 0.5f);
+        }
+    }
+    snprintf(name, sizeof(name), "%s (nodal)", h->name);
+    nodal.name = name;
+    nodal.type = TIDE_ENCODING_NODAL;
+    nodal.speeds = NULL;
+    nodal.amps = base_amps;
+    nodal.phases = epochs;
+    nodal.constituents = constituents;
+    nodal.nodal = &table;
+    nodal.almanac = NULL;
+    nodal_station.harmonic = &nodal;
+
+    /* against the test vectors, with the float and fixed-point predictors */
+    failures += test_tides(&nodal);
+    /* against the per-year form, through every year and a little beyond */
+    p[0].station = station;
+    p[1].station = &nodal_station;
+    srand(2);
+    for(int i=0; i<1000; i++) {
+        time_t t = make_time(h->base_year, 1, 1, 0, 0, 0) + (time_t)((double)rand() / RAND_MAX * (h->n_years + 1) * YEAR_SECONDS);
+        float difference = fabsf(predict_tide(t, &p[0], 0) - predict_tide(t, &p[1], 0));
+        if(difference>*worst) *worst = difference;
+        if(difference>0.001f) failures++;
+    }
+    /* and the event search, a table a month */
+    for(int month=1; month<=12; month++)
+        failures += test_tide_table(&nodal_station, make_time(h->base_year, month, 15, 12, 0, 0), &table_worst);
+    free(base_amps);
+    free(epochs);
+    free(node_factors);
+    free(constituents);
+    return failures;
+}
+
+/* Check that the kernel compiled in gives bit-identical results to the plain C
+reference, with every station's constants at random times in its first year.
+Returns the number of failures. */
+int test_kernel(void)
+{
+    enum { N_TIMES = 64, STRIDE = N_TIMES * TIDE_KERNEL_LANES };
+    static float acc[2][3][STRIDE];
+    float amps[MAX_TIDE_CONSTITUENTS], speeds[MAX_TIDE_CONSTITUENTS], phases[MAX_TIDE_CONSTITUENTS], times[N_TIMES];
+    int failures = 0, n_stations = 0;
+    srand(1);
+    for(int i=0; i<N_TIMES; i++) times[i] = (float)((double)rand() / RAND_MAX * YEAR_SECONDS);
+    for(tidal_station *station = tidal_stations; station!=NULL; station = station->previous) {
+        tidal_harmonic *h = station->harmonic;
+        tidal_station *first = tidal_stations;
+        while(first->harmonic!=h) first = first->previous;
+        if(first!=station || h->type==TIDE_ENCODING_CHEBYSHEV) continue;
+        /* padded with zero amplitudes, as the kernel needs */
+        memset(amps, 0, sizeof(amps));
+        memset(speeds, 0, sizeof(speeds));
+        memset(phases, 0, sizeof(phases));
+        for(int i=0; i<h->n_constituents; i++) harmonic_constituent(h, h->base_year, i, &speeds[i], &amps[i], &phases[i]);
+        int n = TIDE_KERNEL_PAD(h->n_constituents);
+        for(int k=0; k<N_TIMES; k++) {
+            float level[2], rate[2], accel[2];
+            level[0] = tide_kernel_level(amps, speeds, phases, n, times[k]);
+            level[1] = tide_kernel_level_reference(amps, speeds, phases, n, times[k]);
+            if(memcmp(&level[0], &level[1], sizeof(float))!=0) failures++;
+            tide_kernel_derivatives(amps, speeds, phases, n, times[k], &level[0], &rate[0], &accel[0]);
+            tide_kernel_derivatives_reference(amps, speeds, phases, n, times[k], &level[1], &rate[1], &accel[1]);
+            if(memcmp(&level[0], &level[1], sizeof(float))!=0 || memcmp(&rate[0], &rate[1], sizeof(float))!=0 || 
+               memcmp(&accel[0], &accel[1], sizeof(float))!=0) failures++;
+        }
+        /* levels alone, and then with the derivatives */
+        for(int derivatives=0; derivatives<2; derivatives++) {
+            memset(acc, 0, sizeof(acc));
+            for(int c=0; c<n; c+=TIDE_KERNEL_LANES) {
+                tide_kernel_accumulate(amps+c, speeds+c, phases+c, times, N_TIMES, acc[0][0], derivatives ? acc[0][1] : NULL, derivatives ? acc[0][2] : NULL);
+                tide_kernel_accumulate_reference(amps+c, speeds+c, phases+c, times, N_TIMES, acc[1][0], derivatives ? acc[1][1] : NULL, derivatives ? acc[1][2] : NULL);
+            }
+            if(memcmp(acc[0], acc[1], sizeof(acc[0]))!=0) failures++;
+        }
+        n_stations++;
+    }
+    printf("Kernel: %s, %d stations, %d times, %d failed\n", tide_kernel_name(), n_stations, N_TIMES, failures);
+    return failures;
+}
+
+/* Check the nearest stations found by a tree against a search of every point,
+for the compiled-in stations and for a tree of random points built here.
+Returns the number of failures. */
+int test_spatial_index(void)
+{
+    enum { N_RANDOM = 2000, K = 5, QUERIES = 500 };
+    static tide_spatial_point random_points[N_RANDOM];
+    static float distances[N_RANDOM];
+    const tide_spatial_point *trees[2] = {tidal_station_points, random_points};
+    uint32_t sizes[2] = {n_tidal_station_points, N_RANDOM};
+    int failures = 0;
+    srand(1);
+    for(uint32_t i=0; i<N_RANDOM; i++)
+        tide_spatial_point_init(&random_points[i], asinf(2.0f * rand() / RAND_MAX - 1.0f) * 180.0f / (float)M_PI, 360.0f * rand() / RAND_MAX - 180.0f, i);
+    tide_spatial_build(random_points, N_RANDOM);
+    for(int tree=0; tree<2; tree++) {
+        for(int q=0; q<QUERIES; q++) {
+            /* around the stations for the first tree, anywhere for the second */
+            float lat = (tree==0) ? 50.0f + 8.0f * rand() / RAND_MAX : 180.0f * rand() / RAND_MAX - 90.0f;
+            float lon = (tree==0) ? -8.0f + 10.0f * rand() / RAND_MAX : 360.0f * rand() / RAND_MAX - 180.0f;
+            float max_km = (q % 2) ? 200.0f : 0.0f;
+            uint32_t stations[K];
+            float km[K];
+            uint32_t found = tide_spatial_nearest(trees[tree], sizes[tree], lat, lon, max_km, K, stations, km);
+            /* the i-th found must be the i-th nearest of all the points, give or take 10m */
+            uint32_t within = 0;
+            for(uint32_t i=0; i<sizes[tree]; i++) {
+                uint32_t one;
+                tide_spatial_point point = trees[tree][i];
+                point.station = 0;
+                tide_spatial_nearest(&point, 1, lat, lon, 0.0f, 1, &one, &distances[i]);
+                if(max_km<=0 || distances[i]<=max_km) within++;
+            }
+            for(uint32_t i=0; i<found; i++) {
+                uint32_t nearer = 0, near = 0;
+                for(uint32_t j=0; j<sizes[tree]; j++) {
+                    nearer += distances[j]<km[i] - 0.01f;
+                    near += distances[j]<=km[i] + 0.01f;
+                }
+                if(nearer>i || near<i + 1) failures++;
+            }
+            if(found!=(within<K ? within : K)) failures++;
+            for(uint32_t i=1; i<found; i++) if(km[i]<km[i-1]) failures++;
+        }
+    }
+    printf("Spatial index: %u stations, %d random points, %d failed\n", n_tidal_station_points, N_RANDOM, failures);
+    return failures;
+}
+
+/* Export three days of every station, as binary and as CSV, and check the 
+binary against predictions made here, and the CSV's length against it. 
+Returns the number of failures. */
+int test_export(void)
+{
+    char path[] = "/tmp/tide_exportXXXXXX";
+    time_t start = make_time(tidal_stations->harmonic->base_year, 3, 1, 0, 0, 0), end = start + 3 * DAY_SECONDS;
+    int32_t step = 30 * MINUTE_SECONDS;
+    tidal_station **stations = malloc(n_tidal_stations * sizeof(tidal_station *));
+    tide_export_header header;
+    uint8_t *data = NULL;
+    long size = 0;
+    int failures = 0, fd = mkstemp(path);
+    FILE *f;
+    float worst = 0.0f;
+    uint64_t lines = 0;
+
+    for(uint32_t i=0; i<n_tidal_stations; i++) stations[i] = tidal_station_index[i];
+    if(fd<0 || tide_export(path, TIDE_EXPORT_BINARY, stations, n_tidal_stations, start, end, step, 2)!=0 || !(f = fopen(path, "rb"))) {
+        printf("Export: can't write %s\n", path);
+        free(stations);
+        return 1;
+    }
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    rewind(f);
+    data = malloc(size + 1);
+    if(fread(data, 1, size, f)!=(size_t)size || size<(long)sizeof(header)) failures++;
+    fclose(f);
+    memcpy(&header, data, sizeof(header));
+    if(failures || memcmp(header.magic, TIDE_EXPORT_MAGIC, 4)!=0 || header.size!=(uint64_t)size || header.n_stations!=n_tidal_stations 
+       || header.n_samples!=(uint32_t)((end - start) / step)) {
+        printf("Export: bad header\n");
+        failures++;
+    } else {
+        const tide_export_station_record *directory = (const tide_export_station_record *)(data + header.stations);
+        const int64_t *times = (const int64_t *)(data + header.times);
+        const float *levels = (const float *)(data + header.levels);
+        const tide_export_event_record *events = (const tide_export_event_record *)(data + header.events);
+        for(uint32_t i=0; i<header.n_stations; i++) {
+            prepared_station prepared = {0};
+            const char *name = (const char *)data + header.strings + directory[i].name;
+            if(strcmp(name, stations[i]->name)!=0) failures++;
+            prepare_station(&prepared, stations[i], start);
+            for(uint32_t j=0; j<header.n_samples; j++) {
+                float error = fabsf(levels[(size_t)i * header.n_samples + j] - predict_tide(times[j], &prepared, 0));
+                if(times[j]!=start + (time_t)j * step) failures++;
+                if(error>worst) worst = error;
+            }
+            /* each event must be one find_tide_events finds around it */
+            for(uint32_t j=0; j<directory[i].n_events; j++) {
+                const tide_export_event_record *record = &events[directory[i].first_event + j];
+                tidal_event near[MAX_TIDE_EVENTS];
+                int found = 0;
+                find_tide_events(&prepared, record->time - 2 * HOUR_SECONDS, record->time + 2 * HOUR_SECONDS, near);
+                for(int k=0; k<MAX_TIDE_EVENTS; k++) 
+                    found |= near[k].type==record->type && fabs(difftime(near[k].time, record->time))<=MINUTE_SECONDS;
+                if(!found || record->time<start || record->time>=end || (j>0 && record[-1].time>=record->time)) failures++;
+            }
+            /* a day has at least one HW and one LW */
+            if(directory[i].n_events<6) failures++;
+        }
+        if(worst>0.01f) failures++;
+    }
+    /* one row for every sample and every event, and the heading */
+    if(tide_export(path, TIDE_EXPORT_CSV, stations, n_tidal_stations, start, end, step, 2)!=0 || !(f = fopen(path, "r"))) {
+        failures++;
+    } else {
+        for(int c; (c = fgetc(f))!=EOF; ) lines += c=='\n';
+        fclose(f);
+        if(lines!=1 + (uint64_t)header.n_stations * header.n_samples + header.n_events) failures++;
+    }
+    unlink(path);
+    close(fd);
+    free(data);
+    free(stations);
+    printf("Export: %u stations, %llu events, at most %.4fm from predict_tide, %d failed\n", n_tidal_stations, 
+        (unsigned long long)header.n_events, worst, failures);
+    return failures;
+}
+
+/* Check every harmonic station's predictions against its test levels, 
+and its packed tide tables against float ones. Returns the number of failures. */
+int test_all_tides()
+{
+    int failures = 0, table_failures = 0, nodal_failures = 0, n_nodal = 0;
+    float worst_prediction = 0.0f, worst_nodal = 0.0f;
+    const tide_nodal_table *nodal = NULL;
+    for(tidal_station *station = tidal_stations; station!=NULL; station = station->previous)
+    {
+        /* Each harmonic may be shared by several stations; only test it once */
+        tidal_station *first = tidal_stations;
+        while(first->harmonic!=station->harmonic) first = first->previous;
+        if(first==station) failures += test_tides(station->harmonic);
+        /* The shipped stations are per-year; check the nodal encoding with them too */
+        if(first==station && station->harmonic->type==TIDE_ENCODING_HARMONIC && station->harmonic->n_years>0) {
+            nodal_failures += test_nodal_form(station, &worst_nodal);
+            n_nodal++;
+        }
+        /* All the nodal stations normally share one table */
+        if(station->harmonic->type==TIDE_ENCODING_NODAL && station->harmonic->nodal!=nodal) {
+            nodal = station->harmonic->nodal;
+            failures += test_astro_arguments(nodal);
+        }
+        /* A table a month for a year */
+        for(int month=1; month<=12; month++)
+            table_failures += test_tide_table(station, make_time(station->harmonic->base_year, month, 15, 12, 0, 0), &worst_prediction);
+    }
+    printf("Tide tables: %zu bytes for %d days, %zu as floats; %d failed\n", sizeof(tide_table), TIDE_TABLE_DAYS, 
+        offsetof(tide_table, levels) + 2 * (TIDE_TABLE_TIMES + 1) * sizeof(float) + TIDE_TABLE_DAYS * MAX_TIDE_EVENTS * sizeof(tidal_event), table_failures);
+    printf("Tide tables: %d hour steps, at most %.4fm from predict_tide\n", TIDE_TABLE_STEP_HOURS, worst_prediction);
+    printf("Nodal form: %d stations, at most %.4fm from the per-year form; %d failed\n", n_nodal, worst_nodal, nodal_failures);
+    return failures + table_failures + nodal_failures + test_astro_reference() + test_kernel() + test_station_index() + test_spatial_index() + test_export();
+}
+
+/* Print the counters and the trace kept by a TIDE_STATS build, oldest record first */
+void print_tide_stats(void)
+{
+#ifdef TIDE_STATS
+    static const char *kinds[] = {"?", "prepare", "table full", "table shift", "event", "unconverged", "rejected"};
+    char datetime[TIME_STRING_LENGTH];
+    tide_stats *stats = &tide_stats_counters;
+    uint32_t first = (tide_trace_count>TIDE_TRACE_SIZE) ? tide_trace_count - TIDE_TRACE_SIZE : 0;
+    printf("predict_tide calls: %u (d=0), %u (d=1), %u (d=2), %u (higher)\n", 
+        stats->predictions[0], stats->predictions[1], stats->predictions[2], stats->predictions[3]);
+    printf("predict_tide_derivatives calls: %u\n", stats->fused_predictions);
+    printf("Constants prepared: %u\n", stats->prepares);
+    printf("Events found: %u, search steps: %u, Newton steps: %u, unconverged: %u\n", 
+        stats->events_found, stats->search_steps, stats->newton_steps, stats->unconverged);
+    printf("Events rejected: %u duplicate, %u overflowed\n", stats->duplicate_events, stats->overflowed_events);
+    printf("Tables: %u full rebuilds, %u incremental\n", stats->full_rebuilds, stats->incremental_rebuilds);
+    printf("\nLast %u trace records\n", tide_trace_count - first);
+    for(uint32_t i=first; i<tide_trace_count; i++) {
+        tide_trace_record *record = &tide_trace_records[i % TIDE_TRACE_SIZE];
+        printf("%6u %-12s %s %d\n", record->sequence, kinds[record->kind<=TIDE_TRACE_REJECTED ? record->kind : 0], 
+            format_time(record->t, datetime), record->value);
+    }
+#else
+    printf("Built without TIDE_STATS; rebuild with make DEFS=-DTIDE_STATS\n");
+#endif
+}
+
+/* Seconds on a monotonic clock */
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Time the float and fixed-point predictors on every harmonic station,
+for level, rate and acceleration at n times through the current year */
+void bench_fixed(int n)
+{
+    time_t t0 = time(NULL);
+    volatile float sink_f = 0.0f;
+    volatile int32_t sink_i = 0;
+    for(tidal_station *station = tidal_stations; station!=NULL; station = station->previous)
+    {
+        tidal_station *first = tidal_stations;
+        while(first->harmonic!=station->harmonic) first = first->previous;
+        if(first!=station || station->harmonic->type==TIDE_ENCODING_CHEBYSHEV) continue;
+        prepared_station prepared = {0};
+        fixed_station fixed = {0};
+        float level, rate, accel;
+        int32_t level_mm, rate_mm_h, accel_mm_h2;
+        int n_constituents = station->harmonic->n_constituents;
+        double start, float_time, fixed_time;
+        prepared.station = station;
+        fixed.station = station;
+        
+        start = now_seconds();
+        for(int i=0; i<n; i++) {
+            predict_tide_derivatives(t0 + (time_t)i * 97, &prepared, &level, &rate, &accel);
+            sink_f += level + rate + accel;
+        }
+        float_time = now_seconds() - start;
+        start = now_seconds();
+        for(int i=0; i<n; i++) {
+            predict_tide_fixed(t0 + (time_t)i * 97, &fixed, &level_mm, &rate_mm_h, &accel_mm_h2);
+            sink_i += level_mm + rate_mm_h + accel_mm_h2;
+        }
+        fixed_time = now_seconds() - start;
+        /* See tide_fixed.c for the operation counts */
+        printf("%s (%d constituents)\n", station->harmonic->name, n_constituents);
+        printf("    float: %7.1fns per prediction\n", float_time / n * 1e9);
+        printf("    fixed: %7.1fns per prediction, %d multiplies (%d of them 64 bit) and %d table lookups\n", 
+            fixed_time / n * 1e9, 7 * n_constituents, 2 * n_constituents, 2 * n_constituents);
+    }
+}
+
+/* Tide tables for every station, for a run of days */
+typedef struct table_job {
+    tidal_station **stations;
+    int days;
+    time_t start;
+    tide_table *tables; /* [station][day], in the order they are printed */
+} table_job;
+
+/* Build the table for one station and day; each task has its own
+prepared station, so tasks can run on any thread */
+void build_table_task(void *context, int task)
+{
+    table_job *job = context;
+    prepared_station prepared = {0};
+    tide_table *table = &job->tables[task];
+    table->station = NULL;
+    table->base_time = 0;
+    populate_tide_table(table, &prepared, job->stations[task / job->days], job->start + (time_t)(task % job->days) * DAY_SECONDS, 0, 0);
+}
+
+/* Build the tide tables for all stations, for days days from start, 
+across threads threads, and then print them in station order */
+void print_all_tables(time_t start, int days, int threads)
+{
+    table_job job;
+    int n_stations = 0;
+    for(tidal_station *station = tidal_stations; station!=NULL; station = station->previous) n_stations++;
+    job.stations = malloc(n_stations * sizeof(tidal_station *));
+    job.tables = malloc((size_t)n_stations * days * sizeof(tide_table));
+    job.days = days;
+    job.start = start;
+    n_stations = 0;
+    for(tidal_station *station = tidal_stations; station!=NULL; station = station->previous) job.stations[n_stations++] = station;
+    
+    tide_pool_run(n_stations * days, threads, build_table_task, &job);
+    
     printf("Tide tables\n");
-    while(station!=NULL)
-    {        
-        populate_tide_table(&table, station, make_time(2023, 12, 17, 0, 0, 0), 0, 0);
-        print_tide_table(&table);
-        station = station->previous;
+    for(int i=0; i<n_stations*days; i++)
+    {
+        print_tide_table(&job.tables[i], job.tables[i].base_time);
         printf("\n\n");
     }
+    free(job.tables);
+    free(job.stations);
 }
 
+/* List the stations in a database, or print a table for one of them */
+int print_db_station(const char *path, const char *name, time_t now)
+{
+    tide_db db;
+    tide_db_view view;
+    int i;
+    if(tide_db_open(&db, path)!=0) {
+        printf("Can't read database %s\n", path);
+        return 1;
+    }
+    if(!name) {
+        printf("%u stations in %s:\n", tide_db_count(&db), path);
+        for(uint32_t j=0; j<tide_db_count(&db); j++) {
+            if(tide_db_station(&db, j, &view)!=0) {
+                printf("%45s\t(damaged)\n", tide_db_name(&db, j) ? tide_db_name(&db, j) : "?");
+                continue;
+            }
+            printf("%45s\t(%d-%d)\n", view.station.name, view.harmonic.base_year, view.harmonic.base_year + view.harmonic.n_years);
+        }
+        tide_db_close(&db);
+        return 0;
+    }
+    i = tide_db_find(&db, name);
+    if(i<0 || tide_db_station(&db, i, &view)!=0) {
+        printf("Station %s not found\n", name);
+        tide_db_close(&db);
+        return 1;
+    }
+    tide_table table;
+    prepared_station prepared = {0};
+    table.station = NULL;
+    table.base_time = 0;
+    populate_tide_table(&table, &prepared, &view.station, now, 0, 0);
+    print_tide_table(&table, now);
+    tide_db_close(&db);
+    return 0;
+}
 
+/* Export levels and events for the stations matching the prefixes given (or 
+all of them), from the compiled-in stations or a database. The arguments are
+    <file> <start YYYY-MM-DD> <days> <step minutes> [-j<threads>] [--db=<database>] [station prefix...]
+The file is CSV if its name ends in .csv, and tide_export's binary format otherwise. */
+int export_tides(int argc, char **argv)
+{
+    int year, month, day, days, step, threads = tide_pool_default_threads(), result = 1;
+    const char *db_path = NULL;
+    size_t length;
+    int format;
+    tide_db db;
+    tide_db_view *views = NULL;
+    tidal_station **stations = NULL;
+    uint8_t *chosen = NULL;
+    uint32_t total, n = 0, first, prefixes = 0;
+    double start_seconds;
+
+    if(argc<4 || sscanf(argv[1], "%d-%d-%d", &year, &month, &day)!=3 || (days = atoi(argv[2]))<=0 || (step = atoi(argv[3]) * MINUTE_SECONDS)<=0) {
+        printf("Usage: --export <file> <start YYYY-MM-DD> <days> <step minutes> [-j<threads>] [--db=<database>] [station prefix...]\n");
+        return 1;
+    }
+    length = strlen(argv[0]);
+    format = (length>4 && strcmp(argv[0] + length - 4, ".csv")==0) ? TIDE_EXPORT_CSV : TIDE_EXPORT_BINARY;
+    for(int i=4; i<argc; i++) {
+        if(strncmp(argv[i], "-j", 2)==0) threads = atoi(argv[i] + 2);
+        else if(strncmp(argv[i], "--db=", 5)==0) db_path = argv[i] + 5;
+        else prefixes++;
+    }
+    if(db_path && tide_db_open(&db, db_path)!=0) {
+        printf("Can't read database %s\n", db_path);
+        return 1;
+    }
+    total = db_path ? tide_db_count(&db) : n_tidal_stations;
+    /* in name order, once each, however many prefixes match them */
+    chosen = calloc(total ? total : 1, 1);
+    stations = malloc((total ? total : 1) * sizeof(tidal_station *));
+    views = db_path ? malloc((total ? total : 1) * sizeof(tide_db_view)) : NULL;
+    if(!chosen || !stations || (db_path && !views)) goto done;
+    if(prefixes==0) memset(chosen, 1, total);
+    for(int i=4; i<argc; i++) {
+        uint32_t matches;
+        if(strncmp(argv[i], "-j", 2)==0 || strncmp(argv[i], "--db=", 5)==0) continue;
+        matches = db_path ? tide_db_find_range(&db, argv[i], &first) : find_tidal_stations(argv[i], &first);
+        if(matches==0) {
+            printf("No stations match %s\n", argv[i]);
+            goto done;
+        }
+        memset(chosen + first, 1, matches);
+    }
+    for(uint32_t i=0; i<total; i++) {
+        if(!chosen[i]) continue;
+        if(!db_path) {
+            stations[n++] = tidal_station_index[i];
+        } else if(tide_db_station(&db, i, &views[n])==0) {
+            stations[n] = &views[n].station;
+            n++;
+        } else {
+            printf("Station %s is damaged; skipped\n", tide_db_name(&db, i) ? tide_db_name(&db, i) : "?");
+        }
+    }
+
+    start_seconds = now_seconds();
+    time_t start = make_time(year, month, day, 0, 0, 0);
+    if(tide_export(argv[0], format, stations, n, start, start + (time_t)days * DAY_SECONDS, step, threads>0 ? threads : 1)!=0) {
+        printf("Can't write %s\n", argv[0]);
+        goto done;
+    }
+    printf("Exported %u stations, %d days every %d minutes, to %s in %.2fs\n", n, days, step / MINUTE_SECONDS, argv[0], now_seconds() - start_seconds);
+    result = 0;
+done:
+    free(views);
+    free(stations);
+    free(chosen);
+    if(db_path) tide_db_close(&db);
+    return result;
+}
 
 int main(int argc, char **argv) {
     time_t now;
     tidal_station *station; 
-    //test_tides(&station_millport_scotland_2023, station_millport_scotland_2023_test_times, station_millport_scotland_2023_test_tides);
     if(argc<2) {
         /* Dump the names of all known stations */
-        printf("Usage: %s <station name>\n\n", argv[0]);        
+        printf("Usage: %s <station name> [step minutes]\n", argv[0]);
+        printf("       %s --test\n", argv[0]);
+        printf("       %s --all [days] [threads]\n", argv[0]);        
+        printf("       %s --bench-fixed [predictions]\n", argv[0]);
+        printf("       %s --stats <station name>\n", argv[0]);
+        printf("       %s --db <database> [station name]\n", argv[0]);
+        printf("       %s --near <lat> <lon> [stations] [km]\n", argv[0]);
+        printf("       %s --export <file[.csv]> <start YYYY-MM-DD> <days> <step minutes> [-j<threads>] [--db=<database>] [station prefix...]\n\n", argv[0]);
         printf("Known stations:\n");
-        tidal_station *station = tidal_stations;
-        while(station!=NULL) {
+        for(uint32_t i=0; i<n_tidal_stations; i++) {
+            tidal_station *station = tidal_station_index[i];
             printf("%45s\t(%d-%d)\n", station->name, station->harmonic->base_year, station->harmonic->base_year + station->harmonic->n_years);
-            station = station->previous;
         }
         return 1;
     }
     
+    if(strcmp(argv[1], "--test")==0) 
+        return test_all_tides() ? 1 : 0;
+
+    if(strcmp(argv[1], "--export")==0)
+        return export_tides(argc - 2, argv + 2);
+
+    if(strcmp(argv[1], "--bench-fixed")==0) {
+        int n = (argc>2) ? atoi(argv[2]) : 100000;
+        bench_fixed(n>0 ? n : 100000);
+        return 0;
+    }
+
     /* Get current time */
     now = time(NULL);
+
+    if(strcmp(argv[1], "--near")==0) {
+        tidal_station *nearest[MAX_NEAREST_STATIONS];
+        float km[MAX_NEAREST_STATIONS];
+        if(argc<4) {
+            printf("No position given\n");
+            return 1;
+        }
+        int k = (argc>4) ? atoi(argv[4]) : 1;
+        uint32_t found = find_nearest_stations(atof(argv[2]), atof(argv[3]), (argc>5) ? atof(argv[5]) : 0.0f, k>0 ? k : 1, nearest, km);
+        for(uint32_t i=0; i<found; i++)
+            printf("%45s\t%8.1fkm\n", nearest[i]->name, km[i]);
+        return found ? 0 : 1;
+    }
+
+    if(strcmp(argv[1], "--db")==0) {
+        if(argc<3) {
+            printf("No database given\n");
+            return 1;
+        }
+        return print_db_station(argv[2], (argc>3) ? argv[3] : NULL, now);
+    }
+
+    if(strcmp(argv[1], "--all")==0) {
+        int days = (argc>2) ? atoi(argv[2]) : 1;
+        int threads = (argc>3) ? atoi(argv[3]) : tide_pool_default_threads();
+        if(days<=0) days = 1;
+        print_all_tables(now, days, threads);
+        return 0;
+    }
+    
     
+    /* Build a table for a day, move it forward a day, and show the work that took */
+    if(strcmp(argv[1], "--stats")==0) {
+        station = (argc>2) ? find_tidal_station(argv[2]) : tidal_stations;
+        if(!station) {
+            printf("Station %s not found\n", argv[2]);
+            return 1;
+        }
+        tide_table table = {0};
+        prepared_station prepared = {0};
+        populate_tide_table(&table, &prepared, station, now, 0, 0);
+        populate_tide_table(&table, &prepared, station, now + DAY_SECONDS, 0, 0);
+        print_tide_stats();
+        return 0;
+    }
     
     /* Find the station */
     station = find_tidal_station(argv[1]);
@@ -122,11 +783,22 @@ int main(int argc, char **argv) {
         printf("Station %s not found\n", argv[1]);
         return 1;
     }
+    /* With a step, print a day of levels at that spacing instead of the table */
+    if(argc>2) {
+        int step = atoi(argv[2]) * MINUTE_SECONDS;
+        if(step<=0) {
+            printf("Invalid step %s\n", argv[2]);
+            return 1;
+        }
+        print_tide_levels(station, now, step, DAY_SECONDS / step);
+        return 0;
+    }
     tide_table table;
-    table.station = station;
+    prepared_station prepared = {0};
+    table.station = NULL;
     table.base_time = 0;
-    populate_tide_table(&table, station, now, 0, 0);
-    print_tide_table(&table);
+    populate_tide_table(&table, &prepared, station, now, 0, 0);
+    print_tide_table(&table, now);
     return 0;
 }        
 
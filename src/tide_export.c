@@ -0,0 +1,309 @@
+#define _XOPEN_SOURCE 700 /* for pwrite */
+#include "tide_export.h"
+#include "tide_calendar.h"
+#include "tide_pool.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Events are searched for in windows this long, short enough that no
+window holds more than MAX_TIDE_EVENTS. Each search reaches a margin past
+both ends, since an event right at the start of a search can be missed. */
+#define EVENT_WINDOW_SECONDS (6 * HOUR_SECONDS)
+#define EVENT_MARGIN_SECONDS HOUR_SECONDS
+
+#define EXPORT_BUFFER_SIZE (1 << 16)
+/* Most memory the predictions of a batch of stations may take */
+#define EXPORT_BATCH_BYTES (64u << 20)
+/* Longest CSV row */
+#define EXPORT_ROW_LENGTH 256
+
+/* Find the HW/LW events in [t0, t1), however long that is, in order.
+Fills in up to max_events events and returns how many there were. */
+int find_tide_events_range(prepared_station *p, time_t t0, time_t t1, tidal_event *events, int max_events)
+{
+    tidal_event window[MAX_TIDE_EVENTS];
+    int n = 0;
+    for(time_t t=t0; t<t1 && n<max_events; t+=EVENT_WINDOW_SECONDS) {
+        time_t end = (t1 - t<EVENT_WINDOW_SECONDS) ? t1 : t + EVENT_WINDOW_SECONDS;
+        find_tide_events(p, t - EVENT_MARGIN_SECONDS, end + EVENT_MARGIN_SECONDS, window);
+        for(int i=0; i<MAX_TIDE_EVENTS && n<max_events; i++) {
+            if(window[i].type==TIDE_NONE || window[i].time<t || window[i].time>=end) continue;
+            events[n++] = window[i];
+        }
+    }
+    return n;
+}
+
+/* Writes through a fixed buffer to a place in a file, so that several can
+fill different parts of one file in step */
+typedef struct export_writer {
+    int fd;
+    uint64_t offset; /* in the file, of the start of the buffer */
+    size_t used;
+    int failed;
+    char buffer[EXPORT_BUFFER_SIZE];
+} export_writer;
+
+static void writer_init(export_writer *w, int fd, uint64_t offset)
+{
+    w->fd = fd;
+    w->offset = offset;
+    w->used = 0;
+    w->failed = 0;
+}
+
+static void writer_flush(export_writer *w)
+{
+    size_t done = 0;
+    while(done<w->used && !w->failed) {
+        ssize_t n = pwrite(w->fd, w->buffer + done, w->used - done, (off_t)(w->offset + done));
+        if(n<=0) w->failed = 1;
+        else done += n;
+    }
+    w->offset += w->used;
+    w->used = 0;
+}
+
+static void writer_put(export_writer *w, const void *data, size_t size)
+{
+    const char *bytes = data;
+    while(size>0) {
+        size_t n = EXPORT_BUFFER_SIZE - w->used;
+        if(n>size) n = size;
+        memcpy(w->buffer + w->used, bytes, n);
+        w->used += n;
+        bytes += n;
+        size -= n;
+        if(w->used==EXPORT_BUFFER_SIZE) writer_flush(w);
+    }
+}
+
+/* Room for a row of at most EXPORT_ROW_LENGTH characters, to be committed with writer_commit */
+static char *writer_row(export_writer *w)
+{
+    if(EXPORT_BUFFER_SIZE - w->used<EXPORT_ROW_LENGTH) writer_flush(w);
+    return w->buffer + w->used;
+}
+
+static void writer_commit(export_writer *w, int length)
+{
+    /* a longer row was cut short */
+    if(length>0) w->used += (length<EXPORT_ROW_LENGTH) ? length : EXPORT_ROW_LENGTH - 1;
+}
+
+static uint64_t align_offset(uint64_t offset)
+{
+    return (offset + TIDE_EXPORT_ALIGN - 1) & ~(uint64_t)(TIDE_EXPORT_ALIGN - 1);
+}
+
+/* The predictions for one station of a batch */
+typedef struct export_prediction {
+    float *levels; /* n_samples */
+    tidal_event *events; /* max_events */
+    int n_events;
+} export_prediction;
+
+typedef struct export_job {
+    tidal_station **stations; /* of this batch */
+    time_t start, end;
+    int32_t step;
+    uint32_t n_samples;
+    int max_events;
+    export_prediction *predictions;
+} export_job;
+
+/* Predict one station of the batch; each task has its own prepared station,
+so tasks can run on any thread */
+static void export_task(void *context, int task)
+{
+    export_job *job = context;
+    export_prediction *prediction = &job->predictions[task];
+    prepared_station prepared = {0};
+    time_t times[TIDE_BATCH_BLOCK];
+    prepare_station(&prepared, job->stations[task], job->start);
+    /* predict_tide_batch rather than an iterator, as its levels don't drift 
+    from predict_tide's over a long span */
+    for(uint32_t i=0; i<job->n_samples; i+=TIDE_BATCH_BLOCK) {
+        uint32_t n = (job->n_samples - i<TIDE_BATCH_BLOCK) ? job->n_samples - i : TIDE_BATCH_BLOCK;
+        for(uint32_t j=0; j<n; j++) times[j] = job->start + (time_t)(i + j) * job->step;
+        predict_tide_batch(&prepared, times, (int)n, prediction->levels + i, NULL, NULL);
+    }
+    prediction->n_events = find_tide_events_range(&prepared, job->start, job->end, prediction->events, job->max_events);
+}
+
+/* Write t as "2026-10-17T04:47:48Z" into buf, which must hold at least 21 characters */
+static int format_iso_time(time_t t, char *buf)
+{
+    int32_t days = days_from_time(t), year;
+    int32_t seconds = t - (time_t)days * DAY_SECONDS;
+    uint32_t month, day;
+    civil_from_days(days, &year, &month, &day);
+    return sprintf(buf, "%04d-%02u-%02uT%02d:%02d:%02dZ", (int)year, (unsigned)month, (unsigned)day,
+                   (int)(seconds / HOUR_SECONDS), (int)(seconds / MINUTE_SECONDS % 60), (int)(seconds % 60));
+}
+
+/* The name as a CSV field, quoted if it needs to be, into buf of size bytes */
+static void csv_field(const char *name, char *buf, size_t size)
+{
+    size_t n = 0;
+    if(!strpbrk(name, ",\"\n")) {
+        snprintf(buf, size, "%s", name);
+        return;
+    }
+    buf[n++] = '"';
+    for(; *name && n + 3<size; name++) {
+        if(*name=='"') buf[n++] = '"';
+        buf[n++] = *name;
+    }
+    buf[n++] = '"';
+    buf[n] = '\0';
+}
+
+/* Write a station's samples and events as CSV rows, merged in time order */
+static void write_csv_station(export_writer *w, const char *name, export_job *job, export_prediction *prediction)
+{
+    char field[EXPORT_ROW_LENGTH / 2], when[32];
+    uint32_t i = 0;
+    int e = 0;
+    csv_field(name, field, sizeof(field));
+    while(i<job->n_samples || e<prediction->n_events) {
+        time_t t = job->start + (time_t)i * job->step;
+        char *row = writer_row(w);
+        if(i<job->n_samples && (e>=prediction->n_events || t<=prediction->events[e].time)) {
+            format_iso_time(t, when);
+            writer_commit(w, snprintf(row, EXPORT_ROW_LENGTH, "%s,%s,%.3f,,\n", field, when, prediction->levels[i]));
+            i++;
+        } else {
+            tidal_event *event = &prediction->events[e++];
+            format_iso_time(event->time, when);
+            writer_commit(w, snprintf(row, EXPORT_ROW_LENGTH, "%s,%s,%.3f,%s,%.2f\n", field, when, event->level,
+                                      (event->type==TIDE_HIGH) ? "HW" : "LW", event->neap_spring));
+        }
+    }
+}
+
+/* Write a station's level column and its events */
+static void write_binary_station(export_writer *levels, export_writer *events, export_job *job, export_prediction *prediction)
+{
+    writer_put(levels, prediction->levels, (size_t)job->n_samples * sizeof(float));
+    for(int i=0; i<prediction->n_events; i++) {
+        tidal_event *event = &prediction->events[i];
+        tide_export_event_record record = {.time = event->time, .level = event->level, .type = event->type,
+                                           .neap_spring = (uint8_t)(event->neap_spring * 255.0f + 0.5f)};
+        writer_put(events, &record, sizeof(record));
+    }
+}
+
+/* Export the levels every step seconds from start up to end, and the events
+in [start, end), for each of n_stations stations, to path in format
+(TIDE_EXPORT_BINARY or TIDE_EXPORT_CSV), predicting across threads threads.
+Returns 0, or -1 if the file could not be written. */
+int tide_export(const char *path, int format, tidal_station **stations, uint32_t n_stations,
+                time_t start, time_t end, int32_t step, int threads)
+{
+    tide_export_header header = {.magic = TIDE_EXPORT_MAGIC, .version = TIDE_EXPORT_VERSION, .n_stations = n_stations,
+                                 .step = step, .start = start, .end = end};
+    export_job job = {.start = start, .end = end, .step = step};
+    tide_export_station_record *directory = NULL;
+    export_writer *writers = NULL; /* the levels (or the CSV), the events and the rest */
+    size_t events_size, levels_size;
+    uint32_t batch;
+    char *memory = NULL;
+    int fd, failed = 0;
+
+    if(step<=0 || end<=start) return -1;
+    job.n_samples = (uint32_t)((end - start + step - 1) / step);
+    /* there are never more than a few an hour */
+    job.max_events = (int)((end - start) / HOUR_SECONDS) + 8;
+    events_size = (size_t)job.max_events * sizeof(tidal_event);
+    levels_size = align_offset((uint64_t)job.n_samples * sizeof(float));
+    batch = (events_size + levels_size<EXPORT_BATCH_BYTES) ? EXPORT_BATCH_BYTES / (events_size + levels_size) : 1;
+    if(batch>n_stations) batch = n_stations ? n_stations : 1;
+
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd<0) return -1;
+    writers = calloc(3, sizeof(export_writer));
+    directory = calloc(n_stations ? n_stations : 1, sizeof(*directory));
+    job.predictions = malloc(batch * sizeof(export_prediction));
+    memory = malloc(batch * (events_size + levels_size));
+    if(!writers || !directory || !job.predictions || !memory) {
+        failed = 1;
+        goto done;
+    }
+    for(uint32_t i=0; i<batch; i++) {
+        job.predictions[i].events = (tidal_event *)(memory + i * (events_size + levels_size));
+        job.predictions[i].levels = (float *)(memory + i * (events_size + levels_size) + events_size);
+    }
+
+    if(format==TIDE_EXPORT_CSV) {
+        writer_init(&writers[0], fd, 0);
+        writer_put(&writers[0], "station,time,level,event,neap_spring\n", 37);
+    } else {
+        /* everything but the events has a known size, so they go last */
+        uint64_t strings_size = 0;
+        header.n_samples = job.n_samples;
+        header.stations = align_offset(sizeof(header));
+        header.strings = align_offset(header.stations + (uint64_t)n_stations * sizeof(*directory));
+        writer_init(&writers[2], fd, header.strings);
+        for(uint32_t i=0; i<n_stations; i++) {
+            directory[i].name = (uint32_t)strings_size;
+            strings_size += strlen(stations[i]->name) + 1;
+            writer_put(&writers[2], stations[i]->name, strlen(stations[i]->name) + 1);
+        }
+        header.times = align_offset(header.strings + strings_size);
+        writer_flush(&writers[2]);
+        writers[2].offset = header.times;
+        for(uint32_t i=0; i<job.n_samples; i++) {
+            int64_t t = start + (int64_t)i * step;
+            writer_put(&writers[2], &t, sizeof(t));
+        }
+        writer_flush(&writers[2]);
+        failed |= writers[2].failed;
+        header.levels = header.times + (uint64_t)job.n_samples * sizeof(int64_t);
+        header.events = align_offset(header.levels + (uint64_t)n_stations * job.n_samples * sizeof(float));
+        writer_init(&writers[0], fd, header.levels);
+        writer_init(&writers[1], fd, header.events);
+    }
+
+    for(uint32_t first=0; first<n_stations && !failed; first+=batch) {
+        uint32_t n = (n_stations - first<batch) ? n_stations - first : batch;
+        job.stations = stations + first;
+        tide_pool_run((int)n, threads, export_task, &job);
+        for(uint32_t i=0; i<n; i++) {
+            if(format==TIDE_EXPORT_CSV) {
+                write_csv_station(&writers[0], stations[first + i]->name, &job, &job.predictions[i]);
+                continue;
+            }
+            directory[first + i].first_event = header.n_events;
+            directory[first + i].n_events = (uint32_t)job.predictions[i].n_events;
+            header.n_events += job.predictions[i].n_events;
+            write_binary_station(&writers[0], &writers[1], &job, &job.predictions[i]);
+        }
+        failed |= writers[0].failed | writers[1].failed;
+    }
+
+    writer_flush(&writers[0]);
+    failed |= writers[0].failed;
+    if(format!=TIDE_EXPORT_CSV) {
+        /* the header and directory last, once the events are counted */
+        writer_flush(&writers[1]);
+        header.size = header.events + header.n_events * sizeof(tide_export_event_record);
+        writer_init(&writers[2], fd, 0);
+        writer_put(&writers[2], &header, sizeof(header));
+        writer_flush(&writers[2]);
+        writers[2].offset = header.stations;
+        writer_put(&writers[2], directory, (size_t)n_stations * sizeof(*directory));
+        writer_flush(&writers[2]);
+        failed |= writers[1].failed | writers[2].failed;
+    }
+done:
+    free(memory);
+    free(job.predictions);
+    free(directory);
+    free(writers);
+    if(close(fd)!=0) failed = 1;
+    return failed ? -1 : 0;
+}
@@ -0,0 +1,66 @@
+#ifndef __TIDE_EXPORT_H__
+#define __TIDE_EXPORT_H__
+#include "tide_base.h"
+
+/* Bulk export of levels and HW/LW events for many stations over a long span,
+for publishing tide calendars (tide_debug --export). Stations are predicted
+a batch at a time across threads, and written in order through a fixed
+buffer, so memory stays bounded however long the span.
+
+The binary format is little-endian, with every part starting on an 8 byte
+boundary, so it can be mapped and read in place like tide_db:
+    header              tide_export_header
+    station directory   n_stations tide_export_station_record, in the order exported
+    string table        NUL terminated station names
+    times               int64_t[n_samples], start + i * step
+    levels              float[n_stations][n_samples] (m), one column per station
+    events              n_events tide_export_event_record, by station and then time
+
+CSV has a header line, and then for each station a row for every sample and
+every event, in time order:
+    station,time,level,event,neap_spring
+with the time in ISO 8601 UTC, and event and neap_spring empty for samples. */
+#define TIDE_EXPORT_MAGIC "TIDX"
+#define TIDE_EXPORT_VERSION 1
+#define TIDE_EXPORT_ALIGN 8
+
+enum { TIDE_EXPORT_BINARY, TIDE_EXPORT_CSV };
+
+typedef struct tide_export_header {
+    char magic[4]; /* TIDE_EXPORT_MAGIC */
+    uint16_t version; /* TIDE_EXPORT_VERSION */
+    uint16_t reserved;
+    uint32_t n_stations;
+    uint32_t n_samples; /* per station */
+    int32_t step; /* seconds between samples */
+    uint32_t reserved2;
+    int64_t start; /* time of the first sample */
+    int64_t end; /* events are from [start, end) */
+    uint64_t size; /* of the whole file, in bytes */
+    uint64_t n_events;
+    uint64_t stations; /* offsets from the start of the file */
+    uint64_t strings;
+    uint64_t times;
+    uint64_t levels;
+    uint64_t events;
+} tide_export_header;
+
+typedef struct tide_export_station_record {
+    uint32_t name; /* in the string table */
+    uint32_t n_events;
+    uint64_t first_event; /* index into the events */
+} tide_export_station_record;
+
+typedef struct tide_export_event_record {
+    int64_t time;
+    float level; /* m */
+    uint8_t type; /* TIDE_HIGH or TIDE_LOW */
+    uint8_t neap_spring; /* 0 (neaps) to 255 (springs) */
+    uint16_t reserved;
+} tide_export_event_record;
+
+int find_tide_events_range(prepared_station *p, time_t t0, time_t t1, tidal_event *events, int max_events);
+int tide_export(const char *path, int format, tidal_station **stations, uint32_t n_stations,
+                time_t start, time_t end, int32_t step, int threads);
+
+#endif
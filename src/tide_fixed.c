@@ -0,0 +1,121 @@
+#include "tide_base.h"
+#include "tide_calendar.h"
+#include <math.h>
+
+/* Fixed-point tide prediction, using only integer arithmetic once a 
+station's year has been prepared. Levels come out in mm, rates in mm/h
+and accelerations in mm/h^2. Per constituent, a prediction costs two
+64x32 bit multiplies for the angle, a table lookup for cos (and one 
+more for sin if the rate is wanted), and one 32 bit multiply per output. */
+
+#define QUARTER_TURN 0x40000000u
+/* Products of amplitudes and Q15 cosines are shifted down by this much 
+before they are summed, so that 64 of them fit in 32 bits */
+#define SUM_SHIFT 7
+
+/* cos over a quarter turn in 256 steps, Q15, padded by one so that 
+interpolating from the last entry stays in bounds */
+static const int16_t cos_table[258] = {
+    32767, 32766, 32765, 32761, 32757, 32752, 32745, 32737, 32728, 32717, 32705, 32692,
+    32678, 32663, 32646, 32628, 32609, 32589, 32567, 32545, 32521, 32495, 32469, 32441,
+    32412, 32382, 32351, 32318, 32285, 32250, 32213, 32176, 32137, 32098, 32057, 32014,
+    31971, 31926, 31880, 31833, 31785, 31736, 31685, 31633, 31580, 31526, 31470, 31414,
+    31356, 31297, 31237, 31176, 31113, 31050, 30985, 30919, 30852, 30783, 30714, 30643,
+    30571, 30498, 30424, 30349, 30273, 30195, 30117, 30037, 29956, 29874, 29791, 29706,
+    29621, 29534, 29447, 29358, 29268, 29177, 29085, 28992, 28898, 28803, 28706, 28609,
+    28510, 28411, 28310, 28208, 28105, 28001, 27896, 27790, 27683, 27575, 27466, 27356,
+    27245, 27133, 27019, 26905, 26790, 26674, 26556, 26438, 26319, 26198, 26077, 25955,
+    25832, 25708, 25582, 25456, 25329, 25201, 25072, 24942, 24811, 24680, 24547, 24413,
+    24279, 24143, 24007, 23870, 23731, 23592, 23452, 23311, 23170, 23027, 22884, 22739,
+    22594, 22448, 22301, 22154, 22005, 21856, 21705, 21554, 21403, 21250, 21096, 20942,
+    20787, 20631, 20475, 20317, 20159, 20000, 19841, 19680, 19519, 19357, 19195, 19032,
+    18868, 18703, 18537, 18371, 18204, 18037, 17869, 17700, 17530, 17360, 17189, 17018,
+    16846, 16673, 16499, 16325, 16151, 15976, 15800, 15623, 15446, 15269, 15090, 14912,
+    14732, 14553, 14372, 14191, 14010, 13828, 13645, 13462, 13279, 13094, 12910, 12725,
+    12539, 12353, 12167, 11980, 11793, 11605, 11417, 11228, 11039, 10849, 10659, 10469,
+    10278, 10087, 9896, 9704, 9512, 9319, 9126, 8933, 8739, 8545, 8351, 8157,
+    7962, 7767, 7571, 7375, 7179, 6983, 6786, 6590, 6393, 6195, 5998, 5800,
+    5602, 5404, 5205, 5007, 4808, 4609, 4410, 4210, 4011, 3811, 3612, 3412,
+    3212, 3012, 2811, 2611, 2410, 2210, 2009, 1809, 1608, 1407, 1206, 1005,
+    804, 603, 402, 201, 0, 0
+};
+
+/* cos of a binary angle, Q15, by linear interpolation in the quarter-wave table */
+static int32_t cos_bam(uint32_t angle)
+{
+    uint32_t quadrant = angle >> 30;
+    uint32_t a = angle & (QUARTER_TURN - 1);
+    /* cos runs backwards through the second and fourth quadrants... */
+    if(quadrant & 1) a = QUARTER_TURN - a;
+    uint32_t i = a >> 22;
+    int32_t frac = (a >> 7) & 0x7FFF;
+    int32_t c = cos_table[i] + (((cos_table[i+1] - cos_table[i]) * frac) >> 15);
+    /* ...and is negative in the second and third */
+    return ((quadrant + 1) & 2) ? -c : c;
+}
+
+/* Saturate x to a uint16_t */
+static uint16_t clamp_u16(double x)
+{
+    if(x>65535.0) return 65535;
+    if(x<0.0) return 0;
+    return (uint16_t)lround(x);
+}
+
+/* Make sure f holds the integer constants for station at time t0.
+As prepare_station, this does nothing if they are already there; 
+f must be zeroed before its first use. Converting the speeds and the 
+station offsets needs a little floating point, but only once per year. */
+void prepare_fixed_station(fixed_station *f, tidal_station *station, time_t t0)
+{
+    tidal_harmonic *h_station = station->harmonic;
+    tidal_offset *offset = station->offset;
+    int32_t year;
+
+    if(f->station==station && t0>=f->start && t0<f->end) return;
+    year = station_year(station, t0, &f->start, &f->end);
+    f->station = station;
+    f->epoch = year_start(year) - offset->time_offset;
+    f->offset_mm = lround((h_station->offset + offset->level_offset) * offset->level_scale * 1000.0);
+    f->level_k = lround(MAX_TIDE_AMP * 1000.0 / 65535.0 * offset->level_scale * 65536.0);
+    f->n_constituents = h_station->n_constituents;
+    
+    for(int i=0; i<f->n_constituents; i++) {
+        float speed, amp, phase;
+        harmonic_constituent(h_station, year, i, &speed, &amp, &phase);
+        double amp_mm = amp * offset->level_scale * 1000.0;
+        /* Back to the stored quantization, which level_k undoes */
+        f->amps[i] = clamp_u16(amp / MAX_TIDE_AMP * 65535.0);
+        /* MAX_TIDE_PHASE is one whole turn */
+        f->phases[i] = (uint32_t)llround(phase / MAX_TIDE_PHASE * 4294967296.0);
+        f->speeds[i] = llround((double)speed / (2.0 * M_PI) * 4294967296.0 * 65536.0);
+        f->rate_amps[i] = clamp_u16(amp_mm * speed * HOUR_SECONDS * (1 << TIDE_FIXED_RATE_SHIFT));
+        f->accel_amps[i] = clamp_u16(amp_mm * speed * speed * HOUR_SECONDS * HOUR_SECONDS * (1 << TIDE_FIXED_RATE_SHIFT));
+    }
+}
+
+/* Predict the level (mm) at t0, and the rate (mm/h) and acceleration (mm/h^2)
+if those are not NULL, using integer arithmetic only */
+void predict_tide_fixed(time_t t0, fixed_station *f, int32_t *level_mm, int32_t *rate_mm_h, int32_t *accel_mm_h2)
+{
+    int32_t level = 0, rate = 0, accel = 0;
+    int32_t t, t_high;
+    uint32_t t_low;
+    prepare_fixed_station(f, f->station, t0);
+    /* speed * t, split so the product fits in 64 bits for any t in the year */
+    t = (int32_t)(t0 - f->epoch);
+    t_high = t >> 16;
+    t_low = (uint32_t)t & 0xFFFF;
+    for(int i=0; i<f->n_constituents; i++) {
+        uint32_t angle = f->phases[i] + (uint32_t)(f->speeds[i] * t_high) + (uint32_t)((f->speeds[i] * t_low) >> 16);
+        int32_t c = cos_bam(angle);
+        level += ((int32_t)f->amps[i] * c) >> SUM_SHIFT;
+        if(rate_mm_h) rate += ((int32_t)f->rate_amps[i] * cos_bam(angle - QUARTER_TURN)) >> SUM_SHIFT;
+        if(accel_mm_h2) accel += ((int32_t)f->accel_amps[i] * c) >> SUM_SHIFT;
+    }
+    /* The sums are in units of 2^(15-SUM_SHIFT) per unit amplitude; round back to mm */
+    *level_mm = f->offset_mm + (int32_t)(((int64_t)level * f->level_k + (1 << 23)) >> 24);
+    /* d/dt cos = -sin, and d2/dt2 cos = -cos */
+    if(rate_mm_h) *rate_mm_h = -((rate + (1 << (7 + TIDE_FIXED_RATE_SHIFT))) >> (8 + TIDE_FIXED_RATE_SHIFT));
+    if(accel_mm_h2) *accel_mm_h2 = -((accel + (1 << (7 + TIDE_FIXED_RATE_SHIFT))) >> (8 + TIDE_FIXED_RATE_SHIFT));
+}
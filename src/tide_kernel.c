@@ -0,0 +1,442 @@
+#include "tide_kernel.h"
+#include <stdint.h>
+#include <string.h>
+
+#if !defined(TIDE_KERNEL_SCALAR) && defined(__AVX2__)
+#define TIDE_KERNEL_AVX2
+#include <immintrin.h>
+#elif !defined(TIDE_KERNEL_SCALAR) && defined(__SSE2__)
+#define TIDE_KERNEL_SSE2
+#include <emmintrin.h>
+#elif !defined(TIDE_KERNEL_SCALAR) && defined(__GNUC__) && (__GNUC__ >= 9 || defined(__clang__))
+#define TIDE_KERNEL_VECTOR
+#endif
+
+/* Range reduction: x = k*pi/2 + r, with pi/2 split in three parts
+so that k*PIO2_1 and k*PIO2_2 are exact (Cody-Waite) */
+#define TWO_OVER_PI 0.636619772367581343f
+#define PIO2_1 1.5703125f
+#define PIO2_2 4.837512969970703125e-4f
+#define PIO2_3 7.54978995489188216e-8f
+/* Adding and subtracting 1.5*2^23 rounds to the nearest integer */
+#define ROUND_MAGIC 12582912.0f
+
+/* Minimax polynomials for sin and cos on [-pi/4, pi/4] (from Cephes) */
+#define SIN_1 -1.6666654611e-1f
+#define SIN_2 8.3321608736e-3f
+#define SIN_3 -1.9515295891e-4f
+#define COS_1 4.166664568298827e-2f
+#define COS_2 -1.388731625493765e-3f
+#define COS_3 2.443315711809948e-5f
+
+/* sin and cos of x for one lane. The vector versions below must
+follow this sequence of operations exactly. */
+static inline void sincos_lane(float x, float *sin_x, float *cos_x)
+{
+    float y = x * TWO_OVER_PI;
+    float kf = (y + ROUND_MAGIC) - ROUND_MAGIC;
+    int32_t q = (int32_t)kf;
+    float r = x - kf * PIO2_1;
+    r = r - kf * PIO2_2;
+    r = r - kf * PIO2_3;
+    float z = r * r;
+    float ps = SIN_2 + z * SIN_3;
+    ps = SIN_1 + z * ps;
+    float sn = r + (r * z) * ps;
+    float pc = COS_2 + z * COS_3;
+    pc = COS_1 + z * pc;
+    float cs = (1.0f - 0.5f * z) + (z * z) * pc;
+    /* Swap sin/cos in odd quadrants, and fix the signs */
+    float c = (q & 1) ? sn : cs;
+    float s = (q & 1) ? cs : sn;
+    uint32_t bits;
+    memcpy(&bits, &c, sizeof(bits));
+    bits ^= (uint32_t)((q + 1) & 2) << 30;
+    memcpy(&c, &bits, sizeof(bits));
+    memcpy(&bits, &s, sizeof(bits));
+    bits ^= (uint32_t)(q & 2) << 30;
+    memcpy(&s, &bits, sizeof(bits));
+    *sin_x = s;
+    *cos_x = c;
+}
+
+/* Sum the lane accumulators in a fixed order */
+static inline float sum_lanes(const float *lanes)
+{
+    float total = lanes[0];
+    for(int j=1; j<TIDE_KERNEL_LANES; j++) total += lanes[j];
+    return total;
+}
+
+float tide_kernel_level_reference(const float *amps, const float *speeds, const float *phases, int n, float t)
+{
+    float acc[TIDE_KERNEL_LANES] = {0};
+    float s, c;
+    for(int i=0; i<n; i+=TIDE_KERNEL_LANES) {
+        for(int j=0; j<TIDE_KERNEL_LANES; j++) {
+            float x = speeds[i+j] * t + phases[i+j];
+            sincos_lane(x, &s, &c);
+            acc[j] = acc[j] + amps[i+j] * c;
+        }
+    }
+    return sum_lanes(acc);
+}
+
+void tide_kernel_derivatives_reference(const float *amps, const float *speeds, const float *phases, int n, float t, float *level, float *rate, float *accel)
+{
+    float acc0[TIDE_KERNEL_LANES] = {0}, acc1[TIDE_KERNEL_LANES] = {0}, acc2[TIDE_KERNEL_LANES] = {0};
+    float s, c;
+    for(int i=0; i<n; i+=TIDE_KERNEL_LANES) {
+        for(int j=0; j<TIDE_KERNEL_LANES; j++) {
+            float x = speeds[i+j] * t + phases[i+j];
+            sincos_lane(x, &s, &c);
+            float ac = amps[i+j] * c;
+            float as = amps[i+j] * s;
+            acc0[j] = acc0[j] + ac;
+            acc1[j] = acc1[j] - as * speeds[i+j];
+            acc2[j] = acc2[j] - (ac * speeds[i+j]) * speeds[i+j];
+        }
+    }
+    *level = sum_lanes(acc0);
+    *rate = sum_lanes(acc1);
+    *accel = sum_lanes(acc2);
+}
+
+void tide_kernel_accumulate_reference(const float *amps, const float *speeds, const float *phases, const float *t, int nt, float *acc0, float *acc1, float *acc2)
+{
+    float s, c;
+    for(int k=0; k<nt; k++) {
+        for(int j=0; j<TIDE_KERNEL_LANES; j++) {
+            int l = k*TIDE_KERNEL_LANES + j;
+            float x = speeds[j] * t[k] + phases[j];
+            sincos_lane(x, &s, &c);
+            float ac = amps[j] * c;
+            acc0[l] = acc0[l] + ac;
+            if(acc1) {
+                float as = amps[j] * s;
+                acc1[l] = acc1[l] - as * speeds[j];
+                acc2[l] = acc2[l] - (ac * speeds[j]) * speeds[j];
+            }
+        }
+    }
+}
+
+float tide_kernel_reduce(const float *lanes)
+{
+    return sum_lanes(lanes);
+}
+
+#if defined(TIDE_KERNEL_AVX2)
+
+static inline void sincos_avx2(__m256 x, __m256 *sin_x, __m256 *cos_x)
+{
+    const __m256 magic = _mm256_set1_ps(ROUND_MAGIC);
+    const __m256i one = _mm256_set1_epi32(1), two = _mm256_set1_epi32(2);
+    __m256 y = _mm256_mul_ps(x, _mm256_set1_ps(TWO_OVER_PI));
+    __m256 kf = _mm256_sub_ps(_mm256_add_ps(y, magic), magic);
+    __m256i q = _mm256_cvttps_epi32(kf);
+    __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(kf, _mm256_set1_ps(PIO2_1)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(kf, _mm256_set1_ps(PIO2_2)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(kf, _mm256_set1_ps(PIO2_3)));
+    __m256 z = _mm256_mul_ps(r, r);
+    __m256 ps = _mm256_add_ps(_mm256_set1_ps(SIN_2), _mm256_mul_ps(z, _mm256_set1_ps(SIN_3)));
+    ps = _mm256_add_ps(_mm256_set1_ps(SIN_1), _mm256_mul_ps(z, ps));
+    __m256 sn = _mm256_add_ps(r, _mm256_mul_ps(_mm256_mul_ps(r, z), ps));
+    __m256 pc = _mm256_add_ps(_mm256_set1_ps(COS_2), _mm256_mul_ps(z, _mm256_set1_ps(COS_3)));
+    pc = _mm256_add_ps(_mm256_set1_ps(COS_1), _mm256_mul_ps(z, pc));
+    __m256 cs = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(_mm256_set1_ps(0.5f), z)), _mm256_mul_ps(_mm256_mul_ps(z, z), pc));
+    __m256 odd = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q, one), one));
+    __m256 c = _mm256_blendv_ps(cs, sn, odd);
+    __m256 s = _mm256_blendv_ps(sn, cs, odd);
+    __m256i c_sign = _mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(q, one), two), 30);
+    __m256i s_sign = _mm256_slli_epi32(_mm256_and_si256(q, two), 30);
+    *cos_x = _mm256_xor_ps(c, _mm256_castsi256_ps(c_sign));
+    *sin_x = _mm256_xor_ps(s, _mm256_castsi256_ps(s_sign));
+}
+
+float tide_kernel_level(const float *amps, const float *speeds, const float *phases, int n, float t)
+{
+    float lanes[TIDE_KERNEL_LANES];
+    __m256 acc = _mm256_setzero_ps();
+    __m256 tv = _mm256_set1_ps(t);
+    __m256 s, c;
+    for(int i=0; i<n; i+=TIDE_KERNEL_LANES) {
+        __m256 x = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(speeds+i), tv), _mm256_loadu_ps(phases+i));
+        sincos_avx2(x, &s, &c);
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(amps+i), c));
+    }
+    _mm256_storeu_ps(lanes, acc);
+    return sum_lanes(lanes);
+}
+
+void tide_kernel_derivatives(const float *amps, const float *speeds, const float *phases, int n, float t, float *level, float *rate, float *accel)
+{
+    float lanes[TIDE_KERNEL_LANES];
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps(), acc2 = _mm256_setzero_ps();
+    __m256 tv = _mm256_set1_ps(t);
+    __m256 s, c;
+    for(int i=0; i<n; i+=TIDE_KERNEL_LANES) {
+        __m256 speed = _mm256_loadu_ps(speeds+i);
+        __m256 amp = _mm256_loadu_ps(amps+i);
+        __m256 x = _mm256_add_ps(_mm256_mul_ps(speed, tv), _mm256_loadu_ps(phases+i));
+        sincos_avx2(x, &s, &c);
+        __m256 ac = _mm256_mul_ps(amp, c);
+        __m256 as = _mm256_mul_ps(amp, s);
+        acc0 = _mm256_add_ps(acc0, ac);
+        acc1 = _mm256_sub_ps(acc1, _mm256_mul_ps(as, speed));
+        acc2 = _mm256_sub_ps(acc2, _mm256_mul_ps(_mm256_mul_ps(ac, speed), speed));
+    }
+    _mm256_storeu_ps(lanes, acc0);
+    *level = sum_lanes(lanes);
+    _mm256_storeu_ps(lanes, acc1);
+    *rate = sum_lanes(lanes);
+    _mm256_storeu_ps(lanes, acc2);
+    *accel = sum_lanes(lanes);
+}
+
+void tide_kernel_accumulate(const float *amps, const float *speeds, const float *phases, const float *t, int nt, float *acc0, float *acc1, float *acc2)
+{
+    __m256 speed = _mm256_loadu_ps(speeds);
+    __m256 amp = _mm256_loadu_ps(amps);
+    __m256 phase = _mm256_loadu_ps(phases);
+    __m256 s, c;
+    for(int k=0; k<nt; k++) {
+        int l = k*TIDE_KERNEL_LANES;
+        __m256 x = _mm256_add_ps(_mm256_mul_ps(speed, _mm256_set1_ps(t[k])), phase);
+        sincos_avx2(x, &s, &c);
+        __m256 ac = _mm256_mul_ps(amp, c);
+        _mm256_storeu_ps(acc0+l, _mm256_add_ps(_mm256_loadu_ps(acc0+l), ac));
+        if(acc1) {
+            __m256 as = _mm256_mul_ps(amp, s);
+            _mm256_storeu_ps(acc1+l, _mm256_sub_ps(_mm256_loadu_ps(acc1+l), _mm256_mul_ps(as, speed)));
+            _mm256_storeu_ps(acc2+l, _mm256_sub_ps(_mm256_loadu_ps(acc2+l), _mm256_mul_ps(_mm256_mul_ps(ac, speed), speed)));
+        }
+    }
+}
+
+const char *tide_kernel_name(void) { return "avx2"; }
+
+#elif defined(TIDE_KERNEL_SSE2)
+
+static inline void sincos_sse2(__m128 x, __m128 *sin_x, __m128 *cos_x)
+{
+    const __m128 magic = _mm_set1_ps(ROUND_MAGIC);
+    const __m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2);
+    __m128 y = _mm_mul_ps(x, _mm_set1_ps(TWO_OVER_PI));
+    __m128 kf = _mm_sub_ps(_mm_add_ps(y, magic), magic);
+    __m128i q = _mm_cvttps_epi32(kf);
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(kf, _mm_set1_ps(PIO2_1)));
+    r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(PIO2_2)));
+    r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(PIO2_3)));
+    __m128 z = _mm_mul_ps(r, r);
+    __m128 ps = _mm_add_ps(_mm_set1_ps(SIN_2), _mm_mul_ps(z, _mm_set1_ps(SIN_3)));
+    ps = _mm_add_ps(_mm_set1_ps(SIN_1), _mm_mul_ps(z, ps));
+    __m128 sn = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, z), ps));
+    __m128 pc = _mm_add_ps(_mm_set1_ps(COS_2), _mm_mul_ps(z, _mm_set1_ps(COS_3)));
+    pc = _mm_add_ps(_mm_set1_ps(COS_1), _mm_mul_ps(z, pc));
+    __m128 cs = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), z)), _mm_mul_ps(_mm_mul_ps(z, z), pc));
+    /* No blend in SSE2; select with masks */
+    __m128 odd = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one));
+    __m128 c = _mm_or_ps(_mm_and_ps(odd, sn), _mm_andnot_ps(odd, cs));
+    __m128 s = _mm_or_ps(_mm_and_ps(odd, cs), _mm_andnot_ps(odd, sn));
+    __m128i c_sign = _mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, one), two), 30);
+    __m128i s_sign = _mm_slli_epi32(_mm_and_si128(q, two), 30);
+    *cos_x = _mm_xor_ps(c, _mm_castsi128_ps(c_sign));
+    *sin_x = _mm_xor_ps(s, _mm_castsi128_ps(s_sign));
+}
+
+/* Each block of 8 lanes is handled as two halves */
+float tide_kernel_level(const float *amps, const float *speeds, const float *phases, int n, float t)
+{
+    float lanes[TIDE_KERNEL_LANES];
+    __m128 acc[2] = {_mm_setzero_ps(), _mm_setzero_ps()};
+    __m128 tv = _mm_set1_ps(t);
+    __m128 s, c;
+    for(int i=0; i<n; i+=TIDE_KERNEL_LANES) {
+        for(int h=0; h<2; h++) {
+            int k = i + 4*h;
+            __m128 x = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(speeds+k), tv), _mm_loadu_ps(phases+k));
+            sincos_sse2(x, &s, &c);
+            acc[h] = _mm_add_ps(acc[h], _mm_mul_ps(_mm_loadu_ps(amps+k), c));
+        }
+    }
+    _mm_storeu_ps(lanes, acc[0]);
+    _mm_storeu_ps(lanes+4, acc[1]);
+    return sum_lanes(lanes);
+}
+
+void tide_kernel_derivatives(const float *amps, const float *speeds, const float *phases, int n, float t, float *level, float *rate, float *accel)
+{
+    float lanes[TIDE_KERNEL_LANES];
+    __m128 acc0[2] = {_mm_setzero_ps(), _mm_setzero_ps()};
+    __m128 acc1[2] = {_mm_setzero_ps(), _mm_setzero_ps()};
+    __m128 acc2[2] = {_mm_setzero_ps(), _mm_setzero_ps()};
+    __m128 tv = _mm_set1_ps(t);
+    __m128 s, c;
+    for(int i=0; i<n; i+=TIDE_KERNEL_LANES) {
+        for(int h=0; h<2; h++) {
+            int k = i + 4*h;
+            __m128 speed = _mm_loadu_ps(speeds+k);
+            __m128 amp = _mm_loadu_ps(amps+k);
+            __m128 x = _mm_add_ps(_mm_mul_ps(speed, tv), _mm_loadu_ps(phases+k));
+            sincos_sse2(x, &s, &c);
+            __m128 ac = _mm_mul_ps(amp, c);
+            __m128 as = _mm_mul_ps(amp, s);
+            acc0[h] = _mm_add_ps(acc0[h], ac);
+            acc1[h] = _mm_sub_ps(acc1[h], _mm_mul_ps(as, speed));
+            acc2[h] = _mm_sub_ps(acc2[h], _mm_mul_ps(_mm_mul_ps(ac, speed), speed));
+        }
+    }
+    _mm_storeu_ps(lanes, acc0[0]);
+    _mm_storeu_ps(lanes+4, acc0[1]);
+    *level = sum_lanes(lanes);
+    _mm_storeu_ps(lanes, acc1[0]);
+    _mm_storeu_ps(lanes+4, acc1[1]);
+    *rate = sum_lanes(lanes);
+    _mm_storeu_ps(lanes, acc2[0]);
+    _mm_storeu_ps(lanes+4, acc2[1]);
+    *accel = sum_lanes(lanes);
+}
+
+void tide_kernel_accumulate(const float *amps, const float *speeds, const float *phases, const float *t, int nt, float *acc0, float *acc1, float *acc2)
+{
+    __m128 s, c;
+    for(int h=0; h<2; h++) {
+        __m128 speed = _mm_loadu_ps(speeds+4*h);
+        __m128 amp = _mm_loadu_ps(amps+4*h);
+        __m128 phase = _mm_loadu_ps(phases+4*h);
+        for(int k=0; k<nt; k++) {
+            int l = k*TIDE_KERNEL_LANES + 4*h;
+            __m128 x = _mm_add_ps(_mm_mul_ps(speed, _mm_set1_ps(t[k])), phase);
+            sincos_sse2(x, &s, &c);
+            __m128 ac = _mm_mul_ps(amp, c);
+            _mm_storeu_ps(acc0+l, _mm_add_ps(_mm_loadu_ps(acc0+l), ac));
+            if(acc1) {
+                __m128 as = _mm_mul_ps(amp, s);
+                _mm_storeu_ps(acc1+l, _mm_sub_ps(_mm_loadu_ps(acc1+l), _mm_mul_ps(as, speed)));
+                _mm_storeu_ps(acc2+l, _mm_sub_ps(_mm_loadu_ps(acc2+l), _mm_mul_ps(_mm_mul_ps(ac, speed), speed)));
+            }
+        }
+    }
+}
+
+const char *tide_kernel_name(void) { return "sse2"; }
+
+#elif defined(TIDE_KERNEL_VECTOR)
+
+/* Generic compiler vector extensions (e.g. NEON, or anything else GCC/clang can target) */
+typedef float v8f __attribute__((vector_size(TIDE_KERNEL_LANES * sizeof(float))));
+typedef int32_t v8i __attribute__((vector_size(TIDE_KERNEL_LANES * sizeof(int32_t))));
+
+static inline v8f load_v8f(const float *p)
+{
+    v8f v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void sincos_vector(v8f x, v8f *sin_x, v8f *cos_x)
+{
+    v8f y = x * TWO_OVER_PI;
+    v8f kf = (y + ROUND_MAGIC) - ROUND_MAGIC;
+    v8i q = __builtin_convertvector(kf, v8i);
+    v8f r = x - kf * PIO2_1;
+    r = r - kf * PIO2_2;
+    r = r - kf * PIO2_3;
+    v8f z = r * r;
+    v8f ps = SIN_2 + z * SIN_3;
+    ps = SIN_1 + z * ps;
+    v8f sn = r + (r * z) * ps;
+    v8f pc = COS_2 + z * COS_3;
+    pc = COS_1 + z * pc;
+    v8f cs = (1.0f - 0.5f * z) + (z * z) * pc;
+    v8i odd = (q & 1) == 1;
+    v8i c = ((v8i)sn & odd) | ((v8i)cs & ~odd);
+    v8i s = ((v8i)cs & odd) | ((v8i)sn & ~odd);
+    *cos_x = (v8f)(c ^ (((q + 1) & 2) << 30));
+    *sin_x = (v8f)(s ^ ((q & 2) << 30));
+}
+
+float tide_kernel_level(const float *amps, const float *speeds, const float *phases, int n, float t)
+{
+    float lanes[TIDE_KERNEL_LANES];
+    v8f acc = {0};
+    v8f s, c;
+    for(int i=0; i<n; i+=TIDE_KERNEL_LANES) {
+        v8f x = load_v8f(speeds+i) * t + load_v8f(phases+i);
+        sincos_vector(x, &s, &c);
+        acc = acc + load_v8f(amps+i) * c;
+    }
+    memcpy(lanes, &acc, sizeof(lanes));
+    return sum_lanes(lanes);
+}
+
+void tide_kernel_derivatives(const float *amps, const float *speeds, const float *phases, int n, float t, float *level, float *rate, float *accel)
+{
+    float lanes[TIDE_KERNEL_LANES];
+    v8f acc0 = {0}, acc1 = {0}, acc2 = {0};
+    v8f s, c;
+    for(int i=0; i<n; i+=TIDE_KERNEL_LANES) {
+        v8f speed = load_v8f(speeds+i);
+        v8f amp = load_v8f(amps+i);
+        v8f x = speed * t + load_v8f(phases+i);
+        sincos_vector(x, &s, &c);
+        v8f ac = amp * c;
+        v8f as = amp * s;
+        acc0 = acc0 + ac;
+        acc1 = acc1 - as * speed;
+        acc2 = acc2 - (ac * speed) * speed;
+    }
+    memcpy(lanes, &acc0, sizeof(lanes));
+    *level = sum_lanes(lanes);
+    memcpy(lanes, &acc1, sizeof(lanes));
+    *rate = sum_lanes(lanes);
+    memcpy(lanes, &acc2, sizeof(lanes));
+    *accel = sum_lanes(lanes);
+}
+
+void tide_kernel_accumulate(const float *amps, const float *speeds, const float *phases, const float *t, int nt, float *acc0, float *acc1, float *acc2)
+{
+    v8f speed = load_v8f(speeds);
+    v8f amp = load_v8f(amps);
+    v8f phase = load_v8f(phases);
+    v8f s, c, acc;
+    for(int k=0; k<nt; k++) {
+        int l = k*TIDE_KERNEL_LANES;
+        v8f x = speed * t[k] + phase;
+        sincos_vector(x, &s, &c);
+        v8f ac = amp * c;
+        acc = load_v8f(acc0+l) + ac;
+        memcpy(acc0+l, &acc, sizeof(acc));
+        if(acc1) {
+            v8f as = amp * s;
+            acc = load_v8f(acc1+l) - as * speed;
+            memcpy(acc1+l, &acc, sizeof(acc));
+            acc = load_v8f(acc2+l) - (ac * speed) * speed;
+            memcpy(acc2+l, &acc, sizeof(acc));
+        }
+    }
+}
+
+const char *tide_kernel_name(void) { return "vector"; }
+
+#else
+
+float tide_kernel_level(const float *amps, const float *speeds, const float *phases, int n, float t)
+{
+    return tide_kernel_level_reference(amps, speeds, phases, n, t);
+}
+
+void tide_kernel_derivatives(const float *amps, const float *speeds, const float *phases, int n, float t, float *level, float *rate, float *accel)
+{
+    tide_kernel_derivatives_reference(amps, speeds, phases, n, t, level, rate, accel);
+}
+
+void tide_kernel_accumulate(const float *amps, const float *speeds, const float *phases, const float *t, int nt, float *acc0, float *acc1, float *acc2)
+{
+    tide_kernel_accumulate_reference(amps, speeds, phases, t, nt, acc0, acc1, acc2);
+}
+
+const char *tide_kernel_name(void) { return "scalar"; }
+
+#endif
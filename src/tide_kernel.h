@@ -0,0 +1,37 @@
+#ifndef __TIDE_KERNEL_H__
+#define __TIDE_KERNEL_H__
+
+/* Constituent summation kernel.
+Evaluates sum(amp * cos(speed * t + phase)) with a polynomial sin/cos,
+several constituents at a time. Every implementation (AVX2, SSE2, compiler
+vector extensions and plain C) performs exactly the same float operations
+per lane and sums the lanes in the same order, so all of them give
+bit-identical results to tide_kernel_level_reference.
+
+Build with -ffp-contract=off, or the compiler may fuse some paths and not others.
+Define TIDE_KERNEL_SCALAR to force the plain C version. */
+
+/* Constituents are processed in blocks of this many; arrays passed to the
+kernel must be padded to a multiple of it with zero amplitudes. */
+#define TIDE_KERNEL_LANES 8
+#define TIDE_KERNEL_PAD(n) (((n) + TIDE_KERNEL_LANES - 1) & ~(TIDE_KERNEL_LANES - 1))
+
+float tide_kernel_level(const float *amps, const float *speeds, const float *phases, int n, float t);
+void tide_kernel_derivatives(const float *amps, const float *speeds, const float *phases, int n, float t, float *level, float *rate, float *accel);
+
+/* Add one block of TIDE_KERNEL_LANES constituents to the lane sums for nt times.
+acc0 (levels), acc1 (rates) and acc2 (accelerations) are [nt][TIDE_KERNEL_LANES];
+acc1 and acc2 may be NULL. Reducing the lanes after all blocks have been added 
+gives the same result as tide_kernel_level/tide_kernel_derivatives at each time. */
+void tide_kernel_accumulate(const float *amps, const float *speeds, const float *phases, const float *t, int nt, float *acc0, float *acc1, float *acc2);
+float tide_kernel_reduce(const float *lanes);
+
+/* Plain C versions, always available for cross-checking */
+float tide_kernel_level_reference(const float *amps, const float *speeds, const float *phases, int n, float t);
+void tide_kernel_derivatives_reference(const float *amps, const float *speeds, const float *phases, int n, float t, float *level, float *rate, float *accel);
+void tide_kernel_accumulate_reference(const float *amps, const float *speeds, const float *phases, const float *t, int nt, float *acc0, float *acc1, float *acc2);
+
+/* Name of the implementation compiled in */
+const char *tide_kernel_name(void);
+
+#endif
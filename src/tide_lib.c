@@ -0,0 +1,73 @@
+#include "tide_lib.h"
+#include "tide_export.h"
+#include <stdlib.h>
+#include <string.h>
+
+static char lib_name[] = "tide_lib";
+
+/* The station for s, with no offsets, in the structures the core uses */
+typedef struct lib_station {
+    tidal_station station;
+    tidal_offset offset;
+    tidal_harmonic harmonic;
+    prepared_station prepared;
+} lib_station;
+
+static int lib_station_init(lib_station *l, const tide_lib_station *s)
+{
+    if(s->n_constituents>MAX_TIDE_CONSTITUENTS || s->n_years==0) return -1;
+    memset(l, 0, sizeof(*l));
+    /* the arrays are only read, though tidal_harmonic does not say so */
+    l->harmonic.type = TIDE_ENCODING_HARMONIC;
+    l->harmonic.name = lib_name;
+    l->harmonic.speeds = (float *)s->speeds;
+    l->harmonic.amps = (uint16_t *)s->amps;
+    l->harmonic.phases = (uint16_t *)s->phases;
+    l->harmonic.n_constituents = (uint8_t)s->n_constituents;
+    l->harmonic.base_year = s->base_year;
+    l->harmonic.n_years = s->n_years;
+    l->harmonic.offset = s->offset;
+    l->offset.level_scale = 1.0f;
+    l->station.name = lib_name;
+    l->station.harmonic = &l->harmonic;
+    l->station.offset = &l->offset;
+    l->prepared.station = &l->station;
+    return 0;
+}
+
+/* Predict the level (m) and, if they are not NULL, the rate (m/s) and
+acceleration (m/s^2) at each of n times. Returns 0, or -1 if the station
+can't be used. */
+int32_t tide_lib_predict(const tide_lib_station *s, const int64_t *times, int32_t n, float *levels, float *rates, float *accels)
+{
+    lib_station l;
+    time_t block[TIDE_BATCH_BLOCK];
+    if(lib_station_init(&l, s)!=0) return -1;
+    for(int32_t i=0; i<n; i+=TIDE_BATCH_BLOCK) {
+        int32_t m = (n - i<TIDE_BATCH_BLOCK) ? n - i : TIDE_BATCH_BLOCK;
+        for(int32_t j=0; j<m; j++) block[j] = (time_t)times[i+j];
+        predict_tide_batch(&l.prepared, block, m, levels + i, rates ? rates + i : NULL, accels ? accels + i : NULL);
+    }
+    return 0;
+}
+
+/* Find the HW/LW events in [t0, t1), in order, as find_tide_events would.
+Fills in up to max_events times, levels (m) and types (TIDE_HIGH or TIDE_LOW),
+and returns how many there were, or -1 if the station can't be used. */
+int32_t tide_lib_events(const tide_lib_station *s, int64_t t0, int64_t t1, int64_t *times, float *levels, uint8_t *types, int32_t max_events)
+{
+    lib_station l;
+    tidal_event *events;
+    int32_t n;
+    if(lib_station_init(&l, s)!=0 || max_events<0) return -1;
+    events = malloc((max_events ? max_events : 1) * sizeof(tidal_event));
+    if(!events) return -1;
+    n = find_tide_events_range(&l.prepared, (time_t)t0, (time_t)t1, events, max_events);
+    for(int32_t i=0; i<n; i++) {
+        times[i] = events[i].time;
+        levels[i] = events[i].level;
+        types[i] = events[i].type;
+    }
+    free(events);
+    return n;
+}
@@ -0,0 +1,24 @@
+#ifndef __TIDE_LIB_H__
+#define __TIDE_LIB_H__
+#include "tide_base.h"
+
+/* A flat interface to the prediction core, built into a shared library
+(make lib) for the generator scripts (scripts/tide_lib.py), so they get
+levels and events from the code that runs on the device. Stations are
+passed as bare arrays, quantized as in tide_data.c, so the Python side
+does not need the layout of tidal_harmonic. Times are int64_t whatever
+the size of time_t. */
+typedef struct tide_lib_station {
+    const float *speeds; /* radians/s */
+    const uint16_t *amps; /* [n_years][n_constituents], as tidal_harmonic */
+    const uint16_t *phases;
+    int32_t base_year;
+    uint32_t n_years;
+    uint32_t n_constituents; /* at most MAX_TIDE_CONSTITUENTS */
+    float offset; /* datum offset, m */
+} tide_lib_station;
+
+int32_t tide_lib_predict(const tide_lib_station *s, const int64_t *times, int32_t n, float *levels, float *rates, float *accels);
+int32_t tide_lib_events(const tide_lib_station *s, int64_t t0, int64_t t1, int64_t *times, float *levels, uint8_t *types, int32_t max_events);
+
+#endif
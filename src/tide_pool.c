@@ -0,0 +1,124 @@
+#include "tide_pool.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* The tasks a worker has left are [next, end) */
+typedef struct pool_worker {
+    pthread_mutex_t lock;
+    int next, end;
+    int index;
+    struct tide_pool *pool;
+} pool_worker;
+
+typedef struct tide_pool {
+    pool_worker *workers;
+    int n_workers;
+    tide_task_fn fn;
+    void *context;
+} tide_pool;
+
+/* Take the next task from the front of our own range */
+static int take_task(pool_worker *worker)
+{
+    int task = -1;
+    pthread_mutex_lock(&worker->lock);
+    if(worker->next<worker->end) task = worker->next++;
+    pthread_mutex_unlock(&worker->lock);
+    return task;
+}
+
+/* Move the back half of the busiest other worker's range to us.
+Returns 0 if there was nothing left to steal. */
+static int steal_tasks(pool_worker *worker)
+{
+    tide_pool *pool = worker->pool;
+    pool_worker *victim = NULL;
+    int most = 0;
+    for(int i=0; i<pool->n_workers; i++) {
+        pool_worker *other = &pool->workers[i];
+        if(other==worker) continue;
+        pthread_mutex_lock(&other->lock);
+        int left = other->end - other->next;
+        pthread_mutex_unlock(&other->lock);
+        /* Checked again when we take the tasks, as it may have changed */
+        if(left>most) {
+            most = left;
+            victim = other;
+        }
+    }
+    if(!victim) return 0;
+    pthread_mutex_lock(&victim->lock);
+    int left = victim->end - victim->next;
+    int take = (left+1) / 2;
+    int start = victim->end - take;
+    victim->end = start;
+    pthread_mutex_unlock(&victim->lock);
+    if(take<=0) return 1; /* Someone else got there first; look again */
+    pthread_mutex_lock(&worker->lock);
+    worker->next = start;
+    worker->end = start + take;
+    pthread_mutex_unlock(&worker->lock);
+    return 1;
+}
+
+static void *worker_main(void *arg)
+{
+    pool_worker *worker = arg;
+    tide_pool *pool = worker->pool;
+    int task;
+    for(;;) {
+        while((task = take_task(worker))>=0) pool->fn(pool->context, task);
+        if(!steal_tasks(worker)) break;
+    }
+    return NULL;
+}
+
+void tide_pool_run(int n_tasks, int n_threads, tide_task_fn fn, void *context)
+{
+    tide_pool pool;
+    pthread_t *threads;
+    char *started;
+    if(n_threads<1) n_threads = 1;
+    if(n_threads>n_tasks) n_threads = n_tasks;
+    if(n_threads<=1) {
+        for(int i=0; i<n_tasks; i++) fn(context, i);
+        return;
+    }
+    pool.workers = calloc(n_threads, sizeof(pool_worker));
+    threads = calloc(n_threads, sizeof(pthread_t));
+    started = calloc(n_threads, 1);
+    if(!pool.workers || !threads || !started) {
+        free(pool.workers);
+        free(threads);
+        free(started);
+        for(int i=0; i<n_tasks; i++) fn(context, i);
+        return;
+    }
+    pool.n_workers = n_threads;
+    pool.fn = fn;
+    pool.context = context;
+    for(int i=0; i<n_threads; i++) {
+        pool_worker *worker = &pool.workers[i];
+        pthread_mutex_init(&worker->lock, NULL);
+        worker->index = i;
+        worker->pool = &pool;
+        worker->next = (int)((long)n_tasks * i / n_threads);
+        worker->end = (int)((long)n_tasks * (i+1) / n_threads);
+    }
+    /* The calling thread is worker 0. If a thread can't be started, its
+    tasks are left for the others to steal, so they still all get run. */
+    for(int i=1; i<n_threads; i++) started[i] = pthread_create(&threads[i], NULL, worker_main, &pool.workers[i])==0;
+    worker_main(&pool.workers[0]);
+    for(int i=1; i<n_threads; i++) if(started[i]) pthread_join(threads[i], NULL);
+    for(int i=0; i<n_threads; i++) pthread_mutex_destroy(&pool.workers[i].lock);
+    free(started);
+    free(threads);
+    free(pool.workers);
+}
+
+int tide_pool_default_threads(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n>0 ? (int)n : 1;
+}
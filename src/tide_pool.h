@@ -0,0 +1,15 @@
+#ifndef __TIDE_POOL_H__
+#define __TIDE_POOL_H__
+
+/* Work-stealing thread pool for host-side batch jobs.
+Tasks are numbered 0..n_tasks-1 and split evenly between the threads;
+a thread that runs out of work steals half of the remaining tasks 
+from the busiest other thread. fn must be safe to call concurrently 
+for different tasks. */
+typedef void (*tide_task_fn)(void *context, int task);
+
+void tide_pool_run(int n_tasks, int n_threads, tide_task_fn fn, void *context);
+/* Number of threads to use by default (the number of online CPUs) */
+int tide_pool_default_threads(void);
+
+#endif
@@ -0,0 +1,133 @@
+#include "tide_spatial.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define DEG_TO_RAD ((float)M_PI / 180.0f)
+
+static float point_axis(const tide_spatial_point *point, int axis)
+{
+    return (axis==0) ? point->x : (axis==1) ? point->y : point->z;
+}
+
+/* The point for a station at lat, lon (degrees) */
+void tide_spatial_point_init(tide_spatial_point *point, float lat, float lon, uint32_t station)
+{
+    point->x = cosf(lat * DEG_TO_RAD) * cosf(lon * DEG_TO_RAD);
+    point->y = cosf(lat * DEG_TO_RAD) * sinf(lon * DEG_TO_RAD);
+    point->z = sinf(lat * DEG_TO_RAD);
+    point->station = station;
+}
+
+static int compare_x(const void *a, const void *b)
+{
+    float d = ((const tide_spatial_point *)a)->x - ((const tide_spatial_point *)b)->x;
+    return (d>0) - (d<0);
+}
+
+static int compare_y(const void *a, const void *b)
+{
+    float d = ((const tide_spatial_point *)a)->y - ((const tide_spatial_point *)b)->y;
+    return (d>0) - (d<0);
+}
+
+static int compare_z(const void *a, const void *b)
+{
+    float d = ((const tide_spatial_point *)a)->z - ((const tide_spatial_point *)b)->z;
+    return (d>0) - (d<0);
+}
+
+static void build_range(tide_spatial_point *points, uint32_t n, int axis)
+{
+    static int (*const compare[3])(const void *, const void *) = {compare_x, compare_y, compare_z};
+    if(n<2) return;
+    qsort(points, n, sizeof(*points), compare[axis]);
+    build_range(points, n / 2, (axis + 1) % 3);
+    build_range(points + n / 2 + 1, n - n / 2 - 1, (axis + 1) % 3);
+}
+
+/* Reorder points into a tree for tide_spatial_nearest. Takes O(n log^2 n),
+so is meant for loading, not for every query. */
+void tide_spatial_build(tide_spatial_point *points, uint32_t n)
+{
+    build_range(points, n, 0);
+}
+
+/* The k nearest found so far, nearest first, as indices into points */
+typedef struct spatial_search {
+    const tide_spatial_point *points;
+    tide_spatial_point target;
+    float limit; /* squared chord beyond which nothing is wanted */
+    uint32_t k, found;
+    uint32_t *nearest;
+} spatial_search;
+
+static float chord_squared(const tide_spatial_point *a, const tide_spatial_point *b)
+{
+    float dx = a->x - b->x, dy = a->y - b->y, dz = a->z - b->z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+static void offer_point(spatial_search *s, uint32_t index)
+{
+    float d2 = chord_squared(&s->points[index], &s->target);
+    uint32_t i;
+    if(d2>s->limit || (s->found==s->k && d2>=s->limit)) return;
+    /* insert in order, dropping the farthest if full */
+    i = (s->found<s->k) ? s->found++ : s->k - 1;
+    while(i>0 && chord_squared(&s->points[s->nearest[i-1]], &s->target)>d2) {
+        s->nearest[i] = s->nearest[i-1];
+        i--;
+    }
+    s->nearest[i] = index;
+    if(s->found==s->k) s->limit = chord_squared(&s->points[s->nearest[s->k-1]], &s->target);
+}
+
+static void search_range(spatial_search *s, uint32_t lo, uint32_t hi, int axis)
+{
+    uint32_t mid;
+    float d;
+    if(lo>=hi) return;
+    mid = lo + (hi - lo) / 2;
+    offer_point(s, mid);
+    d = point_axis(&s->target, axis) - point_axis(&s->points[mid], axis);
+    /* the near side first, then the far side if it could hold anything nearer */
+    if(d<0) {
+        search_range(s, lo, mid, (axis + 1) % 3);
+        if(d * d<=s->limit) search_range(s, mid + 1, hi, (axis + 1) % 3);
+    } else {
+        search_range(s, mid + 1, hi, (axis + 1) % 3);
+        if(d * d<=s->limit) search_range(s, lo, mid, (axis + 1) % 3);
+    }
+}
+
+/* Find up to k stations of the tree nearest lat, lon (degrees), within max_km
+if that is above zero. Fills stations and, if not NULL, km (the great-circle
+distances) nearest first, and returns how many were found. */
+uint32_t tide_spatial_nearest(const tide_spatial_point *points, uint32_t n, float lat, float lon, float max_km,
+                              uint32_t k, uint32_t *stations, float *km)
+{
+    spatial_search s = {.points = points, .limit = 5.0f, .k = k, .found = 0, .nearest = stations};
+    if(k==0) return 0;
+    tide_spatial_point_init(&s.target, lat, lon, 0);
+    /* no two points on the sphere are more than 2 apart, so 5 is no limit */
+    if(max_km>0 && max_km<(float)M_PI * EARTH_RADIUS_KM) {
+        float chord = 2.0f * sinf(max_km / (2.0f * EARTH_RADIUS_KM));
+        s.limit = chord * chord;
+    }
+    search_range(&s, 0, n, 0);
+    for(uint32_t i=0; i<s.found; i++) {
+        if(km) km[i] = 2.0f * EARTH_RADIUS_KM * asinf(fminf(sqrtf(chord_squared(&points[stations[i]], &s.target)) / 2.0f, 1.0f));
+        stations[i] = points[stations[i]].station;
+    }
+    return s.found;
+}
+
+/* As tide_spatial_nearest, for the compiled-in stations; k is at most MAX_NEAREST_STATIONS */
+uint32_t find_nearest_stations(float lat, float lon, float max_km, uint32_t k, tidal_station **stations, float *km)
+{
+    uint32_t indices[MAX_NEAREST_STATIONS];
+    uint32_t found = tide_spatial_nearest(tidal_station_points, n_tidal_station_points, lat, lon, max_km,
+                                          (k<MAX_NEAREST_STATIONS) ? k : MAX_NEAREST_STATIONS, indices, km);
+    for(uint32_t i=0; i<found; i++) stations[i] = tidal_station_index[indices[i]];
+    return found;
+}
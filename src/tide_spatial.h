@@ -0,0 +1,32 @@
+#ifndef __TIDE_SPATIAL_H__
+#define __TIDE_SPATIAL_H__
+#include "tide_base.h"
+
+/* Nearest stations to a position, by great-circle distance.
+
+Each station is a point on the unit sphere; the straight-line (chord)
+distance between two points grows with the great-circle distance, so the
+nearest by one are the nearest by the other. The points are kept as an
+implicit k-d tree: the point in the middle of each range splits it on x, y
+or z in turn (starting with x), with the points before it no greater and
+those after it no less on that axis. The generator writes the tree for the
+compiled-in stations (tidal_station_points); tide_spatial_build makes one
+from any other points, e.g. the stations of a database. */
+#define EARTH_RADIUS_KM 6371.0f
+#define MAX_NEAREST_STATIONS 16 /* most stations find_nearest_stations returns */
+
+typedef struct tide_spatial_point {
+    float x, y, z; /* unit vector; x towards 0N 0E, z towards the north pole */
+    uint32_t station; /* into tidal_station_index, or whatever list the tree was built from */
+} tide_spatial_point;
+
+extern const tide_spatial_point tidal_station_points[];
+extern const uint32_t n_tidal_station_points;
+
+void tide_spatial_point_init(tide_spatial_point *point, float lat, float lon, uint32_t station);
+void tide_spatial_build(tide_spatial_point *points, uint32_t n);
+uint32_t tide_spatial_nearest(const tide_spatial_point *points, uint32_t n, float lat, float lon, float max_km,
+                              uint32_t k, uint32_t *stations, float *km);
+uint32_t find_nearest_stations(float lat, float lon, float max_km, uint32_t k, tidal_station **stations, float *km);
+
+#endif
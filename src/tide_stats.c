@@ -0,0 +1,25 @@
+#include "tide_stats.h"
+#include <string.h>
+
+#ifdef TIDE_STATS
+tide_stats tide_stats_counters;
+tide_trace_record tide_trace_records[TIDE_TRACE_SIZE];
+uint32_t tide_trace_count;
+
+/* Add a record to the trace, overwriting the oldest once it is full */
+void tide_trace(uint8_t kind, time_t t, int32_t value)
+{
+    tide_trace_record *record = &tide_trace_records[tide_trace_count % TIDE_TRACE_SIZE];
+    record->sequence = tide_trace_count++;
+    record->kind = kind;
+    record->t = t;
+    record->value = value;
+}
+
+/* Zero the counters and empty the trace */
+void tide_stats_reset(void)
+{
+    memset(&tide_stats_counters, 0, sizeof(tide_stats_counters));
+    tide_trace_count = 0;
+}
+#endif
@@ -0,0 +1,57 @@
+#ifndef __TIDE_STATS_H__
+#define __TIDE_STATS_H__
+#include <stdint.h>
+#include <time.h>
+
+/* Optional instrumentation of the prediction core. Build with 
+DEFS=-DTIDE_STATS to count the work done in tide_base.c and keep a short 
+trace of what happened; without it the hooks compile to nothing. 
+The counters and the trace are global and not locked, so counts may be 
+lost if several threads predict at once. */
+
+/* Kinds of trace record */
+#define TIDE_TRACE_PREPARE 1 /* constants rebuilt; value is the year */
+#define TIDE_TRACE_TABLE_FULL 2 /* table rebuilt from scratch; t is its midnight */
+#define TIDE_TRACE_TABLE_SHIFT 3 /* table moved along its ring; value is the days moved */
+#define TIDE_TRACE_EVENT 4 /* event found; value is TIDE_HIGH or TIDE_LOW */
+#define TIDE_TRACE_UNCONVERGED 5 /* Newton's method did not settle; value is the last correction (s) */
+#define TIDE_TRACE_REJECTED 6 /* event not added; value is 0 for a duplicate, 1 for a full list */
+
+/* Trace records kept; a power of two */
+#define TIDE_TRACE_SIZE 64
+
+typedef struct tide_stats {
+    uint32_t predictions[4]; /* predict_tide calls for d=0, 1, 2 and higher */
+    uint32_t fused_predictions; /* predict_tide_derivatives calls */
+    uint32_t prepares; /* constants rebuilt by prepare_station */
+    uint32_t newton_steps; /* in find_tide_event, and refining brackets in find_tide_events */
+    uint32_t search_steps; /* steps of the walk in find_tide_events */
+    uint32_t unconverged; /* brackets where Newton's method did not settle */
+    uint32_t events_found;
+    uint32_t duplicate_events; /* rejected by add_tide_event as too close to another */
+    uint32_t overflowed_events; /* rejected by add_tide_event as the day was full */
+    uint32_t full_rebuilds; /* tables built from scratch by populate_tide_table */
+    uint32_t incremental_rebuilds; /* tables moved by a few days */
+} tide_stats;
+
+typedef struct tide_trace_record {
+    uint32_t sequence; /* increases by one for every record */
+    uint8_t kind; /* TIDE_TRACE_* */
+    time_t t; /* time the record is about */
+    int32_t value;
+} tide_trace_record;
+
+#ifdef TIDE_STATS
+extern tide_stats tide_stats_counters;
+extern tide_trace_record tide_trace_records[TIDE_TRACE_SIZE];
+extern uint32_t tide_trace_count; /* records ever written; the newest is at (count-1) % TIDE_TRACE_SIZE */
+void tide_trace(uint8_t kind, time_t t, int32_t value);
+void tide_stats_reset(void);
+#define TIDE_STAT(field) (tide_stats_counters.field++)
+#define TIDE_TRACE(kind, t, value) tide_trace(kind, t, value)
+#else
+#define TIDE_STAT(field) ((void)0)
+#define TIDE_TRACE(kind, t, value) ((void)0)
+#endif
+
+#endif
@@ -1,4 +1,5 @@
 #include "tide_watch.h"
+#include "tide_almanac.h"
 #include "tide_base.h"
 
 tide_face face_data;
@@ -7,33 +8,35 @@ tide_face face_data;
 void tf_ensure_tide_table(tide_face *face_data, time_t now)
 {
     /* TODO: Verify time zone hasn't changed on the watch -- if it has, update tz_hours and tz_mins */
-    populate_tide_table(&(face_data->current_table), face_data->current_station, now, face_data->tz_hours, face_data->tz_mins);
+    populate_tide_table(&(face_data->current_table), &(face_data->prepared), face_data->current_station, now, face_data->tz_hours, face_data->tz_mins);
 }
 
 
 void tf_update_levels(tide_face *face_data, time_t now)
 {
     tf_ensure_tide_table(face_data, now);
-    face_data->level = interpolate_tide_table(now, &(face_data->current_table));
+    face_data->level = interpolate_tide_level(now, &(face_data->current_table));
     face_data->last_update = now;
 }
 
 void tf_init(tide_face *face_data, time_t t, int tz_hours, int tz_mins)
 {
     face_data->current_station = tidal_stations;    
+    face_data->prepared.station = NULL;
     face_data->mode = MODE_STATION_NAME;
     face_data->event_day = 0;
     face_data->event_number = 0;
+    face_data->event.type = TIDE_NONE;
     face_data->tz_hours = tz_hours;
     face_data->tz_mins = tz_mins;
     tf_update_levels(face_data, t);
 }
 
+/* Move to the next station, in order of name; the prepared constants
+and the table are rebuilt the next time the table is needed */
 tidal_station *tf_cycle_station(tidal_station *station)
 {
-    tidal_station *next = station->previous;
-    if(next==NULL)
-        next = tidal_stations;
+    return next_tidal_station(station);
 }
 
 #define EVENT_NONE 0
@@ -53,20 +56,27 @@ void tf_event(tide_face *face, uint8_t event, time_t t)
             {
                 tide_table *table = &(face->current_table);
                 face->mode = MODE_STATION_EVENT;
-                face->event_day = 1; /* Start at the nearest event to now */
+                face->event_day = TIDE_TABLE_DAYS_BEFORE; /* Start at the nearest event to now */
                 face->event_number = 0;            
-                if(t<table->base_time-DAY_SECONDS || t>=table->base_time+DAY_SECONDS*2-HOUR_SECONDS)
+                /* Stations with an almanac can step through events indefinitely */
+                tidal_event prev;
+                get_almanac_events_near(face->current_station, t, &prev, &face->event);
+                if(face->event.type!=TIDE_NONE)
+                {
+                    /* Found in the almanac; the table is not needed */
+                }
+                else if(t<tide_table_start(table) || t>=tide_table_start(table)+(time_t)TIDE_TABLE_DAYS*DAY_SECONDS-HOUR_SECONDS)
                 {
                     /* We're outside the range of the table; just show the first event for today */
                 }
                 else
                 {                
-                    for(int i=0;i<3;i++)
+                    for(int i=0;i<TIDE_TABLE_DAYS;i++)
                     {
                         for(int j=0;j<MAX_TIDE_EVENTS;j++)
                         {
                             
-                            if(table->events[i][j].time>t)
+                            if(tide_table_event(table, i, j).time>t)
                             {
                                 face->event_day = i;
                                 face->event_number = j;
@@ -84,18 +94,25 @@ void tf_event(tide_face *face, uint8_t event, time_t t)
             break;
         /* Event viewer (HW/LW) mode */
         case MODE_STATION_EVENT:
-            if(event==EVENT_ALARM)
+            if(event==EVENT_ALARM && face->event.type!=TIDE_NONE)
+            {
+                /* Step to the event after the current one; this leaves almanac 
+                mode if we run off the end of the almanac */
+                tidal_event prev;
+                get_almanac_events_near(face->current_station, face->event.time, &prev, &face->event);
+            }
+            else if(event==EVENT_ALARM)
             {
                 int attempts = 0;
                 /* Advance to the next non-empty event */
-                while(face->current_table.events[face->event_day][face->event_number].type==TIDE_NONE && attempts<(4*MAX_TIDE_EVENTS))
+                while(tide_table_event(&face->current_table, face->event_day, face->event_number).type==TIDE_NONE && attempts<((TIDE_TABLE_DAYS+1)*MAX_TIDE_EVENTS))
                 {
                     face->event_number++;
                     if(face->event_number>=MAX_TIDE_EVENTS)
                     {
                         face->event_number = 0;
                         face->event_day++;
-                        if(face->event_day>=3)                        
+                        if(face->event_day>=TIDE_TABLE_DAYS)                        
                             face->event_day = 0;                                                        
                     }
                     attempts++;
@@ -7,10 +7,12 @@
 
 typedef struct tide_face {
     tide_table current_table;
+    prepared_station prepared; // constants for current_station, rebuilt lazily
     time_t last_update;     
     tidal_station *current_station;    
     uint8_t mode; 
     uint8_t event_day, event_number; // day/index of the current event    
+    tidal_event event; // current event when stepping through an almanac, TIDE_NONE if using the table
     float level; // current tide level at last_update
     int tz_hours, tz_mins; // timezone offset
 } tide_face;